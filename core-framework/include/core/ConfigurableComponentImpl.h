@@ -53,6 +53,9 @@ class ConfigurableComponentImpl : public virtual ConfigurableComponent {
   [[nodiscard]] nonstd::expected<std::vector<std::string>, std::error_code> getAllPropertyValues(std::string_view name) const override;
   [[nodiscard]] nonstd::expected<std::vector<std::string>, std::error_code> getAllDynamicPropertyValues(std::string_view name) const override;
 
+  // replaces the supported and dynamic property values with those of a component of the same type, e.g. on a flow update
+  void copyPropertiesFrom(const ConfigurableComponentImpl& other);
+
  private:
   std::shared_ptr<logging::Logger> logger_ = logging::LoggerFactory<ConfigurableComponentImpl>::getLogger();
 
@@ -68,6 +68,8 @@ class ConnectableImpl : public CoreComponentImpl, public virtual Connectable {
 
   bool isAutoTerminated(const Relationship &relationship) override;
 
+  std::vector<Relationship> getAutoTerminatedRelationships() const;
+
   std::chrono::milliseconds getPenalizationPeriod() const override {
     return penalization_period_;
   }
@@ -48,6 +48,7 @@ class ContentRepositoryImpl : public CoreComponentImpl, public StreamManagerImpl
   ~ContentRepositoryImpl() override = default;
 
   std::string getStoragePath() const override;
+  std::string getStreamPath(std::string_view stream_name) const override;
   std::shared_ptr<ContentSession> createSession() override;
   void reset() override;
 
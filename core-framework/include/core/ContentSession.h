@@ -39,6 +39,8 @@ class ContentSessionImpl : public virtual ContentSession {
  public:
   explicit ContentSessionImpl(std::shared_ptr<ContentRepository> repository): repository_(std::move(repository)) {}
 
+  NewContent writeNewContent() override;
+
   std::shared_ptr<io::BaseStream> append(const std::shared_ptr<ResourceClaim>& resource_id, size_t offset, const std::function<void(const std::shared_ptr<ResourceClaim>&)>& on_copy) override;
 
  protected:
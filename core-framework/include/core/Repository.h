@@ -25,6 +25,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -84,6 +85,8 @@ class RepositoryImpl : public core::CoreComponentImpl, public core::RepositoryMe
     return true;
   }
 
+  bool MultiPut(std::span<const std::pair<std::string_view, std::span<const std::byte>>> data) override;
+
   bool Delete(const std::string& /*key*/) override {
     return true;
   }
@@ -49,6 +49,8 @@
 
 namespace org::apache::nifi::minifi::http {
 
+class HTTPMultiClient;
+
 struct KeepAliveProbeData {
   std::chrono::seconds keep_alive_delay;
   std::chrono::seconds keep_alive_interval;
@@ -202,6 +204,12 @@ class HTTPClient : public BaseHTTPClient, public core::ConnectableImpl {
   static std::string removeInvalidCharactersFromHttpHeaderFieldBody(std::string field_body);
 
  private:
+  friend class HTTPMultiClient;
+
+  // submit() is split into these so that HTTPMultiClient can drive the transfer of the prepared handle
+  bool prepareSubmit();
+  bool finishSubmit(CURLcode result);
+
   static int onProgress(void *client, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow);
 
   struct Progress{
@@ -248,6 +256,10 @@ class HTTPClient : public BaseHTTPClient, public core::ConnectableImpl {
 
   struct CurlEasyCleanup { void operator()(CURL* curl) const; };
   struct CurlMimeFree { void operator()(curl_mime* curl_mime) const; };
+  struct CurlSlistFree { void operator()(curl_slist* curl_slist) const; };
+
+  // the header list has to outlive the transfer, which may be driven asynchronously by an HTTPMultiClient
+  std::unique_ptr<curl_slist, CurlSlistFree> request_header_list_;
 
   std::unique_ptr<CURL, CurlEasyCleanup> http_session_;
   std::unique_ptr<curl_mime, CurlMimeFree> form_;
@@ -0,0 +1,83 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "http/HTTPClient.h"
+#include "minifi-cpp/core/logging/Logger.h"
+#include "core/logging/LoggerFactory.h"
+
+namespace org::apache::nifi::minifi::http {
+
+/**
+ * Drives the transfers of several HTTPClients concurrently from the calling thread, using a curl multi handle.
+ * Transfers to the same host are multiplexed over a single connection when the server supports HTTP/2.
+ * The clients must outlive their transfers, the caller owns them.
+ */
+class HTTPMultiClient {
+ public:
+  struct CompletedTransfer {
+    HTTPClient* client;
+    bool success;
+  };
+
+  HTTPMultiClient();
+
+  HTTPMultiClient(const HTTPMultiClient&) = delete;
+  HTTPMultiClient(HTTPMultiClient&&) = delete;
+  HTTPMultiClient& operator=(const HTTPMultiClient&) = delete;
+  HTTPMultiClient& operator=(HTTPMultiClient&&) = delete;
+
+  ~HTTPMultiClient();
+
+  /**
+   * Prepares the request of the client the same way as HTTPClient::submit() does, and starts its transfer
+   * @return false if the transfer could not be started
+   */
+  bool addTransfer(HTTPClient& client);
+
+  /**
+   * Waits at most the given timeout for activity on the running transfers, and makes progress on them
+   * @return the transfers which have finished, their clients hold the response as after HTTPClient::submit()
+   */
+  std::vector<CompletedTransfer> perform(std::chrono::milliseconds timeout);
+
+  /**
+   * Aborts the running transfers without completing them
+   */
+  void cancelTransfers();
+
+  [[nodiscard]] size_t size() const {
+    return transfers_.size();
+  }
+
+ private:
+  std::vector<CompletedTransfer> failTransfers();
+
+  struct CurlMultiCleanup { void operator()(CURLM* curl_multi) const; };
+
+  std::unique_ptr<CURLM, CurlMultiCleanup> multi_handle_;
+  std::unordered_map<CURL*, HTTPClient*> transfers_;
+
+  std::shared_ptr<core::logging::Logger> logger_{core::logging::LoggerFactory<HTTPMultiClient>::getLogger()};
+};
+
+}  // namespace org::apache::nifi::minifi::http
@@ -19,13 +19,27 @@
 
 #include <memory>
 #include <vector>
+#include <filesystem>
 #include <fstream>
+#include <optional>
 #include <string>
 #include "BaseStream.h"
 #include "core/logging/LoggerFactory.h"
 
 namespace org::apache::nifi::minifi::io {
 
+// Below this size opening the files for a kernel copy costs more than copying the data through user space
+inline constexpr uint64_t MIN_KERNEL_COPY_SIZE = 16 * 1024;
+
+/**
+ * A part of a local file, e.g. the content that a stream backed by the file reads next.
+ */
+struct FileRegion {
+  std::filesystem::path path;
+  uint64_t offset = 0;
+  uint64_t size = 0;
+};
+
 /**
  * Purpose: File Stream Base stream extension. This is intended to be a thread safe access to
  * read/write to the local file system.
@@ -83,16 +97,47 @@ class FileStream : public io::BaseStreamImpl {
    */
   size_t write(const uint8_t *value, size_t size) override;
 
+  /**
+   * Copies a region of a local file to the current position of the stream inside the kernel,
+   * without moving the data through user space.
+   * @return the number of bytes copied, or std::nullopt if the kernel could not copy between the files or the region is
+   * smaller than MIN_KERNEL_COPY_SIZE, in which case the data has to be written with write()
+   */
+  std::optional<size_t> copyFrom(const FileRegion& source);
+
+  /**
+   * Returns the part of the file that the stream would read from its current position to its end.
+   */
+  [[nodiscard]] std::optional<FileRegion> getRemainingRegion() const;
+
  private:
   void seekToEndOfFile(const char* caller_error_msg);
 
-  std::mutex file_lock_;
+  mutable std::mutex file_lock_;
   std::unique_ptr<std::fstream> file_stream_;
   size_t offset_{0};
   std::filesystem::path path_;
   size_t length_{0};
+  bool append_{false};
 
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<FileStream>::getLogger();
 };
 
+/**
+ * Returns the part of the local file that the stream would read from its current position to its end,
+ * or std::nullopt if the stream is not backed by a local file.
+ */
+std::optional<FileRegion> getRemainingFileRegion(const InputStream& stream);
+
+/**
+ * Returns the file stream the data written to the stream ends up in, or nullptr if the stream is not backed by a local file.
+ */
+FileStream* getUnderlyingFileStream(OutputStream& stream);
+
+/**
+ * Copies the rest of the stream to `destination` at `destination_offset` inside the kernel, if the stream is backed by a local file.
+ * @return the number of bytes copied, or std::nullopt if the data has to be read from the stream
+ */
+std::optional<size_t> copyToFileInKernel(InputStream& source, const std::filesystem::path& destination, uint64_t destination_offset);
+
 }  // namespace org::apache::nifi::minifi::io
@@ -0,0 +1,74 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+
+#include "BaseStream.h"
+#include "core/logging/LoggerFactory.h"
+
+namespace org::apache::nifi::minifi::io {
+
+/**
+ * Read-only stream over a file mapped into memory. The whole content is available in place through getBuffer(),
+ * so it can be parsed without copying it into a separate buffer first.
+ * The file must not be truncated while it is mapped.
+ */
+class MemoryMappedFileStream : public io::BaseStreamImpl {
+ public:
+  explicit MemoryMappedFileStream(const std::filesystem::path& path);
+  ~MemoryMappedFileStream() override;
+
+  MemoryMappedFileStream(const MemoryMappedFileStream&) = delete;
+  MemoryMappedFileStream& operator=(const MemoryMappedFileStream&) = delete;
+  MemoryMappedFileStream(MemoryMappedFileStream&&) = delete;
+  MemoryMappedFileStream& operator=(MemoryMappedFileStream&&) = delete;
+
+  // false if the file could not be opened or mapped, e.g. on platforms without mmap
+  [[nodiscard]] bool isMapped() const { return mapped_; }
+
+  void seek(size_t offset) override;
+  [[nodiscard]] size_t tell() const override { return offset_; }
+  [[nodiscard]] size_t size() const override { return data_.size(); }
+
+  using BaseStream::read;
+  using BaseStream::write;
+
+  size_t read(std::span<std::byte> buf) override;
+  size_t write(const uint8_t* value, size_t size) override;
+
+  [[nodiscard]] std::span<const std::byte> getBuffer() const override { return data_; }
+
+ private:
+  bool mapped_ = false;
+  std::span<const std::byte> data_;
+  size_t offset_ = 0;
+
+  std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<MemoryMappedFileStream>::getLogger();
+};
+
+/**
+ * Returns the content of the stream from its current position to its end as one contiguous buffer, if the stream keeps
+ * its whole content in memory or mapped into memory, or std::nullopt if the content has to be read from the stream.
+ */
+std::optional<std::span<const std::byte>> getContiguousBuffer(const InputStream& stream);
+
+}  // namespace org::apache::nifi::minifi::io
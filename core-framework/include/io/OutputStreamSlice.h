@@ -0,0 +1,58 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "io/BaseStream.h"
+
+namespace org::apache::nifi::minifi::io {
+
+/**
+ * Exposes the data written to the end of a shared stream as a separate stream, which starts at the end of the
+ * underlying stream at the time of construction. Closing the slice does not close the underlying stream.
+ */
+class OutputStreamSlice : public BaseStreamImpl {
+ public:
+  explicit OutputStreamSlice(std::shared_ptr<io::BaseStream> stream);
+
+  using BaseStream::read;
+  using BaseStream::write;
+
+  size_t write(const uint8_t* value, size_t size) override;
+  size_t read(std::span<std::byte> out_buffer) override;
+
+  [[nodiscard]] size_t size() const override { return stream_->size() - slice_offset_; }
+  [[nodiscard]] size_t offset() const { return slice_offset_; }
+
+  void close() override {}
+  int initialize() override { return 0; }
+
+  void seek(size_t offset) override;
+  [[nodiscard]] size_t tell() const override;
+  [[nodiscard]] std::span<const std::byte> getBuffer() const override;
+
+  [[nodiscard]] const std::shared_ptr<io::BaseStream>& getUnderlyingStream() const { return stream_; }
+
+ private:
+  std::shared_ptr<io::BaseStream> stream_;
+  size_t slice_offset_;
+};
+
+}  // namespace org::apache::nifi::minifi::io
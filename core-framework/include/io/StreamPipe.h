@@ -22,7 +22,9 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <utility>
+#include "io/FileStream.h"
 #include "minifi-cpp/io/InputStream.h"
 #include "minifi-cpp/io/OutputStream.h"
 #include "minifi-cpp/io/StreamCallback.h"
@@ -31,7 +33,22 @@
 namespace org::apache::nifi::minifi {
 namespace internal {
 
+// Copies the rest of src to dst inside the kernel if both are backed by local files
+inline std::optional<int64_t> pipeInKernel(io::InputStream& src, io::OutputStream& dst) {
+  auto* destination = io::getUnderlyingFileStream(dst);
+  if (!destination) return std::nullopt;
+  const auto source = io::getRemainingFileRegion(src);
+  if (!source) return std::nullopt;
+  const auto copied = destination->copyFrom(*source);
+  if (!copied) return std::nullopt;
+  src.seek(src.tell() + *copied);
+  return gsl::narrow<int64_t>(*copied);
+}
+
 inline int64_t pipe(io::InputStream& src, io::OutputStream& dst) {
+  if (const auto copied = pipeInKernel(src, dst)) {
+    return *copied;
+  }
   std::array<std::byte, utils::configuration::DEFAULT_BUFFER_SIZE> buffer{};
   size_t totalTransferred = 0;
   while (true) {
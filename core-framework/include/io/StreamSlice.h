@@ -45,6 +45,8 @@ class StreamSlice : public InputStreamImpl {
   [[nodiscard]] size_t tell() const override;
   [[nodiscard]] std::span<const std::byte> getBuffer() const override;
 
+  [[nodiscard]] const std::shared_ptr<io::InputStream>& getUnderlyingStream() const { return stream_; }
+
  private:
   std::shared_ptr<io::InputStream> stream_;
   size_t slice_offset_;
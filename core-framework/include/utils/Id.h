@@ -39,6 +39,7 @@ class uuid;
 #define UUID_RANDOM_IMPL 1
 #define UUID_DEFAULT_IMPL 2
 #define MINIFI_UID_IMPL 3
+#define UUID_TIME_ORDERED_IMPL 4
 
 #define UUID_RANDOM_STR "random"
 #define UUID_WINDOWS_RANDOM_STR "windows_random"
@@ -46,6 +47,8 @@ class uuid;
 #define MINIFI_UID_STR "minifi_uid"
 #define UUID_TIME_STR "time"
 #define UUID_WINDOWS_STR "windows"
+#define UUID_TIME_ORDERED_STR "time_ordered"
+#define UUID_V7_STR "v7"
 
 namespace org::apache::nifi::minifi::utils {
 
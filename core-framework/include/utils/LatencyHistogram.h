@@ -0,0 +1,58 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace org::apache::nifi::minifi::utils {
+
+/**
+ * Lock-free histogram of latencies with nanosecond resolution. Values below 2^SUB_BUCKET_BITS ns are counted exactly,
+ * larger values go to logarithmic buckets, each power of two being split into 2^SUB_BUCKET_BITS linear sub-buckets,
+ * so percentiles are accurate within 1 / 2^SUB_BUCKET_BITS (~3%) of the reported value, like in HdrHistogram.
+ * Values above MAX_VALUE (~4.9 hours) are counted as MAX_VALUE.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr size_t SUB_BUCKET_BITS = 5;
+  static constexpr size_t VALUE_BITS = 44;
+  static constexpr uint64_t MAX_VALUE = (uint64_t{1} << VALUE_BITS) - 1;
+  static constexpr size_t BUCKET_COUNT = (VALUE_BITS - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS;
+
+  void record(std::chrono::nanoseconds latency);
+
+  [[nodiscard]] uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  [[nodiscard]] std::chrono::nanoseconds max() const { return std::chrono::nanoseconds{max_.load(std::memory_order_relaxed)}; }
+
+  // Returns the latency below which the given ratio (between 0 and 1) of the recorded values fall, or 0 if nothing was recorded
+  [[nodiscard]] std::chrono::nanoseconds percentile(double ratio) const;
+
+  static size_t bucketIndex(uint64_t value);
+  // the highest value counted in the bucket
+  static uint64_t bucketUpperBound(size_t index);
+
+ private:
+  std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> max_{0};
+};
+
+}  // namespace org::apache::nifi::minifi::utils
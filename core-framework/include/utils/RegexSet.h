@@ -0,0 +1,75 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "utils/RegexUtils.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+/**
+ * Matches a set of regular expressions against an input in a single pass.
+ *
+ * The patterns are compiled into one automaton, which is run as a lazily built DFA, so the matching time is linear in
+ * the length of the input regardless of the number of patterns. The automaton supports the syntax which means the
+ * same for the std::regex and the regex.h backends of utils::Regex: literals, '.', bracket expressions with ranges and
+ * character classes, \w \W \s \S, escaped metacharacters, groups, alternation, anchors and the *, +, ?, {n,m}
+ * quantifiers. The remaining patterns (e.g. back references or lookaheads) are matched one by one using utils::Regex,
+ * which also reports the invalid patterns by throwing the same exception as utils::Regex.
+ *
+ * The DFA is built during matching, so a RegexSet must not be used from multiple threads at the same time.
+ */
+class RegexSet {
+ public:
+  enum class MatchMode {
+    FULL_MATCH,  // the whole input has to match the pattern, like utils::regexMatch
+    SEARCH  // any part of the input can match the pattern, like utils::regexSearch
+  };
+
+  RegexSet(const std::vector<std::string>& patterns, MatchMode match_mode, const std::vector<Regex::Mode>& modes = {});
+
+  RegexSet(RegexSet&&) noexcept;
+  RegexSet& operator=(RegexSet&&) noexcept;
+  RegexSet(const RegexSet&) = delete;
+  RegexSet& operator=(const RegexSet&) = delete;
+  ~RegexSet();
+
+  // Returns whether each of the patterns, in the order they were given, matched the input
+  std::vector<bool> match(std::string_view input);
+
+  [[nodiscard]] size_t size() const { return pattern_count_; }
+
+  // Whether the pattern is matched by the shared automaton or falls back to utils::Regex
+  [[nodiscard]] bool isMatchedByAutomaton(size_t pattern_index) const;
+
+ private:
+  class Automaton;
+
+  size_t pattern_count_ = 0;
+  MatchMode match_mode_;
+  std::unique_ptr<Automaton> automaton_;
+  std::vector<std::pair<size_t, Regex>> fallback_regexes_;
+};
+
+}  // namespace org::apache::nifi::minifi::utils
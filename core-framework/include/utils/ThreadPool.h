@@ -30,16 +30,19 @@
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "BackTrace.h"
 #include "MinifiConcurrentQueue.h"
 #include "Monitors.h"
+#include "WorkStealingQueue.h"
 #include "core/expect.h"
 #include "minifi-cpp/controllers/ThreadManagementService.h"
 #include "minifi-cpp/core/controller/ControllerServiceLookup.h"
 #include "minifi-cpp/core/logging/Logger.h"
+#include "minifi-cpp/utils/gsl.h"
 
 namespace org::apache::nifi::minifi::utils {
 
@@ -106,13 +109,6 @@ class Worker {
   std::shared_ptr<std::promise<TaskRescheduleInfo>> promise;
 };
 
-class DelayedTaskComparator {
- public:
-  bool operator()(Worker &a, Worker &b) {
-    return a.getNextExecutionTime() > b.getNextExecutionTime();
-  }
-};
-
 class WorkerThread {
  public:
   explicit WorkerThread(std::thread thread, const std::string &name = "NamelessWorker")
@@ -129,6 +125,77 @@ class WorkerThread {
   std::string name_;
 };
 
+enum class ThreadPoolSchedulingMode {
+  // every worker thread takes the tasks from one shared queue
+  SHARED_QUEUE,
+  // every worker thread has its own queue, and steals tasks from the others when its own queue is empty
+  WORK_STEALING
+};
+
+/**
+ * Queue of the tasks ready to run, backed by either a shared queue or per-worker queues
+ */
+class ReadyTaskQueue {
+ public:
+  void setSchedulingMode(ThreadPoolSchedulingMode mode, size_t worker_count) {
+    mode_ = mode;
+    work_stealing_queue_.resize(mode == ThreadPoolSchedulingMode::WORK_STEALING ? worker_count : 1);
+  }
+
+  ThreadPoolSchedulingMode getSchedulingMode() const {
+    return mode_;
+  }
+
+  // called by each worker thread before it starts dequeueing
+  void registerWorker() {
+    if (mode_ == ThreadPoolSchedulingMode::WORK_STEALING) {
+      work_stealing_queue_.registerConsumer();
+    }
+  }
+
+  void enqueue(Worker&& task) {
+    if (mode_ == ThreadPoolSchedulingMode::WORK_STEALING) {
+      work_stealing_queue_.enqueue(std::move(task));
+    } else {
+      shared_queue_.enqueue(std::move(task));
+    }
+  }
+
+  bool dequeueWait(Worker& task) {
+    return mode_ == ThreadPoolSchedulingMode::WORK_STEALING ? work_stealing_queue_.dequeueWait(task) : shared_queue_.dequeueWait(task);
+  }
+
+  template<typename Functor>
+  void remove(Functor fun) {
+    shared_queue_.remove(fun);
+    work_stealing_queue_.remove(fun);
+  }
+
+  void clear() {
+    shared_queue_.clear();
+    work_stealing_queue_.clear();
+  }
+
+  void start() {
+    shared_queue_.start();
+    work_stealing_queue_.start();
+  }
+
+  void stop() {
+    shared_queue_.stop();
+    work_stealing_queue_.stop();
+  }
+
+  bool isRunning() const {
+    return mode_ == ThreadPoolSchedulingMode::WORK_STEALING ? work_stealing_queue_.isRunning() : shared_queue_.isRunning();
+  }
+
+ private:
+  std::atomic<ThreadPoolSchedulingMode> mode_ = ThreadPoolSchedulingMode::SHARED_QUEUE;
+  ConditionConcurrentQueue<Worker> shared_queue_;
+  WorkStealingQueue<Worker> work_stealing_queue_;
+};
+
 /**
  * Thread pool
  * Purpose: Provides a thread pool with basic functionality similar to
@@ -138,7 +205,8 @@ class WorkerThread {
 class ThreadPool {
  public:
   ThreadPool(int max_worker_threads = 2,
-             core::controller::ControllerServiceLookup* controller_service_provider = nullptr, std::string name = "NamelessPool");
+             core::controller::ControllerServiceLookup* controller_service_provider = nullptr, std::string name = "NamelessPool",
+             ThreadPoolSchedulingMode scheduling_mode = ThreadPoolSchedulingMode::SHARED_QUEUE);
 
   ThreadPool(const ThreadPool &other) = delete;
   ThreadPool& operator=(const ThreadPool &other) = delete;
@@ -165,6 +233,14 @@ class ThreadPool {
    */
   void stopTasks(const TaskId &identifier);
 
+  /**
+   * Moves the delayed tasks with the provided identifier to the worker queue, so
+   * they are run as soon as a worker is available. Tasks with this identifier
+   * which are running at the moment of the call are not delayed after they finish.
+   * @param identifier for worker tasks.
+   */
+  void wakeUp(const TaskId &identifier);
+
   /**
    * resumes work queue processing.
    */
@@ -231,6 +307,23 @@ class ThreadPool {
       start();
   }
 
+  /**
+   * Sets how the ready tasks are distributed among the worker threads.
+   * Like setMaxConcurrentTasks, this restarts the thread pool if it is running,
+   * so it should be called before executing tasks.
+   */
+  void setSchedulingMode(ThreadPoolSchedulingMode scheduling_mode) {
+    std::lock_guard<std::recursive_mutex> lock(manager_mutex_);
+    bool was_running = running_;
+    if (was_running) {
+      shutdown();
+    }
+    scheduling_mode_ = scheduling_mode;
+    worker_queue_.setSchedulingMode(scheduling_mode_, gsl::narrow<size_t>(std::max(max_worker_threads_, 1)));
+    if (was_running)
+      start();
+  }
+
   void setControllerServiceProvider(core::controller::ControllerServiceLookup* controller_service_provider) {
     std::lock_guard<std::recursive_mutex> lock(manager_mutex_);
     bool was_running = running_;
@@ -275,8 +368,13 @@ class ThreadPool {
   core::controller::ControllerServiceLookup* controller_service_provider_;
   std::shared_ptr<controllers::ThreadManagementService> thread_manager_;
   ConcurrentQueue<std::shared_ptr<WorkerThread>> deceased_thread_queue_;
-  ConditionConcurrentQueue<Worker> worker_queue_;
-  std::priority_queue<Worker, std::vector<Worker>, DelayedTaskComparator> delayed_worker_queue_;
+  ThreadPoolSchedulingMode scheduling_mode_;
+  ReadyTaskQueue worker_queue_;
+  using DelayedTasks = std::multimap<std::chrono::steady_clock::time_point, Worker>;
+  // ordered by the next execution time, and indexed by the identifier, so a task can be woken up without rebuilding the queue
+  DelayedTasks delayed_worker_queue_;
+  std::unordered_multimap<TaskId, DelayedTasks::iterator> delayed_tasks_by_id_;
+  std::unordered_set<TaskId> wake_up_requests_;
   std::mutex worker_queue_mutex_;
   std::condition_variable delayed_task_available_;
   std::map<TaskId, bool> task_status_;
@@ -291,6 +389,12 @@ class ThreadPool {
   void manageWorkers();
   void run_tasks(const std::shared_ptr<WorkerThread>& thread);
   void manage_delayed_queue();
+  // must hold the worker_queue_mutex_
+  void removeDelayedTasks(const TaskId &identifier, const std::function<void(Worker&&)>& consumer);
+  // must hold the worker_queue_mutex_
+  void pushDelayedTask(Worker &&task);
+  // must hold the worker_queue_mutex_
+  Worker popDelayedTask();
 };
 
 }  // namespace org::apache::nifi::minifi::utils
@@ -0,0 +1,188 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "minifi-cpp/utils/gsl.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+// A queue split into one deque per consumer. Consumers take elements from their own deque first and
+// steal from the other deques only when it is empty, so they rarely contend on the same lock.
+// Elements enqueued by a registered consumer go to its own deque, other producers distribute elements round-robin.
+// Stopping and starting has the same semantics as in ConditionConcurrentQueue.
+template <typename T>
+class WorkStealingQueue {
+ public:
+  explicit WorkStealingQueue(size_t shard_count = 1, bool start = true) : running_{start} {
+    resize(shard_count);
+  }
+
+  WorkStealingQueue(const WorkStealingQueue& other) = delete;
+  WorkStealingQueue& operator=(const WorkStealingQueue& other) = delete;
+  WorkStealingQueue(WorkStealingQueue&& other) = delete;
+  WorkStealingQueue& operator=(WorkStealingQueue&& other) = delete;
+
+  // Changes the number of deques, elements are redistributed. Must not be called while consumers are active.
+  void resize(size_t shard_count) {
+    shard_count = std::max<size_t>(shard_count, 1);
+    std::deque<T> elements;
+    for (auto& shard : shards_) {
+      std::move(shard->queue.begin(), shard->queue.end(), std::back_inserter(elements));
+    }
+    shards_.clear();
+    for (size_t i = 0; i < shard_count; ++i) {
+      shards_.push_back(std::make_unique<Shard>());
+    }
+    next_consumer_index_ = 0;
+    size_ = 0;
+    for (auto& element : elements) {
+      enqueueTo(next_producer_index_++ % shards_.size(), std::move(element));
+    }
+  }
+
+  // Assigns a deque to the calling thread, which it uses for dequeueing and for enqueueing.
+  void registerConsumer() {
+    current_queue_ = this;
+    current_shard_index_ = next_consumer_index_++ % shards_.size();
+  }
+
+  template <typename... Args>
+  void enqueue(Args&&... args) {
+    const size_t index = current_queue_ == this ? current_shard_index_ : next_producer_index_++ % shards_.size();
+    enqueueTo(index, T{std::forward<Args>(args)...});
+  }
+
+  // Blocks until an element is available or the queue is stopped
+  bool dequeueWait(T& out) {
+    const size_t own_index = current_queue_ == this ? current_shard_index_ : 0;
+    while (running_) {
+      if (tryDequeueFrom(own_index, out, false)) {
+        return true;
+      }
+      for (size_t offset = 1; offset < shards_.size(); ++offset) {
+        if (tryDequeueFrom((own_index + offset) % shards_.size(), out, true)) {
+          return true;
+        }
+      }
+
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      ++sleeping_consumers_;
+      sleep_cv_.wait(lock, [this] { return !running_ || size_ > 0; });
+      --sleeping_consumers_;
+    }
+    return false;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  void clear() {
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> guard(shard->mutex);
+      size_ -= shard->queue.size();
+      shard->queue.clear();
+    }
+  }
+
+  template<typename Functor>
+  void remove(Functor fun) {
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> guard(shard->mutex);
+      const auto new_end = std::remove_if(shard->queue.begin(), shard->queue.end(), fun);
+      size_ -= gsl::narrow<size_t>(std::distance(new_end, shard->queue.end()));
+      shard->queue.erase(new_end, shard->queue.end());
+    }
+  }
+
+  void stop() {
+    std::lock_guard<std::mutex> guard(sleep_mutex_);
+    running_ = false;
+    sleep_cv_.notify_all();
+  }
+
+  void start() {
+    running_ = true;
+  }
+
+  bool isRunning() const {
+    return running_;
+  }
+
+ private:
+  struct Shard {
+    std::mutex mutex;
+    std::deque<T> queue;
+  };
+
+  void enqueueTo(size_t index, T&& element) {
+    {
+      std::lock_guard<std::mutex> guard(shards_[index]->mutex);
+      shards_[index]->queue.push_back(std::move(element));
+      ++size_;
+    }
+    if (running_ && sleeping_consumers_ > 0) {
+      std::lock_guard<std::mutex> guard(sleep_mutex_);
+      sleep_cv_.notify_one();
+    }
+  }
+
+  bool tryDequeueFrom(size_t index, T& out, bool steal) {
+    auto& shard = *shards_[index];
+    std::lock_guard<std::mutex> guard(shard.mutex);
+    if (shard.queue.empty()) {
+      return false;
+    }
+    if (steal) {
+      out = std::move(shard.queue.back());
+      shard.queue.pop_back();
+    } else {
+      out = std::move(shard.queue.front());
+      shard.queue.pop_front();
+    }
+    --size_;
+    return true;
+  }
+
+  static inline thread_local const WorkStealingQueue* current_queue_ = nullptr;
+  static inline thread_local size_t current_shard_index_ = 0;
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<size_t> size_{0};
+  std::atomic<size_t> next_producer_index_{0};
+  std::atomic<size_t> next_consumer_index_{0};
+  std::atomic<bool> running_;
+  std::atomic<size_t> sleeping_consumers_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+};
+
+}  // namespace org::apache::nifi::minifi::utils
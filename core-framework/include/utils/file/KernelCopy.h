@@ -0,0 +1,44 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <system_error>
+
+#include "utils/expected.h"
+
+namespace org::apache::nifi::minifi::utils::file {
+
+/**
+ * Copies `size` bytes of `source` starting at `source_offset` to `destination` at `destination_offset` inside the kernel,
+ * without moving the data through user space. Clones the extents of the source (reflink) if the whole source is copied
+ * into an empty destination and the file system supports it, and uses copy_file_range or sendfile otherwise.
+ * @return the number of bytes copied, or std::errc::operation_not_supported if the platform or the file systems do not
+ * support copying between these files and nothing has been copied, in which case the data has to be copied in user space
+ */
+nonstd::expected<uint64_t, std::error_code> copyFileRange(const std::filesystem::path& source, uint64_t source_offset,
+    const std::filesystem::path& destination, uint64_t destination_offset, uint64_t size);
+
+/**
+ * Sends at most `size` bytes of `source` starting at `offset` to a connected socket with sendfile.
+ * @return the number of bytes sent, which is less than `size` if the send buffer of a non-blocking socket got full,
+ * or std::errc::operation_not_supported if the platform does not support sendfile and nothing has been sent
+ */
+nonstd::expected<uint64_t, std::error_code> sendFile(const std::filesystem::path& source, uint64_t offset, uint64_t size, int socket);
+
+}  // namespace org::apache::nifi::minifi::utils::file
@@ -140,6 +140,15 @@ std::map<std::string, std::string> ConfigurableComponentImpl::getDynamicProperti
   return prop.getAllValues() | utils::transform([](const auto& values) -> std::vector<std::string> { return std::vector<std::string>{values.begin(), values.end()}; });
 }
 
+void ConfigurableComponentImpl::copyPropertiesFrom(const ConfigurableComponentImpl& other) {
+  if (&other == this) {
+    return;
+  }
+  std::scoped_lock lock(configuration_mutex_, other.configuration_mutex_);
+  supported_properties_ = other.supported_properties_;
+  dynamic_properties_ = other.dynamic_properties_;
+}
+
 [[nodiscard]] std::map<std::string, Property, std::less<>> ConfigurableComponentImpl::getSupportedProperties() const {
   std::lock_guard<std::mutex> lock(configuration_mutex_);
   std::map<std::string, Property, std::less<>> supported_properties;
@@ -110,6 +110,16 @@ bool ConnectableImpl::isAutoTerminated(const core::Relationship &relationship) {
   return auto_terminated_relationships_.contains(relationship.getName());
 }
 
+std::vector<core::Relationship> ConnectableImpl::getAutoTerminatedRelationships() const {
+  std::lock_guard<std::mutex> lock(relationship_mutex_);
+  std::vector<core::Relationship> relationships;
+  relationships.reserve(auto_terminated_relationships_.size());
+  for (const auto& [name, relationship] : auto_terminated_relationships_) {
+    relationships.push_back(relationship);
+  }
+  return relationships;
+}
+
 void ConnectableImpl::waitForWork(std::chrono::milliseconds timeout) {
   has_work_.store(isWorkAvailable());
 
@@ -30,6 +30,10 @@ std::string ContentRepositoryImpl::getStoragePath() const {
   return directory_;
 }
 
+std::string ContentRepositoryImpl::getStreamPath(std::string_view stream_name) const {
+  return directory_ + "/" + std::string{stream_name};
+}
+
 void ContentRepositoryImpl::reset() {
   std::lock_guard<std::mutex> lock(count_map_mutex_);
   count_map_.clear();
@@ -22,6 +22,12 @@
 
 namespace org::apache::nifi::minifi::core {
 
+ContentSession::NewContent ContentSessionImpl::writeNewContent() {
+  auto claim = create();
+  auto stream = write(claim);
+  return {.claim = std::move(claim), .offset = 0, .stream = std::move(stream)};
+}
+
 std::shared_ptr<io::BaseStream> ContentSessionImpl::append(const std::shared_ptr<ResourceClaim>& resource_id, size_t offset,
     const std::function<void(const std::shared_ptr<ResourceClaim>&)>& on_copy) {
   auto it = append_state_.find(resource_id);
@@ -27,6 +27,15 @@ bool RepositoryImpl::Delete(std::vector<std::shared_ptr<core::SerializableCompon
   return found;
 }
 
+bool RepositoryImpl::MultiPut(std::span<const std::pair<std::string_view, std::span<const std::byte>>> data) {
+  std::vector<std::pair<std::string, std::unique_ptr<io::BufferStream>>> owned_data;
+  owned_data.reserve(data.size());
+  for (const auto& [key, value] : data) {
+    owned_data.emplace_back(std::string{key}, std::make_unique<io::BufferStream>(value));
+  }
+  return MultiPut(owned_data);
+}
+
 bool RepositoryImpl::storeElement(const std::shared_ptr<core::SerializableComponent>& element) {
   if (!element) {
     return false;
@@ -323,6 +323,13 @@ std::unique_ptr<struct curl_slist, CurlSlistDeleter> toCurlSlist(const std::unor
 
 
 bool HTTPClient::submit() {
+  if (!prepareSubmit()) {
+    return false;
+  }
+  return finishSubmit(curl_easy_perform(http_session_.get()));
+}
+
+bool HTTPClient::prepareSubmit() {
   if (url_.empty()) {
     logger_->log_error("Tried to submit to an empty url");
     return false;
@@ -350,11 +357,11 @@ bool HTTPClient::submit() {
     curl_easy_setopt(http_session_.get(), CURLOPT_NOPROGRESS, 1);
   }
 
-  const auto headers = toCurlSlist(request_headers_);
-  if (headers) {
-    curl_slist_append(headers.get(), "Expect:");
-    curl_easy_setopt(http_session_.get(), CURLOPT_HTTPHEADER, headers.get());
+  request_header_list_.reset(toCurlSlist(request_headers_).release());
+  if (request_header_list_) {
+    curl_slist_append(request_header_list_.get(), "Expect:");
   }
+  curl_easy_setopt(http_session_.get(), CURLOPT_HTTPHEADER, request_header_list_.get());
 
   curl_easy_setopt(http_session_.get(), CURLOPT_URL, url_.c_str());
   logger_->log_debug("Submitting to {} {}", method_ ? magic_enum::enum_name(*method_) : "NONE", url_);
@@ -369,7 +376,11 @@ bool HTTPClient::submit() {
   if (form_ != nullptr) {
     curl_easy_setopt(http_session_.get(), CURLOPT_MIMEPOST, form_.get());
   }
-  res_ = curl_easy_perform(http_session_.get());
+  return true;
+}
+
+bool HTTPClient::finishSubmit(CURLcode result) {
+  res_ = result;
   if (read_callback_ == nullptr) {
     content_.close();
   }
@@ -378,7 +389,7 @@ bool HTTPClient::submit() {
   response_data_.response_code = http_code;
   curl_easy_getinfo(http_session_.get(), CURLINFO_CONTENT_TYPE, &response_data_.response_content_type);
   if (res_ == CURLE_OPERATION_TIMEDOUT) {
-    logger_->log_error("HTTP operation timed out, with absolute timeout {}\n", absolute_timeout);
+    logger_->log_error("HTTP operation timed out, with absolute timeout {}\n", absolute_timeout_.value_or(3 * read_timeout_));
   }
   if (res_ != CURLE_OK) {
     logger_->log_error("curl_easy_perform() failed {} on {}, error code {}\n", curl_easy_strerror(res_), url_, magic_enum::enum_underlying(res_));
@@ -537,4 +548,8 @@ void HTTPClient::CurlMimeFree::operator()(curl_mime* curl_mime) const {
   curl_mime_free(curl_mime);
 }
 
+void HTTPClient::CurlSlistFree::operator()(curl_slist* curl_slist) const {
+  curl_slist_free_all(curl_slist);
+}
+
 }  // namespace org::apache::nifi::minifi::http
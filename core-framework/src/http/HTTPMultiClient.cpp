@@ -0,0 +1,106 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "http/HTTPMultiClient.h"
+
+#include <curl/multi.h>
+
+#include "minifi-cpp/utils/gsl.h"
+
+namespace org::apache::nifi::minifi::http {
+
+HTTPMultiClient::HTTPMultiClient()
+    : multi_handle_(curl_multi_init()) {
+  curl_multi_setopt(multi_handle_.get(), CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+}
+
+HTTPMultiClient::~HTTPMultiClient() {
+  cancelTransfers();
+}
+
+bool HTTPMultiClient::addTransfer(HTTPClient& client) {
+  if (!client.prepareSubmit()) {
+    return false;
+  }
+  CURL* const handle = client.http_session_.get();
+  // wait for a connection which is being set up to the same host to see if it can be multiplexed, instead of opening a new one
+  curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+  if (const auto result = curl_multi_add_handle(multi_handle_.get(), handle); result != CURLM_OK) {
+    logger_->log_error("Could not start transfer to {}: {}", client.getURL(), curl_multi_strerror(result));
+    return false;
+  }
+  transfers_.emplace(handle, &client);
+  return true;
+}
+
+std::vector<HTTPMultiClient::CompletedTransfer> HTTPMultiClient::perform(std::chrono::milliseconds timeout) {
+  int running_transfers = 0;
+  auto result = curl_multi_perform(multi_handle_.get(), &running_transfers);
+  if (result == CURLM_OK && gsl::narrow<size_t>(running_transfers) == transfers_.size()) {
+    // none of the transfers has finished yet, curl_multi_poll also returns early if one of them times out
+    result = curl_multi_poll(multi_handle_.get(), nullptr, 0, gsl::narrow<int>(timeout.count()), nullptr);
+    if (result == CURLM_OK) {
+      result = curl_multi_perform(multi_handle_.get(), &running_transfers);
+    }
+  }
+  if (result != CURLM_OK) {
+    logger_->log_error("curl_multi_perform() failed: {}, aborting {} transfers", curl_multi_strerror(result), transfers_.size());
+    return failTransfers();
+  }
+
+  std::vector<CompletedTransfer> completed_transfers;
+  int messages_left = 0;
+  while (CURLMsg* message = curl_multi_info_read(multi_handle_.get(), &messages_left)) {
+    if (message->msg != CURLMSG_DONE) {
+      continue;
+    }
+    const auto transfer = transfers_.find(message->easy_handle);
+    if (transfer == transfers_.end()) {
+      continue;
+    }
+    // the message is freed when its handle is removed
+    const CURLcode transfer_result = message->data.result;
+    HTTPClient& client = *transfer->second;
+    curl_multi_remove_handle(multi_handle_.get(), transfer->first);
+    transfers_.erase(transfer);
+    completed_transfers.push_back({.client = &client, .success = client.finishSubmit(transfer_result)});
+  }
+  return completed_transfers;
+}
+
+void HTTPMultiClient::cancelTransfers() {
+  for (const auto& [handle, client] : transfers_) {
+    curl_multi_remove_handle(multi_handle_.get(), handle);
+  }
+  transfers_.clear();
+}
+
+std::vector<HTTPMultiClient::CompletedTransfer> HTTPMultiClient::failTransfers() {
+  std::vector<CompletedTransfer> failed_transfers;
+  for (const auto& [handle, client] : transfers_) {
+    curl_multi_remove_handle(multi_handle_.get(), handle);
+    failed_transfers.push_back({.client = client, .success = client->finishSubmit(CURLE_ABORTED_BY_CALLBACK)});
+  }
+  transfers_.clear();
+  return failed_transfers;
+}
+
+void HTTPMultiClient::CurlMultiCleanup::operator()(CURLM* curl_multi) const {
+  curl_multi_cleanup(curl_multi);
+}
+
+}  // namespace org::apache::nifi::minifi::http
@@ -26,6 +26,9 @@
 #include "minifi-cpp/Exception.h"
 #include "io/validation.h"
 #include "io/FileStream.h"
+#include "io/OutputStreamSlice.h"
+#include "io/StreamSlice.h"
+#include "utils/file/KernelCopy.h"
 #include "minifi-cpp/utils/gsl.h"
 
 namespace org::apache::nifi::minifi::io {
@@ -41,9 +44,21 @@ constexpr const char *WRITE_CALL_ERROR_MSG = "write call on file stream failed";
 constexpr const char *EMPTY_MESSAGE_ERROR_MSG = "empty message";
 constexpr const char *SEEKG_CALL_ERROR_MSG = "seekg call on file stream failed";
 constexpr const char *SEEKP_CALL_ERROR_MSG = "seekp call on file stream failed";
+constexpr const char *KERNEL_COPY_ERROR_MSG = "Error copying file in the kernel: ";
+
+namespace {
+void logKernelCopyError(core::logging::Logger& logger, const FileRegion& source, const std::filesystem::path& destination, const std::error_code& error) {
+  if (error == std::errc::operation_not_supported) {
+    logger.log_debug("Copying {} to {} in the kernel is not supported, copying it in user space", source.path, destination);
+  } else {
+    logger.log_warn("{}{} to {}: {}, copying it in user space", KERNEL_COPY_ERROR_MSG, source.path, destination, error.message());
+  }
+}
+}  // namespace
 
 FileStream::FileStream(std::filesystem::path path, bool append)
-    : path_(std::move(path)) {
+    : path_(std::move(path)),
+      append_(append) {
   file_stream_ = std::make_unique<std::fstream>();
   if (append) {
     file_stream_->open(path_, std::fstream::in | std::fstream::out | std::fstream::app | std::fstream::binary);
@@ -164,6 +179,38 @@ size_t FileStream::read(std::span<std::byte> buf) {
   }
 }
 
+std::optional<size_t> FileStream::copyFrom(const FileRegion& source) {
+  if (source.size < MIN_KERNEL_COPY_SIZE) {
+    return std::nullopt;
+  }
+  std::lock_guard<std::mutex> lock(file_lock_);
+  // in append mode the data is written to the end of the file regardless of offset_
+  if (file_stream_ == nullptr || !file_stream_->is_open() || append_) {
+    return std::nullopt;
+  }
+  const auto copied = utils::file::copyFileRange(source.path, source.offset, path_, offset_, source.size);
+  if (!copied) {
+    logKernelCopyError(*logger_, source, path_, copied.error());
+    return std::nullopt;
+  }
+  offset_ += gsl::narrow<size_t>(*copied);
+  length_ = std::max(offset_, length_);
+  file_stream_->clear();
+  if (!file_stream_->seekg(gsl::narrow<std::streamoff>(offset_)))
+    logger_->log_error("{}{}", WRITE_ERROR_MSG, SEEKG_CALL_ERROR_MSG);
+  if (!file_stream_->seekp(gsl::narrow<std::streamoff>(offset_)))
+    logger_->log_error("{}{}", WRITE_ERROR_MSG, SEEKP_CALL_ERROR_MSG);
+  return gsl::narrow<size_t>(*copied);
+}
+
+std::optional<FileRegion> FileStream::getRemainingRegion() const {
+  std::lock_guard<std::mutex> lock(file_lock_);
+  if (file_stream_ == nullptr || !file_stream_->is_open() || append_) {
+    return std::nullopt;
+  }
+  return FileRegion{.path = path_, .offset = offset_, .size = length_ > offset_ ? length_ - offset_ : 0};
+}
+
 void FileStream::seekToEndOfFile(const char *caller_error_msg) {
   if (!file_stream_->seekg(0, file_stream_->end))
     logger_->log_error("{}{}", caller_error_msg, SEEKG_CALL_ERROR_MSG);
@@ -171,4 +218,42 @@ void FileStream::seekToEndOfFile(const char *caller_error_msg) {
     logger_->log_error("{}{}", caller_error_msg, SEEKP_CALL_ERROR_MSG);
 }
 
+std::optional<FileRegion> getRemainingFileRegion(const InputStream& stream) {
+  if (const auto* file_stream = dynamic_cast<const FileStream*>(&stream)) {
+    return file_stream->getRemainingRegion();
+  }
+  if (const auto* slice = dynamic_cast<const StreamSlice*>(&stream)) {
+    auto region = getRemainingFileRegion(*slice->getUnderlyingStream());
+    if (region) {
+      region->size = std::min<uint64_t>(region->size, slice->size() - slice->tell());
+    }
+    return region;
+  }
+  return std::nullopt;
+}
+
+FileStream* getUnderlyingFileStream(OutputStream& stream) {
+  if (auto* file_stream = dynamic_cast<FileStream*>(&stream)) {
+    return file_stream;
+  }
+  if (auto* slice = dynamic_cast<OutputStreamSlice*>(&stream)) {
+    return getUnderlyingFileStream(*slice->getUnderlyingStream());
+  }
+  return nullptr;
+}
+
+std::optional<size_t> copyToFileInKernel(InputStream& source, const std::filesystem::path& destination, uint64_t destination_offset) {
+  const auto region = getRemainingFileRegion(source);
+  if (!region || region->size < MIN_KERNEL_COPY_SIZE) {
+    return std::nullopt;
+  }
+  const auto copied = utils::file::copyFileRange(region->path, region->offset, destination, destination_offset, region->size);
+  if (!copied) {
+    logKernelCopyError(*core::logging::LoggerFactory<FileStream>::getLogger(), *region, destination, copied.error());
+    return std::nullopt;
+  }
+  source.seek(source.tell() + gsl::narrow<size_t>(*copied));
+  return gsl::narrow<size_t>(*copied);
+}
+
 }  // namespace org::apache::nifi::minifi::io
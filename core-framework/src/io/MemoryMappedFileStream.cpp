@@ -0,0 +1,116 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io/MemoryMappedFileStream.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "io/BufferStream.h"
+#include "io/StreamSlice.h"
+#include "minifi-cpp/utils/gsl.h"
+
+namespace org::apache::nifi::minifi::io {
+
+#ifndef WIN32
+
+MemoryMappedFileStream::MemoryMappedFileStream(const std::filesystem::path& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    logger_->log_error("Error opening file {} for memory mapping: {}", path, std::strerror(errno));
+    return;
+  }
+  // the mapping stays valid after the file descriptor is closed
+  const auto close_file = gsl::finally([fd] { ::close(fd); });
+  struct stat file_stat{};
+  if (fstat(fd, &file_stat) != 0) {
+    logger_->log_error("Error querying the size of {}: {}", path, std::strerror(errno));
+    return;
+  }
+  const auto file_size = gsl::narrow<size_t>(file_stat.st_size);
+  if (file_size == 0) {
+    // empty files can not be mapped
+    mapped_ = true;
+    return;
+  }
+  void* address = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (address == MAP_FAILED) {
+    logger_->log_warn("Error mapping {} into memory: {}", path, std::strerror(errno));
+    return;
+  }
+  data_ = std::span<const std::byte>(static_cast<const std::byte*>(address), file_size);
+  mapped_ = true;
+}
+
+MemoryMappedFileStream::~MemoryMappedFileStream() {
+  if (!data_.empty()) {
+    munmap(const_cast<std::byte*>(data_.data()), data_.size());
+  }
+}
+
+#else
+
+MemoryMappedFileStream::MemoryMappedFileStream(const std::filesystem::path& path) {
+  logger_->log_debug("Memory mapping {} is not supported on this platform", path);
+}
+
+MemoryMappedFileStream::~MemoryMappedFileStream() = default;
+
+#endif
+
+void MemoryMappedFileStream::seek(size_t offset) {
+  offset_ = std::min(offset, data_.size());
+}
+
+size_t MemoryMappedFileStream::read(std::span<std::byte> buf) {
+  const auto read_size = std::min(buf.size(), data_.size() - offset_);
+  std::copy_n(data_.subspan(offset_).begin(), read_size, buf.begin());
+  offset_ += read_size;
+  return read_size;
+}
+
+size_t MemoryMappedFileStream::write(const uint8_t* /*value*/, size_t /*size*/) {
+  logger_->log_error("Memory mapped file streams are read-only");
+  return STREAM_ERROR;
+}
+
+std::optional<std::span<const std::byte>> getContiguousBuffer(const InputStream& stream) {
+  if (const auto* memory_mapped_stream = dynamic_cast<const MemoryMappedFileStream*>(&stream)) {
+    return memory_mapped_stream->getBuffer().subspan(memory_mapped_stream->tell());
+  }
+  if (const auto* buffer_stream = dynamic_cast<const BufferStream*>(&stream)) {
+    return buffer_stream->getBuffer().subspan(std::min(buffer_stream->tell(), buffer_stream->size()));
+  }
+  if (const auto* slice = dynamic_cast<const StreamSlice*>(&stream)) {
+    auto buffer = getContiguousBuffer(*slice->getUnderlyingStream());
+    if (buffer) {
+      buffer = buffer->first(std::min(buffer->size(), slice->size() - slice->tell()));
+    }
+    return buffer;
+  }
+  return std::nullopt;
+}
+
+}  // namespace org::apache::nifi::minifi::io
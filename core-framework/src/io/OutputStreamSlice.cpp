@@ -0,0 +1,51 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io/OutputStreamSlice.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace org::apache::nifi::minifi::io {
+
+OutputStreamSlice::OutputStreamSlice(std::shared_ptr<io::BaseStream> stream) : stream_(std::move(stream)), slice_offset_(stream_->size()) {
+  stream_->seek(slice_offset_);
+}
+
+size_t OutputStreamSlice::write(const uint8_t* value, size_t size) {
+  return stream_->write(value, size);
+}
+
+size_t OutputStreamSlice::read(std::span<std::byte> out_buffer) {
+  const size_t max_size = std::min(out_buffer.size(), size() - tell());
+  return stream_->read(out_buffer.subspan(0, max_size));
+}
+
+void OutputStreamSlice::seek(size_t offset) {
+  stream_->seek(slice_offset_ + offset);
+}
+
+size_t OutputStreamSlice::tell() const {
+  return stream_->tell() - slice_offset_;
+}
+
+std::span<const std::byte> OutputStreamSlice::getBuffer() const {
+  return stream_->getBuffer().subspan(slice_offset_);
+}
+
+}  // namespace org::apache::nifi::minifi::io
@@ -30,6 +30,7 @@
 #include <cmath>
 #include <cstdio>
 #include <memory>
+#include <random>
 #include <string>
 #include <limits>
 #include "core/logging/LoggerFactory.h"
@@ -72,6 +73,57 @@ namespace {
 }  // namespace
 #endif
 
+namespace {
+// Generates UUIDv7 identifiers as specified in RFC 9562: a 48 bit unix timestamp in milliseconds, a 26 bit counter and 48 random bits.
+// Every thread has its own generator, so no locking is needed. The identifiers of a thread are strictly increasing,
+// the identifiers of different threads are kept apart by the random start of the counter and the random bits.
+class TimeOrderedUuidGenerator {
+ public:
+  TimeOrderedUuidGenerator() {
+    std::random_device random_device;
+    std::seed_seq seed{random_device(), random_device(), random_device(), random_device(), random_device(), random_device(), random_device(), random_device()};
+    random_engine_.seed(seed);
+  }
+
+  void generate(Identifier::Data& output) {
+    const auto now = gsl::narrow_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    if (now > timestamp_) {
+      timestamp_ = now;
+      counter_ = initialCounter();
+    } else if (++counter_ > MAX_COUNTER) {
+      // the counter ran out in this millisecond (or the clock went backwards), continue in the next one to stay monotonic
+      ++timestamp_;
+      counter_ = initialCounter();
+    }
+    const uint64_t random = random_engine_();
+    for (int i = 0; i < 6; i++) {
+      output[i] = (timestamp_ >> ((5 - i) * 8)) & std::numeric_limits<unsigned char>::max();
+    }
+    // the counter takes the 12 bits after the version and the 14 bits after the variant
+    output[6] = gsl::narrow_cast<unsigned char>(0x70 | (counter_ >> 22));
+    output[7] = (counter_ >> 14) & std::numeric_limits<unsigned char>::max();
+    output[8] = gsl::narrow_cast<unsigned char>(0x80 | ((counter_ >> 8) & 0x3f));
+    output[9] = counter_ & std::numeric_limits<unsigned char>::max();
+    for (int i = 10; i < 16; i++) {
+      output[i] = (random >> ((15 - i) * 8)) & std::numeric_limits<unsigned char>::max();
+    }
+  }
+
+ private:
+  static constexpr uint32_t MAX_COUNTER = (uint32_t{1} << 26) - 1;
+
+  // starting below the half of the range leaves room for at least 2^25 identifiers per millisecond
+  uint32_t initialCounter() {
+    return gsl::narrow_cast<uint32_t>(random_engine_() & (MAX_COUNTER >> 1));
+  }
+
+  std::mt19937_64 random_engine_;
+  uint64_t timestamp_ = 0;
+  uint32_t counter_ = 0;
+};
+
+}  // namespace
+
 IdGenerator::IdGenerator()
     : implementation_(UUID_TIME_IMPL),
       logger_(core::logging::LoggerFactory<IdGenerator>::getLogger()),
@@ -165,6 +217,9 @@ void IdGenerator::initialize(const std::shared_ptr<Properties>& properties) {
         deterministic_prefix_[i] = prefix_element;
       }
       incrementor_ = 0;
+    } else if (UUID_TIME_ORDERED_STR == implementation_str || UUID_V7_STR == implementation_str) {
+      logger_->log_debug("Using time ordered (version 7) implementation for uids.");
+      implementation_ = UUID_TIME_ORDERED_IMPL;
     } else if (UUID_TIME_STR == implementation_str || UUID_WINDOWS_STR == implementation_str) {
       logger_->log_debug("Using uuid_generate_time implementation for uids.");
     } else {
@@ -214,6 +269,11 @@ Identifier IdGenerator::generate() {
       }
     }
     break;
+    case UUID_TIME_ORDERED_IMPL: {
+      thread_local TimeOrderedUuidGenerator time_ordered_generator;
+      time_ordered_generator.generate(output);
+    }
+    break;
     case UUID_TIME_IMPL:
     default:
 #ifdef WIN32
@@ -0,0 +1,71 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/LatencyHistogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace org::apache::nifi::minifi::utils {
+
+size_t LatencyHistogram::bucketIndex(uint64_t value) {
+  value = std::min(value, MAX_VALUE);
+  if (value < (uint64_t{1} << SUB_BUCKET_BITS)) {
+    return static_cast<size_t>(value);
+  }
+  const auto shift = static_cast<size_t>(std::bit_width(value)) - 1 - SUB_BUCKET_BITS;
+  const auto sub_bucket = static_cast<size_t>(value >> shift) - (size_t{1} << SUB_BUCKET_BITS);
+  return ((shift + 1) << SUB_BUCKET_BITS) + sub_bucket;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+  if (index < (size_t{1} << SUB_BUCKET_BITS)) {
+    return index;
+  }
+  const auto shift = (index >> SUB_BUCKET_BITS) - 1;
+  const auto sub_bucket = index & ((size_t{1} << SUB_BUCKET_BITS) - 1);
+  const auto lower_bound = ((uint64_t{1} << SUB_BUCKET_BITS) + sub_bucket) << shift;
+  return lower_bound + (uint64_t{1} << shift) - 1;
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds latency) {
+  const auto value = static_cast<uint64_t>(std::max(latency.count(), int64_t{0}));
+  buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  auto current_max = max_.load(std::memory_order_relaxed);
+  while (value > current_max && !max_.compare_exchange_weak(current_max, value, std::memory_order_relaxed)) {}
+}
+
+std::chrono::nanoseconds LatencyHistogram::percentile(double ratio) const {
+  // the buckets are updated independently of count_, so a concurrent snapshot may see fewer values in the buckets
+  const auto total = count();
+  if (total == 0) {
+    return std::chrono::nanoseconds{0};
+  }
+  const auto rank = std::max(uint64_t{1}, static_cast<uint64_t>(std::ceil(std::clamp(ratio, 0.0, 1.0) * static_cast<double>(total))));
+  uint64_t seen = 0;
+  for (size_t index = 0; index < BUCKET_COUNT; ++index) {
+    seen += buckets_[index].load(std::memory_order_relaxed);
+    if (seen >= rank) {
+      return std::chrono::nanoseconds{static_cast<int64_t>(std::min(bucketUpperBound(index), max_.load(std::memory_order_relaxed)))};
+    }
+  }
+  return max();
+}
+
+}  // namespace org::apache::nifi::minifi::utils
@@ -0,0 +1,732 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/RegexSet.h"
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cctype>
+#include <cstdint>
+#include <map>
+#include <optional>
+
+#include "minifi-cpp/utils/gsl.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+namespace {
+
+using ByteSet = std::bitset<256>;
+
+constexpr size_t MAX_REPETITION_COUNT = 1000;
+constexpr size_t MAX_NFA_STATES = 100000;
+constexpr size_t MAX_DFA_STATES = 2048;
+
+uint8_t toByte(char c) {
+  return static_cast<uint8_t>(c);
+}
+
+ByteSet byteSetOf(const auto& predicate) {
+  ByteSet result;
+  for (size_t byte = 0; byte < result.size(); ++byte) {
+    if (predicate(static_cast<int>(byte))) {
+      result.set(byte);
+    }
+  }
+  return result;
+}
+
+ByteSet anyByte() {
+  ByteSet result;
+  result.set();
+#ifdef NO_MORE_REGFREEE
+  // '.' does not match line terminators in ECMAScript, but it matches everything in POSIX
+  result.reset('\n');
+  result.reset('\r');
+#endif
+  return result;
+}
+
+ByteSet wordBytes() {
+  return byteSetOf([](int byte) { return byte < 128 && (std::isalnum(byte) || byte == '_'); });
+}
+
+ByteSet spaceBytes() {
+  return byteSetOf([](int byte) { return byte < 128 && std::isspace(byte); });
+}
+
+std::optional<ByteSet> characterClass(std::string_view name) {
+  static const std::map<std::string_view, int(*)(int)> character_classes{
+    {"alpha", [](int byte) { return std::isalpha(byte); }},
+    {"digit", [](int byte) { return std::isdigit(byte); }},
+    {"alnum", [](int byte) { return std::isalnum(byte); }},
+    {"upper", [](int byte) { return std::isupper(byte); }},
+    {"lower", [](int byte) { return std::islower(byte); }},
+    {"space", [](int byte) { return std::isspace(byte); }},
+    {"blank", [](int byte) { return std::isblank(byte); }},
+    {"punct", [](int byte) { return std::ispunct(byte); }},
+    {"print", [](int byte) { return std::isprint(byte); }},
+    {"graph", [](int byte) { return std::isgraph(byte); }},
+    {"cntrl", [](int byte) { return std::iscntrl(byte); }},
+    {"xdigit", [](int byte) { return std::isxdigit(byte); }}
+  };
+  const auto it = character_classes.find(name);
+  if (it == character_classes.end()) {
+    return std::nullopt;
+  }
+  return byteSetOf([predicate = it->second](int byte) { return byte < 128 && predicate(byte) != 0; });
+}
+
+ByteSet foldCase(const ByteSet& bytes) {
+  ByteSet result = bytes;
+  for (int byte = 0; byte < 128; ++byte) {
+    if (bytes.test(byte) && std::isalpha(byte)) {
+      result.set(toByte(gsl::narrow<char>(std::tolower(byte))));
+      result.set(toByte(gsl::narrow<char>(std::toupper(byte))));
+    }
+  }
+  return result;
+}
+
+struct RegexNode {
+  enum class Type { BYTES, CONCATENATION, ALTERNATION, REPETITION, BEGIN, END };
+
+  Type type;
+  ByteSet bytes{};
+  std::vector<RegexNode> children{};
+  size_t min = 0;
+  std::optional<size_t> max{};
+};
+
+// Parses the subset of the regex syntax which means the same in ECMAScript (std::regex) and in POSIX extended (regex.h)
+// regular expressions. Returns std::nullopt for everything else, including the invalid patterns.
+class RegexParser {
+ public:
+  RegexParser(std::string_view pattern, bool ignore_case) : pattern_(pattern), ignore_case_(ignore_case) {}
+
+  std::optional<RegexNode> parse() {
+    auto result = parseAlternation();
+    if (!result || !atEnd()) {
+      return std::nullopt;
+    }
+    return result;
+  }
+
+ private:
+  [[nodiscard]] bool atEnd() const { return pos_ >= pattern_.size(); }
+  [[nodiscard]] char peek() const { return pattern_[pos_]; }
+
+  static bool isQuantifier(char c) {
+    return c == '*' || c == '+' || c == '?' || c == '{';
+  }
+
+  RegexNode bytesNode(const ByteSet& bytes) const {
+    return RegexNode{.type = RegexNode::Type::BYTES, .bytes = ignore_case_ ? foldCase(bytes) : bytes};
+  }
+
+  std::optional<RegexNode> parseAlternation() {
+    auto first = parseConcatenation();
+    if (!first || atEnd() || peek() != '|') {
+      return first;
+    }
+    RegexNode alternation{.type = RegexNode::Type::ALTERNATION};
+    alternation.children.push_back(std::move(*first));
+    while (!atEnd() && peek() == '|') {
+      ++pos_;
+      auto next = parseConcatenation();
+      if (!next) {
+        return std::nullopt;
+      }
+      alternation.children.push_back(std::move(*next));
+    }
+    return alternation;
+  }
+
+  std::optional<RegexNode> parseConcatenation() {
+    RegexNode concatenation{.type = RegexNode::Type::CONCATENATION};
+    while (!atEnd() && peek() != '|' && peek() != ')') {
+      auto repetition = parseRepetition();
+      if (!repetition) {
+        return std::nullopt;
+      }
+      concatenation.children.push_back(std::move(*repetition));
+    }
+    // empty alternatives and groups, like in "a||b" or "()", are handled differently by the two syntaxes
+    if (concatenation.children.empty()) {
+      return std::nullopt;
+    }
+    // the anchors are only supported at the edges of the top level alternatives, as regex.h handles them inconsistently elsewhere
+    for (size_t i = 0; i < concatenation.children.size(); ++i) {
+      const auto type = concatenation.children[i].type;
+      if ((type == RegexNode::Type::BEGIN && (depth_ > 0 || i != 0))
+          || (type == RegexNode::Type::END && (depth_ > 0 || i != concatenation.children.size() - 1))) {
+        return std::nullopt;
+      }
+    }
+    return concatenation;
+  }
+
+  std::optional<RegexNode> parseRepetition() {
+    auto atom = parseAtom();
+    if (!atom || atEnd() || !isQuantifier(peek())) {
+      return atom;
+    }
+    if (atom->type == RegexNode::Type::BEGIN || atom->type == RegexNode::Type::END) {
+      return std::nullopt;
+    }
+    RegexNode repetition{.type = RegexNode::Type::REPETITION};
+    if (!parseQuantifier(repetition)) {
+      return std::nullopt;
+    }
+    // stacked quantifiers, like the lazy "a+?" of ECMAScript, are handled differently by the two syntaxes
+    if (!atEnd() && isQuantifier(peek())) {
+      return std::nullopt;
+    }
+    repetition.children.push_back(std::move(*atom));
+    return repetition;
+  }
+
+  bool parseQuantifier(RegexNode& repetition) {
+    switch (pattern_[pos_++]) {
+      case '*':
+        repetition.min = 0;
+        repetition.max = std::nullopt;
+        return true;
+      case '+':
+        repetition.min = 1;
+        repetition.max = std::nullopt;
+        return true;
+      case '?':
+        repetition.min = 0;
+        repetition.max = 1;
+        return true;
+      default:
+        break;
+    }
+    const auto min = parseNumber();
+    if (!min || atEnd()) {
+      return false;
+    }
+    repetition.min = *min;
+    if (peek() == '}') {
+      ++pos_;
+      repetition.max = *min;
+      return true;
+    }
+    if (peek() != ',') {
+      return false;
+    }
+    ++pos_;
+    if (!atEnd() && peek() == '}') {
+      ++pos_;
+      repetition.max = std::nullopt;
+      return true;
+    }
+    const auto max = parseNumber();
+    if (!max || *max < *min || atEnd() || peek() != '}') {
+      return false;
+    }
+    ++pos_;
+    repetition.max = *max;
+    return true;
+  }
+
+  std::optional<size_t> parseNumber() {
+    const auto start = pos_;
+    size_t value = 0;
+    while (!atEnd() && std::isdigit(toByte(peek()))) {
+      value = value * 10 + gsl::narrow<size_t>(peek() - '0');
+      if (value > MAX_REPETITION_COUNT) {
+        return std::nullopt;
+      }
+      ++pos_;
+    }
+    if (pos_ == start) {
+      return std::nullopt;
+    }
+    return value;
+  }
+
+  std::optional<RegexNode> parseAtom() {
+    const char c = pattern_[pos_++];
+    switch (c) {
+      case '(': {
+        // "(?" starts an ECMAScript extension (e.g. a lookahead), which is an error in POSIX
+        if (atEnd() || peek() == '?') {
+          return std::nullopt;
+        }
+        ++depth_;
+        auto group = parseAlternation();
+        --depth_;
+        if (!group || atEnd() || peek() != ')') {
+          return std::nullopt;
+        }
+        ++pos_;
+        return group;
+      }
+      case '[':
+        return parseBracketExpression();
+      case '.':
+        return RegexNode{.type = RegexNode::Type::BYTES, .bytes = anyByte()};
+      case '^':
+        return RegexNode{.type = RegexNode::Type::BEGIN};
+      case '$':
+        return RegexNode{.type = RegexNode::Type::END};
+      case '\\':
+        return parseEscape();
+      case '*': case '+': case '?': case '{': case '}': case ']': case ')':
+        return std::nullopt;
+      default: {
+        ByteSet bytes;
+        bytes.set(toByte(c));
+        return bytesNode(bytes);
+      }
+    }
+  }
+
+  std::optional<RegexNode> parseEscape() {
+    if (atEnd()) {
+      return std::nullopt;
+    }
+    const char c = pattern_[pos_++];
+    switch (c) {
+      case 'w': return bytesNode(wordBytes());
+      case 'W': return bytesNode(~wordBytes());
+      case 's': return bytesNode(spaceBytes());
+      case 'S': return bytesNode(~spaceBytes());
+      default:
+        break;
+    }
+    // other escapes, like \d, \b or \n, are either unsupported or mean a different thing in POSIX
+    if (std::string_view{"^$\\.*+?()[]{}|/-"}.find(c) == std::string_view::npos) {
+      return std::nullopt;
+    }
+    ByteSet bytes;
+    bytes.set(toByte(c));
+    return bytesNode(bytes);
+  }
+
+  std::optional<RegexNode> parseBracketExpression() {
+    bool negated = false;
+    if (!atEnd() && peek() == '^') {
+      negated = true;
+      ++pos_;
+    }
+    // a leading ']' is a literal in POSIX, but it closes an empty bracket expression in ECMAScript
+    if (atEnd() || peek() == ']') {
+      return std::nullopt;
+    }
+    ByteSet bytes;
+    while (true) {
+      if (atEnd()) {
+        return std::nullopt;
+      }
+      const char c = pattern_[pos_++];
+      if (c == ']') {
+        break;
+      }
+      // a backslash is a literal in POSIX bracket expressions, but it starts an escape in ECMAScript
+      if (c == '\\') {
+        return std::nullopt;
+      }
+      if (c == '[' && !atEnd() && (peek() == ':' || peek() == '.' || peek() == '=')) {
+        if (peek() != ':') {
+          return std::nullopt;
+        }
+        const auto name_end = pattern_.find(":]", pos_ + 1);
+        if (name_end == std::string_view::npos) {
+          return std::nullopt;
+        }
+        const auto class_bytes = characterClass(pattern_.substr(pos_ + 1, name_end - pos_ - 1));
+        if (!class_bytes) {
+          return std::nullopt;
+        }
+        bytes |= *class_bytes;
+        pos_ = name_end + 2;
+        continue;
+      }
+      if (pos_ + 1 < pattern_.size() && peek() == '-' && pattern_[pos_ + 1] != ']') {
+        const char range_end = pattern_[pos_ + 1];
+        if (range_end == '[' || range_end == '\\' || toByte(range_end) < toByte(c)) {
+          return std::nullopt;
+        }
+        pos_ += 2;
+        for (size_t byte = toByte(c); byte <= toByte(range_end); ++byte) {
+          bytes.set(byte);
+        }
+        continue;
+      }
+      bytes.set(toByte(c));
+    }
+    if (ignore_case_) {
+      bytes = foldCase(bytes);
+    }
+    if (negated) {
+      bytes.flip();
+    }
+    return RegexNode{.type = RegexNode::Type::BYTES, .bytes = bytes};
+  }
+
+  std::string_view pattern_;
+  size_t pos_ = 0;
+  size_t depth_ = 0;
+  bool ignore_case_;
+};
+
+// Full matches are searched for as anchored patterns, in the same way as utils::regexMatch matches them
+std::optional<RegexNode> parsePattern(const std::string& pattern, RegexSet::MatchMode match_mode, bool ignore_case) {
+  if (match_mode == RegexSet::MatchMode::SEARCH) {
+    return RegexParser{pattern, ignore_case}.parse();
+  }
+#ifdef NO_MORE_REGFREEE
+  auto root = RegexParser{pattern, ignore_case}.parse();
+  if (!root) {
+    return std::nullopt;
+  }
+  RegexNode anchored{.type = RegexNode::Type::CONCATENATION};
+  anchored.children.push_back(RegexNode{.type = RegexNode::Type::BEGIN});
+  anchored.children.push_back(std::move(*root));
+  anchored.children.push_back(RegexNode{.type = RegexNode::Type::END});
+  return anchored;
+#else
+  // regexMatch uses the pattern '^' + pattern + '$' with regex.h, so the anchors only apply to the first and last alternatives
+  return RegexParser{'^' + pattern + '$', ignore_case}.parse();
+#endif
+}
+
+struct NfaState {
+  enum class Type { BYTES, SPLIT, EMPTY, BEGIN, END, MATCH };
+
+  Type type;
+  ByteSet bytes{};
+  int32_t out = -1;
+  int32_t out1 = -1;
+  size_t pattern = 0;
+};
+
+}  // namespace
+
+// A Thompson NFA of all the patterns, which is simulated by building the reachable DFA states on demand, as in RE2.
+// The patterns are searched for in the input, full matches are expressed by anchoring the patterns.
+class RegexSet::Automaton {
+ public:
+
+  bool addPattern(const RegexNode& root, size_t pattern_index) {
+    const auto nfa_size = nfa_.size();
+    auto fragment = compile(root);
+    if (!fragment || nfa_.size() >= MAX_NFA_STATES) {
+      nfa_.resize(nfa_size);
+      return false;
+    }
+    const auto match_state = addNfaState(NfaState{.type = NfaState::Type::MATCH, .pattern = pattern_index});
+    patch(fragment->dangling, match_state);
+    pattern_starts_.push_back(fragment->start);
+    clearDfa();
+    return true;
+  }
+
+  void match(std::string_view input, std::vector<bool>& result) {
+    size_t unmatched_patterns = pattern_starts_.size();
+    const auto record = [&](const std::vector<size_t>& patterns) {
+      for (const auto pattern : patterns) {
+        if (!result[pattern]) {
+          result[pattern] = true;
+          --unmatched_patterns;
+        }
+      }
+    };
+
+    size_t state = initialState();
+    for (const char c : input) {
+      record(dfa_[state].matched_patterns);
+      // no state is left when all patterns are anchored to the beginning and none of them can match any more
+      if (unmatched_patterns == 0 || dfa_[state].nfa_states.empty()) {
+        return;
+      }
+      state = step(state, toByte(c));
+    }
+    record(dfa_[state].matched_patterns);
+    record(matchesAtEnd(state, input.empty()));
+  }
+
+ private:
+  struct Fragment {
+    int32_t start;
+    std::vector<std::pair<int32_t, bool>> dangling;  // the unconnected out (false) and out1 (true) edges
+  };
+
+  struct DfaState {
+    std::vector<int32_t> nfa_states;
+    std::vector<size_t> matched_patterns;
+    std::array<int32_t, 256> next;
+  };
+
+  int32_t addNfaState(NfaState state) {
+    nfa_.push_back(std::move(state));
+    return gsl::narrow<int32_t>(nfa_.size() - 1);
+  }
+
+  void patch(const std::vector<std::pair<int32_t, bool>>& dangling, int32_t target) {
+    for (const auto& [state, is_out1] : dangling) {
+      (is_out1 ? nfa_[state].out1 : nfa_[state].out) = target;
+    }
+  }
+
+  static Fragment singleState(int32_t state) {
+    return Fragment{.start = state, .dangling = {{state, false}}};
+  }
+
+  void append(std::optional<Fragment>& sequence, Fragment next) {
+    if (!sequence) {
+      sequence = std::move(next);
+      return;
+    }
+    patch(sequence->dangling, next.start);
+    sequence->dangling = std::move(next.dangling);
+  }
+
+  std::optional<Fragment> compile(const RegexNode& node) {
+    if (nfa_.size() >= MAX_NFA_STATES) {
+      return std::nullopt;
+    }
+    switch (node.type) {
+      case RegexNode::Type::BYTES:
+        return singleState(addNfaState(NfaState{.type = NfaState::Type::BYTES, .bytes = node.bytes}));
+      case RegexNode::Type::BEGIN:
+        return singleState(addNfaState(NfaState{.type = NfaState::Type::BEGIN}));
+      case RegexNode::Type::END:
+        return singleState(addNfaState(NfaState{.type = NfaState::Type::END}));
+      case RegexNode::Type::CONCATENATION: {
+        std::optional<Fragment> sequence;
+        for (const auto& child : node.children) {
+          auto fragment = compile(child);
+          if (!fragment) {
+            return std::nullopt;
+          }
+          append(sequence, std::move(*fragment));
+        }
+        return sequence;
+      }
+      case RegexNode::Type::ALTERNATION: {
+        std::optional<Fragment> alternatives;
+        for (const auto& child : node.children) {
+          auto fragment = compile(child);
+          if (!fragment) {
+            return std::nullopt;
+          }
+          if (!alternatives) {
+            alternatives = std::move(fragment);
+            continue;
+          }
+          const auto split = addNfaState(NfaState{.type = NfaState::Type::SPLIT, .out = alternatives->start, .out1 = fragment->start});
+          alternatives->start = split;
+          alternatives->dangling.insert(alternatives->dangling.end(), fragment->dangling.begin(), fragment->dangling.end());
+        }
+        return alternatives;
+      }
+      case RegexNode::Type::REPETITION:
+        return compileRepetition(node);
+    }
+    return std::nullopt;
+  }
+
+  std::optional<Fragment> compileRepetition(const RegexNode& node) {
+    const auto& child = node.children.front();
+    std::optional<Fragment> sequence;
+    for (size_t i = 0; i < node.min; ++i) {
+      auto fragment = compile(child);
+      if (!fragment) {
+        return std::nullopt;
+      }
+      append(sequence, std::move(*fragment));
+    }
+    if (!node.max) {
+      auto fragment = compile(child);
+      if (!fragment) {
+        return std::nullopt;
+      }
+      const auto split = addNfaState(NfaState{.type = NfaState::Type::SPLIT, .out = fragment->start});
+      patch(fragment->dangling, split);
+      append(sequence, Fragment{.start = split, .dangling = {{split, true}}});
+      return sequence;
+    }
+    for (size_t i = node.min; i < *node.max; ++i) {
+      auto fragment = compile(child);
+      if (!fragment) {
+        return std::nullopt;
+      }
+      const auto split = addNfaState(NfaState{.type = NfaState::Type::SPLIT, .out = fragment->start});
+      fragment->dangling.emplace_back(split, true);
+      append(sequence, Fragment{.start = split, .dangling = std::move(fragment->dangling)});
+    }
+    if (!sequence) {
+      // x{0} matches the empty string
+      sequence = singleState(addNfaState(NfaState{.type = NfaState::Type::EMPTY}));
+    }
+    return sequence;
+  }
+
+  // Follows the empty edges, and keeps the states which consume a byte or report a match. The anchors are
+  // followed only at the beginning or at the end of the input, the unresolved end anchors are kept as well.
+  std::vector<int32_t> closure(std::vector<int32_t> pending, bool at_begin, bool at_end) {
+    std::vector<int32_t> result;
+    std::vector<bool> visited(nfa_.size());
+    while (!pending.empty()) {
+      const auto state = pending.back();
+      pending.pop_back();
+      if (state < 0 || visited[state]) {
+        continue;
+      }
+      visited[state] = true;
+      const auto& nfa_state = nfa_[state];
+      switch (nfa_state.type) {
+        case NfaState::Type::BYTES:
+        case NfaState::Type::MATCH:
+          result.push_back(state);
+          break;
+        case NfaState::Type::SPLIT:
+          pending.push_back(nfa_state.out1);
+          pending.push_back(nfa_state.out);
+          break;
+        case NfaState::Type::EMPTY:
+          pending.push_back(nfa_state.out);
+          break;
+        case NfaState::Type::BEGIN:
+          if (at_begin) {
+            pending.push_back(nfa_state.out);
+          }
+          break;
+        case NfaState::Type::END:
+          if (at_end) {
+            pending.push_back(nfa_state.out);
+          } else {
+            result.push_back(state);
+          }
+          break;
+      }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  size_t addDfaState(std::vector<int32_t> nfa_states) {
+    if (const auto it = dfa_index_.find(nfa_states); it != dfa_index_.end()) {
+      return it->second;
+    }
+    DfaState dfa_state{.nfa_states = nfa_states, .matched_patterns = {}, .next = {}};
+    dfa_state.next.fill(-1);
+    for (const auto nfa_state : nfa_states) {
+      if (nfa_[nfa_state].type == NfaState::Type::MATCH) {
+        dfa_state.matched_patterns.push_back(nfa_[nfa_state].pattern);
+      }
+    }
+    dfa_.push_back(std::move(dfa_state));
+    dfa_index_.emplace(std::move(nfa_states), dfa_.size() - 1);
+    return dfa_.size() - 1;
+  }
+
+  void clearDfa() {
+    dfa_.clear();
+    dfa_index_.clear();
+    initial_state_.reset();
+  }
+
+  size_t initialState() {
+    if (!initial_state_) {
+      initial_state_ = addDfaState(closure(pattern_starts_, true, false));
+    }
+    return *initial_state_;
+  }
+
+  size_t step(size_t state, uint8_t byte) {
+    if (const auto next = dfa_[state].next[byte]; next >= 0) {
+      return gsl::narrow<size_t>(next);
+    }
+    std::vector<int32_t> targets;
+    for (const auto nfa_state : dfa_[state].nfa_states) {
+      if (nfa_[nfa_state].type == NfaState::Type::BYTES && nfa_[nfa_state].bytes.test(byte)) {
+        targets.push_back(nfa_[nfa_state].out);
+      }
+    }
+    targets.insert(targets.end(), pattern_starts_.begin(), pattern_starts_.end());
+    auto next_nfa_states = closure(std::move(targets), false, false);
+    if (dfa_.size() >= MAX_DFA_STATES) {
+      // the cache is full, start building it again from the current state
+      clearDfa();
+      return addDfaState(std::move(next_nfa_states));
+    }
+    const auto next = addDfaState(std::move(next_nfa_states));
+    dfa_[state].next[byte] = gsl::narrow<int32_t>(next);
+    return next;
+  }
+
+  std::vector<size_t> matchesAtEnd(size_t state, bool at_begin) {
+    std::vector<int32_t> end_anchors;
+    for (const auto nfa_state : dfa_[state].nfa_states) {
+      if (nfa_[nfa_state].type == NfaState::Type::END) {
+        end_anchors.push_back(nfa_state);
+      }
+    }
+    std::vector<size_t> result;
+    for (const auto nfa_state : closure(std::move(end_anchors), at_begin, true)) {
+      if (nfa_[nfa_state].type == NfaState::Type::MATCH) {
+        result.push_back(nfa_[nfa_state].pattern);
+      }
+    }
+    return result;
+  }
+
+  std::vector<NfaState> nfa_;
+  std::vector<int32_t> pattern_starts_;
+  std::vector<DfaState> dfa_;
+  std::map<std::vector<int32_t>, size_t> dfa_index_;
+  std::optional<size_t> initial_state_;
+};
+
+RegexSet::RegexSet(const std::vector<std::string>& patterns, MatchMode match_mode, const std::vector<Regex::Mode>& modes)
+    : pattern_count_(patterns.size()),
+      match_mode_(match_mode),
+      automaton_(std::make_unique<Automaton>()) {
+  const bool ignore_case = std::find(modes.begin(), modes.end(), Regex::Mode::ICASE) != modes.end();
+  for (size_t pattern_index = 0; pattern_index < patterns.size(); ++pattern_index) {
+    const auto root = parsePattern(patterns[pattern_index], match_mode, ignore_case);
+    if (!root || !automaton_->addPattern(*root, pattern_index)) {
+      fallback_regexes_.emplace_back(pattern_index, Regex(patterns[pattern_index], modes));
+    }
+  }
+}
+
+RegexSet::RegexSet(RegexSet&&) noexcept = default;
+RegexSet& RegexSet::operator=(RegexSet&&) noexcept = default;
+RegexSet::~RegexSet() = default;
+
+std::vector<bool> RegexSet::match(std::string_view input) {
+  std::vector<bool> result(pattern_count_, false);
+  automaton_->match(input, result);
+  for (const auto& [pattern_index, regex] : fallback_regexes_) {
+    result[pattern_index] = match_mode_ == MatchMode::FULL_MATCH ? regexMatch(input, regex) : regexSearch(input, regex);
+  }
+  return result;
+}
+
+bool RegexSet::isMatchedByAutomaton(size_t pattern_index) const {
+  return std::none_of(fallback_regexes_.begin(), fallback_regexes_.end(), [pattern_index](const auto& fallback) { return fallback.first == pattern_index; });
+}
+
+}  // namespace org::apache::nifi::minifi::utils
@@ -22,18 +22,22 @@ using namespace std::literals::chrono_literals;
 
 namespace org::apache::nifi::minifi::utils {
 
-ThreadPool::ThreadPool(int max_worker_threads, core::controller::ControllerServiceLookup* controller_service_provider, std::string name)
+ThreadPool::ThreadPool(int max_worker_threads, core::controller::ControllerServiceLookup* controller_service_provider, std::string name,
+                       ThreadPoolSchedulingMode scheduling_mode)
     : thread_reduction_count_(0),
       max_worker_threads_(max_worker_threads),
       current_workers_(0),
       running_(false),
       controller_service_provider_(controller_service_provider),
+      scheduling_mode_(scheduling_mode),
       name_(std::move(name)),
       logger_(core::logging::LoggerFactory<ThreadPool>::getLogger()) {
+  worker_queue_.setSchedulingMode(scheduling_mode_, gsl::narrow<size_t>(std::max(max_worker_threads_, 1)));
 }
 
 void ThreadPool::run_tasks(const std::shared_ptr<WorkerThread>& thread) {
   thread->is_running_ = true;
+  worker_queue_.registerWorker();
   while (running_.load()) {
     if (UNLIKELY(thread_reduction_count_ > 0)) {
       if (--thread_reduction_count_ >= 0) {
@@ -56,31 +60,36 @@ void ThreadPool::run_tasks(const std::shared_ptr<WorkerThread>& thread) {
           continue;
         }
         ++running_task_count_by_id_[task.getIdentifier()];
+        wake_up_requests_.erase(task.getIdentifier());
       }
       const bool taskRunResult = task.run();
-      {
-        std::unique_lock<std::mutex> lock(worker_queue_mutex_);
-        auto& count = running_task_count_by_id_[task.getIdentifier()];
-        if (count == 1) {
-          running_task_count_by_id_.erase(task.getIdentifier());
-        } else {
-          --count;
-        }
+      std::unique_lock<std::mutex> lock(worker_queue_mutex_);
+      auto& count = running_task_count_by_id_[task.getIdentifier()];
+      if (count == 1) {
+        running_task_count_by_id_.erase(task.getIdentifier());
+      } else {
+        --count;
       }
       task_run_complete_.notify_all();
-      if (taskRunResult) {
+      // stopTasks() may have returned as soon as the count dropped, so a stopped task must not be put back in either queue,
+      // otherwise it would run again next to the tasks of a processor rescheduled under the same identifier
+      if (taskRunResult && task_status_[task.getIdentifier()]) {
         if (task.getNextExecutionTime() <= std::chrono::steady_clock::now()) {
           // it can be rescheduled again as soon as there is a worker available
           worker_queue_.enqueue(std::move(task));
           continue;
         }
         // Task will be put to the delayed queue as next exec time is in the future
-        std::unique_lock<std::mutex> lock(worker_queue_mutex_);
+        if (wake_up_requests_.erase(task.getIdentifier()) > 0) {
+          // the task was woken up while it was running, the reason of the delay might not be valid anymore
+          worker_queue_.enqueue(std::move(task));
+          continue;
+        }
         bool need_to_notify =
             delayed_worker_queue_.empty() ||
-                task.getNextExecutionTime() < delayed_worker_queue_.top().getNextExecutionTime();
+                task.getNextExecutionTime() < delayed_worker_queue_.begin()->first;
 
-        delayed_worker_queue_.push(std::move(task));
+        pushDelayedTask(std::move(task));
         if (need_to_notify) {
           delayed_task_available_.notify_all();
         }
@@ -104,16 +113,13 @@ void ThreadPool::manage_delayed_queue() {
     }
 
     // Put the tasks ready to run in the worker queue
-    while (!delayed_worker_queue_.empty() && delayed_worker_queue_.top().getNextExecutionTime() <= std::chrono::steady_clock::now()) {
-      // I'm very sorry for this - committee must has been seriously drunk when the interface of prio queue was submitted.
-      Worker task = std::move(const_cast<Worker&>(delayed_worker_queue_.top()));
-      delayed_worker_queue_.pop();
-      worker_queue_.enqueue(std::move(task));
+    while (!delayed_worker_queue_.empty() && delayed_worker_queue_.begin()->first <= std::chrono::steady_clock::now()) {
+      worker_queue_.enqueue(popDelayedTask());
     }
     if (delayed_worker_queue_.empty()) {
       delayed_task_available_.wait(lock);
     } else {
-      auto wait_time = delayed_worker_queue_.top().getNextExecutionTime() - std::chrono::steady_clock::now();
+      auto wait_time = delayed_worker_queue_.begin()->first - std::chrono::steady_clock::now();
       delayed_task_available_.wait_for(lock, std::max(wait_time, std::chrono::steady_clock::duration(1ms)));
     }
   }
@@ -207,6 +213,7 @@ void ThreadPool::start() {
     thread_manager_ = createThreadManager();
 
     running_ = true;
+    worker_queue_.setSchedulingMode(scheduling_mode_, gsl::narrow<size_t>(std::max(max_worker_threads_, 1)));
     worker_queue_.start();
     manager_thread_ = std::thread(&ThreadPool::manageWorkers, this);
 
@@ -223,15 +230,8 @@ void ThreadPool::stopTasks(const TaskId &identifier) {
   worker_queue_.remove([&] (const Worker& worker) { return worker.getIdentifier() == identifier; });
 
   // also remove from delayed_worker_queue_
-  decltype(delayed_worker_queue_) new_delayed_worker_queue;
-  while (!delayed_worker_queue_.empty()) {
-    Worker task = std::move(const_cast<Worker&>(delayed_worker_queue_.top()));
-    delayed_worker_queue_.pop();
-    if (task.getIdentifier() != identifier) {
-      new_delayed_worker_queue.push(std::move(task));
-    }
-  }
-  delayed_worker_queue_ = std::move(new_delayed_worker_queue);
+  removeDelayedTasks(identifier, [](Worker&&) {});
+  wake_up_requests_.erase(identifier);
 
   // if tasks are in progress, wait for their completion
   task_run_complete_.wait(lock, [&] () {
@@ -240,6 +240,48 @@ void ThreadPool::stopTasks(const TaskId &identifier) {
   });
 }
 
+void ThreadPool::wakeUp(const TaskId &identifier) {
+  std::unique_lock<std::mutex> lock(worker_queue_mutex_);
+  const auto status = task_status_.find(identifier);
+  if (status == task_status_.end() || !status->second) {
+    return;
+  }
+
+  if (running_task_count_by_id_.contains(identifier)) {
+    wake_up_requests_.insert(identifier);
+  }
+
+  if (delayed_tasks_by_id_.contains(identifier)) {
+    removeDelayedTasks(identifier, [this](Worker&& task) { worker_queue_.enqueue(std::move(task)); });
+  }
+}
+
+void ThreadPool::removeDelayedTasks(const TaskId &identifier, const std::function<void(Worker&&)>& consumer) {
+  const auto [begin, end] = delayed_tasks_by_id_.equal_range(identifier);
+  for (auto it = begin; it != end; ++it) {
+    consumer(std::move(it->second->second));
+    delayed_worker_queue_.erase(it->second);
+  }
+  delayed_tasks_by_id_.erase(begin, end);
+}
+
+void ThreadPool::pushDelayedTask(Worker &&task) {
+  const auto next_execution_time = task.getNextExecutionTime();
+  const auto task_it = delayed_worker_queue_.emplace(next_execution_time, std::move(task));
+  delayed_tasks_by_id_.emplace(task_it->second.getIdentifier(), task_it);
+}
+
+Worker ThreadPool::popDelayedTask() {
+  const auto task_it = delayed_worker_queue_.begin();
+  const auto [begin, end] = delayed_tasks_by_id_.equal_range(task_it->second.getIdentifier());
+  const auto index_it = std::find_if(begin, end, [&](const auto& entry) { return entry.second == task_it; });
+  gsl_Assert(index_it != end);
+  delayed_tasks_by_id_.erase(index_it);
+  Worker task = std::move(task_it->second);
+  delayed_worker_queue_.erase(task_it);
+  return task;
+}
+
 void ThreadPool::resume() {
   if (!worker_queue_.isRunning()) {
     worker_queue_.start();
@@ -282,9 +324,9 @@ void ThreadPool::shutdown() {
 
     thread_queue_.clear();
     current_workers_ = 0;
-    while (!delayed_worker_queue_.empty()) {
-      delayed_worker_queue_.pop();
-    }
+    delayed_worker_queue_.clear();
+    delayed_tasks_by_id_.clear();
+    wake_up_requests_.clear();
 
     worker_queue_.clear();
   }
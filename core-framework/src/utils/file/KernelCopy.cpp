@@ -0,0 +1,196 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/file/KernelCopy.h"
+
+#include <algorithm>
+#include <cerrno>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "minifi-cpp/utils/gsl.h"
+
+namespace org::apache::nifi::minifi::utils::file {
+
+#ifdef __linux__
+
+namespace {
+
+// sendfile transfers at most 0x7ffff000 bytes in one call, larger copies are split into chunks of this size
+constexpr uint64_t MAX_CHUNK_SIZE = 1024 * 1024 * 1024;
+
+class FileDescriptor {
+ public:
+  FileDescriptor(const std::filesystem::path& path, int flags) : fd_(::open(path.c_str(), flags | O_CLOEXEC)) {}
+  ~FileDescriptor() {
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+
+  FileDescriptor(const FileDescriptor&) = delete;
+  FileDescriptor& operator=(const FileDescriptor&) = delete;
+  FileDescriptor(FileDescriptor&&) = delete;
+  FileDescriptor& operator=(FileDescriptor&&) = delete;
+
+  [[nodiscard]] bool isOpen() const { return fd_ >= 0; }
+  [[nodiscard]] int get() const { return fd_; }
+
+ private:
+  int fd_;
+};
+
+std::error_code lastError() {
+  return {errno, std::generic_category()};
+}
+
+// copy_file_range and sendfile fail with these when the kernel or the file systems can not copy between the files
+bool isNotSupportedError(int error) {
+  return error == EXDEV || error == EINVAL || error == ENOSYS || error == EOPNOTSUPP;
+}
+
+bool cloneWholeFile(const FileDescriptor& source, const FileDescriptor& destination, uint64_t source_offset, uint64_t destination_offset, uint64_t size) {
+#ifdef FICLONE
+  if (source_offset != 0 || destination_offset != 0) {
+    return false;
+  }
+  struct stat source_stat{};
+  struct stat destination_stat{};
+  if (fstat(source.get(), &source_stat) != 0 || fstat(destination.get(), &destination_stat) != 0) {
+    return false;
+  }
+  if (gsl::narrow<uint64_t>(source_stat.st_size) != size || destination_stat.st_size != 0) {
+    return false;
+  }
+  return ioctl(destination.get(), FICLONE, source.get()) == 0;
+#else
+  (void) source; (void) destination; (void) source_offset; (void) destination_offset; (void) size;
+  return false;
+#endif
+}
+
+// Calls copy_chunk, which has the same contract as copy_file_range and sendfile, until `size` bytes are copied
+template<typename CopyChunk>
+nonstd::expected<uint64_t, std::error_code> copyInChunks(uint64_t size, CopyChunk copy_chunk) {
+  uint64_t copied = 0;
+  while (copied < size) {
+    const ssize_t result = copy_chunk(gsl::narrow<size_t>(std::min(size - copied, MAX_CHUNK_SIZE)));
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (copied == 0 && isNotSupportedError(errno)) {
+        return nonstd::make_unexpected(std::make_error_code(std::errc::operation_not_supported));
+      }
+      return nonstd::make_unexpected(lastError());
+    }
+    if (result == 0) {
+      // the source is shorter than expected
+      return nonstd::make_unexpected(std::make_error_code(std::errc::io_error));
+    }
+    copied += gsl::narrow<uint64_t>(result);
+  }
+  return copied;
+}
+
+}  // namespace
+
+nonstd::expected<uint64_t, std::error_code> copyFileRange(const std::filesystem::path& source, uint64_t source_offset,
+    const std::filesystem::path& destination, uint64_t destination_offset, uint64_t size) {
+  const FileDescriptor source_file(source, O_RDONLY);
+  if (!source_file.isOpen()) {
+    return nonstd::make_unexpected(lastError());
+  }
+  const FileDescriptor destination_file(destination, O_WRONLY);
+  if (!destination_file.isOpen()) {
+    return nonstd::make_unexpected(lastError());
+  }
+  if (size == 0) {
+    return 0;
+  }
+  if (cloneWholeFile(source_file, destination_file, source_offset, destination_offset, size)) {
+    return size;
+  }
+
+  auto input_offset = gsl::narrow<loff_t>(source_offset);
+  auto output_offset = gsl::narrow<loff_t>(destination_offset);
+  auto result = copyInChunks(size, [&](size_t chunk_size) {
+    return copy_file_range(source_file.get(), &input_offset, destination_file.get(), &output_offset, chunk_size, 0);
+  });
+  if (result || result.error() != std::errc::operation_not_supported) {
+    return result;
+  }
+
+  // e.g. copy_file_range between different file systems on older kernels, sendfile writes at the file position of the destination
+  if (lseek(destination_file.get(), gsl::narrow<off_t>(destination_offset), SEEK_SET) < 0) {
+    return nonstd::make_unexpected(lastError());
+  }
+  auto sendfile_offset = gsl::narrow<off_t>(source_offset);
+  return copyInChunks(size, [&](size_t chunk_size) {
+    return ::sendfile(destination_file.get(), source_file.get(), &sendfile_offset, chunk_size);
+  });
+}
+
+nonstd::expected<uint64_t, std::error_code> sendFile(const std::filesystem::path& source, uint64_t offset, uint64_t size, int socket) {
+  const FileDescriptor source_file(source, O_RDONLY);
+  if (!source_file.isOpen()) {
+    return nonstd::make_unexpected(lastError());
+  }
+  auto source_offset = gsl::narrow<off_t>(offset);
+  uint64_t sent = 0;
+  while (sent < size) {
+    const ssize_t result = ::sendfile(socket, source_file.get(), &source_offset, gsl::narrow<size_t>(std::min(size - sent, MAX_CHUNK_SIZE)));
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN) {
+        break;
+      }
+      if (sent == 0 && isNotSupportedError(errno)) {
+        return nonstd::make_unexpected(std::make_error_code(std::errc::operation_not_supported));
+      }
+      return nonstd::make_unexpected(lastError());
+    }
+    if (result == 0) {
+      return nonstd::make_unexpected(std::make_error_code(std::errc::io_error));
+    }
+    sent += gsl::narrow<uint64_t>(result);
+  }
+  return sent;
+}
+
+#else
+
+nonstd::expected<uint64_t, std::error_code> copyFileRange(const std::filesystem::path&, uint64_t, const std::filesystem::path&, uint64_t, uint64_t) {
+  return nonstd::make_unexpected(std::make_error_code(std::errc::operation_not_supported));
+}
+
+nonstd::expected<uint64_t, std::error_code> sendFile(const std::filesystem::path&, uint64_t, uint64_t, int) {
+  return nonstd::make_unexpected(std::make_error_code(std::errc::operation_not_supported));
+}
+
+#endif
+
+}  // namespace org::apache::nifi::minifi::utils::file
@@ -16,15 +16,31 @@
  */
 #pragma once
 
+#include <utility>
+
 #include "minifi-cpp/controllers/RecordSetReader.h"
 #include "core/controller/ControllerService.h"
 
-
 namespace org::apache::nifi::minifi::core {
 
 class RecordSetReaderImpl : public virtual controller::ControllerServiceImpl, public virtual RecordSetReader {
  public:
   using ControllerServiceImpl::ControllerServiceImpl;
+
+  nonstd::expected<RecordSet, std::error_code> read(io::InputStream& input_stream) override {
+    RecordSet record_set;
+    const auto record_reader = createRecordReader(input_stream);
+    while (true) {
+      auto record = record_reader->next();
+      if (!record) {
+        return nonstd::make_unexpected(record.error());
+      }
+      if (!*record) {
+        return record_set;
+      }
+      record_set.push_back(std::move(**record));
+    }
+  }
 };
 
 }  // namespace org::apache::nifi::minifi::core
@@ -16,7 +16,11 @@
  */
 #pragma once
 
+#include <memory>
+
 #include "minifi-cpp/controllers/RecordSetWriter.h"
+#include "minifi-cpp/io/Stream.h"
+#include "minifi-cpp/utils/gsl.h"
 #include "core/controller/ControllerService.h"
 
 namespace org::apache::nifi::minifi::core {
@@ -24,6 +28,25 @@ namespace org::apache::nifi::minifi::core {
 class RecordSetWriterImpl : public virtual controller::ControllerServiceImpl, public virtual RecordSetWriter {
  public:
   using ControllerServiceImpl::ControllerServiceImpl;
+
+  void write(const RecordSet& record_set, const std::shared_ptr<FlowFile>& flow_file, ProcessSession& session) override {
+    session.write(flow_file, [this, &record_set](const std::shared_ptr<io::OutputStream>& stream) -> int64_t {
+      const auto record_writer = createRecordWriter(*stream);
+      size_t bytes_written = 0;
+      for (const auto& record : record_set) {
+        const auto write_result = record_writer->write(record);
+        if (io::isError(write_result)) {
+          return -1;
+        }
+        bytes_written += write_result;
+      }
+      const auto finish_result = record_writer->finish();
+      if (io::isError(finish_result)) {
+        return -1;
+      }
+      return gsl::narrow<int64_t>(bytes_written + finish_result);
+    });
+  }
 };
 
 }  // namespace org::apache::nifi::minifi::core
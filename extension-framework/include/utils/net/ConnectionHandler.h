@@ -21,6 +21,7 @@
 
 #include "utils/net/AsioCoro.h"
 #include "utils/net/AsioSocketUtils.h"
+#include "utils/file/KernelCopy.h"
 #include "ConnectionHandlerBase.h"
 
 namespace org::apache::nifi::minifi::utils::net {
@@ -67,6 +68,7 @@ class ConnectionHandler final : public ConnectionHandlerBase {
   asio::awaitable<std::error_code> establishNewConnection(const asio::ip::tcp::resolver::results_type& endpoints, asio::io_context& io_context_);
   [[nodiscard]] asio::awaitable<std::tuple<std::error_code, size_t>> write(const asio::const_buffer& buffer) override;
   [[nodiscard]] asio::awaitable<std::tuple<std::error_code, size_t>> read(asio::mutable_buffer& buffer) override;
+  [[nodiscard]] asio::awaitable<std::tuple<std::error_code, size_t>> sendFile(const std::filesystem::path& path, uint64_t offset, uint64_t size) override;
 
   SocketType createNewSocket(asio::io_context& io_context_);
   void shutdownSocket();
@@ -115,6 +117,40 @@ inline void ConnectionHandler<SslSocket>::shutdownSocket() {
   }
 }
 
+template<>
+inline asio::awaitable<std::tuple<std::error_code, size_t>> ConnectionHandler<TcpSocket>::sendFile(const std::filesystem::path& path, uint64_t offset, uint64_t size) {
+#ifdef __linux__
+  std::error_code non_blocking_error;
+  socket_->native_non_blocking(true, non_blocking_error);
+  if (non_blocking_error)
+    co_return std::make_tuple(non_blocking_error, size_t{0});
+  uint64_t bytes_sent = 0;
+  while (bytes_sent < size) {
+    const auto send_result = utils::file::sendFile(path, offset + bytes_sent, size - bytes_sent, socket_->native_handle());
+    if (!send_result)
+      co_return std::make_tuple(send_result.error(), gsl::narrow<size_t>(bytes_sent));
+    bytes_sent += *send_result;
+    if (bytes_sent < size) {
+      // the send buffer of the socket is full
+      auto [wait_error] = co_await asyncOperationWithTimeout(socket_->async_wait(TcpSocket::wait_write, use_nothrow_awaitable), timeout_duration_);
+      if (wait_error)
+        co_return std::make_tuple(wait_error, gsl::narrow<size_t>(bytes_sent));
+    }
+  }
+  last_used_ = std::chrono::steady_clock::now();
+  co_return std::make_tuple(std::error_code(), gsl::narrow<size_t>(bytes_sent));
+#else
+  (void) path; (void) offset; (void) size;
+  co_return std::make_tuple(std::make_error_code(std::errc::operation_not_supported), size_t{0});
+#endif
+}
+
+template<>
+inline asio::awaitable<std::tuple<std::error_code, size_t>> ConnectionHandler<SslSocket>::sendFile(const std::filesystem::path&, uint64_t, uint64_t) {
+  // the data has to be encrypted in user space
+  co_return std::make_tuple(std::make_error_code(std::errc::operation_not_supported), size_t{0});
+}
+
 template<class SocketType>
 asio::awaitable<std::error_code> ConnectionHandler<SocketType>::establishNewConnection(const asio::ip::tcp::resolver::results_type& endpoints, asio::io_context& io_context) {
   auto socket = createNewSocket(io_context);
@@ -17,6 +17,9 @@
 
 #pragma once
 
+#include <cstdint>
+#include <filesystem>
+
 namespace org::apache::nifi::minifi::utils::net {
 
 class ConnectionHandlerBase {
@@ -36,6 +39,8 @@ class ConnectionHandlerBase {
   [[nodiscard]] virtual bool hasBeenUsedIn(std::chrono::milliseconds dur) const = 0;
   [[nodiscard]] virtual asio::awaitable<std::tuple<std::error_code, size_t>> write(const asio::const_buffer& buffer) = 0;
   [[nodiscard]] virtual asio::awaitable<std::tuple<std::error_code, size_t>> read(asio::mutable_buffer& buffer) = 0;
+  // Sends a part of a local file without reading it into user space, fails with std::errc::operation_not_supported if the connection can not do that
+  [[nodiscard]] virtual asio::awaitable<std::tuple<std::error_code, size_t>> sendFile(const std::filesystem::path& path, uint64_t offset, uint64_t size) = 0;
 };
 
 }  // namespace org::apache::nifi::minifi::utils::net
@@ -18,7 +18,11 @@
 
 #include <optional>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 #include <asio/awaitable.hpp>
+#include <asio/ip/udp.hpp>
 
 #include "Server.h"
 #include "minifi-cpp/core/logging/Logger.h"
@@ -26,14 +30,32 @@
 
 namespace org::apache::nifi::minifi::utils::net {
 
+// Receives datagrams on one or more sockets bound to the same port. With multiple sockets, SO_REUSEPORT lets the kernel
+// distribute the senders between the sockets, and each socket is read by its own thread.
 class UdpServer : public Server {
  public:
   UdpServer(std::optional<size_t> max_queue_size,
             uint16_t port,
-            std::shared_ptr<core::logging::Logger> logger);
+            std::shared_ptr<core::logging::Logger> logger,
+            size_t socket_count = 1);
+
+  void run() override;
 
  private:
+  // Datagrams are received into these buffers, and only the received bytes are copied into the queued messages
+  struct ReceiveBuffers {
+    ReceiveBuffers();
+
+    std::vector<std::string> buffers;
+  };
+
   asio::awaitable<void> doReceive() override;
+  asio::awaitable<void> receive(asio::ip::udp::socket socket);
+  asio::ip::udp::socket openSocket();
+  size_t receiveBatch(asio::ip::udp::socket& socket, ReceiveBuffers& receive_buffers, asio::ip::port_type local_port);
+  void enqueue(std::string_view data, const asio::ip::udp::endpoint& sender_endpoint, asio::ip::port_type local_port);
+
+  size_t socket_count_;
 };
 
 }  // namespace org::apache::nifi::minifi::utils::net
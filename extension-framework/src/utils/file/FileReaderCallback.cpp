@@ -21,6 +21,7 @@
 #include <cstring>
 
 #include "core/logging/LoggerFactory.h"
+#include "io/FileStream.h"
 #include "utils/StringUtils.h"
 
 namespace org::apache::nifi::minifi::utils {
@@ -40,6 +41,16 @@ int64_t FileReaderCallback::operator()(const std::shared_ptr<io::OutputStream>&
     throw FileReaderCallbackIOError(string::join_pack("Error opening file: ", std::strerror(errno)), errno);
   }
   logger_->log_debug("Opening {}", file_path_);
+  if (auto* file_output_stream = io::getUnderlyingFileStream(*output_stream)) {
+    std::error_code file_size_error;
+    const auto file_size = std::filesystem::file_size(file_path_, file_size_error);
+    if (!file_size_error) {
+      if (const auto num_bytes_copied = file_output_stream->copyFrom({.path = file_path_, .offset = 0, .size = file_size})) {
+        logger_->log_debug("Finished copying {} bytes from the file in the kernel", *num_bytes_copied);
+        return gsl::narrow<int64_t>(*num_bytes_copied);
+      }
+    }
+  }
   while (input_stream.good()) {
     input_stream.read(buffer.data(), gsl::narrow<std::streamsize>(buffer.size()));
     if (input_stream.bad()) {
@@ -19,6 +19,7 @@
 
 #include <fstream>
 
+#include "io/FileStream.h"
 #include "utils/Id.h"
 
 namespace org::apache::nifi::minifi::utils {
@@ -41,6 +42,12 @@ int64_t FileWriterCallback::operator()(const std::shared_ptr<io::InputStream>& s
 
   std::ofstream tmp_file_os(temp_path_, std::ios::out | std::ios::binary);
 
+  if (const auto copied = io::copyToFileInKernel(*stream, temp_path_, 0)) {
+    tmp_file_os.close();
+    write_succeeded_ = static_cast<bool>(tmp_file_os);
+    return gsl::narrow<int64_t>(*copied);
+  }
+
   do {
     const auto read = stream->read(buffer);
     if (io::isError(read)) return -1;
@@ -15,37 +15,149 @@
  * limitations under the License.
  */
 #include "utils/net/UdpServer.h"
+
+#include <algorithm>
+#include <array>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
 #include "utils/net/AsioCoro.h"
 
 namespace org::apache::nifi::minifi::utils::net {
 
+namespace {
 constexpr size_t MAX_UDP_PACKET_SIZE = 65535;
+// number of datagrams received before waiting for the socket again, on Linux with a single recvmmsg call
+constexpr size_t RECEIVE_BATCH_SIZE = 32;
+#ifdef __linux__
+constexpr size_t RECEIVE_BUFFER_COUNT = RECEIVE_BATCH_SIZE;
+#else
+constexpr size_t RECEIVE_BUFFER_COUNT = 1;
+#endif
+}  // namespace
+
+UdpServer::ReceiveBuffers::ReceiveBuffers()
+    : buffers(RECEIVE_BUFFER_COUNT, std::string(MAX_UDP_PACKET_SIZE, {})) {
+}
 
 UdpServer::UdpServer(std::optional<size_t> max_queue_size,
                      uint16_t port,
-                     std::shared_ptr<core::logging::Logger> logger)
-    : Server(max_queue_size, port, std::move(logger)) {
+                     std::shared_ptr<core::logging::Logger> logger,
+                     size_t socket_count)
+    : Server(max_queue_size, port, std::move(logger)),
+      socket_count_(std::max<size_t>(socket_count, 1)) {
+#ifndef SO_REUSEPORT
+  if (socket_count_ > 1) {
+    logger_->log_warn("SO_REUSEPORT is not supported on this platform, receiving datagrams on a single socket");
+    socket_count_ = 1;
+  }
+#endif
+}
+
+void UdpServer::run() {
+  asio::co_spawn(io_context_, doReceive(), asio::detached);
+  std::vector<std::thread> receiver_threads;
+  for (size_t i = 1; i < socket_count_; ++i) {
+    receiver_threads.emplace_back([this] { io_context_.run(); });
+  }
+  io_context_.run();
+  for (auto& receiver_thread : receiver_threads) {
+    receiver_thread.join();
+  }
 }
 
 asio::awaitable<void> UdpServer::doReceive() {
-  asio::ip::udp::socket socket(io_context_, asio::ip::udp::endpoint(asio::ip::udp::v6(), port_));
+  for (size_t i = 0; i < socket_count_; ++i) {
+    asio::co_spawn(io_context_, receive(openSocket()), asio::detached);
+  }
+  co_return;
+}
+
+asio::ip::udp::socket UdpServer::openSocket() {
+  asio::ip::udp::socket socket(io_context_, asio::ip::udp::v6());
+#ifdef SO_REUSEPORT
+  if (socket_count_ > 1) {
+    socket.set_option(asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true));
+  }
+#endif
+  socket.bind(asio::ip::udp::endpoint(asio::ip::udp::v6(), port_));
   if (port_ == 0)
     port_ = socket.local_endpoint().port();
-  while (true) {
-    std::string buffer = std::string(MAX_UDP_PACKET_SIZE, {});
-    asio::ip::udp::endpoint sender_endpoint;
+  return socket;
+}
 
-    auto [receive_error, bytes_received] = co_await socket.async_receive_from(asio::buffer(buffer, MAX_UDP_PACKET_SIZE), sender_endpoint, utils::net::use_nothrow_awaitable);
-    if (receive_error) {
-      logger_->log_warn("Error during receive: {}", receive_error.message());
+asio::awaitable<void> UdpServer::receive(asio::ip::udp::socket socket) {
+  const auto local_port = socket.local_endpoint().port();
+  socket.non_blocking(true);
+  ReceiveBuffers receive_buffers;
+  while (true) {
+    auto [wait_error] = co_await socket.async_wait(asio::ip::udp::socket::wait_read, utils::net::use_nothrow_awaitable);
+    if (wait_error) {
+      logger_->log_warn("Error during waiting for datagrams: {}", wait_error.message());
       continue;
     }
-    buffer.resize(bytes_received);
-    if (!max_queue_size_ || max_queue_size_ > concurrent_queue_.size()) {
-      concurrent_queue_.enqueue(utils::net::Message(std::move(buffer), IpProtocol::UDP, sender_endpoint.address(), sender_endpoint.port(), socket.local_endpoint().port()));
-    } else {
-      logger_->log_warn("Queue is full. UDP message ignored.");
+    while (receiveBatch(socket, receive_buffers, local_port) == RECEIVE_BATCH_SIZE) {}
+  }
+}
+
+size_t UdpServer::receiveBatch(asio::ip::udp::socket& socket, ReceiveBuffers& receive_buffers, asio::ip::port_type local_port) {
+#ifdef __linux__
+  std::array<mmsghdr, RECEIVE_BATCH_SIZE> headers{};
+  std::array<iovec, RECEIVE_BATCH_SIZE> buffer_vectors{};
+  std::array<sockaddr_storage, RECEIVE_BATCH_SIZE> sender_addresses{};
+  for (size_t i = 0; i < RECEIVE_BATCH_SIZE; ++i) {
+    buffer_vectors[i] = iovec{.iov_base = receive_buffers.buffers[i].data(), .iov_len = receive_buffers.buffers[i].size()};
+    headers[i].msg_hdr.msg_iov = &buffer_vectors[i];
+    headers[i].msg_hdr.msg_iovlen = 1;
+    headers[i].msg_hdr.msg_name = &sender_addresses[i];
+    headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+  }
+
+  const int received = recvmmsg(socket.native_handle(), headers.data(), RECEIVE_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+  if (received < 0) {
+    if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+      logger_->log_warn("Error during receive: {}", std::strerror(errno));
     }
+    return 0;
+  }
+
+  for (size_t i = 0; i < static_cast<size_t>(received); ++i) {
+    asio::ip::udp::endpoint sender_endpoint;
+    const auto address_length = std::min<size_t>(headers[i].msg_hdr.msg_namelen, sender_endpoint.capacity());
+    std::memcpy(sender_endpoint.data(), &sender_addresses[i], address_length);
+    sender_endpoint.resize(address_length);
+    enqueue(std::string_view(receive_buffers.buffers[i].data(), headers[i].msg_len), sender_endpoint, local_port);
+  }
+  return static_cast<size_t>(received);
+#else
+  auto& buffer = receive_buffers.buffers.front();
+  size_t received = 0;
+  for (; received < RECEIVE_BATCH_SIZE; ++received) {
+    asio::ip::udp::endpoint sender_endpoint;
+    std::error_code receive_error;
+    const auto bytes_received = socket.receive_from(asio::buffer(buffer), sender_endpoint, 0, receive_error);
+    if (receive_error) {
+      if (receive_error != asio::error::would_block) {
+        logger_->log_warn("Error during receive: {}", receive_error.message());
+      }
+      break;
+    }
+    enqueue(std::string_view(buffer.data(), bytes_received), sender_endpoint, local_port);
+  }
+  return received;
+#endif
+}
+
+void UdpServer::enqueue(std::string_view data, const asio::ip::udp::endpoint& sender_endpoint, asio::ip::port_type local_port) {
+  if (!max_queue_size_ || max_queue_size_ > concurrent_queue_.size()) {
+    concurrent_queue_.enqueue(utils::net::Message(std::string(data), IpProtocol::UDP, sender_endpoint.address(), sender_endpoint.port(), local_port));
+  } else {
+    logger_->log_warn("Queue is full. UDP message ignored.");
   }
 }
 
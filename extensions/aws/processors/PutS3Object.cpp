@@ -81,6 +81,12 @@ void PutS3Object::onSchedule(core::ProcessContext& context, core::ProcessSession
 
   logger_->log_debug("PutS3Object: Multipart Size {}", multipart_size_);
 
+  multipart_max_parallel_parts_ = gsl::narrow<size_t>(minifi::utils::parseU64Property(context, MultipartUploadMaxParallelParts));
+  if (multipart_max_parallel_parts_ == 0) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Multipart Upload Max Parallel Parts must be at least 1");
+  }
+  logger_->log_debug("PutS3Object: Multipart Upload Max Parallel Parts {}", multipart_max_parallel_parts_);
+
 
   multipart_upload_ageoff_interval_ = minifi::utils::parseDurationProperty(context, MultipartUploadAgeOffInterval);
   logger_->log_debug("PutS3Object: Multipart Upload Ageoff Interval {}", multipart_upload_ageoff_interval_);
@@ -301,7 +307,7 @@ void PutS3Object::onTrigger(core::ProcessContext& context, core::ProcessSession&
         return gsl::narrow<int64_t>(flow_file->getSize());
       } else {
         logger_->log_info("S3 Object '{}' passes the multipart threshold, uploading it in multiple parts", put_s3_request_params->object_key);
-        result = s3_wrapper_.putObjectMultipart(*put_s3_request_params, stream, flow_file->getSize(), multipart_size_);
+        result = s3_wrapper_.putObjectMultipart(*put_s3_request_params, stream, flow_file->getSize(), multipart_size_, multipart_max_parallel_parts_);
         return gsl::narrow<int64_t>(flow_file->getSize());
       }
     } catch(const aws::s3::StreamReadException& ex) {
@@ -131,6 +131,13 @@ class PutS3Object : public S3Processor {  // NOLINT(cppcoreguidelines-special-me
       .withDefaultValue("5 GB")
       .isRequired(true)
       .build();
+  EXTENSIONAPI static constexpr auto MultipartUploadMaxParallelParts = core::PropertyDefinitionBuilder<>::createProperty("Multipart Upload Max Parallel Parts")
+      .withDescription("Specifies the maximum number of parts of a multipart upload which are uploaded at the same time. While earlier parts are being uploaded, "
+          "the next parts are read from the flow file, so up to this many parts are held in memory, each up to the Multipart Part Size.")
+      .withValidator(core::StandardPropertyValidators::UNSIGNED_INTEGER_VALIDATOR)
+      .withDefaultValue("1")
+      .isRequired(true)
+      .build();
   EXTENSIONAPI static constexpr auto MultipartUploadAgeOffInterval = core::PropertyDefinitionBuilder<>::createProperty("Multipart Upload AgeOff Interval")
       .withDescription("Specifies the interval at which existing multipart uploads in AWS S3 will be evaluated for ageoff. "
           "When processor is triggered it will initiate the ageoff evaluation if this interval has been exceeded.")
@@ -163,6 +170,7 @@ class PutS3Object : public S3Processor {  // NOLINT(cppcoreguidelines-special-me
       UsePathStyleAccess,
       MultipartThreshold,
       MultipartPartSize,
+      MultipartUploadMaxParallelParts,
       MultipartUploadAgeOffInterval,
       MultipartUploadMaxAgeThreshold,
       ChecksumAlgorithm
@@ -229,6 +237,7 @@ class PutS3Object : public S3Processor {  // NOLINT(cppcoreguidelines-special-me
   bool use_virtual_addressing_ = true;
   uint64_t multipart_threshold_{};
   uint64_t multipart_size_{};
+  size_t multipart_max_parallel_parts_ = 1;
   std::chrono::milliseconds multipart_upload_ageoff_interval_;
   std::chrono::milliseconds multipart_upload_max_age_threshold_;
   std::mutex last_ageoff_mutex_;
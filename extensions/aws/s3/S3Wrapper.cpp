@@ -21,6 +21,10 @@
 #include <utility>
 #include <vector>
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 #include "S3ClientRequestSender.h"
 #include "utils/ArrayUtils.h"
@@ -68,8 +72,13 @@ std::string S3Wrapper::getEncryptionString(Aws::S3::Model::ServerSideEncryption
 }
 
 std::shared_ptr<Aws::StringStream> S3Wrapper::readFlowFileStream(const std::shared_ptr<io::InputStream>& stream, uint64_t read_limit, uint64_t& read_size_out) {
-  std::array<std::byte, BUFFER_SIZE> buffer{};
   auto data_stream = std::make_shared<Aws::StringStream>();
+  read_size_out = readFlowFileStream(stream, read_limit, *data_stream);
+  return data_stream;
+}
+
+uint64_t S3Wrapper::readFlowFileStream(const std::shared_ptr<io::InputStream>& stream, uint64_t read_limit, Aws::StringStream& data_stream) {
+  std::array<std::byte, BUFFER_SIZE> buffer{};
   uint64_t read_size = 0;
   while (read_size < read_limit) {
     const auto next_read_size = (std::min)(read_limit - read_size, uint64_t{BUFFER_SIZE});
@@ -78,14 +87,13 @@ std::shared_ptr<Aws::StringStream> S3Wrapper::readFlowFileStream(const std::shar
       throw StreamReadException("Reading flow file inputstream failed!");
     }
     if (read_ret > 0) {
-      data_stream->write(reinterpret_cast<char*>(buffer.data()), gsl::narrow<std::streamsize>(read_ret));
+      data_stream.write(reinterpret_cast<char*>(buffer.data()), gsl::narrow<std::streamsize>(read_ret));
       read_size += read_ret;
     } else {
       break;
     }
   }
-  read_size_out = read_size;
-  return data_stream;
+  return read_size;
 }
 
 std::optional<PutObjectResult> S3Wrapper::putObject(const PutObjectRequestParameters& put_object_params, const std::shared_ptr<io::InputStream>& stream, uint64_t flow_size) {
@@ -103,11 +111,10 @@ std::optional<PutObjectResult> S3Wrapper::putObject(const PutObjectRequestParame
 }
 
 std::optional<S3Wrapper::UploadPartsResult> S3Wrapper::uploadParts(const PutObjectRequestParameters& put_object_params, const std::shared_ptr<io::InputStream>& stream,
-    MultipartUploadState upload_state) {
+    MultipartUploadState upload_state, size_t max_parallel_parts) {
   stream->seek(upload_state.uploaded_size);
   S3Wrapper::UploadPartsResult result;
   result.upload_id = upload_state.upload_id;
-  result.part_etags = upload_state.uploaded_etags;
   const auto flow_size = upload_state.full_size - upload_state.uploaded_size;
   if (upload_state.part_size == 0) {
     logger_->log_error("Invalid upload part size 0 was set for S3 object with key '{}' in bucket '{}'", put_object_params.object_key, put_object_params.bucket);
@@ -117,41 +124,159 @@ std::optional<S3Wrapper::UploadPartsResult> S3Wrapper::uploadParts(const PutObje
   size_t total_read = 0;
   const size_t start_part = upload_state.uploaded_parts + 1;
   const size_t last_part = start_part + part_count - 1;
-  for (size_t part_number = start_part; part_number <= last_part; ++part_number) {
-    uint64_t read_size{};
-    const auto remaining = flow_size - total_read;
-    const auto next_read_size = std::min(remaining, upload_state.part_size);
-    auto stream_ptr = readFlowFileStream(stream, next_read_size, read_size);
-    total_read += read_size;
-
-    auto upload_part_request = Aws::S3::Model::UploadPartRequest{}
-      .WithBucket(put_object_params.bucket)
-      .WithKey(put_object_params.object_key)
-      .WithPartNumber(gsl::narrow<int>(part_number))
-      .WithUploadId(upload_state.upload_id)
-      .WithChecksumAlgorithm(put_object_params.checksum_algorithm);
-    upload_part_request.SetBody(stream_ptr);
-
-    Aws::Utils::ByteBuffer part_md5(Aws::Utils::HashingUtils::CalculateMD5(*stream_ptr));
-    upload_part_request.SetContentMD5(Aws::Utils::HashingUtils::Base64Encode(part_md5));
-
-    auto upload_part_result = request_sender_->sendUploadPartRequest(upload_part_request, put_object_params.credentials, put_object_params.client_config, put_object_params.use_virtual_addressing);
-    if (!upload_part_result) {
-      logger_->log_error("Failed to upload part {} of {} of S3 object with key '{}'", part_number, last_part, put_object_params.object_key);
-      return std::nullopt;
+
+  struct CompletedPart {
+    std::optional<std::string> etag;
+    uint64_t size = 0;
+  };
+  struct QueuedPart {
+    size_t part_number = 0;
+    uint64_t size = 0;
+    std::shared_ptr<Aws::StringStream> body;
+  };
+  // parts are read sequentially into a fixed set of recycled buffers, uploaded in parallel by a fixed set of workers,
+  // and they may complete in any order
+  const size_t worker_count = std::max(size_t{1}, std::min(max_parallel_parts, part_count));
+  std::mutex mutex;
+  std::condition_variable part_queued;
+  std::condition_variable part_completed;
+  std::deque<QueuedPart> queued_parts;
+  std::vector<std::shared_ptr<Aws::StringStream>> free_buffers;
+  std::map<size_t, CompletedPart> newly_completed_parts;
+  std::map<size_t, CompletedPart> completed_parts;
+  bool stopping = false;
+
+  std::vector<std::thread> workers;
+  const auto stop_workers = gsl::finally([&] {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+      queued_parts.clear();
     }
-    result.part_etags.push_back(upload_part_result->GetETag());
-    upload_state.uploaded_etags.push_back(upload_part_result->GetETag());
-    upload_state.uploaded_parts += 1;
-    upload_state.uploaded_size += read_size;
-    multipart_upload_storage_->storeState(put_object_params.bucket, put_object_params.object_key, upload_state);
-    logger_->log_info("Uploaded part {} of {} S3 object with key '{}'", part_number, last_part, put_object_params.object_key);
+    part_queued.notify_all();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  });
+  for (size_t i = 0; i < worker_count; ++i) {
+    workers.emplace_back([&] {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true) {
+        part_queued.wait(lock, [&] { return stopping || !queued_parts.empty(); });
+        if (queued_parts.empty()) {
+          return;
+        }
+        auto part = std::move(queued_parts.front());
+        queued_parts.pop_front();
+        lock.unlock();
+        CompletedPart completed_part{.etag = std::nullopt, .size = part.size};
+        try {
+          completed_part.etag = uploadPart(put_object_params, upload_state.upload_id, part.part_number, part.body);
+        } catch (const std::exception& ex) {
+          logger_->log_error("Exception while uploading part {} of S3 object with key '{}': {}", part.part_number, put_object_params.object_key, ex.what());
+        }
+        lock.lock();
+        // the buffer of the part is released as soon as its upload finishes, so that the next part can be read into it
+        free_buffers.push_back(std::move(part.body));
+        newly_completed_parts.emplace(part.part_number, std::move(completed_part));
+        part_completed.notify_one();
+      }
+    });
   }
 
+  size_t next_part_number = start_part;
+  size_t parts_in_flight = 0;
+  bool failed = false;
+  // no new parts are started after a failure, but the ones in flight are waited for
+  while ((!failed && next_part_number <= last_part) || parts_in_flight > 0) {
+    if (!failed && next_part_number <= last_part && parts_in_flight < worker_count) {
+      std::shared_ptr<Aws::StringStream> body;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!free_buffers.empty()) {
+          body = std::move(free_buffers.back());
+          free_buffers.pop_back();
+        }
+      }
+      if (body) {
+        body->str("");
+        body->clear();
+      } else {
+        body = std::make_shared<Aws::StringStream>();
+      }
+      const auto remaining = flow_size - total_read;
+      const auto read_size = readFlowFileStream(stream, std::min(remaining, upload_state.part_size), *body);
+      total_read += read_size;
+
+      ++parts_in_flight;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued_parts.push_back(QueuedPart{.part_number = next_part_number++, .size = read_size, .body = std::move(body)});
+      }
+      part_queued.notify_one();
+      continue;
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      part_completed.wait(lock, [&] { return !newly_completed_parts.empty(); });
+      parts_in_flight -= newly_completed_parts.size();
+      completed_parts.merge(newly_completed_parts);
+    }
+
+    // only the uninterrupted sequence of uploaded parts is stored, the parts after a gap are uploaded again when the upload is continued
+    const auto stored_parts = upload_state.uploaded_parts;
+    for (auto it = completed_parts.begin(); it != completed_parts.end() && it->first == upload_state.uploaded_parts + 1;) {
+      if (!it->second.etag) {
+        break;
+      }
+      upload_state.uploaded_etags.push_back(*it->second.etag);
+      upload_state.uploaded_parts += 1;
+      upload_state.uploaded_size += it->second.size;
+      logger_->log_info("Uploaded part {} of {} S3 object with key '{}'", it->first, last_part, put_object_params.object_key);
+      it = completed_parts.erase(it);
+    }
+    if (upload_state.uploaded_parts != stored_parts) {
+      multipart_upload_storage_->storeState(put_object_params.bucket, put_object_params.object_key, upload_state);
+    }
+
+    for (const auto& [part_number, completed_part] : completed_parts) {
+      if (!completed_part.etag && !failed) {
+        logger_->log_error("Failed to upload part {} of {} of S3 object with key '{}'", part_number, last_part, put_object_params.object_key);
+        failed = true;
+      }
+    }
+  }
+
+  if (failed) {
+    return std::nullopt;
+  }
+
+  result.part_etags = upload_state.uploaded_etags;
   multipart_upload_storage_->removeState(put_object_params.bucket, put_object_params.object_key);
   return result;
 }
 
+std::optional<std::string> S3Wrapper::uploadPart(const PutObjectRequestParameters& put_object_params, const std::string& upload_id, size_t part_number,
+    const std::shared_ptr<Aws::StringStream>& part_body) {
+  auto upload_part_request = Aws::S3::Model::UploadPartRequest{}
+    .WithBucket(put_object_params.bucket)
+    .WithKey(put_object_params.object_key)
+    .WithPartNumber(gsl::narrow<int>(part_number))
+    .WithUploadId(upload_id)
+    .WithChecksumAlgorithm(put_object_params.checksum_algorithm);
+  upload_part_request.SetBody(part_body);
+
+  Aws::Utils::ByteBuffer part_md5(Aws::Utils::HashingUtils::CalculateMD5(*part_body));
+  upload_part_request.SetContentMD5(Aws::Utils::HashingUtils::Base64Encode(part_md5));
+
+  auto upload_part_result = request_sender_->sendUploadPartRequest(upload_part_request, put_object_params.credentials, put_object_params.client_config, put_object_params.use_virtual_addressing);
+  if (!upload_part_result) {
+    return std::nullopt;
+  }
+  return upload_part_result->GetETag();
+}
+
 std::optional<Aws::S3::Model::CompleteMultipartUploadResult> S3Wrapper::completeMultipartUpload(const PutObjectRequestParameters& put_object_params,
     const S3Wrapper::UploadPartsResult& upload_parts_result) {
   auto complete_multipart_upload_request = Aws::S3::Model::CompleteMultipartUploadRequest{}
@@ -198,11 +323,11 @@ std::optional<MultipartUploadState> S3Wrapper::getMultipartUploadState(const Put
 }
 
 std::optional<PutObjectResult> S3Wrapper::putObjectMultipart(const PutObjectRequestParameters& put_object_params, const std::shared_ptr<io::InputStream>& stream,
-    uint64_t flow_size, uint64_t multipart_size) {
-  gsl_Expects(multipart_upload_storage_);
+    uint64_t flow_size, uint64_t multipart_size, size_t max_parallel_parts) {
+  gsl_Expects(multipart_upload_storage_ && max_parallel_parts > 0);
   if (auto upload_state = getMultipartUploadState(put_object_params)) {
     logger_->log_info("Found previous multipart upload state for {} in bucket {}, continuing upload", put_object_params.object_key, put_object_params.bucket);
-    return uploadParts(put_object_params, stream, std::move(*upload_state))
+    return uploadParts(put_object_params, stream, std::move(*upload_state), max_parallel_parts)
       | minifi::utils::andThen([&, this](const auto& upload_parts_result) { return completeMultipartUpload(put_object_params, upload_parts_result); })
       | minifi::utils::transform([this](const auto& complete_multipart_upload_result) { return createPutObjectResult(complete_multipart_upload_result); });
   } else {
@@ -210,7 +335,7 @@ std::optional<PutObjectResult> S3Wrapper::putObjectMultipart(const PutObjectRequ
     auto request = createPutObjectRequest<Aws::S3::Model::CreateMultipartUploadRequest>(put_object_params);
     return request_sender_->sendCreateMultipartUploadRequest(request, put_object_params.credentials, put_object_params.client_config, put_object_params.use_virtual_addressing)
       | minifi::utils::andThen([&, this](const auto& create_multipart_result) { return uploadParts(put_object_params, stream,
-          MultipartUploadState{create_multipart_result.GetUploadId(), multipart_size, flow_size, Aws::Utils::DateTime::Now()}); })
+          MultipartUploadState{create_multipart_result.GetUploadId(), multipart_size, flow_size, Aws::Utils::DateTime::Now()}, max_parallel_parts); })
       | minifi::utils::andThen([&, this](const auto& upload_parts_result) { return completeMultipartUpload(put_object_params, upload_parts_result); })
       | minifi::utils::transform([this](const auto& complete_multipart_upload_result) { return createPutObjectResult(complete_multipart_upload_result); });
   }
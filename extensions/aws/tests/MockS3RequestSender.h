@@ -19,7 +19,9 @@
 #pragma once
 
 #include <map>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <string>
 #include <sstream>
 #include <utility>
@@ -264,11 +266,19 @@ class MockS3RequestSender : public minifi::aws::s3::S3RequestSender {
       const Aws::Auth::AWSCredentials& credentials,
       const Aws::Client::ClientConfiguration& client_config,
       bool use_virtual_addressing) override {
+    std::lock_guard<std::mutex> lock(upload_part_mutex_);
     if (etag_counter_ == fail_on_part_) {
       fail_on_part_ = 0;
       return std::nullopt;
     }
-    upload_part_requests.push_back(request);
+    // the uploader reuses the body streams for the later parts, so the stored request gets a copy of the body
+    upload_part_body_streams.insert(request.GetBody().get());
+    auto stored_request = request;
+    const auto body_position = request.GetBody()->tellg();
+    stored_request.SetBody(std::make_shared<Aws::StringStream>(getUploadPartRequestBody(request)));
+    request.GetBody()->clear();
+    request.GetBody()->seekg(body_position);
+    upload_part_requests.push_back(std::move(stored_request));
     credentials_ = credentials;
     client_config_ = client_config;
     use_virtual_addressing_ = use_virtual_addressing;
@@ -391,6 +401,7 @@ class MockS3RequestSender : public minifi::aws::s3::S3RequestSender {
   Aws::S3::Model::HeadObjectRequest head_object_request;
   Aws::S3::Model::CreateMultipartUploadRequest create_multipart_upload_request;
   std::vector<Aws::S3::Model::UploadPartRequest> upload_part_requests;
+  std::set<const Aws::IOStream*> upload_part_body_streams;
   Aws::S3::Model::CompleteMultipartUploadRequest complete_multipart_upload_request;
   Aws::S3::Model::ListMultipartUploadsRequest list_multipart_upload_request;
   std::vector<Aws::S3::Model::AbortMultipartUploadRequest> abort_multipart_upload_requests;
@@ -406,4 +417,5 @@ class MockS3RequestSender : public minifi::aws::s3::S3RequestSender {
   bool use_virtual_addressing_ = true;
   uint32_t etag_counter_ = 1;
   uint32_t fail_on_part_ = 0;
+  std::mutex upload_part_mutex_;
 };
@@ -16,6 +16,10 @@
  * limitations under the License.
  */
 
+#include <map>
+#include <set>
+#include <string>
+
 #include "S3TestsFixture.h"
 #include "processors/PutS3Object.h"
 #include "unit/TestUtils.h"
@@ -404,6 +408,92 @@ TEST_CASE_METHOD(PutS3ObjectUploadLimitChangedTestsFixture, "Local state is not
   }
 }
 
+TEST_CASE_METHOD(PutS3ObjectUploadLimitChangedTestsFixture, "Test multipart upload with parallel parts", "[awsS3MultipartUpload]") {
+  setRequiredProperties();
+  plan->setProperty(s3_processor, "Multipart Threshold", "35 B");
+  plan->setProperty(s3_processor, "Multipart Part Size", "10 B");
+  plan->setProperty(s3_processor, "Multipart Upload Max Parallel Parts", "4");
+  auto temp_dir = test_controller.createTempDirectory();
+  plan->setProperty(s3_processor, "Temporary Directory Multipart State", temp_dir.string());
+  test_controller.runSession(plan);
+
+  CHECK(verifyLogLinePresenceInPollTime(std::chrono::seconds(3), "key:s3.etag value:" + S3_ETAG_UNQUOTED));
+  std::map<int, std::string> part_bodies;
+  for (const auto& upload_part_request : mock_s3_request_sender_ptr->upload_part_requests) {
+    CHECK(upload_part_request.GetUploadId() == S3_UPLOAD_ID);
+    part_bodies.emplace(upload_part_request.GetPartNumber(), mock_s3_request_sender_ptr->getUploadPartRequestBody(upload_part_request));
+  }
+  REQUIRE(part_bodies.size() == 4);
+  CHECK(part_bodies.at(1) == INPUT_DATA.substr(0, 10));
+  CHECK(part_bodies.at(2) == INPUT_DATA.substr(10, 10));
+  CHECK(part_bodies.at(3) == INPUT_DATA.substr(20, 10));
+  CHECK(part_bodies.at(4) == INPUT_DATA.substr(30));
+
+  // the parts may be uploaded in any order, but they are completed in the order of their part numbers
+  const auto& parts = mock_s3_request_sender_ptr->complete_multipart_upload_request.GetMultipartUpload().GetParts();
+  REQUIRE(parts.size() == 4);
+  std::set<std::string> etags;
+  for (size_t i = 0; i < parts.size(); ++i) {
+    CHECK(parts[i].GetPartNumber() == static_cast<int>(i + 1));
+    etags.insert(parts[i].GetETag());
+  }
+  CHECK(etags == std::set<std::string>{"etag1", "etag2", "etag3", "etag4"});
+}
+
+TEST_CASE_METHOD(PutS3ObjectUploadLimitChangedTestsFixture, "Parallel parts are read into a bounded set of reused buffers", "[awsS3MultipartUpload]") {
+  setRequiredProperties();
+  plan->setProperty(s3_processor, "Multipart Threshold", "35 B");
+  plan->setProperty(s3_processor, "Multipart Part Size", "10 B");
+  plan->setProperty(s3_processor, "Multipart Upload Max Parallel Parts", "2");
+  auto temp_dir = test_controller.createTempDirectory();
+  plan->setProperty(s3_processor, "Temporary Directory Multipart State", temp_dir.string());
+  test_controller.runSession(plan);
+
+  CHECK(verifyLogLinePresenceInPollTime(std::chrono::seconds(3), "key:s3.etag value:" + S3_ETAG_UNQUOTED));
+  CHECK(mock_s3_request_sender_ptr->upload_part_requests.size() == 4);
+  CHECK(mock_s3_request_sender_ptr->upload_part_body_streams.size() <= 2);
+}
+
+TEST_CASE_METHOD(PutS3ObjectUploadLimitChangedTestsFixture, "Failed parallel part stops the multipart upload before the remaining parts are submitted", "[awsS3MultipartUpload]") {
+  setRequiredProperties();
+  plan->setProperty(s3_processor, "Multipart Threshold", "35 B");
+  plan->setProperty(s3_processor, "Multipart Part Size", "10 B");
+  plan->setProperty(s3_processor, "Multipart Upload Max Parallel Parts", "2");
+  plan->setProperty(s3_processor, "Object Key", "resumable_key");
+  auto temp_dir = test_controller.createTempDirectory();
+  plan->setProperty(s3_processor, "Temporary Directory Multipart State", temp_dir.string());
+  auto log_failure = plan->addProcessor(
+    "LogAttribute",
+    "LogFailure",
+    core::Relationship("failure", "d"));
+  plan->addConnection(s3_processor, core::Relationship("failure", "d"), log_failure);
+  log_failure->setAutoTerminatedRelationships(std::array{core::Relationship("success", "d")});
+
+  // one of the first two parts fails while parts 3 and 4 are not submitted yet
+  mock_s3_request_sender_ptr->failOnPartOnce(1);
+  test_controller.runSession(plan);
+  CHECK(verifyLogLinePresenceInPollTime(std::chrono::seconds(3), "Failed to upload part"));
+  CHECK(mock_s3_request_sender_ptr->upload_part_requests.size() < 4);
+  CHECK(mock_s3_request_sender_ptr->complete_multipart_upload_request.GetMultipartUpload().GetParts().empty());
+
+  plan->reset();
+  LogTestController::getInstance().clear();
+  test_controller.runSession(plan);
+
+  CHECK(verifyLogLinePresenceInPollTime(std::chrono::seconds(3), "key:s3.etag value:" + S3_ETAG_UNQUOTED));
+  const auto& parts = mock_s3_request_sender_ptr->complete_multipart_upload_request.GetMultipartUpload().GetParts();
+  REQUIRE(parts.size() == 4);
+  for (size_t i = 0; i < parts.size(); ++i) {
+    CHECK(parts[i].GetPartNumber() == static_cast<int>(i + 1));
+  }
+}
+
+TEST_CASE_METHOD(PutS3ObjectTestsFixture, "Multipart Upload Max Parallel Parts must be positive", "[awsS3MultipartUpload]") {
+  setRequiredProperties();
+  plan->setProperty(s3_processor, "Multipart Upload Max Parallel Parts", "0");
+  REQUIRE_THROWS_AS(test_controller.runSession(plan), minifi::Exception);
+}
+
 TEST_CASE_METHOD(PutS3ObjectUploadLimitChangedTestsFixture, "Do not continue multipart upload that only exists in local cache but not in S3", "[awsS3MultipartUpload]") {
   setRequiredProperties();
   plan->setProperty(s3_processor, "Multipart Threshold", "35 B");
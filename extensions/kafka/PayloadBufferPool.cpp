@@ -0,0 +1,72 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "PayloadBufferPool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace org::apache::nifi::minifi::utils {
+
+std::shared_ptr<PayloadBufferPool::Buffer> PayloadBufferPool::acquire(const size_t min_size) {
+  std::unique_ptr<Buffer> buffer;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto big_enough = std::find_if(free_buffers_.rbegin(), free_buffers_.rend(), [min_size](const auto& free_buffer) { return free_buffer->size() >= min_size; });
+    if (big_enough != free_buffers_.rend()) {
+      buffer = std::move(*big_enough);
+      free_buffers_.erase(std::next(big_enough).base());
+    } else if (!free_buffers_.empty()) {
+      buffer = std::move(free_buffers_.back());
+      free_buffers_.pop_back();
+    }
+    if (buffer) {
+      pooled_bytes_ -= buffer->capacity();
+    }
+  }
+  if (!buffer) {
+    buffer = std::make_unique<Buffer>(min_size);
+  } else if (buffer->size() < min_size) {
+    buffer->resize(min_size);
+  }
+  return {buffer.release(), [weak_pool = weak_from_this()](Buffer* released_buffer) {
+    std::unique_ptr<Buffer> owned_buffer{released_buffer};
+    if (const auto pool = weak_pool.lock()) {
+      pool->release(std::move(owned_buffer));
+    }
+  }};
+}
+
+size_t PayloadBufferPool::pooledBufferCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return free_buffers_.size();
+}
+
+size_t PayloadBufferPool::pooledByteCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pooled_bytes_;
+}
+
+void PayloadBufferPool::release(std::unique_ptr<Buffer> buffer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto buffer_bytes = buffer->capacity();
+  if (free_buffers_.size() < max_pooled_buffers_ && buffer_bytes <= max_pooled_bytes_ - pooled_bytes_) {
+    pooled_bytes_ += buffer_bytes;
+    free_buffers_.push_back(std::move(buffer));
+  }
+}
+
+}  // namespace org::apache::nifi::minifi::utils
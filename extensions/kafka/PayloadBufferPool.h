@@ -0,0 +1,56 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace org::apache::nifi::minifi::utils {
+
+/**
+ * Recycles the buffers which hold the payloads of the messages handed over to librdkafka without copying.
+ * A buffer is returned to the pool when the last reference to it is released, which is normally done by the
+ * delivery report callback of the message. The pool must be owned by a shared_ptr, but the buffers can outlive it.
+ * A released buffer is dropped instead of pooled if it would exceed either the buffer count or the total byte limit.
+ */
+class PayloadBufferPool : public std::enable_shared_from_this<PayloadBufferPool> {
+ public:
+  using Buffer = std::vector<std::byte>;
+
+  PayloadBufferPool(size_t max_pooled_buffers, size_t max_pooled_bytes)
+      : max_pooled_buffers_(max_pooled_buffers),
+        max_pooled_bytes_(max_pooled_bytes) {}
+
+  // Returns a buffer with a size of at least min_size bytes
+  std::shared_ptr<Buffer> acquire(size_t min_size);
+
+  [[nodiscard]] size_t pooledBufferCount() const;
+  [[nodiscard]] size_t pooledByteCount() const;
+
+ private:
+  void release(std::unique_ptr<Buffer> buffer);
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<Buffer>> free_buffers_;
+  size_t pooled_bytes_ = 0;
+  const size_t max_pooled_buffers_;
+  const size_t max_pooled_bytes_;
+};
+
+}  // namespace org::apache::nifi::minifi::utils
@@ -18,6 +18,7 @@
 
 #include <map>
 #include <set>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -175,11 +176,15 @@ class ReadCallback {
     return result;
   }
 
-  rd_kafka_resp_err_t produce(const size_t segment_num, std::vector<std::byte>& buffer, const size_t buflen) const {
+  // A pooled payload buffer is not copied by librdkafka, it is kept alive by the delivery callback instead
+  rd_kafka_resp_err_t produce(const size_t segment_num, const std::span<std::byte> payload,
+      std::shared_ptr<utils::PayloadBufferPool::Buffer> pooled_payload_buffer) const {
     const std::shared_ptr<PublishKafka::Messages> messages_ptr_copy = this->messages_;
     const auto flow_file_index_copy = this->flow_file_index_;
     const auto logger = logger_;
-    const auto produce_callback = [messages_ptr_copy, flow_file_index_copy, segment_num, logger](rd_kafka_t* /*rk*/,
+    const int message_flags = pooled_payload_buffer ? 0 : RD_KAFKA_MSG_F_COPY;
+    const auto produce_callback = [messages_ptr_copy, flow_file_index_copy, segment_num, logger,
+                                      pooled_payload_buffer = std::move(pooled_payload_buffer)](rd_kafka_t* /*rk*/,
                                       const rd_kafka_message_t* rkmessage) {
       messages_ptr_copy->modifyResult(flow_file_index_copy,
           [segment_num, rkmessage, logger, flow_file_index_copy](FlowFileResult& flow_file) {
@@ -206,8 +211,8 @@ class ReadCallback {
     const auto err = rd_kafka_producev(rk_,
         RD_KAFKA_V_RKT(rkt_),
         RD_KAFKA_V_PARTITION(RD_KAFKA_PARTITION_UA),
-        RD_KAFKA_V_MSGFLAGS(RD_KAFKA_MSG_F_COPY),
-        RD_KAFKA_V_VALUE(buffer.data(), buflen),
+        RD_KAFKA_V_MSGFLAGS(message_flags),
+        RD_KAFKA_V_VALUE(payload.data(), payload.size()),
         RD_KAFKA_V_HEADERS(hdrs_copy.get()),
         RD_KAFKA_V_KEY(key_.c_str(), key_.size()),
         RD_KAFKA_V_OPAQUE(callback_ptr.get()),
@@ -230,7 +235,7 @@ class ReadCallback {
   ReadCallback(const uint64_t max_seg_size, std::string key, rd_kafka_topic_t* const rkt, rd_kafka_t* const rk,
       const core::FlowFile& flowFile, const std::optional<utils::Regex>& attributeNameRegex,
       std::shared_ptr<PublishKafka::Messages> messages, const size_t flow_file_index, const bool fail_empty_flow_files,
-      std::shared_ptr<core::logging::Logger> logger)
+      std::shared_ptr<utils::PayloadBufferPool> payload_buffer_pool, std::shared_ptr<core::logging::Logger> logger)
       : flow_size_(flowFile.getSize()),
         max_seg_size_(max_seg_size == 0 || flow_size_ < max_seg_size ? flow_size_ : max_seg_size),
         key_(std::move(key)),
@@ -240,6 +245,7 @@ class ReadCallback {
         messages_(std::move(messages)),
         flow_file_index_(flow_file_index),
         fail_empty_flow_files_(fail_empty_flow_files),
+        payload_buffer_pool_(std::move(payload_buffer_pool)),
         logger_(std::move(logger)) {}
 
   ReadCallback(ReadCallback&&) = delete;
@@ -250,8 +256,9 @@ class ReadCallback {
 
   int64_t operator()(const std::shared_ptr<io::InputStream>& stream) {
     std::vector<std::byte> buffer;
-
-    buffer.resize(max_seg_size_);
+    if (!payload_buffer_pool_) {
+      buffer.resize(max_seg_size_);
+    }
     read_size_ = 0;
     status_ = 0;
     called_ = true;
@@ -264,7 +271,7 @@ class ReadCallback {
 
     // If the flow file is empty, we still want to send the message, unless the user wants to fail_empty_flow_files_
     if (flow_size_ == 0 && !fail_empty_flow_files_) {
-      const auto err = produce(0, buffer, 0);
+      const auto err = produce(0, {}, nullptr);
       if (err != RD_KAFKA_RESP_ERR_NO_ERROR) {
         status_ = -1;
         error_ = rd_kafka_err2str(err);
@@ -273,7 +280,13 @@ class ReadCallback {
     }
 
     for (size_t segment_num = 0; read_size_ < flow_size_; ++segment_num) {
-      const auto readRet = stream->read(buffer);
+      std::shared_ptr<utils::PayloadBufferPool::Buffer> pooled_buffer;
+      std::span<std::byte> read_buffer = buffer;
+      if (payload_buffer_pool_) {
+        pooled_buffer = payload_buffer_pool_->acquire(max_seg_size_);
+        read_buffer = std::span<std::byte>(*pooled_buffer).first(max_seg_size_);
+      }
+      const auto readRet = stream->read(read_buffer);
       if (io::isError(readRet)) {
         status_ = -1;
         error_ = "Failed to read from stream";
@@ -281,7 +294,7 @@ class ReadCallback {
       }
       if (readRet == 0) { break; }
 
-      if (const auto err = produce(segment_num, buffer, readRet)) {
+      if (const auto err = produce(segment_num, read_buffer.first(readRet), std::move(pooled_buffer))) {
         messages_->modifyResult(flow_file_index_, [segment_num, err](FlowFileResult& flow_file) {
           auto& [status, err_code] = flow_file.messages.at(segment_num);
           status = MessageStatus::Error;
@@ -309,6 +322,7 @@ class ReadCallback {
   uint32_t read_size_ = 0;
   bool called_ = false;
   const bool fail_empty_flow_files_ = true;
+  const std::shared_ptr<utils::PayloadBufferPool> payload_buffer_pool_;
   const std::shared_ptr<core::logging::Logger> logger_;
 };
 
@@ -351,6 +365,14 @@ void PublishKafka::onSchedule(core::ProcessContext& context, core::ProcessSessio
   max_flow_seg_size_ = utils::parseDataSizeProperty(context, MaxFlowSegSize);
   logger_->log_debug("PublishKafka: Max Flow Segment Size [{}]", max_flow_seg_size_);
 
+  // Zero Copy Produce
+  if (utils::parseBoolProperty(context, ZeroCopyProduce)) {
+    payload_buffer_pool_ = std::make_shared<utils::PayloadBufferPool>(MAX_POOLED_PAYLOAD_BUFFERS, MAX_POOLED_PAYLOAD_BYTES);
+  } else {
+    payload_buffer_pool_.reset();
+  }
+  logger_->log_debug("PublishKafka: Zero Copy Produce [{}]", payload_buffer_pool_ != nullptr);
+
   // Attributes to Send as Headers
   attributeNameRegex_ = context.getProperty(AttributeNameRegex)
     | utils::transform([](auto pattern_str) { return utils::Regex{std::move(pattern_str)}; })
@@ -698,6 +720,7 @@ void PublishKafka::onTrigger(core::ProcessContext& context, core::ProcessSession
         messages,
         flow_file_index,
         failEmptyFlowFiles,
+        payload_buffer_pool_,
         logger_);
     session.read(flowFile, std::ref(callback));
 
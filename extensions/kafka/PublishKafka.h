@@ -29,6 +29,7 @@
 
 #include "KafkaConnection.h"
 #include "KafkaProcessorBase.h"
+#include "PayloadBufferPool.h"
 #include "minifi-cpp/controllers/SSLContextServiceInterface.h"
 #include "core/Core.h"
 #include "minifi-cpp/core/FlowFile.h"
@@ -39,6 +40,7 @@
 #include "minifi-cpp/core/logging/Logger.h"
 #include "core/logging/LoggerFactory.h"
 #include "minifi-cpp/core/PropertyValidator.h"
+#include "minifi-cpp/utils/Literals.h"
 #include "rdkafka.h"
 #include "utils/ArrayUtils.h"
 #include "utils/RegexUtils.h"
@@ -226,11 +228,23 @@ class PublishKafka final : public KafkaProcessorBase {
           .withValidator(core::StandardPropertyValidators::BOOLEAN_VALIDATOR)
           .withDefaultValue("true")
           .build();
+  EXTENSIONAPI static constexpr auto ZeroCopyProduce =
+      core::PropertyDefinitionBuilder<>::createProperty("Zero Copy Produce")
+          .withDescription(
+              "If true, the message payloads are read from the flow file content into pooled buffers, "
+              "which are handed to librdkafka without copying them again, and are returned to the pool "
+              "when the delivery of the message is reported. The buffers of the undelivered messages "
+              "are not freed until their delivery reports arrive.")
+          .isRequired(true)
+          .withValidator(core::StandardPropertyValidators::BOOLEAN_VALIDATOR)
+          .withDefaultValue("false")
+          .build();
   EXTENSIONAPI static constexpr auto Properties = utils::array_cat(KafkaProcessorBase::Properties,
       std::to_array<core::PropertyReference>({SeedBrokers, Topic, DeliveryGuarantee, MaxMessageSize, RequestTimeOut,
           MessageTimeOut, ClientName, BatchSize, TargetBatchPayloadSize, AttributeNameRegex, QueueBufferMaxTime,
           QueueBufferMaxSize, QueueBufferMaxMessage, CompressCodec, MaxFlowSegSize, SecurityCA, SecurityCert,
-          SecurityPrivateKey, SecurityPrivateKeyPassWord, KafkaKey, MessageKeyField, DebugContexts, FailEmptyFlowFiles}));
+          SecurityPrivateKey, SecurityPrivateKeyPassWord, KafkaKey, MessageKeyField, DebugContexts, FailEmptyFlowFiles,
+          ZeroCopyProduce}));
 
   EXTENSIONAPI static constexpr auto Success = core::RelationshipDefinition{"success",
       "Any FlowFile that is successfully sent to Kafka will be routed to "
@@ -269,6 +283,9 @@ class PublishKafka final : public KafkaProcessorBase {
   std::optional<utils::net::SslData> getSslData(core::ProcessContext& context) const override;
 
  private:
+  static constexpr size_t MAX_POOLED_PAYLOAD_BUFFERS = 64;
+  static constexpr size_t MAX_POOLED_PAYLOAD_BYTES = 32_MiB;
+
   KafkaConnectionKey key_;
   std::unique_ptr<KafkaConnection> conn_;
   std::mutex connection_mutex_;
@@ -277,6 +294,7 @@ class PublishKafka final : public KafkaProcessorBase {
   uint64_t target_batch_payload_size_{};
   uint64_t max_flow_seg_size_{};
   std::optional<utils::Regex> attributeNameRegex_;
+  std::shared_ptr<utils::PayloadBufferPool> payload_buffer_pool_;
 
   std::atomic<bool> interrupted_{false};
   std::mutex messages_mutex_;  // If both connection_mutex_ and messages_mutex_ are needed, always take connection_mutex_
@@ -68,4 +68,62 @@ TEST_CASE("Compress Codec property") {
   }
 }
 
+TEST_CASE("Zero Copy Produce publishes the flow file contents from pooled buffers", "[testPublishKafka]") {
+  using processors::PublishKafka;
+  SingleProcessorTestController test_controller(minifi::test::utils::make_processor<PublishKafka>("PublishKafka"));
+  const auto publish_kafka = test_controller.getProcessor();
+  REQUIRE(publish_kafka->setProperty(PublishKafka::ClientName.name, "test_client"));
+  REQUIRE(publish_kafka->setProperty(PublishKafka::SeedBrokers.name, "test_seedbroker"));
+  REQUIRE(publish_kafka->setProperty(PublishKafka::Topic.name, "test_topic"));
+  REQUIRE(publish_kafka->setProperty(PublishKafka::MaxFlowSegSize.name, "4 B"));
+  REQUIRE(publish_kafka->setProperty(PublishKafka::ZeroCopyProduce.name, "true"));
+  // the brokers of librdkafka's built-in mock cluster replace the seed brokers
+  REQUIRE(publish_kafka->setDynamicProperty("test.mock.num.brokers", "1"));
+
+  const auto result = test_controller.trigger({{.content = "first flow file"}, {.content = "second"}, {.content = ""}});
+  CHECK(result.at(PublishKafka::Success).size() == 2);
+  CHECK(result.at(PublishKafka::Failure).size() == 1);  // empty flow files are failed by default
+}
+
+TEST_CASE("PayloadBufferPool reuses the released buffers", "[testPublishKafka]") {
+  auto pool = std::make_shared<minifi::utils::PayloadBufferPool>(1, 1024);
+  auto first = pool->acquire(10);
+  auto second = pool->acquire(20);
+  CHECK(first->size() == 10);
+  CHECK(second->size() == 20);
+  const auto* const first_data = first->data();
+  first.reset();
+  second.reset();
+  CHECK(pool->pooledBufferCount() == 1);
+
+  auto reused = pool->acquire(5);
+  CHECK(reused->data() == first_data);
+  CHECK(pool->pooledBufferCount() == 0);
+
+  SECTION("A buffer can outlive the pool") {
+    std::weak_ptr<minifi::utils::PayloadBufferPool> weak_pool = pool;
+    pool.reset();
+    CHECK(weak_pool.expired());
+    reused.reset();
+  }
+}
+
+TEST_CASE("PayloadBufferPool limits the total size of the pooled buffers", "[testPublishKafka]") {
+  auto pool = std::make_shared<minifi::utils::PayloadBufferPool>(4, 25);
+  auto first = pool->acquire(10);
+  auto second = pool->acquire(20);
+  auto too_big = pool->acquire(30);
+  const auto* const first_data = first->data();
+  first.reset();
+  second.reset();
+  too_big.reset();
+  CHECK(pool->pooledBufferCount() == 1);
+  CHECK(pool->pooledByteCount() == 10);
+
+  auto reused = pool->acquire(10);
+  CHECK(reused->data() == first_data);
+  CHECK(pool->pooledBufferCount() == 0);
+  CHECK(pool->pooledByteCount() == 0);
+}
+
 }  // namespace org::apache::nifi::minifi::test
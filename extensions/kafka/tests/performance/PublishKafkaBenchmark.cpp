@@ -0,0 +1,100 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "minifi-cpp/utils/gsl.h"
+#include "minifi-cpp/utils/Literals.h"
+#include "PayloadBufferPool.h"
+#include "rdkafka.h"
+#include "rdkafka_utils.h"
+
+namespace minifi = org::apache::nifi::minifi;
+
+namespace {
+
+constexpr size_t MESSAGES_PER_ITERATION = 256;
+
+// the opaque of the zero copy messages keeps their pooled payload buffer alive until the delivery is reported
+void deliveryCallback(rd_kafka_t* /*rk*/, const rd_kafka_message_t* rkmessage, void* /*opaque*/) {
+  delete static_cast<std::shared_ptr<minifi::utils::PayloadBufferPool::Buffer>*>(rkmessage->_private);  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+minifi::utils::rd_kafka_producer_unique_ptr createMockClusterProducer() {
+  std::array<char, 512U> err_chars{};
+  minifi::utils::rd_kafka_conf_unique_ptr conf{rd_kafka_conf_new()};
+  if (rd_kafka_conf_set(conf.get(), "test.mock.num.brokers", "1", err_chars.data(), err_chars.size()) != RD_KAFKA_CONF_OK
+      || rd_kafka_conf_set(conf.get(), "linger.ms", "5", err_chars.data(), err_chars.size()) != RD_KAFKA_CONF_OK) {
+    throw std::runtime_error(err_chars.data());
+  }
+  rd_kafka_conf_set_dr_msg_cb(conf.get(), &deliveryCallback);
+  minifi::utils::rd_kafka_producer_unique_ptr producer{rd_kafka_new(RD_KAFKA_PRODUCER, conf.release(), err_chars.data(), err_chars.size())};
+  if (!producer) {
+    throw std::runtime_error(err_chars.data());
+  }
+  return producer;
+}
+
+// Publishes messages to librdkafka's built-in mock cluster. The payloads are read from a content buffer, as PublishKafka reads
+// them from the content repository, and are either copied by librdkafka or handed over in buffers of a PayloadBufferPool.
+void publishMessages(benchmark::State& state, const bool zero_copy) {
+  const auto message_size = gsl::narrow<size_t>(state.range(0));
+  const std::vector<std::byte> content(message_size, std::byte{'x'});
+  const auto producer = createMockClusterProducer();
+  const minifi::utils::rd_kafka_topic_unique_ptr topic{rd_kafka_topic_new(producer.get(), "benchmark", nullptr)};
+  const auto pool = std::make_shared<minifi::utils::PayloadBufferPool>(64, 32_MiB);
+  std::vector<std::byte> copied_buffer(message_size);
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < MESSAGES_PER_ITERATION; ++i) {
+      std::byte* payload = copied_buffer.data();
+      int message_flags = RD_KAFKA_MSG_F_COPY;
+      std::unique_ptr<std::shared_ptr<minifi::utils::PayloadBufferPool::Buffer>> pooled_buffer;
+      if (zero_copy) {
+        pooled_buffer = std::make_unique<std::shared_ptr<minifi::utils::PayloadBufferPool::Buffer>>(pool->acquire(message_size));
+        payload = (*pooled_buffer)->data();
+        message_flags = 0;
+      }
+      std::copy(content.begin(), content.end(), payload);
+
+      while (rd_kafka_produce(topic.get(), RD_KAFKA_PARTITION_UA, message_flags, payload, message_size, nullptr, 0, pooled_buffer.get()) != 0) {
+        if (rd_kafka_last_error() != RD_KAFKA_RESP_ERR__QUEUE_FULL) {
+          state.SkipWithError(rd_kafka_err2str(rd_kafka_last_error()));
+          return;
+        }
+        rd_kafka_poll(producer.get(), 10);
+      }
+      std::ignore = pooled_buffer.release();  // deleted in deliveryCallback
+      rd_kafka_poll(producer.get(), 0);
+    }
+    rd_kafka_flush(producer.get(), 10000);
+  }
+  state.SetBytesProcessed(gsl::narrow<int64_t>(state.iterations() * MESSAGES_PER_ITERATION * message_size));
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(publishMessages, copy, false)->Arg(1024)->Arg(64 * 1024)->Arg(512 * 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(publishMessages, zeroCopy, true)->Arg(1024)->Arg(64 * 1024)->Arg(512 * 1024)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -20,6 +20,7 @@
 #include <cinttypes>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include "utils/StringUtils.h"
@@ -264,7 +265,7 @@ void PublishMQTT::setMqtt5Properties(MQTTAsync_message& message, const std::stri
 }
 
 void PublishMQTT::addAttributesAsUserProperties(MQTTAsync_message& message, const std::shared_ptr<core::FlowFile>& flow_file) {
-  for (const auto& [key, value] : *flow_file->getAttributesPtr()) {
+  for (const auto& [key, value] : *std::as_const(*flow_file).getAttributesPtr()) {
     MQTTProperty property;
     property.identifier = MQTTPROPERTY_CODE_USER_PROPERTY;
 
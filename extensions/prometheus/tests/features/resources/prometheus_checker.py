@@ -50,12 +50,14 @@ class PrometheusChecker:
             all((self._verify_metrics_exist(['minifi_rocksdb_table_readers_size_bytes', 'minifi_rocksdb_all_memory_tables_size_bytes'], 'RepositoryMetrics', labels) for labels in label_list[1:3]))
 
     def _verify_queue_metrics(self) -> bool:
-        return self._verify_metrics_exist(['minifi_queue_data_size', 'minifi_queue_data_size_max', 'minifi_queue_size', 'minifi_queue_size_max'], 'QueueMetrics')
+        return self._verify_metrics_exist(['minifi_queue_data_size', 'minifi_queue_data_size_max', 'minifi_queue_size', 'minifi_queue_size_max',
+                                           'minifi_queue_wait_time_nanoseconds'], 'QueueMetrics')
 
     def _verify_general_processor_metrics(self, metric_class: str, processor_name: str) -> bool:
         labels = {'processor_name': processor_name}
         return self._verify_metrics_exist(['minifi_average_onTrigger_runtime_milliseconds', 'minifi_last_onTrigger_runtime_milliseconds',
                                            'minifi_average_session_commit_runtime_milliseconds', 'minifi_last_session_commit_runtime_milliseconds',
+                                           'minifi_onTrigger_runtime_nanoseconds', 'minifi_session_commit_runtime_nanoseconds',
                                            'minifi_incoming_flow_files', 'minifi_incoming_bytes', 'minifi_bytes_read', 'minifi_bytes_written'], metric_class, labels) and \
             self._verify_metrics_larger_than_zero(['minifi_onTrigger_invocations', 'minifi_transferred_flow_files', 'minifi_transferred_to_success',
                                                    'minifi_transferred_bytes', 'minifi_processing_nanos'],
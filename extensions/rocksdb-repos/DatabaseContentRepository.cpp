@@ -25,12 +25,14 @@
 
 #include "minifi-cpp/Exception.h"
 #include "RocksDbStream.h"
+#include "io/OutputStreamSlice.h"
 #include "core/Resource.h"
 #include "core/TypedValues.h"
 #include "database/RocksDbUtils.h"
 #include "database/StringAppender.h"
 #include "encryption/RocksDbEncryptionProvider.h"
 #include "utils/Locations.h"
+#include "utils/ParsingUtils.h"
 #include "minifi-cpp/utils/gsl.h"
 
 namespace org::apache::nifi::minifi::core::repository {
@@ -58,6 +60,13 @@ bool DatabaseContentRepository::initialize(const std::shared_ptr<minifi::Configu
 
   setCompactionPeriod(configuration);
 
+  chunk_size_ = (configuration->get(Configure::nifi_dbcontent_repository_chunk_size) | utils::andThen([](const std::string& size) { return parsing::parseDataSize(size) | utils::toOptional(); })).value_or(io::RocksDbStream::DEFAULT_CHUNK_SIZE);
+  if (chunk_size_ == 0) {
+    logger_->log_warn("Invalid '{}' of 0, using the default chunk size", Configure::nifi_dbcontent_repository_chunk_size);
+    chunk_size_ = io::RocksDbStream::DEFAULT_CHUNK_SIZE;
+  }
+  const auto min_blob_size = configuration->get(Configure::nifi_dbcontent_repository_rocksdb_min_blob_size) | utils::andThen([](const std::string& size) { return parsing::parseDataSize(size) | utils::toOptional(); });
+
   auto set_db_opts = [encrypted_env] (minifi::internal::Writable<rocksdb::DBOptions>& db_opts) {
     minifi::internal::setCommonRocksDbOptions(db_opts);
     if (encrypted_env) {
@@ -66,10 +75,16 @@ bool DatabaseContentRepository::initialize(const std::shared_ptr<minifi::Configu
       db_opts.set(&rocksdb::DBOptions::env, rocksdb::Env::Default());
     }
   };
-  auto set_cf_opts = [&configuration] (rocksdb::ColumnFamilyOptions& cf_opts) {
+  auto set_cf_opts = [&configuration, &min_blob_size] (rocksdb::ColumnFamilyOptions& cf_opts) {
     cf_opts.OptimizeForPointLookup(4);
+    // content written by earlier versions was appended using merges
     cf_opts.merge_operator = std::make_shared<StringAppender>();
     cf_opts.max_successive_merges = 0;
+    if (min_blob_size) {
+      // large chunks are stored in blob files, so compactions do not have to rewrite them
+      cf_opts.enable_blob_files = true;
+      cf_opts.min_blob_size = *min_blob_size;
+    }
     if (auto compression_type = minifi::internal::readConfiguredCompressionType(configuration, Configure::nifi_content_repository_rocksdb_compression)) {
       cf_opts.compression = *compression_type;
     }
@@ -145,54 +160,80 @@ void DatabaseContentRepository::stop() {
 }
 
 DatabaseContentRepository::Session::Session(std::shared_ptr<ContentRepository> repository, bool use_synchronous_writes)
-    : BufferedContentSession(std::move(repository)),
+    : ContentSessionImpl(std::move(repository)),
       use_synchronous_writes_(use_synchronous_writes) {}
 
 std::shared_ptr<ContentSession> DatabaseContentRepository::createSession() {
   return std::make_shared<Session>(sharedFromThis<ContentRepository>(), use_synchronous_writes_);
 }
 
-void DatabaseContentRepository::Session::commit() {
-  auto dbContentRepository = std::dynamic_pointer_cast<DatabaseContentRepository>(repository_);
-  auto opendb = dbContentRepository->db_->open();
-  if (!opendb) {
-    throw Exception(REPOSITORY_EXCEPTION, "Couldn't open rocksdb database to commit content changes");
+std::shared_ptr<DatabaseContentRepository> DatabaseContentRepository::Session::databaseRepository() const {
+  return std::dynamic_pointer_cast<DatabaseContentRepository>(repository_);
+}
+
+std::shared_ptr<ResourceClaim> DatabaseContentRepository::Session::create() {
+  auto claim = ResourceClaim::create(repository_);
+  created_claims_.insert(claim);
+  return claim;
+}
+
+std::shared_ptr<io::BaseStream> DatabaseContentRepository::Session::write(const std::shared_ptr<ResourceClaim>& resource_id) {
+  if (!created_claims_.contains(resource_id)) {
+    throw Exception(REPOSITORY_EXCEPTION, "Can only overwrite owned resource");
   }
-  auto batch = opendb->createWriteBatch();
-  for (const auto& resource : managed_resources_) {
-    auto outStream = dbContentRepository->write(*resource.first, false, &batch);
-    if (outStream == nullptr) {
-      throw Exception(REPOSITORY_EXCEPTION, "Couldn't open the underlying resource for write: " + resource.first->getContentFullPath());
-    }
-    const auto size = resource.second->size();
-    if (outStream->write(resource.second->getBuffer()) != size) {
-      throw Exception(REPOSITORY_EXCEPTION, "Failed to write new resource: " + resource.first->getContentFullPath());
-    }
+  // the written chunks are synced together when the session is committed
+  return databaseRepository()->write(*resource_id, false, false);
+}
+
+std::shared_ptr<io::BaseStream> DatabaseContentRepository::Session::append(const std::shared_ptr<ResourceClaim>& resource_id) {
+  auto stream = databaseRepository()->write(*resource_id, true, false);
+  if (!stream) {
+    throw Exception(REPOSITORY_EXCEPTION, "Couldn't open the underlying resource for append: " + resource_id->getContentFullPath());
   }
-  for (const auto& resource : append_state_) {
-    auto outStream = dbContentRepository->write(*resource.first, true, &batch);
-    if (outStream == nullptr) {
-      throw Exception(REPOSITORY_EXCEPTION, "Couldn't open the underlying resource for append: " + resource.first->getContentFullPath());
-    }
-    const auto size = resource.second.stream->size();
-    if (outStream->write(resource.second.stream->getBuffer()) != size) {
-      throw Exception(REPOSITORY_EXCEPTION, "Failed to append to resource: " + resource.first->getContentFullPath());
-    }
+  appended_streams_[resource_id] = stream;
+  // the size of the RocksDbStream includes the stored content, which the session already counts as the base size
+  return std::make_shared<io::OutputStreamSlice>(std::move(stream));
+}
+
+std::shared_ptr<io::BaseStream> DatabaseContentRepository::Session::read(const std::shared_ptr<ResourceClaim>& resource_id) {
+  if (auto it = appended_streams_.find(resource_id); it != appended_streams_.end()) {
+    // the content appended in this session is only visible to the reader once the buffered part is stored
+    it->second->close();
   }
+  return repository_->read(*resource_id);
+}
 
-  rocksdb::WriteOptions options;
-  options.sync = use_synchronous_writes_;
-  rocksdb::Status status = opendb->Write(options, &batch);
-  if (!status.ok()) {
-    throw Exception(REPOSITORY_EXCEPTION, "Batch write failed: " + status.ToString());
+void DatabaseContentRepository::Session::closeAppendedStreams() {
+  // the buffered content has to be stored before the append locks are released
+  for (const auto& [claim, stream] : appended_streams_) {
+    stream->close();
   }
+  appended_streams_.clear();
+}
 
-  managed_resources_.clear();
+void DatabaseContentRepository::Session::commit() {
+  closeAppendedStreams();
+  if (use_synchronous_writes_) {
+    auto opendb = databaseRepository()->db_->open();
+    if (!opendb) {
+      throw Exception(REPOSITORY_EXCEPTION, "Couldn't open rocksdb database to commit content changes");
+    }
+    if (const auto status = opendb->FlushWAL(true); !status.ok()) {
+      throw Exception(REPOSITORY_EXCEPTION, "Failed to sync content changes: " + status.ToString());
+    }
+  }
+  created_claims_.clear();
+  append_state_.clear();
+}
+
+void DatabaseContentRepository::Session::rollback() {
+  closeAppendedStreams();
+  created_claims_.clear();
   append_state_.clear();
 }
 
 std::shared_ptr<io::BaseStream> DatabaseContentRepository::write(const minifi::ResourceClaim &claim, bool append) {
-  return write(claim, append, nullptr);
+  return write(claim, append, true);
 }
 
 std::shared_ptr<io::BaseStream> DatabaseContentRepository::read(const minifi::ResourceClaim &claim) {
@@ -200,7 +241,8 @@ std::shared_ptr<io::BaseStream> DatabaseContentRepository::read(const minifi::Re
   // we can simply return a nullptr, which is also valid from the API when this stream is not valid.
   if (!is_valid_ || !db_)
     return nullptr;
-  return std::make_shared<io::RocksDbStream>(claim.getContentFullPath(), gsl::make_not_null<minifi::internal::RocksDatabase*>(db_.get()), false, nullptr, true, verify_checksums_in_rocksdb_reads_);
+  return std::make_shared<io::RocksDbStream>(claim.getContentFullPath(), gsl::make_not_null<minifi::internal::RocksDatabase*>(db_.get()), false, nullptr, true,
+      verify_checksums_in_rocksdb_reads_, chunk_size_);
 }
 
 bool DatabaseContentRepository::exists(const minifi::ResourceClaim &streamId) {
@@ -208,12 +250,16 @@ bool DatabaseContentRepository::exists(const minifi::ResourceClaim &streamId) {
   if (!opendb) {
     return false;
   }
-  std::string value;
-  rocksdb::Status status;
+  const auto content_path = streamId.getContentFullPath();
+  const auto upper_bound = io::RocksDbStream::chunkKeyUpperBound(content_path);
+  rocksdb::Slice upper_bound_slice(upper_bound);
   rocksdb::ReadOptions options;
   options.verify_checksums = verify_checksums_in_rocksdb_reads_;
-  status = opendb->Get(options, streamId.getContentFullPath(), &value);
-  if (status.ok()) {
+  options.iterate_upper_bound = &upper_bound_slice;
+  auto it = opendb->NewIterator(options);
+  // the content is either stored under the path itself by earlier versions or in chunks after it
+  it->Seek(content_path);
+  if (it->Valid()) {
     logger_->log_debug("{} exists", streamId.getContentFullPath());
     return true;
   } else {
@@ -230,13 +276,12 @@ bool DatabaseContentRepository::removeKeySync(const std::string &content_path) {
   if (!opendb) {
     return false;
   }
-  rocksdb::Status status = opendb->Delete(rocksdb::WriteOptions(), content_path);
+  auto batch = opendb->createWriteBatch();
+  deleteContent(*opendb, batch, content_path);
+  rocksdb::Status status = opendb->Write(rocksdb::WriteOptions(), &batch);
   if (status.ok()) {
     logger_->log_debug("Deleting resource {}", content_path);
     return true;
-  } else if (status.IsNotFound()) {
-    logger_->log_debug("Resource {} was not found", content_path);
-    return true;
   } else {
     logger_->log_debug("Attempted, but could not delete {}", content_path);
     return false;
@@ -270,7 +315,7 @@ void DatabaseContentRepository::runGc() {
     }
     auto batch = opendb->createWriteBatch();
     for (auto& key : keys) {
-      batch.Delete(key);
+      deleteContent(*opendb, batch, key);
     }
     rocksdb::Status status;
     status = opendb->Write(rocksdb::WriteOptions(), &batch);
@@ -289,13 +334,37 @@ void DatabaseContentRepository::runGc() {
   }
 }
 
-std::shared_ptr<io::BaseStream> DatabaseContentRepository::write(const minifi::ResourceClaim& claim, bool /*append*/, minifi::internal::WriteBatch* batch) {
+std::shared_ptr<io::BaseStream> DatabaseContentRepository::write(const minifi::ResourceClaim& claim, bool append, bool use_synchronous_writes) {
   // the traditional approach with these has been to return -1 from the stream; however, since we have the ability here
   // we can simply return a nullptr, which is also valid from the API when this stream is not valid.
   if (!is_valid_ || !db_)
     return nullptr;
-  // append is already supported in all modes
-  return std::make_shared<io::RocksDbStream>(claim.getContentFullPath(), gsl::make_not_null<minifi::internal::RocksDatabase*>(db_.get()), true, batch, true, verify_checksums_in_rocksdb_reads_);
+  const auto create_stream = [&] {
+    return std::make_shared<io::RocksDbStream>(claim.getContentFullPath(), gsl::make_not_null<minifi::internal::RocksDatabase*>(db_.get()), true, nullptr, use_synchronous_writes,
+        verify_checksums_in_rocksdb_reads_, chunk_size_);
+  };
+  auto stream = create_stream();
+  if (!append && stream->size() > 0) {
+    // the stream appends new chunks after the existing ones, which have to be removed to overwrite the content
+    if (!removeKeySync(claim.getContentFullPath())) {
+      return nullptr;
+    }
+    stream = create_stream();
+  }
+  return stream;
+}
+
+void DatabaseContentRepository::deleteContent(minifi::internal::OpenRocksDb& opendb, minifi::internal::WriteBatch& batch, const std::string& content_path) const {
+  batch.Delete(content_path);
+  const auto upper_bound = io::RocksDbStream::chunkKeyUpperBound(content_path);
+  rocksdb::Slice upper_bound_slice(upper_bound);
+  rocksdb::ReadOptions options;
+  options.verify_checksums = verify_checksums_in_rocksdb_reads_;
+  options.iterate_upper_bound = &upper_bound_slice;
+  auto it = opendb.NewIterator(options);
+  for (it->Seek(io::RocksDbStream::chunkKeyLowerBound(content_path)); it->Valid(); it->Next()) {
+    batch.Delete(it->key());
+  }
 }
 
 void DatabaseContentRepository::clearOrphans() {
@@ -314,10 +383,11 @@ void DatabaseContentRepository::clearOrphans() {
   auto it = opendb->NewIterator(options);
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
     auto key = it->key().ToString();
+    const std::string content_path{io::RocksDbStream::pathOfKey(key)};
     std::lock_guard<std::mutex> lock(count_map_mutex_);
-    auto claim_it = count_map_.find(key);
+    auto claim_it = count_map_.find(content_path);
     if (claim_it == count_map_.end() || claim_it->second == 0) {
-      logger_->log_error("Deleting orphan resource {}", key);
+      logger_->log_error("Deleting orphan resource {}", content_path);
       keys_to_be_deleted.push_back(key);
     }
   }
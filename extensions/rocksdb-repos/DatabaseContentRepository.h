@@ -21,26 +21,45 @@
 #include <string_view>
 #include <utility>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "core/ContentRepository.h"
-#include "core/BufferedContentSession.h"
+#include "core/ContentSession.h"
 #include "core/logging/LoggerFactory.h"
 #include "minifi-cpp/core/Property.h"
 #include "database/RocksDatabase.h"
+#include "RocksDbStream.h"
 #include "minifi-cpp/properties/Configure.h"
 #include "utils/StoppableThread.h"
 
 namespace org::apache::nifi::minifi::core::repository {
 
 class DatabaseContentRepository : public core::ContentRepositoryImpl {
-  class Session : public BufferedContentSession {
+  // Writes the content directly to the database in chunks, so the memory used by the session does not depend on the size of the content.
+  // The content of a rolled back session is removed when its claims are released.
+  class Session : public ContentSessionImpl {
    public:
     explicit Session(std::shared_ptr<ContentRepository> repository, bool use_synchronous_writes);
 
+    std::shared_ptr<ResourceClaim> create() override;
+    std::shared_ptr<io::BaseStream> write(const std::shared_ptr<ResourceClaim>& resource_id) override;
+    std::shared_ptr<io::BaseStream> read(const std::shared_ptr<ResourceClaim>& resource_id) override;
     void commit() override;
+    void rollback() override;
+
+   protected:
+    std::shared_ptr<io::BaseStream> append(const std::shared_ptr<ResourceClaim>& resource_id) override;
+
    private:
+    std::shared_ptr<DatabaseContentRepository> databaseRepository() const;
+    void closeAppendedStreams();
+
     bool use_synchronous_writes_;
+    std::unordered_set<std::shared_ptr<ResourceClaim>> created_claims_;
+    // the database streams behind the appended slices, their buffered content is stored when they are closed
+    std::unordered_map<std::shared_ptr<ResourceClaim>, std::shared_ptr<io::BaseStream>> appended_streams_;
   };
 
   static constexpr std::chrono::milliseconds DEFAULT_COMPACTION_PERIOD = std::chrono::minutes{2};
@@ -89,7 +108,8 @@ class DatabaseContentRepository : public core::ContentRepositoryImpl {
   bool removeKeySync(const std::string& content_path);
   bool removeKey(const std::string& content_path) override;
 
-  std::shared_ptr<io::BaseStream> write(const minifi::ResourceClaim &claim, bool append, minifi::internal::WriteBatch* batch);
+  std::shared_ptr<io::BaseStream> write(const minifi::ResourceClaim &claim, bool append, bool use_synchronous_writes);
+  void deleteContent(minifi::internal::OpenRocksDb& opendb, minifi::internal::WriteBatch& batch, const std::string& content_path) const;
 
   void runCompaction();
   void setCompactionPeriod(const std::shared_ptr<minifi::Configure> &configuration);
@@ -107,6 +127,7 @@ class DatabaseContentRepository : public core::ContentRepositoryImpl {
   std::unique_ptr<utils::StoppableThread> gc_thread_;
   bool use_synchronous_writes_ = true;
   bool verify_checksums_in_rocksdb_reads_ = false;
+  size_t chunk_size_ = io::RocksDbStream::DEFAULT_CHUNK_SIZE;
 };
 
 }  // namespace org::apache::nifi::minifi::core::repository
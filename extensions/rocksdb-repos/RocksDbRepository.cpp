@@ -15,6 +15,10 @@
  * limitations under the License.
  */
 #include "RocksDbRepository.h"
+
+#include <chrono>
+
+#include "minifi-cpp/utils/gsl.h"
 #include "utils/span.h"
 #include "utils/OptionalUtils.h"
 
@@ -28,7 +32,13 @@ std::optional<RepositoryMetricsSource::RocksDbStats> RocksDbRepository::getRocks
     return RocksDbStats{};
   }
 
-  return opendb->getStats();
+  auto stats = opendb->getStats();
+  stats.write_group_stats = RocksDbWriteGroupStats{
+    .write_group_count = write_group_count_.load(),
+    .grouped_write_count = grouped_write_count_.load(),
+    .total_commit_latency_us = total_commit_latency_us_.load()
+  };
+  return stats;
 }
 
 bool RocksDbRepository::ExecuteWithRetry(const std::function<rocksdb::Status()>& operation) {
@@ -58,21 +68,89 @@ bool RocksDbRepository::Put(const std::string& key, const uint8_t *buf, size_t b
 }
 
 bool RocksDbRepository::MultiPut(const std::vector<std::pair<std::string, std::unique_ptr<minifi::io::BufferStream>>>& data) {
-  auto opendb = db_->open();
-  if (!opendb) {
-    return false;
+  std::vector<std::pair<std::string_view, std::span<const std::byte>>> data_view;
+  data_view.reserve(data.size());
+  for (const auto& [key, value] : data) {
+    data_view.emplace_back(key, value->getBuffer());
   }
-  auto batch = opendb->createWriteBatch();
-  for (const auto &item : data) {
-    const auto buf = utils::as_span<const char>(item.second->getBuffer());
-    rocksdb::Slice value(buf.data(), buf.size());
-    if (!batch.Put(item.first, value).ok()) {
-      logger_->log_error("Failed to add item to batch operation");
-      return false;
+  return MultiPut(std::span<const std::pair<std::string_view, std::span<const std::byte>>>{data_view});
+}
+
+bool RocksDbRepository::MultiPut(std::span<const std::pair<std::string_view, std::span<const std::byte>>> data) {
+  const auto start_time = std::chrono::steady_clock::now();
+  PendingWrite pending_write{.data = data};
+  std::unique_lock<std::mutex> lock(write_group_mutex_);
+  pending_writes_.push_back(&pending_write);
+  write_group_cv_.wait(lock, [&] { return pending_write.done || !write_group_in_progress_; });
+  if (!pending_write.done) {
+    write_group_in_progress_ = true;
+    auto write_group = std::exchange(pending_writes_, {});
+    lock.unlock();
+
+    if (auto opendb = db_->open()) {
+      commitWriteGroup(*opendb, write_group);
+    } else {
+      for (auto* write : write_group) {
+        write->success = false;
+      }
+    }
+
+    lock.lock();
+    for (auto* write : write_group) {
+      write->done = true;
+    }
+    ++write_group_count_;
+    write_group_in_progress_ = false;
+    write_group_cv_.notify_all();
+  }
+  lock.unlock();
+
+  ++grouped_write_count_;
+  total_commit_latency_us_ += gsl::narrow<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count());
+  return pending_write.success;
+}
+
+void RocksDbRepository::commitWriteGroup(minifi::internal::OpenRocksDb& opendb, std::vector<PendingWrite*>& write_group) {
+  const auto add_to_batch = [this](minifi::internal::WriteBatch& batch, const PendingWrite& write) {
+    batch.SetSavePoint();
+    for (const auto& [key, value] : write.data) {
+      const auto buf = utils::as_span<const char>(value);
+      if (!batch.Put(rocksdb::Slice{key.data(), key.size()}, rocksdb::Slice{buf.data(), buf.size()}).ok()) {
+        logger_->log_error("Failed to add item to batch operation");
+        batch.RollbackToSavePoint();
+        return false;
+      }
+    }
+    return true;
+  };
+
+  auto batch = opendb.createWriteBatch();
+  std::vector<PendingWrite*> batched_writes;
+  for (auto* write : write_group) {
+    write->success = false;
+    if (add_to_batch(batch, *write)) {
+      batched_writes.push_back(write);
+    }
+  }
+  if (batched_writes.empty()) {
+    return;
+  }
+
+  if (ExecuteWithRetry([&batch, &opendb]() { return opendb.Write(rocksdb::WriteOptions(), &batch); })) {
+    for (auto* write : batched_writes) {
+      write->success = true;
+    }
+    return;
+  }
+
+  if (batched_writes.size() > 1) {
+    // do not let a single failing request fail the whole group, commit the requests separately
+    logger_->log_warn("Failed to commit write group of {} requests, committing them one by one", batched_writes.size());
+    for (auto* write : batched_writes) {
+      auto single_batch = opendb.createWriteBatch();
+      write->success = add_to_batch(single_batch, *write) && ExecuteWithRetry([&single_batch, &opendb]() { return opendb.Write(rocksdb::WriteOptions(), &single_batch); });
     }
   }
-  auto operation = [&batch, &opendb]() { return opendb->Write(rocksdb::WriteOptions(), &batch); };
-  return ExecuteWithRetry(operation);
 }
 
 bool RocksDbRepository::Get(const std::string &key, std::string &value) {
@@ -16,6 +16,10 @@
  */
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <span>
 #include <utility>
 #include <vector>
 #include <string>
@@ -43,6 +47,7 @@ class RocksDbRepository : public ThreadedRepositoryImpl {
 
   bool Put(const std::string& key, const uint8_t *buf, size_t bufLen) override;
   bool MultiPut(const std::vector<std::pair<std::string, std::unique_ptr<minifi::io::BufferStream>>>& data) override;
+  bool MultiPut(std::span<const std::pair<std::string_view, std::span<const std::byte>>> data) override;
   bool Get(const std::string &key, std::string &value) override;
 
   uint64_t getRepositorySize() const override;
@@ -52,6 +57,18 @@ class RocksDbRepository : public ThreadedRepositoryImpl {
  protected:
   bool ExecuteWithRetry(const std::function<rocksdb::Status()>& operation);
 
+  // A MultiPut request waiting to be written to the database as part of a write group
+  struct PendingWrite {
+    std::span<const std::pair<std::string_view, std::span<const std::byte>>> data;
+    bool done = false;
+    bool success = false;
+  };
+
+  // Concurrent MultiPut calls are committed together in a single WriteBatch: the first caller becomes the leader
+  // and writes the requests of every waiting caller, the others wait until their request has been committed.
+  // Each caller only returns after its own data has been written, so the durability guarantee of MultiPut is kept.
+  void commitWriteGroup(minifi::internal::OpenRocksDb& opendb, std::vector<PendingWrite*>& write_group);
+
   std::thread& getThread() override {
     return thread_;
   }
@@ -60,6 +77,14 @@ class RocksDbRepository : public ThreadedRepositoryImpl {
   std::shared_ptr<logging::Logger> logger_;
   std::thread thread_;
   bool verify_checksums_in_rocksdb_reads_ = false;
+
+  std::mutex write_group_mutex_;
+  std::condition_variable write_group_cv_;
+  std::vector<PendingWrite*> pending_writes_;
+  bool write_group_in_progress_ = false;
+  std::atomic<uint64_t> write_group_count_{0};
+  std::atomic<uint64_t> grouped_write_count_{0};
+  std::atomic<uint64_t> total_commit_latency_us_{0};
 };
 
 }  // namespace org::apache::nifi::minifi::core::repository
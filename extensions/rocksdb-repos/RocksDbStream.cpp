@@ -18,35 +18,114 @@
 
 #include "RocksDbStream.h"
 #include <algorithm>
-#include <fstream>
+#include <charconv>
+#include <cstring>
 #include <utility>
-#include <vector>
 #include <memory>
 #include <string>
+#include "fmt/format.h"
 #include "minifi-cpp/Exception.h"
 #include "io/validation.h"
 
 namespace org::apache::nifi::minifi::io {
 
+namespace {
+// separates the path and the offset in chunk keys, it does not occur in content paths
+constexpr char CHUNK_KEY_SEPARATOR = '\x1f';
+constexpr size_t CHUNK_OFFSET_DIGITS = 16;
+
+std::optional<size_t> offsetOfChunkKey(std::string_view key) {
+  if (key.size() < CHUNK_OFFSET_DIGITS) {
+    return std::nullopt;
+  }
+  const auto offset_str = key.substr(key.size() - CHUNK_OFFSET_DIGITS);
+  size_t offset = 0;
+  const auto [ptr, ec] = std::from_chars(offset_str.data(), offset_str.data() + offset_str.size(), offset, 16);
+  if (ec != std::errc{} || ptr != offset_str.data() + offset_str.size()) {
+    return std::nullopt;
+  }
+  return offset;
+}
+}  // namespace
+
 RocksDbStream::RocksDbStream(std::string path, gsl::not_null<minifi::internal::RocksDatabase*> db, bool write_enable, minifi::internal::WriteBatch* batch,
-  bool use_synchronous_writes, bool verify_checksums)
+  bool use_synchronous_writes, bool verify_checksums, size_t chunk_size)
     : BaseStreamImpl(),
       path_(std::move(path)),
       write_enable_(write_enable),
       db_(db),
-      exists_([this, verify_checksums] {
-        auto opendb = db_->open();
-        rocksdb::ReadOptions options;
-        options.verify_checksums = verify_checksums;
-        return opendb && opendb->Get(options, path_, &value_).ok();
-      }()),
-      offset_(0),
+      opendb_(db_->open()),
+      lower_bound_(chunkKeyLowerBound(path_)),
+      upper_bound_(chunkKeyUpperBound(path_)),
+      lower_bound_slice_(lower_bound_),
+      upper_bound_slice_(upper_bound_),
       batch_(batch),
-      size_(value_.size()),
+      chunk_size_(std::max<size_t>(chunk_size, 1)),
       use_synchronous_writes_(use_synchronous_writes) {
+  if (!opendb_) {
+    return;
+  }
+  read_options_.verify_checksums = verify_checksums;
+  read_options_.iterate_lower_bound = &lower_bound_slice_;
+  read_options_.iterate_upper_bound = &upper_bound_slice_;
+  exists_ = opendb_->Get(read_options_, path_, &legacy_value_).ok();
+  size_ = legacy_value_.size();
+
+  createChunkIterator();
+  chunk_iterator_->SeekToLast();
+  if (chunk_iterator_->Valid()) {
+    exists_ = true;
+    if (const auto last_chunk_offset = offsetOfChunkKey(chunk_iterator_->key().ToStringView())) {
+      size_ = std::max(size_, *last_chunk_offset + chunk_iterator_->value().size());
+    }
+  }
+  stored_size_ = size_;
+  if (write_enable_) {
+    // the iterator pins the current state of the database, writers only need it to read the content
+    chunk_iterator_.reset();
+  }
+}
+
+std::string RocksDbStream::chunkKey(std::string_view path, size_t offset) {
+  return fmt::format("{}{}{:0{}x}", path, CHUNK_KEY_SEPARATOR, offset, CHUNK_OFFSET_DIGITS);
+}
+
+std::string RocksDbStream::chunkKeyLowerBound(std::string_view path) {
+  return fmt::format("{}{}", path, CHUNK_KEY_SEPARATOR);
+}
+
+std::string RocksDbStream::chunkKeyUpperBound(std::string_view path) {
+  return fmt::format("{}{}", path, static_cast<char>(CHUNK_KEY_SEPARATOR + 1));
+}
+
+std::string_view RocksDbStream::pathOfKey(std::string_view key) {
+  const auto separator_pos = key.rfind(CHUNK_KEY_SEPARATOR);
+  if (separator_pos == std::string_view::npos || key.size() - separator_pos - 1 != CHUNK_OFFSET_DIGITS) {
+    return key;
+  }
+  return key.substr(0, separator_pos);
+}
+
+void RocksDbStream::createChunkIterator() {
+  chunk_iterator_ = opendb_->NewIterator(read_options_);
+  chunk_offset_.reset();
 }
 
 void RocksDbStream::close() {
+  if (!buffer_.empty()) {
+    if (putChunk(buffer_)) {
+      buffer_.clear();
+    } else {
+      logger_->log_error("Failed to store the last chunk of {}", path_);
+    }
+  }
+  if (has_unsynced_writes_ && use_synchronous_writes_) {
+    const auto status = opendb_->FlushWAL(true);
+    if (!status.ok()) {
+      logger_->log_error("Failed to sync the chunks of {}: {}", path_, status.ToString());
+    }
+  }
+  has_unsynced_writes_ = false;
 }
 
 void RocksDbStream::seek(size_t offset) {
@@ -57,40 +136,98 @@ size_t RocksDbStream::tell() const {
   return offset_;
 }
 
+bool RocksDbStream::putChunk(std::string_view chunk) {
+  const auto key = chunkKey(path_, stored_size_);
+  rocksdb::Status status;
+  if (batch_ != nullptr) {
+    status = batch_->Put(key, chunk);
+  } else {
+    // the chunks are synced together when the stream is closed
+    status = opendb_->Put(rocksdb::WriteOptions{}, key, chunk);
+    has_unsynced_writes_ = true;
+  }
+  if (!status.ok()) {
+    logger_->log_error("Failed to store chunk {} of {}: {}", stored_size_, path_, status.ToString());
+    return false;
+  }
+  stored_size_ += chunk.size();
+  return true;
+}
+
 size_t RocksDbStream::write(const uint8_t *value, size_t size) {
   if (!write_enable_) return STREAM_ERROR;
   if (size != 0 && IsNullOrEmpty(value)) return STREAM_ERROR;
-  auto opendb = db_->open();
-  if (!opendb) {
+  if (!opendb_) {
     return STREAM_ERROR;
   }
-  rocksdb::Slice slice_value(reinterpret_cast<const char*>(value), size);
-  rocksdb::Status status;
+  std::string_view data(reinterpret_cast<const char*>(value), size);
+  if (!buffer_.empty()) {
+    const auto buffered_size = std::min(data.size(), chunk_size_ - buffer_.size());
+    buffer_.append(data.substr(0, buffered_size));
+    data.remove_prefix(buffered_size);
+    if (buffer_.size() == chunk_size_) {
+      if (!putChunk(buffer_)) {
+        return STREAM_ERROR;
+      }
+      buffer_.clear();
+    }
+  }
+  while (data.size() >= chunk_size_) {
+    if (!putChunk(data.substr(0, chunk_size_))) {
+      return STREAM_ERROR;
+    }
+    data.remove_prefix(chunk_size_);
+  }
+  buffer_.append(data);
   size_ += size;
-  if (batch_ != nullptr) {
-    status = batch_->Merge(path_, slice_value);
-  } else {
-    rocksdb::WriteOptions opts;
-    opts.sync = use_synchronous_writes_;
-    status = opendb->Merge(opts, path_, slice_value);
+  return size;
+}
+
+bool RocksDbStream::loadChunk(size_t offset) {
+  if (chunk_offset_ && *chunk_offset_ <= offset && offset < *chunk_offset_ + chunk_.size()) {
+    return true;
+  }
+  if (!chunk_iterator_) {
+    createChunkIterator();
   }
-  if (status.ok()) {
-    return size;
+  if (chunk_offset_ && *chunk_offset_ + chunk_.size() == offset) {
+    chunk_iterator_->Next();
   } else {
-    return STREAM_ERROR;
+    chunk_iterator_->SeekForPrev(chunkKey(path_, offset));
   }
+  chunk_offset_.reset();
+  if (!chunk_iterator_->Valid()) {
+    return false;
+  }
+  chunk_offset_ = offsetOfChunkKey(chunk_iterator_->key().ToStringView());
+  chunk_ = chunk_iterator_->value();
+  return chunk_offset_ && *chunk_offset_ <= offset && offset < *chunk_offset_ + chunk_.size();
 }
 
 size_t RocksDbStream::read(std::span<std::byte> buf) {
   // The check have to be in this order for RocksDBStreamTest "Read zero bytes" to succeed
   if (!exists_) return STREAM_ERROR;
   if (buf.empty()) return 0;
-  if (offset_ >= value_.size()) return 0;
 
-  const auto amtToRead = std::min(buf.size(), value_.size() - offset_);
-  std::memcpy(buf.data(), value_.data() + offset_, amtToRead);
-  offset_ += amtToRead;
-  return amtToRead;
+  size_t read_size = 0;
+  while (read_size < buf.size() && offset_ < stored_size_) {
+    const auto remaining = buf.subspan(read_size);
+    size_t amount = 0;
+    if (offset_ < legacy_value_.size()) {
+      amount = std::min(remaining.size(), legacy_value_.size() - offset_);
+      std::memcpy(remaining.data(), legacy_value_.data() + offset_, amount);
+    } else if (loadChunk(offset_)) {
+      const auto offset_in_chunk = offset_ - *chunk_offset_;
+      amount = std::min(remaining.size(), chunk_.size() - offset_in_chunk);
+      std::memcpy(remaining.data(), chunk_.data() + offset_in_chunk, amount);
+    } else {
+      logger_->log_error("Missing chunk at offset {} of {}", offset_, path_);
+      return read_size > 0 ? read_size : STREAM_ERROR;
+    }
+    offset_ += amount;
+    read_size += amount;
+  }
+  return read_size;
 }
 
 }  // namespace org::apache::nifi::minifi::io
@@ -17,36 +17,48 @@
  */
 #pragma once
 
-#include <iostream>
 #include <cstdint>
-#include <string>
 #include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
 #include "database/RocksDatabase.h"
 #include "io/BaseStream.h"
 #include "core/logging/LoggerFactory.h"
+#include "minifi-cpp/utils/Literals.h"
 
 namespace org::apache::nifi::minifi::io {
 
 /**
- * Purpose: File Stream Base stream extension. This is intended to be a thread safe access to
- * read/write to the local file system.
- *
- * Design: Simply extends BaseStream and overrides readData/writeData to allow a sink to the
- * fstream object.
+ * Stream of a content claim stored in RocksDB.
+ * The content is stored in chunks of at most chunk_size bytes under the keys returned by chunkKey, so neither reading
+ * nor writing holds more than a chunk in memory. Content written by earlier versions is stored as a single value under
+ * the path of the claim, which is read before the chunks.
  */
 class RocksDbStream : public io::BaseStreamImpl {
  public:
+  static constexpr size_t DEFAULT_CHUNK_SIZE = 1_MiB;
+
   /**
-   * File Stream constructor that accepts an fstream shared pointer.
-   * It must already be initialized for read and write.
+   * Opens the content at path, writes are appended to the existing content.
+   * Writes are buffered until a chunk is full or the stream is closed.
    */
   explicit RocksDbStream(std::string path, gsl::not_null<minifi::internal::RocksDatabase*> db, bool write_enable = false,
-    minifi::internal::WriteBatch* batch = nullptr, bool use_synchronous_writes = true, bool verify_checksums = false);
+    minifi::internal::WriteBatch* batch = nullptr, bool use_synchronous_writes = true, bool verify_checksums = false, size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+  RocksDbStream(const RocksDbStream&) = delete;
+  RocksDbStream(RocksDbStream&&) = delete;
+  RocksDbStream& operator=(const RocksDbStream&) = delete;
+  RocksDbStream& operator=(RocksDbStream&&) = delete;
 
   ~RocksDbStream() override {
     close();
   }
 
+  /**
+   * Stores the buffered content as the last chunk, the stream can still be written to afterwards.
+   */
   void close() final;
   /**
    * Skip to the specified offset.
@@ -77,16 +89,44 @@ class RocksDbStream : public io::BaseStreamImpl {
    */
   size_t write(const uint8_t *value, size_t size) override;
 
+  // the key of the chunk starting at offset, keys of the same path sort by their offset
+  static std::string chunkKey(std::string_view path, size_t offset);
+  // every chunk key of path is in the range [chunkKeyLowerBound(path), chunkKeyUpperBound(path))
+  static std::string chunkKeyLowerBound(std::string_view path);
+  static std::string chunkKeyUpperBound(std::string_view path);
+  // the path of the content claim a key belongs to, either a chunk key or the path itself
+  static std::string_view pathOfKey(std::string_view key);
+
  protected:
+  bool putChunk(std::string_view chunk);
+  bool loadChunk(size_t offset);
+  void createChunkIterator();
+
   std::string path_;
   bool write_enable_;
   gsl::not_null<minifi::internal::RocksDatabase*> db_;
-  std::string value_;
-  bool exists_;
-  size_t offset_;
+  std::optional<minifi::internal::OpenRocksDb> opendb_;
+  std::string lower_bound_;
+  std::string upper_bound_;
+  rocksdb::Slice lower_bound_slice_;
+  rocksdb::Slice upper_bound_slice_;
+  rocksdb::ReadOptions read_options_;
+  std::unique_ptr<rocksdb::Iterator> chunk_iterator_;
+  // the chunk the iterator points to, valid until the iterator is moved
+  std::optional<size_t> chunk_offset_;
+  rocksdb::Slice chunk_;
+  // content stored by earlier versions under the path itself
+  std::string legacy_value_;
+  bool exists_ = false;
+  size_t offset_ = 0;
   minifi::internal::WriteBatch* batch_;
-  size_t size_;
+  size_t size_ = 0;
+  // the size of the content stored in chunks, the rest of the written content is buffered
+  size_t stored_size_ = 0;
+  std::string buffer_;
+  size_t chunk_size_;
   bool use_synchronous_writes_;
+  bool has_unsynced_writes_ = false;
 
  private:
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<RocksDbStream>::getLogger();
@@ -32,4 +32,12 @@ rocksdb::Status WriteBatch::Merge(const rocksdb::Slice &key, const rocksdb::Slic
   return impl_.Merge(column_, key, value);
 }
 
+void WriteBatch::SetSavePoint() {
+  impl_.SetSavePoint();
+}
+
+rocksdb::Status WriteBatch::RollbackToSavePoint() {
+  return impl_.RollbackToSavePoint();
+}
+
 }  // namespace org::apache::nifi::minifi::internal
@@ -29,6 +29,8 @@ class WriteBatch {
   rocksdb::Status Put(const rocksdb::Slice &key, const rocksdb::Slice &value);
   rocksdb::Status Delete(const rocksdb::Slice &key);
   rocksdb::Status Merge(const rocksdb::Slice &key, const rocksdb::Slice &value);
+  void SetSavePoint();
+  rocksdb::Status RollbackToSavePoint();
  private:
   rocksdb::WriteBatch impl_;
   rocksdb::ColumnFamilyHandle* column_;
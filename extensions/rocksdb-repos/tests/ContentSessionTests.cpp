@@ -187,3 +187,72 @@ TEST_CASE("ContentSession behavior") {
     test_template<core::repository::DatabaseContentRepository>();
   }
 }
+
+template<typename ContentRepositoryClass>
+void test_append_twice_template() {
+  ContentSessionController<ContentRepositoryClass> controller;
+  std::shared_ptr<core::ContentRepository> contentRepository = controller.contentRepository;
+
+  std::shared_ptr<minifi::ResourceClaim> claim;
+  {
+    auto session = contentRepository->createSession();
+    claim = session->create();
+    session->write(claim) << "data";
+    session->commit();
+  }
+
+  auto session = contentRepository->createSession();
+  auto first_stream = session->append(claim, 4, NO_CREATE);
+  first_stream << "-first";
+  CHECK(first_stream->size() == 6);
+  // the second append continues the stream of the first one
+  auto second_stream = session->append(claim, 10, NO_CREATE);
+  CHECK(second_stream == first_stream);
+  second_stream << "-second";
+  session->commit();
+
+  std::string content;
+  contentRepository->read(*claim) >> content;
+  CHECK(content == "data-first-second");
+}
+
+TEST_CASE("ContentSession can append to a committed claim multiple times") {
+  SECTION("FileSystemRepository") {
+    test_append_twice_template<core::repository::FileSystemRepository>();
+  }
+  SECTION("VolatileContentRepository") {
+    test_append_twice_template<core::repository::VolatileContentRepository>();
+  }
+  SECTION("DatabaseContentRepository") {
+    test_append_twice_template<core::repository::DatabaseContentRepository>();
+  }
+}
+
+TEST_CASE("DatabaseContentRepository copies the content appended in the session when appending at an earlier offset") {
+  ContentSessionController<core::repository::DatabaseContentRepository> controller;
+  std::shared_ptr<core::ContentRepository> contentRepository = controller.contentRepository;
+
+  std::shared_ptr<minifi::ResourceClaim> claim;
+  {
+    auto session = contentRepository->createSession();
+    claim = session->create();
+    session->write(claim) << "data";
+    session->commit();
+  }
+
+  auto session = contentRepository->createSession();
+  session->append(claim, 4, NO_CREATE) << "-appended";
+  // the content up to the requested offset includes the appended content, which is still buffered
+  std::shared_ptr<minifi::ResourceClaim> copied_claim;
+  session->append(claim, 8, [&] (auto new_claim) {
+    copied_claim = std::move(new_claim);
+  }) << "-copy";
+  REQUIRE(copied_claim);
+  session->commit();
+
+  std::string content;
+  contentRepository->read(*claim) >> content;
+  CHECK(content == "data-appended");
+  contentRepository->read(*copied_claim) >> content;
+  CHECK(content == "data-app-copy");
+}
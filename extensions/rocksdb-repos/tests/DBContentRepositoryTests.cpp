@@ -16,7 +16,9 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <memory>
+#include <span>
 #include <string>
 
 #include "core/Core.h"
@@ -55,10 +57,10 @@ TEST_CASE("Write Claim", "[TestDBCR1]") {
 
   stream->write(as_bytes(std::span(content)));
 
-  REQUIRE(content_repo->size(*claim) == content.length());
-
   stream->close();
 
+  REQUIRE(content_repo->size(*claim) == content.length());
+
   content_repo->invalidate();
   // reclaim the memory
   content_repo = nullptr;
@@ -355,3 +357,56 @@ TEST_CASE("DBContentRepository can clear orphan entries") {
 
   REQUIRE(getDbSize(dir) == 0);
 }
+
+TEST_CASE("DBContentRepository stores the content in chunks") {
+  TestController testController;
+  auto dir = testController.createTempDirectory();
+  auto configuration = std::make_shared<org::apache::nifi::minifi::ConfigureImpl>();
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, dir.string());
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_chunk_size, "10 B");
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_purge_period, "0");
+
+  std::string content;
+  for (int i = 0; i < 100; ++i) {
+    content += std::to_string(i % 10);
+  }
+  {
+    auto content_repo = std::make_shared<core::repository::DatabaseContentRepository>();
+    REQUIRE(content_repo->initialize(configuration));
+
+    minifi::ResourceClaimImpl claim(content_repo);
+    {
+      auto stream = content_repo->write(claim);
+      for (size_t offset = 0; offset < content.size(); offset += 7) {
+        const auto part = std::span(content).subspan(offset, std::min<size_t>(7, content.size() - offset));
+        REQUIRE(stream->write(as_bytes(part)) == part.size());
+      }
+    }
+    REQUIRE(content_repo->size(claim) == content.size());
+
+    auto read_stream = content_repo->read(claim);
+    read_stream->seek(25);
+    std::string read_content(content.size() - 25, '\0');
+    REQUIRE(read_stream->read(as_writable_bytes(std::span(read_content))) == read_content.size());
+    CHECK(read_content == content.substr(25));
+
+    minifi::ResourceClaimImpl removed_claim(content_repo);
+    content_repo->write(removed_claim)->write(as_bytes(std::span(content)));
+    REQUIRE(content_repo->exists(removed_claim));
+    REQUIRE(content_repo->remove(removed_claim));
+    REQUIRE_FALSE(content_repo->exists(removed_claim));
+
+    // ensure that the content is not deleted during resource claim destruction
+    content_repo->incrementStreamCount(claim);
+  }
+
+  REQUIRE(getDbSize(dir) == 10);
+
+  {
+    auto content_repo = std::make_shared<core::repository::DatabaseContentRepository>();
+    REQUIRE(content_repo->initialize(configuration));
+    content_repo->clearOrphans();
+  }
+
+  REQUIRE(getDbSize(dir) == 0);
+}
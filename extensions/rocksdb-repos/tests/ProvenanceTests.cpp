@@ -18,8 +18,10 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <utility>
 #include <string>
+#include <vector>
 
 #include "core/Core.h"
 #include "core/repository/AtomicRepoEntries.h"
@@ -159,3 +161,58 @@ TEST_CASE("Test Provenance record serialization NoOp", "[Testprovenance::Provena
   record2->setEventId(eventId);
   REQUIRE(record2->loadFromRepository(testRepository) == false);
 }
+
+TEST_CASE("Provenance events keep the attributes of the flow file at the time of the event", "[Testprovenance::ProvenanceEventRecord]") {
+  auto flow_file = std::make_shared<minifi::FlowFileRecordImpl>();
+  flow_file->setAttribute("potato", "potatoe");
+
+  auto record1 = std::make_shared<provenance::ProvenanceEventRecordImpl>(provenance::ProvenanceEventRecord::ProvenanceEventType::CREATE, "componentid", "componenttype");
+  record1->fromFlowFile(*flow_file);
+  flow_file->setAttribute("potato", "mashed");
+  flow_file->setAttribute("tomato", "tomatoe");
+  REQUIRE(record1->getAttributes() == std::map<std::string, std::string>{{"potato", "potatoe"}});
+
+  std::shared_ptr<core::Repository> testRepository = std::make_shared<TestRepository>();
+  testRepository->storeElement(record1);
+  auto record2 = std::make_shared<provenance::ProvenanceEventRecordImpl>();
+  record2->setEventId(record1->getEventId());
+  REQUIRE(record2->loadFromRepository(testRepository));
+  REQUIRE(record2->getAttributes() == record1->getAttributes());
+}
+
+TEST_CASE("Provenance events are sampled by the UUID of the flow file", "[Testprovenance::ProvenanceReporter]") {
+  std::shared_ptr<core::Repository> testRepository = std::make_shared<TestRepository>();
+  std::vector<std::shared_ptr<minifi::FlowFileRecordImpl>> flow_files;
+  for (int i = 0; i < 1000; ++i) {
+    flow_files.push_back(std::make_shared<minifi::FlowFileRecordImpl>());
+  }
+  const auto record_events = [&](double sampling_ratio, int& details_generated) {
+    auto reporter = std::make_shared<provenance::ProvenanceReporterImpl>(testRepository, "componentid", "componenttype", sampling_ratio);
+    for (const auto& flow_file : flow_files) {
+      reporter->create(*flow_file, [&] { ++details_generated; return std::string{"created"}; });
+    }
+    std::set<utils::Identifier> recorded_flow_files;
+    for (const auto& event : reporter->getEvents()) {
+      CHECK(event->getDetails() == "created");
+      recorded_flow_files.insert(event->getFlowFileUuid());
+    }
+    return recorded_flow_files;
+  };
+
+  int details_generated = 0;
+  SECTION("Every event is recorded by default") {
+    CHECK(record_events(1.0, details_generated).size() == flow_files.size());
+    CHECK(details_generated == 1000);
+  }
+  SECTION("No event is recorded and no details are generated with a zero ratio") {
+    CHECK(record_events(0.0, details_generated).empty());
+    CHECK(details_generated == 0);
+  }
+  SECTION("The same flow files are recorded by every reporter") {
+    const auto recorded = record_events(0.5, details_generated);
+    CHECK(recorded.size() > 400);
+    CHECK(recorded.size() < 600);
+    CHECK(details_generated == gsl::narrow<int>(recorded.size()));
+    CHECK(record_events(0.5, details_generated) == recorded);
+  }
+}
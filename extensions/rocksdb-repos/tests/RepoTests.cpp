@@ -16,10 +16,12 @@
  * limitations under the License.
  */
 
+#include <atomic>
 #include <chrono>
 #include <map>
 #include <string>
 #include <thread>
+#include <vector>
 #include <optional>
 
 #include "core/Core.h"
@@ -833,4 +835,53 @@ TEST_CASE("FlowFileRepository can filter out too small contents") {
   CHECK(connection->getQueueSize() == expected_flowfiles);
 }
 
+TEST_CASE("Concurrent MultiPut calls are all persisted", "[TestFFR8]") {
+  TestController testController;
+  const auto dir = testController.createTempDirectory();
+  const auto repository = std::make_shared<core::repository::FlowFileRepository>("ff", dir.string(), 0ms, 0, 1ms);
+  REQUIRE(repository->initialize(std::make_shared<minifi::ConfigureImpl>()));
+
+  constexpr size_t THREAD_COUNT = 8;
+  constexpr size_t PUTS_PER_THREAD = 50;
+  std::vector<std::thread> threads;
+  std::atomic<size_t> failed_puts{0};
+  for (size_t thread_index = 0; thread_index < THREAD_COUNT; ++thread_index) {
+    threads.emplace_back([&repository, &failed_puts, thread_index] {
+      for (size_t put_index = 0; put_index < PUTS_PER_THREAD; ++put_index) {
+        std::vector<std::pair<std::string, std::unique_ptr<minifi::io::BufferStream>>> data;
+        for (const auto* suffix : {"a", "b"}) {
+          auto stream = std::make_unique<minifi::io::BufferStream>();
+          stream->write(fmt::format("value-{}-{}", thread_index, put_index));
+          data.emplace_back(fmt::format("key-{}-{}-{}", thread_index, put_index, suffix), std::move(stream));
+        }
+        if (!repository->MultiPut(data)) {
+          ++failed_puts;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  REQUIRE(failed_puts == 0);
+
+  for (size_t thread_index = 0; thread_index < THREAD_COUNT; ++thread_index) {
+    for (size_t put_index = 0; put_index < PUTS_PER_THREAD; ++put_index) {
+      std::string value;
+      REQUIRE(repository->Get(fmt::format("key-{}-{}-b", thread_index, put_index), value));
+      minifi::io::BufferStream stream(value);
+      std::string deserialized_value;
+      stream.read(deserialized_value);
+      CHECK(deserialized_value == fmt::format("value-{}-{}", thread_index, put_index));
+    }
+  }
+
+  const auto stats = repository->getRocksDbStats();
+  REQUIRE(stats);
+  REQUIRE(stats->write_group_stats);
+  CHECK(stats->write_group_stats->grouped_write_count == THREAD_COUNT * PUTS_PER_THREAD);
+  CHECK(stats->write_group_stats->write_group_count > 0);
+  CHECK(stats->write_group_stats->write_group_count <= THREAD_COUNT * PUTS_PER_THREAD);
+}
+
 }  // namespace
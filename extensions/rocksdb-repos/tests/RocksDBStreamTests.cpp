@@ -50,6 +50,7 @@ TEST_CASE_METHOD(RocksDBStreamTest, "Verify simple operation") {
   const auto second_write_result = outStream.write(content);
   REQUIRE(second_write_result > 0);
   REQUIRE_FALSE(minifi::io::isError(second_write_result));
+  outStream.close();
   minifi::io::RocksDbStream inStream("one", gsl::make_not_null(db.get()));
   std::string str;
   inStream.read(str);
@@ -71,6 +72,7 @@ TEST_CASE_METHOD(RocksDBStreamTest, "Read zero bytes") {
   const auto banana_write_result = one.write("banana");
   REQUIRE_FALSE(minifi::io::isError(banana_write_result));
   REQUIRE(banana_write_result > 0);
+  one.close();
 
   minifi::io::RocksDbStream stream("one", gsl::make_not_null(db.get()));
 
@@ -81,3 +83,59 @@ TEST_CASE_METHOD(RocksDBStreamTest, "Read zero bytes") {
 
   REQUIRE(minifi::io::isError(nonExistingStream.read(std::span(fake_buffer).subspan(0, 0))));
 }
+
+TEST_CASE_METHOD(RocksDBStreamTest, "Content is stored in chunks") {
+  constexpr size_t chunk_size = 4;
+  const std::string content = "abcdefghijklmnopqrstuvwxyz";
+  {
+    minifi::io::RocksDbStream outStream("one", gsl::make_not_null(db.get()), true, nullptr, true, false, chunk_size);
+    REQUIRE(outStream.write(as_bytes(std::span(content)).subspan(0, 3)) == 3);
+    REQUIRE(outStream.write(as_bytes(std::span(content)).subspan(3)) == content.size() - 3);
+    REQUIRE(outStream.size() == content.size());
+  }
+  {
+    minifi::io::RocksDbStream appendStream("one", gsl::make_not_null(db.get()), true, nullptr, true, false, chunk_size);
+    REQUIRE(appendStream.size() == content.size());
+    REQUIRE(appendStream.write(as_bytes(std::span(content))) == content.size());
+  }
+
+  size_t chunk_count = 0;
+  auto opendb = db->open();
+  REQUIRE(opendb);
+  auto it = opendb->NewIterator({});
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    CHECK(it->value().size() <= chunk_size);
+    CHECK(minifi::io::RocksDbStream::pathOfKey(it->key().ToString()) == "one");
+    ++chunk_count;
+  }
+  CHECK(chunk_count == 14);
+
+  minifi::io::RocksDbStream inStream("one", gsl::make_not_null(db.get()));
+  REQUIRE(inStream.size() == 2 * content.size());
+  std::string read_content(inStream.size(), '\0');
+  REQUIRE(inStream.read(as_writable_bytes(std::span(read_content))) == read_content.size());
+  CHECK(read_content == content + content);
+
+  inStream.seek(30);
+  std::string middle(3, '\0');
+  REQUIRE(inStream.read(as_writable_bytes(std::span(middle))) == middle.size());
+  CHECK(middle == "efg");
+}
+
+TEST_CASE_METHOD(RocksDBStreamTest, "Chunks are appended to content stored as a single value") {
+  {
+    auto opendb = db->open();
+    REQUIRE(opendb);
+    REQUIRE(opendb->Put(rocksdb::WriteOptions{}, "one", "stored as a single value, ").ok());
+  }
+  const std::string content = "appended in chunks";
+  {
+    minifi::io::RocksDbStream outStream("one", gsl::make_not_null(db.get()), true, nullptr, true, false, 5);
+    REQUIRE(outStream.write(as_bytes(std::span(content))) == content.size());
+  }
+
+  minifi::io::RocksDbStream inStream("one", gsl::make_not_null(db.get()));
+  std::string read_content(inStream.size(), '\0');
+  REQUIRE(inStream.read(as_writable_bytes(std::span(read_content))) == read_content.size());
+  CHECK(read_content == "stored as a single value, appended in chunks");
+}
@@ -80,6 +80,14 @@ class Statement {
   virtual ~Statement() = default;
   virtual std::unique_ptr<Rowset> execute(const std::vector<std::string> &args = {}) = 0;
 
+  // Executes the statement once for each set of arguments, discarding the results.
+  // Every set of arguments must have the same size. Implementations may bind them as arrays.
+  virtual void executeBatch(const std::vector<std::vector<std::string>> &args_batch) {
+    for (const auto& args : args_batch) {
+      execute(args);
+    }
+  }
+
  protected:
   std::string query_;
 };
@@ -98,6 +106,8 @@ class Connection {
   virtual ~Connection() = default;
   virtual bool connected(std::string& exception) const = 0;
   virtual std::unique_ptr<Statement> prepareStatement(const std::string &query) const = 0;
+  // Returns a statement owned by the connection, which can be reused for executing the same query repeatedly
+  virtual Statement& getCachedStatement(const std::string &query) = 0;
   virtual std::unique_ptr<Session> getSession() const = 0;
 };
 
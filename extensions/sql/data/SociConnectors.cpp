@@ -17,10 +17,23 @@
  */
 
 #include "SociConnectors.h"
+
+#include <algorithm>
+
 #include "core/logging/LoggerFactory.h"
 
 namespace org::apache::nifi::minifi::sql {
 
+namespace {
+[[noreturn]] void throwSqlError(const soci::soci_error& ex) {
+  if (ex.get_error_category() == soci::soci_error::error_category::connection_error
+      || ex.get_error_category() == soci::soci_error::error_category::system_error) {
+    throw sql::ConnectionError(ex.get_error_message());
+  }
+  throw sql::StatementError(ex.get_error_message());
+}
+}  // namespace
+
 void SociRow::setIterator(const soci::rowset<soci::row>::iterator& iter) {
   current_ = iter;
 }
@@ -124,18 +137,67 @@ std::unique_ptr<Rowset> SociStatement::execute(const std::vector<std::string>& a
     return std::make_unique<SociRowset>(stmt);
   } catch (const soci::soci_error& ex) {
     logger_->log_error("Error while evaluating query, type: {}, what: {}", typeid(ex).name(), ex.what());
-    if (ex.get_error_category() == soci::soci_error::error_category::connection_error
-        || ex.get_error_category() == soci::soci_error::error_category::system_error) {
-      throw sql::ConnectionError(ex.get_error_message());
-    } else {
-      throw sql::StatementError(ex.get_error_message());
-    }
+    throwSqlError(ex);
   } catch (const std::exception& ex) {
     logger_->log_error("Error while evaluating query, type: {}, what: {}", typeid(ex).name(), ex.what());
     throw sql::StatementError(ex.what());
   }
 }
 
+SociPreparedStatement::SociPreparedStatement(soci::session& session, const std::string& query)
+    : SociStatement(session, query), logger_(core::logging::LoggerFactory<SociPreparedStatement>::getLogger()) {}
+
+void SociPreparedStatement::executeBatch(const std::vector<std::vector<std::string>>& args_batch) {
+  if (args_batch.empty()) {
+    return;
+  }
+  const auto argument_count = args_batch.front().size();
+  if (std::any_of(args_batch.begin(), args_batch.end(), [argument_count](const auto& args) { return args.size() != argument_count; })) {
+    throw sql::StatementError("Every set of arguments in a batch must have the same size");
+  }
+  try {
+    if (!statement_ || argument_columns_.size() != argument_count || batch_size_ != args_batch.size()) {
+      prepare(argument_count, args_batch.size());
+    }
+    if (argument_count == 0) {
+      // without bound arrays the statement is executed only once
+      for (std::size_t i = 0; i < args_batch.size(); ++i) {
+        statement_->execute(true);
+      }
+      return;
+    }
+    for (std::size_t row = 0; row < args_batch.size(); ++row) {
+      for (std::size_t column = 0; column < argument_count; ++column) {
+        argument_columns_[column][row] = args_batch[row][column];
+      }
+    }
+    statement_->execute(true);
+  } catch (const soci::soci_error& ex) {
+    logger_->log_error("Error while executing batch of {} argument sets, type: {}, what: {}", args_batch.size(), typeid(ex).name(), ex.what());
+    statement_.reset();
+    throwSqlError(ex);
+  } catch (const std::exception& ex) {
+    logger_->log_error("Error while executing batch of {} argument sets, type: {}, what: {}", args_batch.size(), typeid(ex).name(), ex.what());
+    statement_.reset();
+    throw sql::StatementError(ex.what());
+  }
+}
+
+void SociPreparedStatement::prepare(std::size_t argument_count, std::size_t batch_size) {
+  statement_.reset();
+  argument_columns_.assign(argument_count, std::vector<std::string>(batch_size));
+  batch_size_ = batch_size;
+  auto statement = std::make_unique<soci::statement>(session_);
+  for (auto& column : argument_columns_) {
+    statement->exchange(soci::use(column));
+  }
+  statement->alloc();
+  statement->prepare(query_);
+  statement->define_and_bind();
+  statement_ = std::move(statement);
+  logger_->log_debug("Prepared statement \"{}\" for batches of {}", query_, batch_size);
+}
+
 void SociSession::begin() {
   session_.begin();
 }
@@ -174,6 +236,21 @@ std::unique_ptr<sql::Statement> ODBCConnection::prepareStatement(const std::stri
   return std::make_unique<sql::SociStatement>(*session_, query);
 }
 
+sql::Statement& ODBCConnection::getCachedStatement(const std::string& query) {
+  const auto it = std::find_if(cached_statements_.begin(), cached_statements_.end(), [&query](const auto& cached_statement) {
+    return cached_statement.first == query;
+  });
+  if (it != cached_statements_.end()) {
+    cached_statements_.splice(cached_statements_.begin(), cached_statements_, it);
+    return *cached_statements_.front().second;
+  }
+  if (cached_statements_.size() >= MAX_CACHED_STATEMENTS) {
+    cached_statements_.pop_back();
+  }
+  cached_statements_.emplace_front(query, std::make_unique<SociPreparedStatement>(*session_, query));
+  return *cached_statements_.front().second;
+}
+
 std::unique_ptr<Session> ODBCConnection::getSession() const {
   return std::make_unique<sql::SociSession>(*session_);
 }
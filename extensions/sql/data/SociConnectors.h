@@ -21,7 +21,10 @@
 #include <soci/soci.h>
 #include <soci/odbc/soci-odbc.h>
 #include <memory>
+#include <list>
 #include <string>
+#include <utility>
+#include <vector>
 #include <ctime>
 
 #include "minifi-cpp/Exception.h"
@@ -79,6 +82,24 @@ class SociStatement : public Statement {
   std::shared_ptr<core::logging::Logger> logger_;
 };
 
+// Keeps the statement prepared between executions of argument batches of the same size,
+// and binds the arguments of a batch as arrays, so that drivers supporting it execute them in a single round trip.
+class SociPreparedStatement : public SociStatement {
+ public:
+  SociPreparedStatement(soci::session& session, const std::string &query);
+
+  void executeBatch(const std::vector<std::vector<std::string>>& args_batch) override;
+
+ private:
+  void prepare(std::size_t argument_count, std::size_t batch_size);
+
+  std::unique_ptr<soci::statement> statement_;
+  // the values of the Nth argument of each set in the batch, bound to the Nth parameter of the statement
+  std::vector<std::vector<std::string>> argument_columns_;
+  std::size_t batch_size_ = 0;
+  std::shared_ptr<core::logging::Logger> logger_;
+};
+
 class SociSession : public Session {
  public:
   explicit SociSession(soci::session& session)
@@ -100,14 +121,19 @@ class ODBCConnection : public sql::Connection {
 
   bool connected(std::string& exception) const override;
   std::unique_ptr<sql::Statement> prepareStatement(const std::string& query) const override;
+  sql::Statement& getCachedStatement(const std::string& query) override;
   std::unique_ptr<Session> getSession() const override;
 
  private:
   soci::connection_parameters getSessionParameters() const;
 
+  static constexpr std::size_t MAX_CACHED_STATEMENTS = 32;
+
  private:
   std::unique_ptr<soci::session> session_;
   std::string connection_string_;
+  // most recently used first, the statements have to be destroyed before the session
+  std::list<std::pair<std::string, std::unique_ptr<SociPreparedStatement>>> cached_statements_;
 };
 
 }  // namespace org::apache::nifi::minifi::sql
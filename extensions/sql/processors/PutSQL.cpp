@@ -19,6 +19,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "io/BufferStream.h"
 #include "minifi-cpp/core/ProcessContext.h"
@@ -26,6 +27,7 @@
 #include "core/Resource.h"
 #include "minifi-cpp/Exception.h"
 #include "core/logging/LoggerFactory.h"
+#include "utils/ProcessorConfigUtils.h"
 
 namespace org::apache::nifi::minifi::processors {
 
@@ -38,20 +40,31 @@ void PutSQL::processOnSchedule(core::ProcessContext& context) {
   if (auto sql_statement = context.getProperty(SQLStatement); sql_statement && sql_statement->empty()) {
     throw Exception(PROCESSOR_EXCEPTION, "Empty SQL statement");
   }
+  batch_size_ = utils::parseU64Property(context, BatchSize);
+}
+
+std::string PutSQL::getSqlStatement(core::ProcessContext& context, core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file) const {
+  std::string sql_statement = context.getProperty(SQLStatement).value_or("");
+  if (sql_statement.empty()) {
+    logger_->log_debug("Using the contents of the flow file as the SQL statement");
+    sql_statement = to_string(session.readBuffer(flow_file));
+  }
+  return sql_statement;
 }
 
 void PutSQL::processOnTrigger(core::ProcessContext& context, core::ProcessSession& session) {
+  if (batch_size_ > 1) {
+    processBatches(context, session);
+    return;
+  }
+
   auto flow_file = session.get();
   if (!flow_file) {
     context.yield();
     return;
   }
 
-  std::string sql_statement = context.getProperty(SQLStatement).value_or("");
-  if (sql_statement.empty()) {
-    logger_->log_debug("Using the contents of the flow file as the SQL statement");
-    sql_statement = to_string(session.readBuffer(flow_file));
-  }
+  const std::string sql_statement = getSqlStatement(context, session, flow_file);
 
   try {
     connection_->prepareStatement(sql_statement)->execute(collectArguments(flow_file));
@@ -62,6 +75,59 @@ void PutSQL::processOnTrigger(core::ProcessContext& context, core::ProcessSessio
   }
 }
 
+void PutSQL::processBatches(core::ProcessContext& context, core::ProcessSession& session) {
+  std::vector<Batch> batches;
+  for (uint64_t i = 0; i < batch_size_; ++i) {
+    auto flow_file = session.get();
+    if (!flow_file) {
+      break;
+    }
+    auto sql_statement = getSqlStatement(context, session, flow_file);
+    auto arguments = collectArguments(flow_file);
+    // only consecutive flow files are batched together, so that the statements are executed in the order of the flow files
+    if (batches.empty() || batches.back().sql_statement != sql_statement || batches.back().arguments.front().size() != arguments.size()) {
+      batches.push_back(Batch{.sql_statement = std::move(sql_statement), .flow_files = {}, .arguments = {}});
+    }
+    batches.back().flow_files.push_back(std::move(flow_file));
+    batches.back().arguments.push_back(std::move(arguments));
+  }
+
+  if (batches.empty()) {
+    context.yield();
+    return;
+  }
+
+  for (const auto& batch : batches) {
+    executeBatch(session, batch);
+  }
+}
+
+void PutSQL::executeBatch(core::ProcessSession& session, const Batch& batch) {
+  const auto database_session = connection_->getSession();
+  try {
+    database_session->begin();
+    connection_->getCachedStatement(batch.sql_statement).executeBatch(batch.arguments);
+    database_session->commit();
+    for (const auto& flow_file : batch.flow_files) {
+      session.transfer(flow_file, Success);
+    }
+    return;
+  } catch (const sql::StatementError& ex) {
+    logger_->log_warn("Error while executing SQL statement for a batch of {} flow files, executing them one by one: {}", batch.flow_files.size(), ex.what());
+    database_session->rollback();
+  }
+
+  for (size_t i = 0; i < batch.flow_files.size(); ++i) {
+    try {
+      connection_->getCachedStatement(batch.sql_statement).executeBatch({batch.arguments[i]});
+      session.transfer(batch.flow_files[i], Success);
+    } catch (const sql::StatementError& ex) {
+      logger_->log_error("Error while executing SQL statement in flow file: {}", ex.what());
+      session.transfer(batch.flow_files[i], Failure);
+    }
+  }
+}
+
 REGISTER_RESOURCE(PutSQL, Processor);
 
 }  // namespace org::apache::nifi::minifi::processors
@@ -20,7 +20,9 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "core/ProcessSession.h"
 #include "core/PropertyDefinitionBuilder.h"
@@ -48,7 +50,15 @@ class PutSQL : public SQLProcessor {
       .isRequired(false)
       .supportsExpressionLanguage(true)
       .build();
-  EXTENSIONAPI static constexpr auto Properties = utils::array_cat(SQLProcessor::Properties, std::to_array<core::PropertyReference>({SQLStatement}));
+  EXTENSIONAPI static constexpr auto BatchSize = core::PropertyDefinitionBuilder<>::createProperty("Batch Size")
+      .withDescription(
+        "The maximum number of flow files to take in a single trigger. Consecutive flow files with the same SQL statement and number of arguments are executed "
+        "in a single transaction, reusing the prepared statement and binding their arguments as arrays where the driver supports it. "
+        "If a batch fails, its flow files are executed one by one, so that only the failing ones are routed to failure.")
+      .withValidator(core::StandardPropertyValidators::UNSIGNED_INTEGER_VALIDATOR)
+      .withDefaultValue("1")
+      .build();
+  EXTENSIONAPI static constexpr auto Properties = utils::array_cat(SQLProcessor::Properties, std::to_array<core::PropertyReference>({SQLStatement, BatchSize}));
 
   EXTENSIONAPI static constexpr auto Success = core::RelationshipDefinition{"success", "After a successful SQL update operation, the incoming FlowFile sent here"};
   EXTENSIONAPI static constexpr auto Failure = core::RelationshipDefinition{"failure", "Flow files that contain malformed sql statements"};
@@ -65,6 +75,19 @@ class PutSQL : public SQLProcessor {
   void processOnTrigger(core::ProcessContext& context, core::ProcessSession& session) override;
 
   void initialize() override;
+
+ private:
+  struct Batch {
+    std::string sql_statement;
+    std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+    std::vector<std::vector<std::string>> arguments;
+  };
+
+  std::string getSqlStatement(core::ProcessContext& context, core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file) const;
+  void processBatches(core::ProcessContext& context, core::ProcessSession& session);
+  void executeBatch(core::ProcessSession& session, const Batch& batch);
+
+  uint64_t batch_size_ = 1;
 };
 
 }  // namespace org::apache::nifi::minifi::processors
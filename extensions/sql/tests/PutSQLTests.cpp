@@ -15,6 +15,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "unit/TestBase.h"
 #include "unit/TestUtils.h"
 #include "unit/Catch.h"
@@ -158,3 +163,118 @@ TEST_CASE("PutSQL routes to failure on malformed content statement") {
   REQUIRE(output.size() == 1);
   REQUIRE(output.at(0) == input_file);
 }
+
+TEST_CASE("PutSQL executes the flow files of a batch together") {
+  SQLTestController testController;
+
+  auto plan = testController.createSQLPlan("PutSQL", {{"success", "d"}, {"failure", "d"}});
+  auto sql_proc = plan->getSQLProcessor();
+  REQUIRE(sql_proc->setProperty(minifi::processors::PutSQL::BatchSize.name, "10"));
+
+  std::vector<std::shared_ptr<core::FlowFile>> good_files;
+  for (int i = 1; i <= 3; ++i) {
+    good_files.push_back(plan->addInput({
+      {"sql.args.1.value", std::to_string(i)},
+      {"sql.args.2.value", "row" + std::to_string(i)}
+    }, "INSERT INTO test_table VALUES(?, ?);"));
+  }
+  auto bad_file = plan->addInput({
+    {"sql.args.1.value", "42"}
+  }, "INSERT INTO no_such_table VALUES(?);");
+  good_files.push_back(plan->addInput({
+    {"sql.args.1.value", "4"}
+  }, "INSERT INTO test_table (int_col, text_col) VALUES(?, 'constant');"));
+
+  plan->run();
+
+  auto success_files = plan->getOutputs({"success", "d"});
+  REQUIRE(success_files.size() == 4);
+  for (const auto& good_file : good_files) {
+    CHECK(std::find(success_files.begin(), success_files.end(), good_file) != success_files.end());
+  }
+  auto failure_files = plan->getOutputs({"failure", "d"});
+  REQUIRE(failure_files.size() == 1);
+  CHECK(failure_files.at(0) == bad_file);
+
+  auto rows = testController.fetchValues();
+  std::sort(rows.begin(), rows.end(), [](const TableRow& lhs, const TableRow& rhs) { return lhs.int_col < rhs.int_col; });
+  REQUIRE(rows.size() == 4);
+  CHECK(rows[0].int_col == 1);
+  CHECK(rows[0].text_col == "row1");
+  CHECK(rows[2].int_col == 3);
+  CHECK(rows[2].text_col == "row3");
+  CHECK(rows[3].int_col == 4);
+  CHECK(rows[3].text_col == "constant");
+}
+
+TEST_CASE("PutSQL executes interleaved statements in the order of the flow files") {
+  SQLTestController testController;
+
+  auto plan = testController.createSQLPlan("PutSQL", {{"success", "d"}, {"failure", "d"}});
+  auto sql_proc = plan->getSQLProcessor();
+  REQUIRE(sql_proc->setProperty(minifi::processors::PutSQL::BatchSize.name, "10"));
+
+  plan->addInput({
+    {"sql.args.1.value", "1"},
+    {"sql.args.2.value", "row1"}
+  }, "INSERT INTO test_table VALUES(?, ?);");
+  plan->addInput({
+    {"sql.args.1.value", "2"}
+  }, "INSERT INTO test_table (int_col, text_col) VALUES(?, 'constant');");
+  plan->addInput({
+    {"sql.args.1.value", "3"},
+    {"sql.args.2.value", "row3"}
+  }, "INSERT INTO test_table VALUES(?, ?);");
+
+  plan->run();
+
+  CHECK(plan->getOutputs({"success", "d"}).size() == 3);
+  CHECK(plan->getOutputs({"failure", "d"}).empty());
+
+  auto rows = testController.fetchValues();
+  REQUIRE(rows.size() == 3);
+  CHECK(rows[0].int_col == 1);
+  CHECK(rows[1].int_col == 2);
+  CHECK(rows[1].text_col == "constant");
+  CHECK(rows[2].int_col == 3);
+}
+
+#ifdef MINIFI_USE_REAL_ODBC_TEST_DRIVER
+TEST_CASE("PutSQL routes only the failing flow file of a batch to failure") {
+  SQLTestController testController;
+  testController.execute("CREATE UNIQUE INDEX test_table_int_col ON test_table (int_col);");
+  testController.insertValues({{2, "existing"}});
+
+  auto plan = testController.createSQLPlan("PutSQL", {{"success", "d"}, {"failure", "d"}});
+  auto sql_proc = plan->getSQLProcessor();
+  REQUIRE(sql_proc->setProperty(minifi::processors::PutSQL::BatchSize.name, "10"));
+
+  std::vector<std::shared_ptr<core::FlowFile>> input_files;
+  for (int i = 1; i <= 3; ++i) {
+    input_files.push_back(plan->addInput({
+      {"sql.args.1.value", std::to_string(i)},
+      {"sql.args.2.value", "row" + std::to_string(i)}
+    }, "INSERT INTO test_table VALUES(?, ?);"));
+  }
+
+  plan->run();
+
+  auto success_files = plan->getOutputs({"success", "d"});
+  REQUIRE(success_files.size() == 2);
+  CHECK(std::find(success_files.begin(), success_files.end(), input_files[0]) != success_files.end());
+  CHECK(std::find(success_files.begin(), success_files.end(), input_files[2]) != success_files.end());
+  auto failure_files = plan->getOutputs({"failure", "d"});
+  REQUIRE(failure_files.size() == 1);
+  CHECK(failure_files.at(0) == input_files[1]);
+
+  auto rows = testController.fetchValues();
+  std::sort(rows.begin(), rows.end(), [](const TableRow& lhs, const TableRow& rhs) { return lhs.int_col < rhs.int_col; });
+  REQUIRE(rows.size() == 3);
+  CHECK(rows[0].int_col == 1);
+  CHECK(rows[0].text_col == "row1");
+  CHECK(rows[1].int_col == 2);
+  CHECK(rows[1].text_col == "existing");
+  CHECK(rows[2].int_col == 3);
+  CHECK(rows[2].text_col == "row3");
+}
+#endif
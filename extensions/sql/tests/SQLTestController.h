@@ -85,6 +85,10 @@ class SQLTestController : public TestController {
     }
   }
 
+  void execute(const std::string& statement) {
+    ODBCConnection{connection_str_}.prepareStatement(statement)->execute();
+  }
+
   std::vector<TableRow> fetchValues() {
     std::vector<TableRow> rows;
     ODBCConnection connection{connection_str_};
@@ -419,6 +419,14 @@ std::unique_ptr<sql::Statement> MockODBCConnection::prepareStatement(const std::
   return std::make_unique<sql::MockStatement>(query, file_path_);
 }
 
+sql::Statement& MockODBCConnection::getCachedStatement(const std::string& query) {
+  auto& statement = cached_statements_[query];
+  if (!statement) {
+    statement = prepareStatement(query);
+  }
+  return *statement;
+}
+
 std::unique_ptr<Session> MockODBCConnection::getSession() const {
   return std::make_unique<sql::MockSession>();
 }
@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "data/DatabaseConnectors.h"
 #include "utils/StringUtils.h"
@@ -155,11 +156,13 @@ class MockODBCConnection : public Connection {
   explicit MockODBCConnection(std::string connectionString);
   bool connected(std::string& exception) const override;
   std::unique_ptr<sql::Statement> prepareStatement(const std::string& query) const override;
+  sql::Statement& getCachedStatement(const std::string& query) override;
   std::unique_ptr<Session> getSession() const override;
 
  private:
   std::string connection_string_;
   std::string file_path_;
+  std::unordered_map<std::string, std::unique_ptr<sql::Statement>> cached_statements_;
 };
 
 }  // namespace org::apache::nifi::minifi::sql
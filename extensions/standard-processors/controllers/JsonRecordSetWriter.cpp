@@ -67,69 +67,94 @@ rapidjson::Value toJson(const core::RecordObject& field, rapidjson::Document::Al
   }
   return object_json;
 }
-}  // namespace
 
-void JsonRecordSetWriter::onEnable() {
-  output_grouping_ = getProperty(OutputGrouping.name) | utils::andThen(parsing::parseEnum<OutputGroupingType>) | utils::orThrow("JsonRecordSetWriter::OutputGrouping is required property");
-  pretty_print_ = getProperty(PrettyPrint.name) | utils::andThen(parsing::parseBool) | utils::orThrow("Missing JsonRecordSetWriter::PrettyPrint despite default value");
+void convertRecord(const core::Record& record, rapidjson::Value& record_json, rapidjson::Document::AllocatorType& alloc) {
+  for (const auto& [field_name, field_val] : record) {
+    rapidjson::Value json_name(field_name.c_str(), gsl::narrow<rapidjson::SizeType>(field_name.length()), alloc);
+    rapidjson::Value json_value = (std::visit([&alloc](auto&& f)-> rapidjson::Value{ return toJson(f, alloc); }, field_val.value_));
+    record_json.AddMember(json_name, json_value, alloc);
+  }
 }
 
-void JsonRecordSetWriter::writePerLine(const core::RecordSet& record_set, const std::shared_ptr<core::FlowFile>& flow_file, core::ProcessSession& session) {
-  session.write(flow_file, [&record_set](const std::shared_ptr<io::OutputStream>& stream) -> int64_t {
-    int64_t write_result = 0;
-    for (const auto& record : record_set) {
-      auto doc = rapidjson::Document(rapidjson::kObjectType);
-      auto& allocator = doc.GetAllocator();
-      convertRecord(record, doc, allocator);
-      rapidjson::StringBuffer buffer;
-      rapidjson::Writer writer(buffer);
-      doc.Accept(writer);
-      write_result += gsl::narrow<int64_t>(stream->write(gsl::make_span(fmt::format("{}\n", buffer.GetString())).as_span<const std::byte>()));
+// Serializes each record as soon as it is written, only the JSON text of the current record is buffered
+class JsonRecordWriter : public core::RecordWriter {
+ public:
+  JsonRecordWriter(io::OutputStream& output_stream, OutputGroupingType output_grouping, bool pretty_print)
+      : output_stream_(output_stream),
+        output_grouping_(output_grouping),
+        pretty_print_(pretty_print) {
+  }
+
+  size_t write(const core::Record& record) override {
+    auto doc = rapidjson::Document(rapidjson::kObjectType);
+    convertRecord(record, doc, doc.GetAllocator());
+    switch (output_grouping_) {
+      case OutputGroupingType::ARRAY:
+        startArrayIfNeeded();
+        if (pretty_print_) {
+          doc.Accept(pretty_writer_);
+        } else {
+          doc.Accept(writer_);
+        }
+        break;
+      case OutputGroupingType::ONE_LINE_PER_OBJECT: {
+        rapidjson::Writer line_writer(buffer_);
+        doc.Accept(line_writer);
+        buffer_.Put('\n');
+        break;
+      }
     }
-    return write_result;
-  });
-}
+    return flush();
+  }
+
+  size_t finish() override {
+    if (output_grouping_ == OutputGroupingType::ARRAY) {
+      startArrayIfNeeded();
+      if (pretty_print_) {
+        pretty_writer_.EndArray();
+      } else {
+        writer_.EndArray();
+      }
+    }
+    return flush();
+  }
 
-void JsonRecordSetWriter::writeAsArray(const core::RecordSet& record_set, const std::shared_ptr<core::FlowFile>& flow_file, core::ProcessSession& session) const {
-  session.write(flow_file, [this, &record_set](const std::shared_ptr<io::OutputStream>& stream) -> int64_t {
-    auto doc = rapidjson::Document(rapidjson::kArrayType);
-    for (const auto& record : record_set) {
-      auto& allocator = doc.GetAllocator();
-      auto record_json = rapidjson::Value(rapidjson::kObjectType);
-      convertRecord(record, record_json, allocator);
-      doc.PushBack(std::move(record_json), allocator);
+ private:
+  void startArrayIfNeeded() {
+    if (array_started_) {
+      return;
     }
-    rapidjson::StringBuffer buffer;
     if (pretty_print_) {
-      rapidjson::PrettyWriter pretty_writer(buffer);
-      doc.Accept(pretty_writer);
+      pretty_writer_.StartArray();
     } else {
-      rapidjson::Writer writer(buffer);
-      doc.Accept(writer);
+      writer_.StartArray();
     }
-    return gsl::narrow<int64_t>(stream->write(gsl::make_span(fmt::format("{}", buffer.GetString())).as_span<const std::byte>()));
-  });
-}
+    array_started_ = true;
+  }
 
-void JsonRecordSetWriter::write(const core::RecordSet& record_set, const std::shared_ptr<core::FlowFile>& flow_file, core::ProcessSession& session) {
-  switch (output_grouping_) {
-    case OutputGroupingType::ARRAY:
-      writeAsArray(record_set, flow_file, session);
-      break;
-    case OutputGroupingType::ONE_LINE_PER_OBJECT:
-      writePerLine(record_set, flow_file, session);
-      break;
-    default:
-      throw std::invalid_argument(fmt::format("Invalid OutputGroupingType: {}", magic_enum::enum_underlying(output_grouping_)));
+  size_t flush() {
+    const auto write_result = output_stream_.write(reinterpret_cast<const uint8_t*>(buffer_.GetString()), buffer_.GetSize());
+    buffer_.Clear();
+    return write_result;
   }
+
+  io::OutputStream& output_stream_;
+  OutputGroupingType output_grouping_;
+  bool pretty_print_;
+  bool array_started_ = false;
+  rapidjson::StringBuffer buffer_;
+  rapidjson::Writer<rapidjson::StringBuffer> writer_{buffer_};
+  rapidjson::PrettyWriter<rapidjson::StringBuffer> pretty_writer_{buffer_};
+};
+}  // namespace
+
+void JsonRecordSetWriter::onEnable() {
+  output_grouping_ = getProperty(OutputGrouping.name) | utils::andThen(parsing::parseEnum<OutputGroupingType>) | utils::orThrow("JsonRecordSetWriter::OutputGrouping is required property");
+  pretty_print_ = getProperty(PrettyPrint.name) | utils::andThen(parsing::parseBool) | utils::orThrow("Missing JsonRecordSetWriter::PrettyPrint despite default value");
 }
 
-void JsonRecordSetWriter::convertRecord(const core::Record& record, rapidjson::Value& record_json, rapidjson::Document::AllocatorType& alloc) {
-  for (const auto& [field_name, field_val] : record) {
-    rapidjson::Value json_name(field_name.c_str(), gsl::narrow<rapidjson::SizeType>(field_name.length()), alloc);
-    rapidjson::Value json_value = (std::visit([&alloc](auto&& f)-> rapidjson::Value{ return toJson(f, alloc); }, field_val.value_));
-    record_json.AddMember(json_name, json_value, alloc);
-  }
+std::unique_ptr<core::RecordWriter> JsonRecordSetWriter::createRecordWriter(io::OutputStream& output_stream) {
+  return std::make_unique<JsonRecordWriter>(output_stream, output_grouping_, pretty_print_);
 }
 
 REGISTER_RESOURCE(JsonRecordSetWriter, ControllerService);
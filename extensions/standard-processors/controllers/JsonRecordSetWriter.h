@@ -16,6 +16,8 @@
  */
 #pragma once
 
+#include <memory>
+
 #include "core/PropertyDefinitionBuilder.h"
 #include "controllers/RecordSetWriter.h"
 #include "minifi-cpp/core/FlowFile.h"
@@ -86,7 +88,7 @@ class JsonRecordSetWriter final : public core::RecordSetWriterImpl {
   EXTENSIONAPI static constexpr auto ImplementsApis = std::array{ RecordSetWriter::ProvidesApi };
   ADD_COMMON_VIRTUAL_FUNCTIONS_FOR_CONTROLLER_SERVICES
 
-  void write(const core::RecordSet& record_set, const std::shared_ptr<core::FlowFile>& flow_file, core::ProcessSession& session) override;
+  std::unique_ptr<core::RecordWriter> createRecordWriter(io::OutputStream& output_stream) override;
 
   void initialize() override {
     setSupportedProperties(Properties);
@@ -97,10 +99,6 @@ class JsonRecordSetWriter final : public core::RecordSetWriterImpl {
   bool isWorkAvailable() override { return false; }
 
  private:
-  void writeAsArray(const core::RecordSet& record_set, const std::shared_ptr<core::FlowFile>& flow_file, core::ProcessSession& session) const;
-  static void writePerLine(const core::RecordSet& record_set, const std::shared_ptr<core::FlowFile>& flow_file, core::ProcessSession& session);
-  static void convertRecord(const core::Record& record, rapidjson::Value& record_json, rapidjson::Document::AllocatorType& alloc);
-
   OutputGroupingType output_grouping_ = OutputGroupingType::ARRAY;
   bool pretty_print_ = false;
 };
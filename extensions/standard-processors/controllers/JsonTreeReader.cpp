@@ -17,6 +17,11 @@
 
 #include "JsonTreeReader.h"
 
+#include <algorithm>
+#include <cctype>
+#include <optional>
+#include <string>
+
 #include "core/Resource.h"
 #include "rapidjson/document.h"
 
@@ -89,57 +94,164 @@ nonstd::expected<core::Record, std::error_code> parseRecord(rapidjson::Value& re
   }
   return result;
 }
-}  // namespace
 
-bool readAsJsonLines(const std::string& content, core::RecordSet& record_set) {
-  std::stringstream ss(content);
-  std::string line;
-  while (std::getline(ss, line, '\n')) {
-    rapidjson::Document document;
-    if (rapidjson::ParseResult parse_result = document.Parse<rapidjson::kParseStopWhenDoneFlag>(line); parse_result.IsError())
-      return false;
-    auto record = parseRecord(document);
-    if (!record)
-      return false;
-    record_set.push_back(std::move(*record));
+// Reads the input stream in chunks, so the content does not have to be copied into memory as a whole
+class ChunkedInput {
+ public:
+  explicit ChunkedInput(io::InputStream& input_stream) : input_stream_(input_stream) {}
+
+  // Returns the next character without consuming it, or std::nullopt at the end of the stream or after a read error
+  std::optional<char> peek() {
+    if (position_ == buffer_.size() && !fill()) {
+      return std::nullopt;
+    }
+    return buffer_[position_];
+  }
+
+  std::optional<char> get() {
+    const auto result = peek();
+    if (result) {
+      ++position_;
+    }
+    return result;
   }
-  return true;
-}
 
-bool readAsArray(const std::string& content, core::RecordSet& record_set) {
-  rapidjson::Document document;
-  if (const rapidjson::ParseResult parse_result = document.Parse<rapidjson::kParseStopWhenDoneFlag>(content); parse_result.IsError())
-    return false;
-  if (!document.IsArray())
-    return false;
-  for (auto& json_record : document.GetArray()) {
-    auto record  = parseRecord(json_record);
-    if (!record)
+  // Same semantics as std::getline: returns false only if the end of the stream was reached without reading anything
+  bool getLine(std::string& line) {
+    line.clear();
+    while (position_ < buffer_.size() || fill()) {
+      const auto chunk_begin = buffer_.begin() + gsl::narrow<std::ptrdiff_t>(position_);
+      const auto newline = std::find(chunk_begin, buffer_.end(), '\n');
+      line.append(chunk_begin, newline);
+      position_ = gsl::narrow<size_t>(std::distance(buffer_.begin(), newline));
+      if (newline != buffer_.end()) {
+        ++position_;
+        return true;
+      }
+    }
+    return !line.empty();
+  }
+
+  [[nodiscard]] bool failed() const { return failed_; }
+
+ private:
+  static constexpr size_t CHUNK_SIZE = 8192;
+
+  bool fill() {
+    if (failed_ || finished_) {
       return false;
-    record_set.push_back(std::move(*record));
+    }
+    buffer_.resize(CHUNK_SIZE);
+    position_ = 0;
+    const auto read_result = input_stream_.read(as_writable_bytes(std::span(buffer_)));
+    if (io::isError(read_result)) {
+      failed_ = true;
+      buffer_.clear();
+      return false;
+    }
+    buffer_.resize(read_result);
+    finished_ = read_result == 0;
+    return !finished_;
   }
-  return true;
-}
 
-nonstd::expected<core::RecordSet, std::error_code> JsonTreeReader::read(io::InputStream& input_stream) {
-  core::RecordSet record_set{};
-  const auto read_result = [&record_set](io::InputStream& input_stream) -> size_t {
-    std::string content;
-    content.resize(input_stream.size());
-    const auto read_ret = input_stream.read(as_writable_bytes(std::span(content)));
-    if (io::isError(read_ret)) {
-      return io::STREAM_ERROR;
-    }
-    if (content.starts_with('[')) {
-      readAsArray(content, record_set);
+  io::InputStream& input_stream_;
+  std::string buffer_;
+  size_t position_ = 0;
+  bool failed_ = false;
+  bool finished_ = false;
+};
+
+// Parses the records one by one: either the elements of a top level JSON array, or one JSON object per line.
+// Reading stops at the first record which is not a valid JSON object, the records before it are still returned.
+class JsonRecordReader : public core::RecordReader {
+ public:
+  explicit JsonRecordReader(io::InputStream& input_stream) : input_(input_stream) {}
+
+  nonstd::expected<std::optional<core::Record>, std::error_code> next() override {
+    if (finished_) {
+      return std::nullopt;
+    }
+    if (!format_) {
+      format_ = input_.peek() == '[' ? Format::Array : Format::Lines;
+      if (format_ == Format::Array) {
+        input_.get();
+      }
+    }
+    const bool has_next = format_ == Format::Array ? nextArrayElement() : input_.getLine(current_record_);
+    if (input_.failed()) {
+      finished_ = true;
+      return nonstd::make_unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+    if (!has_next) {
+      finished_ = true;
+      return std::nullopt;
+    }
+
+    rapidjson::Document document;
+    if (format_ == Format::Array) {
+      document.Parse(current_record_);
     } else {
-      readAsJsonLines(content, record_set);
+      document.Parse<rapidjson::kParseStopWhenDoneFlag>(current_record_);
     }
-    return read_ret;
-  }(input_stream);
-  if (io::isError(read_result))
-    return nonstd::make_unexpected(std::make_error_code(std::errc::invalid_argument));
-  return record_set;
+    if (document.HasParseError()) {
+      finished_ = true;
+      return std::nullopt;
+    }
+    auto record = parseRecord(document);
+    if (!record) {
+      finished_ = true;
+      return std::nullopt;
+    }
+    return std::optional<core::Record>{std::move(*record)};
+  }
+
+ private:
+  enum class Format { Array, Lines };
+
+  // Collects the text of the next array element into current_record_, the elements are only split here, parsing is left to rapidjson
+  bool nextArrayElement() {
+    while (input_.peek() && std::isspace(static_cast<unsigned char>(*input_.peek()))) {
+      input_.get();
+    }
+    if (!input_.peek() || *input_.peek() == ']') {
+      return false;
+    }
+
+    current_record_.clear();
+    size_t depth = 0;
+    bool in_string = false;
+    bool escaped = false;
+    while (const auto c = input_.peek()) {
+      if (in_string) {
+        in_string = escaped || *c != '"';
+        escaped = !escaped && *c == '\\';
+      } else if (depth == 0 && (*c == ',' || *c == ']')) {
+        break;
+      } else if (*c == '"') {
+        in_string = true;
+      } else if (*c == '{' || *c == '[') {
+        ++depth;
+      } else if ((*c == '}' || *c == ']') && depth > 0) {
+        --depth;
+      }
+      current_record_.push_back(*c);
+      input_.get();
+    }
+    if (input_.peek() == ',') {
+      input_.get();
+    }
+    return true;
+  }
+
+  ChunkedInput input_;
+  std::optional<Format> format_;
+  std::string current_record_;
+  bool finished_ = false;
+};
+}  // namespace
+
+std::unique_ptr<core::RecordReader> JsonTreeReader::createRecordReader(io::InputStream& input_stream) {
+  return std::make_unique<JsonRecordReader>(input_stream);
 }
 
 REGISTER_RESOURCE(JsonTreeReader, ControllerService);
@@ -18,7 +18,11 @@
 #include "XMLReader.h"
 
 #include <algorithm>
+#include <optional>
 #include <ranges>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include "core/Resource.h"
 #include "utils/TimeUtil.h"
@@ -134,35 +138,10 @@ void XMLReader::parseXmlNode(core::RecordObject& record_object, const pugi::xml_
   }
 }
 
-void XMLReader::addRecordFromXmlNode(const pugi::xml_node& node, core::RecordSet& record_set) const {
+core::Record XMLReader::createRecordFromXmlNode(const pugi::xml_node& node) const {
   core::RecordObject record_object;
   parseXmlNode(record_object, node);
-  core::Record record(std::move(record_object));
-  record_set.emplace_back(std::move(record));
-}
-
-bool XMLReader::parseRecordsFromXml(core::RecordSet& record_set, const std::string& xml_content) const {
-  pugi::xml_document doc;
-  if (!doc.load_string(xml_content.c_str())) {
-    logger_->log_error("Failed to parse XML content: {}", xml_content);
-    return false;
-  }
-
-  if (expect_records_as_array_) {
-    pugi::xml_node root = doc.first_child();
-    for (pugi::xml_node record_node : root.children()) {
-      addRecordFromXmlNode(record_node, record_set);
-    }
-    return true;
-  }
-
-  pugi::xml_node root = doc.first_child();
-  if (!root.first_child()) {
-    logger_->log_info("XML content does not contain any records: {}", xml_content);
-    return true;
-  }
-  addRecordFromXmlNode(root, record_set);
-  return true;
+  return core::Record(std::move(record_object));
 }
 
 void XMLReader::onEnable() {
@@ -182,25 +161,66 @@ void XMLReader::onEnable() {
   expect_records_as_array_ = parseBoolProperty(ExpectRecordsAsArray.name);
 }
 
-nonstd::expected<core::RecordSet, std::error_code> XMLReader::read(io::InputStream& input_stream) {
-  core::RecordSet record_set{};
-  const auto read_result = [this, &record_set](io::InputStream& input_stream) -> size_t {
-    std::string content;
-    content.resize(input_stream.size());
-    const auto read_ret = input_stream.read(as_writable_bytes(std::span(content)));
+// pugixml can only parse the whole document at once, but records are converted one at a time as they are requested,
+// so only the DOM is kept in memory instead of the DOM and the whole record set
+class XMLRecordReader : public core::RecordReader {
+ public:
+  XMLRecordReader(const XMLReader& xml_reader, io::InputStream& input_stream, std::shared_ptr<core::logging::Logger> logger)
+      : xml_reader_(xml_reader),
+        input_stream_(input_stream),
+        logger_(std::move(logger)) {
+  }
+
+  nonstd::expected<std::optional<core::Record>, std::error_code> next() override {
+    if (!loaded_) {
+      if (!load()) {
+        return nonstd::make_unexpected(std::make_error_code(std::errc::invalid_argument));
+      }
+      loaded_ = true;
+    }
+    if (!next_record_node_) {
+      return std::nullopt;
+    }
+    auto record = xml_reader_.createRecordFromXmlNode(next_record_node_);
+    next_record_node_ = xml_reader_.expect_records_as_array_ ? next_record_node_.next_sibling() : pugi::xml_node{};
+    return std::optional<core::Record>{std::move(record)};
+  }
+
+ private:
+  bool load() {
+    std::vector<std::byte> content(input_stream_.size());
+    const auto read_ret = input_stream_.read(content);
     if (io::isError(read_ret)) {
       logger_->log_error("Failed to read XML data from input stream");
-      return io::STREAM_ERROR;
+      return false;
     }
-    if (!parseRecordsFromXml(record_set, content)) {
-      return io::STREAM_ERROR;
+    content.resize(read_ret);
+    if (!doc_.load_buffer(content.data(), content.size())) {
+      logger_->log_error("Failed to parse XML content: {}", std::string_view{reinterpret_cast<const char*>(content.data()), content.size()});
+      return false;
     }
-    return read_ret;
-  }(input_stream);
-  if (io::isError(read_result)) {
-    return nonstd::make_unexpected(std::make_error_code(std::errc::invalid_argument));
+
+    pugi::xml_node root = doc_.first_child();
+    if (xml_reader_.expect_records_as_array_) {
+      next_record_node_ = root.first_child();
+    } else if (!root.first_child()) {
+      logger_->log_info("XML content does not contain any records: {}", std::string_view{reinterpret_cast<const char*>(content.data()), content.size()});
+    } else {
+      next_record_node_ = root;
+    }
+    return true;
   }
-  return record_set;
+
+  const XMLReader& xml_reader_;
+  io::InputStream& input_stream_;
+  std::shared_ptr<core::logging::Logger> logger_;
+  pugi::xml_document doc_;
+  pugi::xml_node next_record_node_;
+  bool loaded_ = false;
+};
+
+std::unique_ptr<core::RecordReader> XMLReader::createRecordReader(io::InputStream& input_stream) {
+  return std::make_unique<XMLRecordReader>(*this, input_stream, logger_);
 }
 
 REGISTER_RESOURCE(XMLReader, ControllerService);
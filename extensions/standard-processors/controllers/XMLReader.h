@@ -16,6 +16,8 @@
  */
 #pragma once
 
+#include <memory>
+
 #include "controllers/RecordSetReader.h"
 #include "core/PropertyDefinitionBuilder.h"
 #include "minifi-cpp/core/logging/Logger.h"
@@ -69,7 +71,7 @@ class XMLReader final : public core::RecordSetReaderImpl {
   EXTENSIONAPI static constexpr auto ImplementsApis = std::array{ RecordSetReader::ProvidesApi };
   ADD_COMMON_VIRTUAL_FUNCTIONS_FOR_CONTROLLER_SERVICES
 
-  nonstd::expected<core::RecordSet, std::error_code> read(io::InputStream& input_stream) override;
+  std::unique_ptr<core::RecordReader> createRecordReader(io::InputStream& input_stream) override;
 
   void initialize() override {
     setSupportedProperties(Properties);
@@ -83,8 +85,9 @@ class XMLReader final : public core::RecordSetReaderImpl {
   void writeRecordField(core::RecordObject& record_object, const std::string& name, const std::string& value, bool write_pcdata_node = false) const;
   void parseNodeElement(core::RecordObject& record_object, const pugi::xml_node& node) const;
   void parseXmlNode(core::RecordObject& record_object, const pugi::xml_node& node) const;
-  void addRecordFromXmlNode(const pugi::xml_node& node, core::RecordSet& record_set) const;
-  bool parseRecordsFromXml(core::RecordSet& record_set, const std::string& xml_content) const;
+  core::Record createRecordFromXmlNode(const pugi::xml_node& node) const;
+
+  friend class XMLRecordReader;
 
   std::string field_name_for_content_;
   bool parse_xml_attributes_ = false;
@@ -16,6 +16,10 @@
  */
 #include "XMLRecordSetWriter.h"
 
+#include <memory>
+#include <sstream>
+#include <string>
+
 #include "core/Resource.h"
 #include "minifi-cpp/Exception.h"
 #include "utils/TimeUtil.h"
@@ -132,32 +136,56 @@ void XMLRecordSetWriter::convertRecordField(const std::string& field_name, const
   }, field.value_);
 }
 
-std::string XMLRecordSetWriter::convertRecordSetToXml(const core::RecordSet& record_set) const {
-  gsl_Expects(!name_of_record_tag_.empty() && !name_of_root_tag_.empty());
-  pugi::xml_document xml_doc;
-  auto root_node = xml_doc.append_child(name_of_root_tag_.c_str());
+// Writes the opening tags before the first record and prints the records one by one, the output is the same as
+// if the whole record set was converted to a single XML document
+class XMLRecordWriter : public core::RecordWriter {
+ public:
+  XMLRecordWriter(const XMLRecordSetWriter& xml_record_set_writer, io::OutputStream& output_stream)
+      : xml_record_set_writer_(xml_record_set_writer),
+        output_stream_(output_stream) {
+  }
+
+  size_t write(const core::Record& record) override {
+    std::ostringstream xml_string_stream;
+    if (!started_) {
+      if (!xml_record_set_writer_.omit_xml_declaration_) {
+        xml_string_stream << R"(<?xml version="1.0"?>)" << (xml_record_set_writer_.pretty_print_xml_ ? "\n" : "");
+      }
+      xml_string_stream << "<" << xml_record_set_writer_.name_of_root_tag_ << ">" << (xml_record_set_writer_.pretty_print_xml_ ? "\n" : "");
+      started_ = true;
+    }
 
-  for (const auto& record : record_set) {
-    auto record_node = root_node.append_child(name_of_record_tag_.c_str());
+    pugi::xml_document xml_doc;
+    auto record_node = xml_doc.append_child(xml_record_set_writer_.name_of_record_tag_.c_str());
     for (const auto& [key, field] : record) {
-      convertRecordField(key, field, record_node);
+      xml_record_set_writer_.convertRecordField(key, field, record_node);
     }
+    record_node.print(xml_string_stream, "  ", xml_record_set_writer_.pretty_print_xml_ ? pugi::format_indent : pugi::format_raw, pugi::encoding_auto, 1);
+    return writeString(xml_string_stream.str());
   }
 
-  return formatXmlOutput(xml_doc);
-}
+  size_t finish() override {
+    if (!started_) {
+      pugi::xml_document xml_doc;
+      xml_doc.append_child(xml_record_set_writer_.name_of_root_tag_.c_str());
+      return writeString(xml_record_set_writer_.formatXmlOutput(xml_doc));
+    }
+    return writeString(fmt::format("</{}>{}", xml_record_set_writer_.name_of_root_tag_, xml_record_set_writer_.pretty_print_xml_ ? "\n" : ""));
+  }
 
-void XMLRecordSetWriter::write(const core::RecordSet& record_set, const std::shared_ptr<core::FlowFile>& flow_file, core::ProcessSession& session) {
-  if (!flow_file) {
-    logger_->log_error("FlowFile is null, cannot write RecordSet to XML");
-    return;
+ private:
+  size_t writeString(const std::string& str) {
+    return output_stream_.write(reinterpret_cast<const uint8_t*>(str.data()), str.size());
   }
 
-  auto xml_content = convertRecordSetToXml(record_set);
-  session.write(flow_file, [&xml_content](const std::shared_ptr<io::OutputStream>& stream) -> int64_t {
-    stream->write(reinterpret_cast<const uint8_t*>(xml_content.data()), xml_content.size());
-    return gsl::narrow<int64_t>(xml_content.size());
-  });
+  const XMLRecordSetWriter& xml_record_set_writer_;
+  io::OutputStream& output_stream_;
+  bool started_ = false;
+};
+
+std::unique_ptr<core::RecordWriter> XMLRecordSetWriter::createRecordWriter(io::OutputStream& output_stream) {
+  gsl_Expects(!name_of_record_tag_.empty() && !name_of_root_tag_.empty());
+  return std::make_unique<XMLRecordWriter>(*this, output_stream);
 }
 
 REGISTER_RESOURCE(XMLRecordSetWriter, ControllerService);
@@ -16,6 +16,8 @@
  */
 #pragma once
 
+#include <memory>
+
 #include "controllers/RecordSetWriter.h"
 #include "core/PropertyDefinitionBuilder.h"
 #include "minifi-cpp/core/logging/Logger.h"
@@ -105,7 +107,7 @@ class XMLRecordSetWriter final : public core::RecordSetWriterImpl {
   EXTENSIONAPI static constexpr auto ImplementsApis = std::array{ RecordSetWriter::ProvidesApi };
   ADD_COMMON_VIRTUAL_FUNCTIONS_FOR_CONTROLLER_SERVICES
 
-  void write(const core::RecordSet& record_set, const std::shared_ptr<core::FlowFile>& flow_file, core::ProcessSession& session) override;
+  std::unique_ptr<core::RecordWriter> createRecordWriter(io::OutputStream& output_stream) override;
 
   void initialize() override {
     setSupportedProperties(Properties);
@@ -117,7 +119,6 @@ class XMLRecordSetWriter final : public core::RecordSetWriterImpl {
 
  private:
   std::string formatXmlOutput(pugi::xml_document& xml_doc) const;
-  std::string convertRecordSetToXml(const core::RecordSet& record_set) const;
   void convertRecordArrayField(const std::string& field_name, const core::RecordField& field, pugi::xml_node& parent_node) const;
   void convertRecordField(const std::string& field_name, const core::RecordField& field, pugi::xml_node& parent_node) const;
 
@@ -128,6 +129,8 @@ class XMLRecordSetWriter final : public core::RecordSetWriterImpl {
   std::string name_of_record_tag_;
   std::string name_of_root_tag_;
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<XMLRecordSetWriter>::getLogger();
+
+  friend class XMLRecordWriter;
 };
 
 }  // namespace org::apache::nifi::minifi::standard
@@ -20,6 +20,7 @@
 #include "AttributesToJSON.h"
 
 #include <unordered_set>
+#include <utility>
 
 #include "rapidjson/writer.h"
 #include "utils/StringUtils.h"
@@ -119,7 +120,7 @@ void AttributesToJSON::onTrigger(core::ProcessContext&, core::ProcessSession& se
     return;
   }
 
-  auto json_data = buildAttributeJsonData(*flow_file->getAttributesPtr());
+  auto json_data = buildAttributeJsonData(*std::as_const(*flow_file).getAttributesPtr());
   if (write_destination_ == attributes_to_json::WriteDestination::FLOWFILE_ATTRIBUTE) {
     logger_->log_debug("Writing the following attribute data to JSONAttributes attribute: {}", json_data);
     session.putAttribute(*flow_file, "JSONAttributes", json_data);
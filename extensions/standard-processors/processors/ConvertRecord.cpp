@@ -17,6 +17,8 @@
 #include "ConvertRecord.h"
 
 #include "core/Resource.h"
+#include "io/BufferStream.h"
+#include "minifi-cpp/Exception.h"
 #include "nonstd/expected.hpp"
 #include "utils/GeneralUtils.h"
 #include "utils/ProcessorConfigUtils.h"
@@ -40,26 +42,69 @@ void ConvertRecord::onTrigger(core::ProcessContext& context, core::ProcessSessio
     return;
   }
 
-  nonstd::expected<core::RecordSet, std::error_code> record_set;
-  session.read(flow_file, [this, &record_set](const std::shared_ptr<io::InputStream>& input_stream) {
-    record_set = record_converter_->record_set_reader->read(*input_stream);
-    return gsl::narrow<int64_t>(input_stream->size());
-  });
-  if (!record_set) {
-    logger_->log_error("Failed to read record set from flow file: {}", record_set.error().message());
-    flow_file->setAttribute(processors::ConvertRecord::RecordErrorMessageOutputAttribute.name, record_set.error().message());
+  // Records are converted one by one while streaming the content, so the whole record set is never kept in memory
+  std::error_code read_error;
+  size_t record_count = 0;
+  const auto convert_records = [this, &read_error, &record_count](io::InputStream& input_stream, io::OutputStream& output_stream) -> size_t {
+    const auto record_reader = record_converter_->record_set_reader->createRecordReader(input_stream);
+    const auto record_writer = record_converter_->record_set_writer->createRecordWriter(output_stream);
+    size_t bytes_written = 0;
+    while (true) {
+      auto record = record_reader->next();
+      if (!record) {
+        read_error = record.error();
+        return io::STREAM_ERROR;
+      }
+      if (!*record) {
+        break;
+      }
+      const auto write_result = record_writer->write(**record);
+      if (io::isError(write_result)) {
+        return io::STREAM_ERROR;
+      }
+      bytes_written += write_result;
+      ++record_count;
+    }
+    const auto finish_result = record_writer->finish();
+    return io::isError(finish_result) ? io::STREAM_ERROR : bytes_written + finish_result;
+  };
+
+  try {
+    if (flow_file->getSize() == 0) {
+      // readWrite does not call the callback for empty flow files, but the writer may still need to produce output (e.g. an empty array)
+      io::BufferStream empty_input;
+      session.write(flow_file, [&convert_records, &empty_input](const std::shared_ptr<io::OutputStream>& output_stream) -> int64_t {
+        const auto bytes_written = convert_records(empty_input, *output_stream);
+        return io::isError(bytes_written) ? -1 : gsl::narrow<int64_t>(bytes_written);
+      });
+    } else {
+      session.readWrite(flow_file, [&convert_records](const std::shared_ptr<io::InputStream>& input_stream, const std::shared_ptr<io::OutputStream>& output_stream) -> std::optional<io::ReadWriteResult> {
+        const auto bytes_written = convert_records(*input_stream, *output_stream);
+        if (io::isError(bytes_written)) {
+          return std::nullopt;
+        }
+        return io::ReadWriteResult{.bytes_written = gsl::narrow<int64_t>(bytes_written), .bytes_read = gsl::narrow<int64_t>(input_stream->size())};
+      });
+    }
+  } catch (const Exception& exception) {
+    if (read_error) {
+      logger_->log_error("Failed to read record set from flow file: {}", read_error.message());
+      flow_file->setAttribute(processors::ConvertRecord::RecordErrorMessageOutputAttribute.name, read_error.message());
+    } else {
+      logger_->log_error("Failed to write record set to flow file: {}", exception.what());
+      flow_file->setAttribute(processors::ConvertRecord::RecordErrorMessageOutputAttribute.name, exception.what());
+    }
     session.transfer(flow_file, Failure);
     return;
   }
 
-  if (!include_zero_record_flow_files_ && record_set->empty()) {
+  if (!include_zero_record_flow_files_ && record_count == 0) {
     logger_->log_info("No records found in flow file, removing flow file");
     session.remove(flow_file);
     return;
   }
 
-  record_converter_->record_set_writer->write(*record_set, flow_file, session);
-  flow_file->setAttribute(processors::ConvertRecord::RecordCountOutputAttribute.name, std::to_string(record_set->size()));
+  flow_file->setAttribute(processors::ConvertRecord::RecordCountOutputAttribute.name, std::to_string(record_count));
   session.transfer(flow_file, Success);
 }
 
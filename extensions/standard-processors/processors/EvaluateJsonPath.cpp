@@ -16,6 +16,9 @@
  */
 #include "EvaluateJsonPath.h"
 
+#include <optional>
+#include <span>
+#include <string_view>
 #include <unordered_map>
 
 #include "core/ProcessSession.h"
@@ -101,21 +104,25 @@ void EvaluateJsonPath::onTrigger(core::ProcessContext& context, core::ProcessSes
     return;
   }
 
-  const auto json_string = to_string(session.readBuffer(flow_file));
-  if (json_string.empty()) {
-    logger_->log_error("FlowFile content is empty, transferring to Failure relationship");
-    session.transfer(flow_file, Failure);
-    return;
-  }
-
-  jsoncons::json json_object;
-  try {
-    json_object = jsoncons::json::parse(json_string);
-  } catch (const jsoncons::json_exception& e) {
-    logger_->log_error("FlowFile content is not a valid JSON document, transferring to Failure relationship: {}", e.what());
+  std::optional<jsoncons::json> parsed_json;
+  session.readInPlace(*flow_file, [this, &parsed_json](std::span<const std::byte> content) -> int64_t {
+    const std::string_view json_string{reinterpret_cast<const char*>(content.data()), content.size()};
+    if (json_string.empty()) {
+      logger_->log_error("FlowFile content is empty, transferring to Failure relationship");
+      return 0;
+    }
+    try {
+      parsed_json = jsoncons::json::parse(json_string);
+    } catch (const jsoncons::json_exception& e) {
+      logger_->log_error("FlowFile content is not a valid JSON document, transferring to Failure relationship: {}", e.what());
+    }
+    return gsl::narrow<int64_t>(content.size());
+  });
+  if (!parsed_json) {
     session.transfer(flow_file, Failure);
     return;
   }
+  const jsoncons::json& json_object = *parsed_json;
 
   std::unordered_map<std::string, std::string> attributes_to_set;
   for (const auto& property_name : context.getDynamicPropertyKeys()) {
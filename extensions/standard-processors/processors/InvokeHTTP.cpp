@@ -20,6 +20,7 @@
 
 #include <cinttypes>
 #include <functional>
+#include <list>
 #include <memory>
 #include <string>
 #include <utility>
@@ -155,6 +156,10 @@ void InvokeHTTP::setupMembersFromProperties(const core::ProcessContext& context)
   maximum_upload_speed_ = context.getProperty(UploadSpeedLimit) | utils::andThen(invoke_http::parseDataTransferSpeed) | utils::toOptional();
   maximum_download_speed_ = context.getProperty(DownloadSpeedLimit) | utils::andThen(invoke_http::parseDataTransferSpeed) | utils::toOptional();
 
+  max_concurrent_requests_ = utils::parseU64Property(context, MaxConcurrentRequests);
+  if (max_concurrent_requests_ == 0)
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Max Concurrent Requests must be at least 1");
+
   connect_timeout_ = utils::parseDurationProperty(context, ConnectTimeout);  // Shouldn't fail due to default value;
   read_timeout_ = utils::parseDurationProperty(context, ReadTimeout);  // Shouldn't fail due to default value;
 
@@ -196,7 +201,16 @@ void InvokeHTTP::onSchedule(core::ProcessContext& context, core::ProcessSessionF
     return createHTTPClientFromMembers(url);
   };
 
-  client_queue_ = std::make_unique<invoke_http::HttpClientStore>(context.getMaxConcurrentTasks() * 2, create_client);
+  // every thread may hold a client for each of its concurrent requests
+  const auto clients_per_thread = std::max<size_t>(2, gsl::narrow<size_t>(max_concurrent_requests_));
+  client_queue_ = std::make_unique<invoke_http::HttpClientStore>(context.getMaxConcurrentTasks() * clients_per_thread, create_client);
+
+  if (max_concurrent_requests_ > 1) {
+    multi_clients_ = utils::ResourceQueue<http::HTTPMultiClient>::create([] { return std::make_unique<http::HTTPMultiClient>(); },
+        context.getMaxConcurrentTasks(), std::nullopt, logger_);
+  } else {
+    multi_clients_.reset();
+  }
 }
 
 bool InvokeHTTP::shouldEmitFlowFile() const {
@@ -237,9 +251,7 @@ bool InvokeHTTP::appendHeaders(const core::FlowFile& flow_file, std::invocable<s
   return true;
 }
 
-void InvokeHTTP::onTrigger(core::ProcessContext& context, core::ProcessSession& session) {
-  gsl_Expects(client_queue_);
-
+std::shared_ptr<core::FlowFile> InvokeHTTP::getOrCreateFlowFile(core::ProcessContext& context, core::ProcessSession& session) const {
   auto flow_file = session.get();
 
   if (flow_file == nullptr) {
@@ -249,11 +261,25 @@ void InvokeHTTP::onTrigger(core::ProcessContext& context, core::ProcessSession&
     } else {
       logger_->log_debug("Exiting because method is {} and there is no flowfile available to execute it, yielding", magic_enum::enum_name(method_));
       context.yield();
-      return;
     }
   } else {
     logger_->log_debug("InvokeHTTP -- Received flowfile");
   }
+  return flow_file;
+}
+
+void InvokeHTTP::onTrigger(core::ProcessContext& context, core::ProcessSession& session) {
+  gsl_Expects(client_queue_);
+
+  if (multi_clients_) {
+    onTriggerWithMultiClient(context, session);
+    return;
+  }
+
+  auto flow_file = getOrCreateFlowFile(context, session);
+  if (!flow_file) {
+    return;
+  }
 
   auto url = context.getProperty(URL, flow_file.get());
   if (!url || url->empty()) {
@@ -276,6 +302,103 @@ void InvokeHTTP::onTriggerWithClient(core::ProcessContext& context, core::Proces
 
   std::string transaction_id = utils::IdGenerator::getIdGenerator()->generate().to_string();
 
+  if (!prepareRequest(session, flow_file, client)) {
+    session.transfer(flow_file, RelFailure);
+    return;
+  }
+
+  logger_->log_trace("InvokeHTTP -- curl performed");
+  processResponse(context, session, flow_file, client, transaction_id, client.submit());
+}
+
+namespace {
+struct Transfer {
+  Transfer(invoke_http::HttpClientStore& client_store, const std::string& url, std::shared_ptr<core::FlowFile> flow_file)
+      : client(client_store.getClient(url)),
+        flow_file(std::move(flow_file)),
+        transaction_id(utils::IdGenerator::getIdGenerator()->generate().to_string()) {
+  }
+
+  invoke_http::HttpClientStore::HttpClientWrapper client;
+  std::shared_ptr<core::FlowFile> flow_file;
+  std::string transaction_id;
+};
+
+constexpr auto MULTI_CLIENT_POLL_TIMEOUT = 1s;
+// new flow files are taken for this long, or until this many times Max Concurrent Requests flow files are taken,
+// then the trigger waits for the remaining transfers, so that the session is committed regularly
+constexpr auto MULTI_CLIENT_TRIGGER_DURATION = 1s;
+constexpr uint64_t MULTI_CLIENT_WINDOWS_PER_TRIGGER = 10;
+}  // namespace
+
+void InvokeHTTP::onTriggerWithMultiClient(core::ProcessContext& context, core::ProcessSession& session) {
+  auto first_flow_file = getOrCreateFlowFile(context, session);
+  if (!first_flow_file) {
+    return;
+  }
+
+  const auto multi_client = multi_clients_->getResource();
+  std::list<Transfer> transfers;
+  // the transfers have to be removed from the multi client before their clients are returned to the client store
+  const auto cancel_transfers_at_exit = gsl::finally([&multi_client] {
+    multi_client->cancelTransfers();
+  });
+  const auto finish_transfer = [&](std::list<Transfer>::iterator transfer, bool submitted) {
+    processResponse(context, session, transfer->flow_file, transfer->client.get(), transfer->transaction_id, submitted);
+    transfer->client.get().setUploadCallback({});
+    transfers.erase(transfer);
+  };
+  const auto start_transfer = [&](const std::shared_ptr<core::FlowFile>& flow_file) {
+    auto url = context.getProperty(URL, flow_file.get());
+    if (!url || url->empty()) {
+      logger_->log_error("InvokeHTTP -- URL is empty, transferring to failure");
+      session.transfer(flow_file, RelFailure);
+      return;
+    }
+    const auto transfer = transfers.emplace(transfers.end(), *client_queue_, *url, flow_file);
+    auto& client = transfer->client.get();
+    logger_->log_debug("onTrigger InvokeHTTP with {} to {}", magic_enum::enum_name(method_), client.getURL());
+    if (!prepareRequest(session, flow_file, client)) {
+      client.setUploadCallback({});
+      session.transfer(flow_file, RelFailure);
+      transfers.erase(transfer);
+      return;
+    }
+    if (!multi_client->addTransfer(client)) {
+      finish_transfer(transfer, false);
+    }
+  };
+
+  const auto trigger_deadline = std::chrono::steady_clock::now() + MULTI_CLIENT_TRIGGER_DURATION;
+  const auto max_flow_files = max_concurrent_requests_ * MULTI_CLIENT_WINDOWS_PER_TRIGGER;
+  uint64_t started_flow_files = 1;
+  start_transfer(first_flow_file);
+  // a new flow file is taken whenever a transfer completes, so a slow request does not hold back the others
+  const auto fill_window = [&] {
+    while (multi_client->size() < max_concurrent_requests_ && started_flow_files < max_flow_files && std::chrono::steady_clock::now() < trigger_deadline) {
+      auto flow_file = session.get();
+      if (!flow_file) {
+        return;
+      }
+      ++started_flow_files;
+      start_transfer(flow_file);
+    }
+  };
+  fill_window();
+
+  while (multi_client->size() > 0) {
+    for (const auto& completed_transfer : multi_client->perform(MULTI_CLIENT_POLL_TIMEOUT)) {
+      const auto transfer = std::find_if(transfers.begin(), transfers.end(), [&completed_transfer](const Transfer& transfer) {
+        return &transfer.client.get() == completed_transfer.client;
+      });
+      gsl_Assert(transfer != transfers.end());
+      finish_transfer(transfer, completed_transfer.success);
+    }
+    fill_window();
+  }
+}
+
+bool InvokeHTTP::prepareRequest(core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file, http::HTTPClient& client) {
   if (shouldEmitFlowFile()) {
     logger_->log_trace("InvokeHTTP -- reading flowfile");
     const auto flow_file_reader_stream = session.getFlowFileContentStream(*flow_file);
@@ -310,13 +433,12 @@ void InvokeHTTP::onTriggerWithClient(core::ProcessContext& context, core::Proces
   }
 
   const auto append_header = [&](const std::string& key, const std::string& value) { client.setRequestHeader(key, value); };
-  if (!appendHeaders(*flow_file, append_header)) {
-    session.transfer(flow_file, RelFailure);
-    return;
-  }
+  return appendHeaders(*flow_file, append_header);
+}
 
-  logger_->log_trace("InvokeHTTP -- curl performed");
-  if (client.submit()) {
+void InvokeHTTP::processResponse(core::ProcessContext& context, core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file,
+    http::HTTPClient& client, const std::string& transaction_id, bool submitted) {
+  if (submitted) {
     logger_->log_trace("InvokeHTTP -- curl successful");
 
     const std::vector<char>& response_body = client.getResponseBody();
@@ -39,6 +39,7 @@
 #include "utils/Id.h"
 #include "utils/ResourceQueue.h"
 #include "http/HTTPClient.h"
+#include "http/HTTPMultiClient.h"
 #include "minifi-cpp/utils/Export.h"
 #include "utils/Enum.h"
 #include "utils/RegexUtils.h"
@@ -254,6 +255,14 @@ class InvokeHTTP : public core::ProcessorImpl {
       .withDescription("Maximum download speed,e.g. '500 KB/s'. Leave this empty if you want no limit.")
       .withValidator(invoke_http::DATA_TRANSFER_SPEED_VALIDATOR)
       .build();
+  EXTENSIONAPI static constexpr auto MaxConcurrentRequests = core::PropertyDefinitionBuilder<>::createProperty("Max Concurrent Requests")
+      .withDescription("The maximum number of requests sent concurrently by a single thread of the processor. "
+          "If greater than 1, up to this many requests are sent concurrently, multiplexed over a single connection per host when the server supports HTTP/2. "
+          "The flow files are routed as their responses arrive, and a new flow file is taken in place of each completed one, "
+          "for up to 1 second or 10 times this many flow files per trigger.")
+      .withValidator(core::StandardPropertyValidators::UNSIGNED_INTEGER_VALIDATOR)
+      .withDefaultValue("1")
+      .build();
 
   EXTENSIONAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({
         Method,
@@ -278,7 +287,8 @@ class InvokeHTTP : public core::ProcessorImpl {
         PenalizeOnNoRetry,
         InvalidHTTPHeaderFieldHandlingStrategy,
         UploadSpeedLimit,
-        DownloadSpeedLimit
+        DownloadSpeedLimit,
+        MaxConcurrentRequests
   });
 
 
@@ -338,8 +348,13 @@ class InvokeHTTP : public core::ProcessorImpl {
   void route(const std::shared_ptr<core::FlowFile>& request, const std::shared_ptr<core::FlowFile>& response, core::ProcessSession& session,
       core::ProcessContext& context, bool is_success, int64_t status_code);
   [[nodiscard]] bool shouldEmitFlowFile() const;
+  std::shared_ptr<core::FlowFile> getOrCreateFlowFile(core::ProcessContext& context, core::ProcessSession& session) const;
   void onTriggerWithClient(core::ProcessContext& context, core::ProcessSession& session,
       const std::shared_ptr<core::FlowFile>& flow_file, http::HTTPClient& client);
+  void onTriggerWithMultiClient(core::ProcessContext& context, core::ProcessSession& session);
+  [[nodiscard]] bool prepareRequest(core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file, http::HTTPClient& client);
+  void processResponse(core::ProcessContext& context, core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file,
+      http::HTTPClient& client, const std::string& transaction_id, bool submitted);
   [[nodiscard]] bool appendHeaders(const core::FlowFile& flow_file, std::invocable<std::string, std::string> auto append_header);
 
 
@@ -356,6 +371,7 @@ class InvokeHTTP : public core::ProcessorImpl {
   bool send_date_header_{true};
   std::optional<uint64_t> maximum_upload_speed_ = std::nullopt;
   std::optional<uint64_t> maximum_download_speed_ = std::nullopt;
+  uint64_t max_concurrent_requests_{1};
 
   std::shared_ptr<minifi::controllers::SSLContextServiceInterface> ssl_context_service_;
 
@@ -367,6 +383,7 @@ class InvokeHTTP : public core::ProcessorImpl {
   std::optional<std::string> content_type_;
   invoke_http::InvalidHTTPHeaderFieldHandlingOption invalid_http_header_field_handling_strategy_{};
   std::unique_ptr<invoke_http::HttpClientStore> client_queue_;
+  std::shared_ptr<utils::ResourceQueue<http::HTTPMultiClient>> multi_clients_;
 };
 
 }  // namespace org::apache::nifi::minifi::processors
@@ -49,11 +49,17 @@ void ListenSyslog::initialize() {
 
 void ListenSyslog::onSchedule(core::ProcessContext& context, core::ProcessSessionFactory&) {
   parse_messages_ = utils::parseBoolProperty(context, ParseMessages);
+  message_packing_ = MessagePacking::FlowFilePerMessage;
 
   if (const auto protocol = utils::parseEnumProperty<utils::net::IpProtocol>(context, ProtocolProperty); protocol == utils::net::IpProtocol::TCP) {
     startTcpServer(context, SSLContextService, ClientAuth, true, "\n");
   } else if (protocol == utils::net::IpProtocol::UDP) {
-    startUdpServer(context);
+    message_packing_ = utils::parseEnumProperty<MessagePacking>(context, MessagePackingProperty);
+    if (parse_messages_ && message_packing_ != MessagePacking::FlowFilePerMessage) {
+      logger_->log_warn("{} is ignored when {} is enabled", MessagePackingProperty.name, ParseMessages.name);
+      message_packing_ = MessagePacking::FlowFilePerMessage;
+    }
+    startUdpServer(context, ReceiveSocketCount);
   } else {
     throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Invalid protocol");
   }
@@ -28,7 +28,8 @@ void ListenUDP::initialize() {
 }
 
 void ListenUDP::onSchedule(core::ProcessContext& context, core::ProcessSessionFactory&) {
-  startUdpServer(context);
+  message_packing_ = utils::parseEnumProperty<MessagePacking>(context, MessagePackingProperty);
+  startUdpServer(context, ReceiveSocketCount);
 }
 
 void ListenUDP::transferAsFlowFile(const utils::net::Message& message, core::ProcessSession& session) {
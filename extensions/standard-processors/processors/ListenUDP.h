@@ -33,7 +33,7 @@ class ListenUDP : public NetworkListenerProcessor {
  public:
   using NetworkListenerProcessor::NetworkListenerProcessor;
 
-  EXTENSIONAPI static constexpr const char* Description = "Listens for incoming UDP datagrams. For each datagram the processor produces a single FlowFile.";
+  EXTENSIONAPI static constexpr const char* Description = "Listens for incoming UDP datagrams. For each datagram the processor produces a single FlowFile, unless Message Packing is used.";
 
   EXTENSIONAPI static constexpr auto Port = core::PropertyDefinitionBuilder<>::createProperty("Listening Port")
       .withDescription("The port to listen on for communication.")
@@ -53,10 +53,29 @@ class ListenUDP : public NetworkListenerProcessor {
       .withDefaultValue("10000")
       .isRequired(true)
       .build();
+  EXTENSIONAPI static constexpr auto ReceiveSocketCount = core::PropertyDefinitionBuilder<>::createProperty("Receive Socket Count")
+      .withDescription("The number of sockets bound to the listening port, each read by its own thread. "
+          "The operating system distributes the senders between the sockets using SO_REUSEPORT. Only supported on platforms supporting SO_REUSEPORT.")
+      .withValidator(core::StandardPropertyValidators::UNSIGNED_INTEGER_VALIDATOR)
+      .withDefaultValue("1")
+      .isRequired(true)
+      .build();
+  EXTENSIONAPI static constexpr auto MessagePackingProperty = core::PropertyDefinitionBuilder<magic_enum::enum_count<MessagePacking>()>::createProperty("Message Packing")
+      .withDescription("Specifies how the received messages are arranged into flow files.\n"
+          "Flow file per message: Every message is written to its own flow file.\n"
+          "Newline delimited: The messages of the same sender received in one trigger are written to a single flow file, each followed by a newline.\n"
+          "Length prefixed: The messages of the same sender received in one trigger are written to a single flow file, "
+          "each preceded by its length as a 4 byte big-endian integer.")
+      .withDefaultValue(magic_enum::enum_name(MessagePacking::FlowFilePerMessage))
+      .withAllowedValues(magic_enum::enum_names<MessagePacking>())
+      .isRequired(true)
+      .build();
   EXTENSIONAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({
       Port,
       MaxBatchSize,
       MaxQueueSize,
+      ReceiveSocketCount,
+      MessagePackingProperty
   });
 
 
@@ -15,6 +15,12 @@
  * limitations under the License.
  */
 #include "NetworkListenerProcessor.h"
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+
 #include "utils/net/UdpServer.h"
 #include "utils/net/TcpServer.h"
 #include "utils/net/Ssl.h"
@@ -29,14 +35,49 @@ NetworkListenerProcessor::~NetworkListenerProcessor() {
 void NetworkListenerProcessor::onTrigger(core::ProcessContext&, core::ProcessSession& session) {
   gsl_Expects(max_batch_size_ > 0);
   size_t logs_processed = 0;
+  std::vector<utils::net::Message> messages_to_pack;
   while (!server_->queueEmpty() && logs_processed < max_batch_size_) {
-    if (const auto received_message = server_->tryDequeue()) {
-      transferAsFlowFile(received_message.value(), session);
+    if (auto received_message = server_->tryDequeue()) {
+      if (message_packing_ == MessagePacking::FlowFilePerMessage) {
+        transferAsFlowFile(received_message.value(), session);
+      } else {
+        messages_to_pack.push_back(std::move(*received_message));
+      }
       ++logs_processed;
     } else {
       break;
     }
   }
+  if (!messages_to_pack.empty()) {
+    transferPacked(std::move(messages_to_pack), session);
+  }
+}
+
+void NetworkListenerProcessor::transferPacked(std::vector<utils::net::Message> messages, core::ProcessSession& session) {
+  // messages of the same sender are packed into one flow file, so the sender attributes remain valid
+  using SenderKey = std::tuple<utils::net::IpProtocol, asio::ip::address, asio::ip::port_type, asio::ip::port_type>;
+  std::map<SenderKey, size_t> packed_message_indices;
+  std::vector<utils::net::Message> packed_messages;
+  for (auto& message : messages) {
+    const SenderKey sender_key{message.protocol, message.remote_address, message.remote_port, message.local_port};
+    auto [it, inserted] = packed_message_indices.try_emplace(sender_key, packed_messages.size());
+    if (inserted) {
+      packed_messages.emplace_back(std::string{}, message.protocol, message.remote_address, message.remote_port, message.local_port);
+    }
+    auto& packed_data = packed_messages[it->second].message_data;
+    if (message_packing_ == MessagePacking::LengthPrefixed) {
+      const auto length = gsl::narrow<uint32_t>(message.message_data.size());
+      for (int shift = 24; shift >= 0; shift -= 8) {
+        packed_data.push_back(static_cast<char>((length >> shift) & 0xFF));
+      }
+      packed_data.append(message.message_data);
+    } else {
+      packed_data.append(message.message_data).push_back('\n');
+    }
+  }
+  for (const auto& packed_message : packed_messages) {
+    transferAsFlowFile(packed_message, session);
+  }
 }
 
 NetworkListenerProcessor::ServerOptions NetworkListenerProcessor::readServerOptions(const core::ProcessContext& context) {
@@ -84,10 +125,13 @@ void NetworkListenerProcessor::startTcpServer(const core::ProcessContext& contex
   startServer(options, utils::net::IpProtocol::TCP);
 }
 
-void NetworkListenerProcessor::startUdpServer(const core::ProcessContext& context) {
+void NetworkListenerProcessor::startUdpServer(const core::ProcessContext& context, const core::PropertyReference& socket_count_property) {
   gsl_Expects(!server_thread_.joinable() && !server_);
   auto options = readServerOptions(context);
-  server_ = std::make_unique<utils::net::UdpServer>(options.max_queue_size, options.port, logger_);
+  const auto socket_count = utils::parseU64Property(context, socket_count_property);
+  if (socket_count < 1)
+    throw Exception(PROCESSOR_EXCEPTION, fmt::format("{} property is invalid", socket_count_property.name));
+  server_ = std::make_unique<utils::net::UdpServer>(options.max_queue_size, options.port, logger_, socket_count);
   startServer(options, utils::net::IpProtocol::UDP);
 }
 
@@ -19,14 +19,43 @@
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "core/ProcessorImpl.h"
 #include "minifi-cpp/core/ProcessContext.h"
 #include "core/ProcessSession.h"
+#include "utils/Enum.h"
 #include "utils/net/Server.h"
 
 namespace org::apache::nifi::minifi::processors {
 
+enum class MessagePacking {
+  FlowFilePerMessage,
+  NewlineDelimited,
+  LengthPrefixed
+};
+
+}  // namespace org::apache::nifi::minifi::processors
+
+namespace magic_enum::customize {
+using MessagePacking = org::apache::nifi::minifi::processors::MessagePacking;
+
+template <>
+constexpr customize_t enum_name<MessagePacking>(MessagePacking value) noexcept {
+  switch (value) {
+    case MessagePacking::FlowFilePerMessage:
+      return "Flow file per message";
+    case MessagePacking::NewlineDelimited:
+      return "Newline delimited";
+    case MessagePacking::LengthPrefixed:
+      return "Length prefixed";
+  }
+  return invalid_tag;
+}
+}  // namespace magic_enum::customize
+
+namespace org::apache::nifi::minifi::processors {
+
 class NetworkListenerProcessor : public core::ProcessorImpl {
  public:
   using ProcessorImpl::ProcessorImpl;
@@ -61,7 +90,9 @@ class NetworkListenerProcessor : public core::ProcessorImpl {
       const core::PropertyReference& client_auth_property,
       bool consume_delimiter,
       std::string delimiter);
-  void startUdpServer(const core::ProcessContext& context);
+  void startUdpServer(const core::ProcessContext& context, const core::PropertyReference& socket_count_property);
+
+  MessagePacking message_packing_ = MessagePacking::FlowFilePerMessage;
 
  private:
   struct ServerOptions {
@@ -72,6 +103,7 @@ class NetworkListenerProcessor : public core::ProcessorImpl {
   void stopServer();
   void startServer(const ServerOptions& options, utils::net::IpProtocol protocol);
   ServerOptions readServerOptions(const core::ProcessContext& context);
+  void transferPacked(std::vector<utils::net::Message> messages, core::ProcessSession& session);
 
   virtual void transferAsFlowFile(const utils::net::Message& message, core::ProcessSession& session) = 0;
   virtual core::PropertyReference getMaxBatchSizeProperty() = 0;
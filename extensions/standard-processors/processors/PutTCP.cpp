@@ -22,6 +22,7 @@
 
 #include "minifi-cpp/core/ProcessContext.h"
 #include "core/ProcessSession.h"
+#include "io/FileStream.h"
 #include "core/Resource.h"
 #include "minifi-cpp/core/logging/Logger.h"
 #include "range/v3/range/conversion.hpp"
@@ -145,6 +146,16 @@ asio::awaitable<std::error_code> PutTCP::sendStreamWithDelimiter(utils::net::Con
     co_return connection_error;
   }
 
+  if (const auto file_region = io::getRemainingFileRegion(*stream_to_send); file_region && file_region->size >= io::MIN_KERNEL_COPY_SIZE) {
+    auto [send_file_error, bytes_sent] = co_await connection_handler.sendFile(file_region->path, file_region->offset, file_region->size);
+    if (!send_file_error) {
+      stream_to_send->seek(stream_to_send->tell() + bytes_sent);
+      logger_->log_trace("Sending flowfile({} bytes) from file to socket succeeded", bytes_sent);
+    } else if (send_file_error != std::errc::operation_not_supported) {
+      co_return send_file_error;
+    }
+  }
+
   std::vector<std::byte> data_chunk;
   data_chunk.resize(chunk_size);
   const std::span<std::byte> buffer{data_chunk};
@@ -19,6 +19,8 @@
 
 #include <algorithm>
 #include <map>
+#include <optional>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -35,6 +37,7 @@
 #include "range/v3/algorithm/any_of.hpp"
 #include "utils/OptionalUtils.h"
 #include "utils/ProcessorConfigUtils.h"
+#include "utils/RegexSet.h"
 #include "utils/Searcher.h"
 
 namespace org::apache::nifi::minifi::processors {
@@ -59,25 +62,56 @@ void RouteText::onSchedule(core::ProcessContext& context, core::ProcessSessionFa
     dynamic_relationships_[property_name] = rel;
     logger_->log_info("RouteText registered dynamic route '{}'", property_name);
   }
+
+  {
+    std::lock_guard lock(regex_set_mutex_);
+    cached_regex_set_.reset();
+  }
+  const auto dynamic_property_keys = context.getDynamicPropertyKeys();
+  const bool has_expressions = ranges::any_of(dynamic_property_keys, [&] (const auto& key) {
+    return context.getRawDynamicProperty(key).value_or("").find("${") != std::string::npos;
+  });
+  if ((matching_ == route_text::Matching::CONTAINS_REGEX || matching_ == route_text::Matching::MATCHES_REGEX) && !has_expressions) {
+    // the patterns evaluate to the same values for every flow file, so their RegexSet is built only once
+    std::vector<std::string> patterns;
+    for (const auto& key : dynamic_property_keys) {
+      patterns.push_back(context.getDynamicProperty(key) | utils::orThrow("Missing dynamic property"));
+    }
+    const auto match_mode = matching_ == route_text::Matching::CONTAINS_REGEX ? utils::RegexSet::MatchMode::SEARCH : utils::RegexSet::MatchMode::FULL_MATCH;
+    releaseRegexSet(acquireRegexSet(std::move(patterns), match_mode));
+  }
+}
+
+RouteText::CachedRegexSet RouteText::acquireRegexSet(std::vector<std::string> patterns, utils::RegexSet::MatchMode match_mode) {
+  {
+    std::lock_guard lock(regex_set_mutex_);
+    if (cached_regex_set_ && cached_regex_set_->patterns_ == patterns) {
+      auto cached = std::move(*cached_regex_set_);
+      cached_regex_set_.reset();
+      return cached;
+    }
+  }
+  std::vector<utils::Regex::Mode> flags;
+  if (case_policy_ == route_text::CasePolicy::IGNORE_CASE) {
+    flags.push_back(utils::Regex::Mode::ICASE);
+  }
+  utils::RegexSet regex_set(patterns, match_mode, flags);
+  return CachedRegexSet{.patterns_ = std::move(patterns), .regex_set_ = std::move(regex_set)};
+}
+
+void RouteText::releaseRegexSet(CachedRegexSet regex_set) {
+  std::lock_guard lock(regex_set_mutex_);
+  cached_regex_set_ = std::move(regex_set);
 }
 
 class RouteText::ReadCallback {
   using Fn = std::function<void(Segment)>;
 
  public:
-  ReadCallback(route_text::Segmentation segmentation, size_t file_size, Fn&& fn)
-    : segmentation_(segmentation), file_size_(file_size), fn_(std::move(fn)) {}
-
-  int64_t operator()(const std::shared_ptr<io::InputStream>& stream) const {
-    std::vector<std::byte> buffer;
-    buffer.resize(file_size_);
-    size_t ret = stream->read(buffer);
-    if (io::isError(ret)) {
-      return -1;
-    }
-    if (ret != file_size_) {
-      throw Exception(PROCESS_SESSION_EXCEPTION, "Couldn't read whole flowfile content");
-    }
+  ReadCallback(route_text::Segmentation segmentation, Fn&& fn)
+    : segmentation_(segmentation), fn_(std::move(fn)) {}
+
+  int64_t operator()(std::span<const std::byte> buffer) const {
     std::string_view content{reinterpret_cast<const char*>(buffer.data()), buffer.size()};
     switch (segmentation_) {
       case route_text::Segmentation::FULL_TEXT: {
@@ -110,7 +144,6 @@ class RouteText::ReadCallback {
 
  private:
   route_text::Segmentation segmentation_;
-  size_t file_size_;
   Fn fn_;
 };
 
@@ -142,22 +175,38 @@ class RouteText::MatchingContext {
   };
 
  public:
-  MatchingContext(core::ProcessContext& process_context, std::shared_ptr<core::FlowFile> flow_file, route_text::CasePolicy case_policy)
-    : process_context_(process_context),
+  MatchingContext(RouteText& route_text, core::ProcessContext& process_context, std::shared_ptr<core::FlowFile> flow_file, route_text::CasePolicy case_policy)
+    : route_text_(route_text),
+      process_context_(process_context),
       flow_file_(std::move(flow_file)),
       case_policy_(case_policy) {}
 
-  const utils::Regex& getRegexProperty(const std::string& property_name) {
-    auto it = regex_values_.find(property_name);
-    if (it != regex_values_.end()) {
-      return it->second;
+  MatchingContext(const MatchingContext&) = delete;
+  MatchingContext(MatchingContext&&) = delete;
+  MatchingContext& operator=(const MatchingContext&) = delete;
+  MatchingContext& operator=(MatchingContext&&) = delete;
+
+  ~MatchingContext() {
+    if (regex_set_) {
+      route_text_.releaseRegexSet(std::move(*regex_set_));
     }
-    const auto value = process_context_.getDynamicProperty(property_name, flow_file_.get()) | utils::orThrow("Missing dynamic property");
-    std::vector<utils::Regex::Mode> flags;
-    if (case_policy_ == route_text::CasePolicy::IGNORE_CASE) {
-      flags.push_back(utils::Regex::Mode::ICASE);
+  }
+
+  // The regexes of all dynamic properties are matched against the segment in a single pass, when the first of them is queried
+  bool matchesRegex(const Segment& segment, const std::string& property_name, utils::RegexSet::MatchMode match_mode) {
+    if (!regex_set_) {
+      std::vector<std::string> patterns;
+      for (const auto& key : process_context_.getDynamicPropertyKeys()) {
+        regex_indices_.emplace(key, patterns.size());
+        patterns.push_back(process_context_.getDynamicProperty(key, flow_file_.get()) | utils::orThrow("Missing dynamic property"));
+      }
+      regex_set_.emplace(route_text_.acquireRegexSet(std::move(patterns), match_mode));
     }
-    return (regex_values_[property_name] = utils::Regex(value, flags));
+    if (regex_matches_segment_idx_ != segment.idx_) {
+      regex_matches_ = regex_set_->regex_set_.match(segment.value_);
+      regex_matches_segment_idx_ = segment.idx_;
+    }
+    return regex_matches_.at(regex_indices_.at(property_name));
   }
 
   const std::string& getStringProperty(const std::string& property_name) {
@@ -181,12 +230,17 @@ class RouteText::MatchingContext {
         std::forward_as_tuple(value, case_policy_)).first->second.searcher_;
   }
 
+  RouteText& route_text_;
   core::ProcessContext& process_context_;
   std::shared_ptr<core::FlowFile> flow_file_;
   route_text::CasePolicy case_policy_;
 
   std::map<std::string, std::string> string_values_;
-  std::map<std::string, utils::Regex> regex_values_;
+
+  std::optional<CachedRegexSet> regex_set_;
+  std::map<std::string, size_t> regex_indices_;
+  std::optional<size_t> regex_matches_segment_idx_;
+  std::vector<bool> regex_matches_;
 
   struct OwningSearcher {
     OwningSearcher(std::string str, route_text::CasePolicy case_policy)
@@ -224,9 +278,9 @@ void RouteText::onTrigger(core::ProcessContext& context, core::ProcessSession& s
 
   std::map<Route, std::string> flow_file_contents;
 
-  MatchingContext matching_context(context, flow_file, case_policy_);
+  MatchingContext matching_context(*this, context, flow_file, case_policy_);
 
-  ReadCallback callback(segmentation_, flow_file->getSize(), [&] (Segment segment) {
+  ReadCallback callback(segmentation_, [&] (Segment segment) {
     std::string_view original_value = segment.value_;
     std::string_view preprocessed_value = preprocess(segment.value_);
 
@@ -276,7 +330,7 @@ void RouteText::onTrigger(core::ProcessContext& context, core::ProcessSession& s
     }
     throw Exception(PROCESSOR_EXCEPTION, "Unknown routing strategy");
   });
-  session.read(flow_file, std::move(callback));
+  session.readInPlace(*flow_file, std::move(callback));
 
   for (const auto& [route, content] : flow_file_contents) {
     auto new_flow_file = session.create(flow_file.get());
@@ -359,12 +413,10 @@ bool RouteText::matchSegment(MatchingContext& context, const Segment& segment, c
       return utils::string::equals(segment.value_, context.getStringProperty(property_name), case_policy_ == route_text::CasePolicy::CASE_SENSITIVE);
     }
     case route_text::Matching::CONTAINS_REGEX: {
-      std::string segment_str = std::string(segment.value_);
-      return utils::regexSearch(segment_str, context.getRegexProperty(property_name));
+      return context.matchesRegex(segment, property_name, utils::RegexSet::MatchMode::SEARCH);
     }
     case route_text::Matching::MATCHES_REGEX: {
-      std::string segment_str = std::string(segment.value_);
-      return utils::regexMatch(segment_str, context.getRegexProperty(property_name));
+      return context.matchesRegex(segment, property_name, utils::RegexSet::MatchMode::FULL_MATCH);
     }
   }
   throw Exception(PROCESSOR_EXCEPTION, "Unknown matching strategy");
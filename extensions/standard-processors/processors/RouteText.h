@@ -20,8 +20,10 @@
 #include <optional>
 #include <string_view>
 #include <map>
+#include <mutex>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "minifi-cpp/core/OutputAttributeDefinition.h"
 #include "core/ProcessorImpl.h"
@@ -31,6 +33,7 @@
 #include "minifi-cpp/core/RelationshipDefinition.h"
 #include "utils/Enum.h"
 #include "minifi-cpp/utils/Export.h"
+#include "utils/RegexSet.h"
 #include "utils/RegexUtils.h"
 
 namespace org::apache::nifi::minifi::processors::route_text {
@@ -223,9 +226,17 @@ class RouteText : public core::ProcessorImpl {
     size_t idx_;  // 1-based index as in nifi
   };
 
+  struct CachedRegexSet {
+    std::vector<std::string> patterns_;
+    utils::RegexSet regex_set_;
+  };
+
   std::string_view preprocess(std::string_view str) const;
   bool matchSegment(MatchingContext& context, const Segment& segment, const std::string& property_name) const;
   std::optional<std::string> getGroup(const std::string_view& segment) const;
+  // Returns the cached RegexSet if it was built from the same patterns, matching modifies it, so it is only used by one trigger at a time
+  CachedRegexSet acquireRegexSet(std::vector<std::string> patterns, utils::RegexSet::MatchMode match_mode);
+  void releaseRegexSet(CachedRegexSet regex_set);
 
   route_text::Routing routing_ = route_text::Routing::DYNAMIC;
   route_text::Matching matching_ = route_text::Matching::STARTS_WITH;
@@ -236,6 +247,9 @@ class RouteText : public core::ProcessorImpl {
   std::string group_fallback_;
 
   std::map<std::string, core::Relationship> dynamic_relationships_;
+
+  std::mutex regex_set_mutex_;
+  std::optional<CachedRegexSet> cached_regex_set_;
 };
 
 }  // namespace org::apache::nifi::minifi::processors
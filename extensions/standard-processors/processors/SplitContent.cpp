@@ -18,13 +18,16 @@
 
 #include "SplitContent.h"
 
+#include <optional>
+#include <string>
+#include <vector>
+
 #include <range/v3/view/split.hpp>
 
 #include "minifi-cpp/core/FlowFile.h"
 #include "minifi-cpp/core/ProcessContext.h"
 #include "core/ProcessSession.h"
 #include "core/Resource.h"
-#include "utils/ConfigurationUtils.h"
 #include "utils/ProcessorConfigUtils.h"
 #include "minifi-cpp/utils/gsl.h"
 
@@ -35,7 +38,6 @@ void SplitContent::initialize() {
 }
 
 void SplitContent::onSchedule(core::ProcessContext& context, core::ProcessSessionFactory&) {
-  buffer_size_ = utils::configuration::getBufferSize(*context.getConfiguration());
   auto byte_sequence_str = utils::parseProperty(context, ByteSequence);
   const auto byte_sequence_format = utils::parseEnumProperty<ByteSequenceFormat>(context, ByteSequenceFormatProperty);
   std::vector<std::byte> byte_sequence{};
@@ -52,17 +54,16 @@ void SplitContent::onSchedule(core::ProcessContext& context, core::ProcessSessio
 }
 
 namespace {
+// Finds the ranges of the splits in the content of the original flow file, the splits are clones referencing these ranges
 class Splitter {
  public:
-  explicit Splitter(core::ProcessSession& session, std::optional<std::string> original_filename, SplitContent::ByteSequenceMatcher& byte_sequence_matcher, const bool keep_byte_sequence,
-      const SplitContent::ByteSequenceLocation byte_sequence_location, const size_t buffer_size)
+  explicit Splitter(core::ProcessSession& session, const core::FlowFile& original, SplitContent::ByteSequenceMatcher& byte_sequence_matcher, const bool keep_byte_sequence,
+      const SplitContent::ByteSequenceLocation byte_sequence_location)
       : session_(session),
-        original_filename_(std::move(original_filename)),
+        original_(original),
         byte_sequence_matcher_(byte_sequence_matcher),
         keep_trailing_byte_sequence_(keep_byte_sequence && byte_sequence_location == SplitContent::ByteSequenceLocation::Trailing),
-        keep_leading_byte_sequence_(keep_byte_sequence && byte_sequence_location == SplitContent::ByteSequenceLocation::Leading),
-        buffer_size_(buffer_size) {
-    data_before_byte_sequence_.reserve(buffer_size_);
+        keep_leading_byte_sequence_(keep_byte_sequence && byte_sequence_location == SplitContent::ByteSequenceLocation::Leading) {
   }
 
   Splitter(const Splitter&) = delete;
@@ -70,100 +71,89 @@ class Splitter {
   Splitter(Splitter&&) = delete;
   Splitter& operator=(Splitter&&) = delete;
 
-  ~Splitter() {
-    flushRemainingData();
-    updateSplitAttributesAndTransfer();
-  }
+  ~Splitter() = default;
 
   void digest(const std::byte b) {
-    const auto prev_matching_bytes = matching_bytes_;
+    ++position_;
     matching_bytes_ = byte_sequence_matcher_.getNumberOfMatchingBytes(matching_bytes_, b);
-    if (matchedByteSequence()) {
-      appendDataBeforeByteSequenceToSplit();
-      if (keep_trailing_byte_sequence_) { appendByteSequenceToSplit(); }
-      closeCurrentSplit();
-
-      // possible new split
-      if (keep_leading_byte_sequence_) { appendByteSequenceToSplit(); }
-      matching_bytes_ = 0;
+    if (!matchedByteSequence()) {
       return;
     }
-    // matching grew, no need to grow data_before_byte_sequence
-    if (matching_bytes_ > prev_matching_bytes) { return; }
-
-    if (matching_bytes_ > 0) {
-      // last byte could be part of the byte_sequence
-      std::copy_n(getByteSequence().begin(), prev_matching_bytes - matching_bytes_ + 1, std::back_inserter(data_before_byte_sequence_));
-    } else {
-      // last byte is not part of the byte_sequence
-      std::copy_n(getByteSequence().begin(), prev_matching_bytes - matching_bytes_, std::back_inserter(data_before_byte_sequence_));
-      data_before_byte_sequence_.push_back(b);
+    const uint64_t byte_sequence_start = position_ - getByteSequence().size();
+    if (byte_sequence_start > data_start_ && !split_start_) {
+      split_start_ = data_start_;
+    }
+    if (keep_trailing_byte_sequence_ && !split_start_) {
+      split_start_ = byte_sequence_start;
     }
+    closeCurrentSplit(keep_trailing_byte_sequence_ ? position_ : byte_sequence_start);
+
+    // possible new split
+    if (keep_leading_byte_sequence_) { split_start_ = byte_sequence_start; }
+    data_start_ = position_;
+    matching_bytes_ = 0;
   }
 
-  void flushIfBufferTooLarge() {
-    if (data_before_byte_sequence_.size() >= buffer_size_) { appendDataBeforeByteSequenceToSplit(); }
+  // Creates and transfers the splits, must be called after every byte of the content has been digested
+  void finish() {
+    closeLastSplit();
+    createSplitsAndTransfer();
   }
 
  private:
-  void closeCurrentSplit() {
-    if (current_split_) {
-      completed_splits_.push_back(current_split_);
-      current_split_.reset();
+  struct Range {
+    uint64_t offset;
+    uint64_t size;
+  };
+
+  void closeCurrentSplit(const uint64_t split_end) {
+    if (split_start_) {
+      completed_splits_.push_back(Range{.offset = *split_start_, .size = split_end - *split_start_});
+      split_start_.reset();
     }
   }
 
-  void appendDataBeforeByteSequenceToSplit() {
-    if (data_before_byte_sequence_.empty()) { return; }
-    ensureCurrentSplit();
-    session_.appendBuffer(current_split_, std::span<const std::byte>(data_before_byte_sequence_.data(), data_before_byte_sequence_.size()));
-    data_before_byte_sequence_.clear();
-  }
-
-  void appendByteSequenceToSplit() {
-    ensureCurrentSplit();
-    session_.appendBuffer(current_split_, getByteSequence());
-  }
-
   [[nodiscard]] std::span<const std::byte> getByteSequence() const { return byte_sequence_matcher_.getByteSequence(); }
 
-  void ensureCurrentSplit() {
-    if (!current_split_) { current_split_ = session_.create(); }
-  }
-
   [[nodiscard]] bool matchedByteSequence() const { return matching_bytes_ == byte_sequence_matcher_.getByteSequence().size(); }
 
-  void flushRemainingData() {
-    if (current_split_ || !data_before_byte_sequence_.empty() || matching_bytes_ > 0) {
-      ensureCurrentSplit();
-      session_.appendBuffer(current_split_, std::span<const std::byte>(data_before_byte_sequence_.data(), data_before_byte_sequence_.size()));
-      session_.appendBuffer(current_split_, byte_sequence_matcher_.getByteSequence().subspan(0, matching_bytes_));
-      completed_splits_.push_back(current_split_);
+  void closeLastSplit() {
+    // the remaining data includes a partially matched byte sequence at the end of the content
+    if (!split_start_ && position_ > data_start_) {
+      split_start_ = data_start_;
     }
+    closeCurrentSplit(position_);
   }
 
-  void updateSplitAttributesAndTransfer() const {
+  void createSplitsAndTransfer() const {
     const std::string fragment_identifier_ = utils::IdGenerator::getIdGenerator()->generate().to_string();
+    const auto original_filename = original_.getAttribute(core::SpecialFlowAttribute::FILENAME);
     for (size_t split_i = 0; split_i < completed_splits_.size(); ++split_i) {
-      const auto& split = completed_splits_[split_i];
+      const auto& range = completed_splits_[split_i];
+      const auto split = session_.clone(original_, gsl::narrow<int64_t>(range.offset), gsl::narrow<int64_t>(range.size));
+      if (!split) {
+        throw Exception(PROCESSOR_EXCEPTION, fmt::format("Couldn't create split of {} at offset {}", original_.getUUIDStr(), range.offset));
+      }
       split->setAttribute(SplitContent::FragmentCountOutputAttribute.name, std::to_string(completed_splits_.size()));
       split->setAttribute(SplitContent::FragmentIndexOutputAttribute.name, std::to_string(split_i + 1));  // One based indexing
       split->setAttribute(SplitContent::FragmentIdentifierOutputAttribute.name, fragment_identifier_);
-      split->setAttribute(SplitContent::SegmentOriginalFilenameOutputAttribute.name, original_filename_.value_or(""));
+      split->setAttribute(SplitContent::SegmentOriginalFilenameOutputAttribute.name, original_filename.value_or(""));
       session_.transfer(split, SplitContent::Splits);
     }
   }
 
   core::ProcessSession& session_;
-  const std::optional<std::string> original_filename_;
+  const core::FlowFile& original_;
   SplitContent::ByteSequenceMatcher& byte_sequence_matcher_;
-  std::vector<std::byte> data_before_byte_sequence_;
-  std::shared_ptr<core::FlowFile> current_split_ = nullptr;
-  std::vector<std::shared_ptr<core::FlowFile>> completed_splits_;
+  // number of bytes digested so far
+  uint64_t position_ = 0;
+  // start of the data which is not part of a matched byte sequence and has not been added to a split yet
+  uint64_t data_start_ = 0;
+  std::optional<uint64_t> split_start_;
+  std::vector<Range> completed_splits_;
   SplitContent::size_type matching_bytes_ = 0;
   const bool keep_trailing_byte_sequence_ = false;
   const bool keep_leading_byte_sequence_ = false;
-  size_t buffer_size_{};
 };
 }  // namespace
 
@@ -212,12 +202,11 @@ void SplitContent::onTrigger(core::ProcessContext& context, core::ProcessSession
   const auto ff_content_stream = session.getFlowFileContentStream(*original);
   if (!ff_content_stream) { throw Exception(PROCESSOR_EXCEPTION, fmt::format("Couldn't access the ContentStream of {}", original->getUUID().to_string())); }
 
-  Splitter splitter{session, original->getAttribute(core::SpecialFlowAttribute::FILENAME), *byte_sequence_matcher_, keep_byte_sequence, byte_sequence_location_, buffer_size_};
-
+  Splitter splitter{session, *original, *byte_sequence_matcher_, keep_byte_sequence, byte_sequence_location_};
   while (auto latest_byte = ff_content_stream->readByte()) {
     splitter.digest(*latest_byte);
-    splitter.flushIfBufferTooLarge();
   }
+  splitter.finish();
 
   session.transfer(original, Original);
 }
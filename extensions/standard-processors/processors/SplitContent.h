@@ -122,7 +122,6 @@ class SplitContent final : public core::ProcessorImpl {
   std::optional<ByteSequenceMatcher> byte_sequence_matcher_;
   bool keep_byte_sequence = false;
   ByteSequenceLocation byte_sequence_location_ = ByteSequenceLocation::Trailing;
-  size_t buffer_size_{};
 };
 
 }  // namespace org::apache::nifi::minifi::processors
@@ -16,6 +16,9 @@
  */
 #include "SplitJson.h"
 
+#include <optional>
+#include <span>
+#include <string_view>
 #include <unordered_map>
 
 #include "core/ProcessSession.h"
@@ -39,19 +42,24 @@ void SplitJson::onSchedule(core::ProcessContext& context, core::ProcessSessionFa
 }
 
 std::optional<jsoncons::json> SplitJson::queryArrayUsingJsonPath(core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file) const {
-  const auto json_string = to_string(session.readBuffer(flow_file));
-  if (json_string.empty()) {
-    logger_->log_error("FlowFile content is empty, transferring to the 'failure' relationship");
-    return std::nullopt;
-  }
-
-  jsoncons::json json_object;
-  try {
-    json_object = jsoncons::json::parse(json_string);
-  } catch (const jsoncons::json_exception& e) {
-    logger_->log_error("FlowFile content is not a valid JSON document, transferring to the 'failure' relationship: {}", e.what());
+  std::optional<jsoncons::json> parsed_json;
+  session.readInPlace(*flow_file, [this, &parsed_json](std::span<const std::byte> content) -> int64_t {
+    const std::string_view json_string{reinterpret_cast<const char*>(content.data()), content.size()};
+    if (json_string.empty()) {
+      logger_->log_error("FlowFile content is empty, transferring to the 'failure' relationship");
+      return 0;
+    }
+    try {
+      parsed_json = jsoncons::json::parse(json_string);
+    } catch (const jsoncons::json_exception& e) {
+      logger_->log_error("FlowFile content is not a valid JSON document, transferring to the 'failure' relationship: {}", e.what());
+    }
+    return gsl::narrow<int64_t>(content.size());
+  });
+  if (!parsed_json) {
     return std::nullopt;
   }
+  const jsoncons::json& json_object = *parsed_json;
 
   jsoncons::json query_result;
   try {
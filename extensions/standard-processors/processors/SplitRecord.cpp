@@ -16,6 +16,9 @@
  */
 #include "SplitRecord.h"
 
+#include <memory>
+#include <vector>
+
 #include "core/Resource.h"
 #include "nonstd/expected.hpp"
 #include "utils/GeneralUtils.h"
@@ -54,44 +57,61 @@ void SplitRecord::onTrigger(core::ProcessContext& context, core::ProcessSession&
     return;
   }
 
-  nonstd::expected<core::RecordSet, std::error_code> record_set;
-  session.read(original_flow_file, [this, &record_set](const std::shared_ptr<io::InputStream>& input_stream) {
-    record_set = record_converter_->record_set_reader->read(*input_stream);
+  // Only the records of the current split are kept in memory, the fragment count is set once the whole input has been read
+  std::vector<std::shared_ptr<core::FlowFile>> split_flow_files;
+  bool failed = false;
+  session.read(original_flow_file, [&](const std::shared_ptr<io::InputStream>& input_stream) -> int64_t {
+    const auto record_reader = record_converter_->record_set_reader->createRecordReader(*input_stream);
+    bool has_more_records = true;
+    while (has_more_records) {
+      core::RecordSet slice_record_set;
+      slice_record_set.reserve(*records_per_split);
+      while (slice_record_set.size() < *records_per_split) {
+        auto record = record_reader->next();
+        if (!record) {
+          logger_->log_error("Failed to read record set from flow file: {}", record.error().message());
+          failed = true;
+          return gsl::narrow<int64_t>(input_stream->size());
+        }
+        if (!*record) {
+          has_more_records = false;
+          break;
+        }
+        slice_record_set.push_back(std::move(**record));
+      }
+      if (slice_record_set.empty()) {
+        break;
+      }
+
+      auto split_flow_file = session.create(original_flow_file.get());
+      if (!split_flow_file) {
+        logger_->log_error("Failed to create a new flow file for record set");
+        failed = true;
+        return gsl::narrow<int64_t>(input_stream->size());
+      }
+      split_flow_file->setAttribute("record.count", std::to_string(slice_record_set.size()));
+      record_converter_->record_set_writer->write(slice_record_set, split_flow_file, session);
+      split_flow_files.push_back(std::move(split_flow_file));
+    }
     return gsl::narrow<int64_t>(input_stream->size());
   });
-  if (!record_set) {
-    logger_->log_error("Failed to read record set from flow file: {}", record_set.error().message());
+  if (failed) {
+    for (const auto& split_flow_file : split_flow_files) {
+      session.remove(split_flow_file);
+    }
     session.transfer(original_flow_file, Failure);
     return;
   }
 
-  std::size_t current_index = 0;
   const auto fragment_identifier = original_flow_file->getAttribute(core::SpecialFlowAttribute::UUID).value_or(utils::IdGenerator::getIdGenerator()->generate().to_string());
-  std::size_t fragment_index = 0;
-  const auto fragment_count = utils::intdiv_ceil(record_set->size(), records_per_split.value());
-  while (current_index < record_set->size()) {
-    auto split_flow_file = session.create(original_flow_file.get());
-    if (!split_flow_file) {
-      logger_->log_error("Failed to create a new flow file for record set");
-      session.transfer(original_flow_file, Failure);
-      return;
-    }
-
-    core::RecordSet slice_record_set;
-    slice_record_set.reserve(*records_per_split);
-    for (std::size_t i = 0; i < records_per_split.value() && current_index < record_set->size(); ++i, ++current_index) {
-      slice_record_set.push_back(std::move(record_set->at(current_index)));
-    }
-
-    split_flow_file->setAttribute("record.count", std::to_string(slice_record_set.size()));
+  const auto original_filename = original_flow_file->getAttribute("filename").value_or("");
+  for (std::size_t fragment_index = 0; fragment_index < split_flow_files.size(); ++fragment_index) {
+    const auto& split_flow_file = split_flow_files[fragment_index];
     split_flow_file->setAttribute("fragment.identifier", fragment_identifier);
     split_flow_file->setAttribute("fragment.index", std::to_string(fragment_index));
-    split_flow_file->setAttribute("fragment.count", std::to_string(fragment_count));
-    split_flow_file->setAttribute("segment.original.filename", original_flow_file->getAttribute("filename").value_or(""));
-
-    record_converter_->record_set_writer->write(slice_record_set, split_flow_file, session);
+    split_flow_file->setAttribute("fragment.count", std::to_string(split_flow_files.size()));
+    split_flow_file->setAttribute("segment.original.filename", original_filename);
     session.transfer(split_flow_file, Splits);
-    ++fragment_index;
   }
 
   session.transfer(original_flow_file, Original);
@@ -27,6 +27,10 @@
 #include <utility>
 #include <vector>
 
+#ifndef WIN32
+#include <sys/stat.h>
+#endif
+
 #include "range/v3/action/sort.hpp"
 
 #include "io/CRCStream.h"
@@ -82,6 +86,18 @@ std::map<std::filesystem::path, TailState> update_keys_in_legacy_states(const st
   return new_tail_states;
 }
 
+std::optional<FileIdentity> getFileIdentity(const std::filesystem::path& file_path) {
+#ifndef WIN32
+  struct stat file_status{};
+  if (stat(file_path.c_str(), &file_status) != 0) {
+    return std::nullopt;
+  }
+  return FileIdentity{.device = static_cast<uint64_t>(file_status.st_dev), .inode = static_cast<uint64_t>(file_status.st_ino)};
+#else
+  return std::nullopt;
+#endif
+}
+
 void openFile(const std::filesystem::path& file_path, uint64_t offset, std::ifstream &input_stream, const std::shared_ptr<core::logging::Logger> &logger) {
   logger->log_debug("Opening {}", file_path);
   input_stream.open(file_path, std::fstream::in | std::fstream::binary);
@@ -104,10 +120,12 @@ class FileReaderCallback {
                      uint64_t offset,
                      char input_delimiter,
                      uint64_t checksum,
-                     size_t buffer_size)
+                     size_t buffer_size,
+                     std::optional<uint64_t> max_flow_file_size)
     : input_delimiter_(input_delimiter),
       checksum_(checksum),
-      buffer_size_(buffer_size) {
+      buffer_size_(buffer_size),
+      max_flow_file_size_(max_flow_file_size) {
     openFile(file_path, offset, input_stream_, logger_);
   }
 
@@ -115,9 +133,11 @@ class FileReaderCallback {
     io::CRCStream<io::OutputStream> crc_stream{gsl::make_not_null(output_stream.get()), checksum_};
 
     uint64_t num_bytes_written = 0;
-    bool found_delimiter = false;
+    lines_in_latest_flow_file_ = 0;
+    complete_lines_size_ = 0;
+    bool flow_file_is_full = false;
 
-    while (hasMoreToRead() && !found_delimiter) {
+    while (hasMoreToRead() && !flow_file_is_full) {
       if (begin_ == end_) {
         input_stream_.read(buffer_.data(), gsl::narrow<std::streamsize>(buffer_.size()));
 
@@ -129,27 +149,43 @@ class FileReaderCallback {
       }
 
       char *delimiter_pos = std::find(begin_, end_, input_delimiter_);
-      found_delimiter = (delimiter_pos != end_);
+      const bool found_delimiter = (delimiter_pos != end_);
 
       const auto zlen = gsl::narrow<size_t>(std::distance(begin_, delimiter_pos)) + (found_delimiter ? 1 : 0);
       crc_stream.write(reinterpret_cast<uint8_t*>(begin_), zlen);
       num_bytes_written += zlen;
       begin_ += zlen;
-    }
 
-    if (found_delimiter) {
-      checksum_ = crc_stream.getCRC();
-    } else {
-      latest_flow_file_ends_with_delimiter_ = false;
+      if (found_delimiter) {
+        ++lines_in_latest_flow_file_;
+        complete_lines_size_ = num_bytes_written;
+        checksum_ = crc_stream.getCRC();
+        flow_file_is_full = lines_in_latest_flow_file_ >= max_lines_ || (max_flow_file_size_ && num_bytes_written >= *max_flow_file_size_);
+      }
     }
 
+    latest_flow_file_ends_with_delimiter_ = lines_in_latest_flow_file_ > 0 && complete_lines_size_ == num_bytes_written;
+
     return gsl::narrow<int64_t>(num_bytes_written);
   }
 
+  void setMaxLines(uint64_t max_lines) {
+    max_lines_ = max_lines;
+  }
+
   uint64_t checksum() const {
     return checksum_;
   }
 
+  uint64_t linesInLatestFlowFile() const {
+    return lines_in_latest_flow_file_;
+  }
+
+  // size of the latest flow file up to and including its last delimiter
+  uint64_t completeLinesSize() const {
+    return complete_lines_size_;
+  }
+
   bool hasMoreToRead() const {
     return begin_ != end_ || input_stream_.good();
   }
@@ -163,12 +199,16 @@ class FileReaderCallback {
   uint64_t checksum_{};
   std::ifstream input_stream_;
   size_t buffer_size_{};
+  std::optional<uint64_t> max_flow_file_size_;
+  uint64_t max_lines_ = 1;
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<TailFile>::getLogger();
 
   std::vector<char> buffer_ = std::vector<char>(buffer_size_);
   char *begin_ = buffer_.data();
   char *end_ = buffer_.data();
 
+  uint64_t lines_in_latest_flow_file_ = 0;
+  uint64_t complete_lines_size_ = 0;
   bool latest_flow_file_ends_with_delimiter_ = true;
 };
 
@@ -310,6 +350,25 @@ void TailFile::onSchedule(core::ProcessContext& context, core::ProcessSessionFac
   initial_start_position_ = utils::parseEnumProperty<InitialStartPositions>(context, InitialStartPosition);
   batch_size_ = gsl::narrow<uint32_t>(utils::parseU64Property(context, BatchSize));
   if (batch_size_ == 0) { batch_size_.reset(); }
+  lines_per_flow_file_ = utils::parseU64Property(context, LinesPerFlowFile);
+  if (lines_per_flow_file_ == 0) {
+    throw minifi::Exception(ExceptionType::PROCESSOR_EXCEPTION, "Lines Per Flow File must be at least 1");
+  }
+  max_flow_file_size_ = utils::parseOptionalDataSizeProperty(context, MaxFlowFileSize);
+
+  files_with_unread_data_.clear();
+  files_in_unwatched_directories_.clear();
+  change_notifier_.reset();
+  if (utils::parseEnumProperty<TailChangeDetection>(context, ChangeDetection) == TailChangeDetection::FileSystemNotifications) {
+    change_notifier_ = std::make_unique<utils::FileChangeNotifier>(logger_);
+    if (change_notifier_->isSupported()) {
+      notification_wait_time_ = utils::parseDurationProperty(context, NotificationWaitTime);
+      watchTailedDirectories();
+    } else {
+      logger_->log_warn("File system notifications are not supported on this platform, falling back to polling");
+      change_notifier_.reset();
+    }
+  }
 }
 
 void TailFile::parseStateFileLine(char *buf, std::map<std::filesystem::path, TailState> &state) const {
@@ -424,13 +483,18 @@ bool TailFile::getStateFromStateManager(std::map<std::filesystem::path, TailStat
         std::chrono::file_clock::time_point last_read_time{std::chrono::milliseconds{
             readOptionalInt64(state_map, "file." + std::to_string(i) + ".last_read_time")
         }};
+        std::optional<FileIdentity> identity;
+        if (state_map.contains("file." + std::to_string(i) + ".inode")) {
+          identity = FileIdentity{.device = readOptionalUint64(state_map, "file." + std::to_string(i) + ".device"),
+                                  .inode = readOptionalUint64(state_map, "file." + std::to_string(i) + ".inode")};
+        }
 
         std::filesystem::path file_path = current;
         if (file_path.has_filename() && file_path.has_parent_path()) {
           logger_->log_debug("Received path {}, file {}", file_path.parent_path(), file_path.filename());
-          new_tail_states.emplace(current, TailState{file_path.parent_path(), file_path.filename(), position, last_read_time, checksum});
+          new_tail_states.emplace(current, TailState{file_path.parent_path(), file_path.filename(), position, last_read_time, checksum, false, identity});
         } else {
-          new_tail_states.emplace(current, TailState{file_path.parent_path(), file_path, position, last_read_time, checksum});
+          new_tail_states.emplace(current, TailState{file_path.parent_path(), file_path, position, last_read_time, checksum, false, identity});
         }
       } catch (...) {
         continue;
@@ -492,6 +556,10 @@ bool TailFile::storeState() const {
     state["file." + std::to_string(i) + ".position"] = std::to_string(tail_state.second.position_);
     state["file." + std::to_string(i) + ".checksum"] = std::to_string(tail_state.second.checksum_);
     state["file." + std::to_string(i) + ".last_read_time"] = std::to_string(tail_state.second.lastReadTimeInMilliseconds());
+    if (const auto& identity = tail_state.second.identity_) {
+      state["file." + std::to_string(i) + ".device"] = std::to_string(identity->device);
+      state["file." + std::to_string(i) + ".inode"] = std::to_string(identity->inode);
+    }
     ++i;
   }
   if (!state_manager_->set(state)) {
@@ -565,7 +633,10 @@ std::vector<TailState> TailFile::sortAndSkipMainFilePrefix(const TailState &stat
     TailState &first_rotated_file = matched_files_with_mtime[0].tail_state_;
     auto full_file_name = first_rotated_file.fileNameWithPath();
     if (utils::file::file_size(full_file_name) >= state.position_) {
-      if (utils::file::computeChecksum(full_file_name, state.position_) == state.checksum_) {
+      // a file renamed by the rotation keeps its identity, so its prefix only has to be checksummed if it was copied
+      const bool is_previously_tailed_file = (state.identity_ && getFileIdentity(full_file_name) == state.identity_)
+          || utils::file::computeChecksum(full_file_name, state.position_) == state.checksum_;
+      if (is_previously_tailed_file) {
         first_rotated_file.position_ = state.position_;
         first_rotated_file.checksum_ = state.checksum_;
       }
@@ -590,25 +661,71 @@ void TailFile::onTrigger(core::ProcessContext& context, core::ProcessSession& se
   }
 
   // iterate over file states. may modify them
-  for (auto &state : tail_states_) {
-    processFile(session, state.first, state.second);
+  for (const auto& full_file_name : filesToProcess()) {
+    if (processFile(session, full_file_name, tail_states_.at(full_file_name))) {
+      files_with_unread_data_.insert(full_file_name);
+    } else {
+      files_with_unread_data_.erase(full_file_name);
+    }
   }
 
-  if (!session.existsFlowFileInRelationship(Success)) {
+  // when waiting for notifications, the trigger has already waited for new data
+  if (!session.existsFlowFileInRelationship(Success) && (!change_notifier_ || notification_wait_time_ == std::chrono::milliseconds{0})) {
     context.yield();
   }
 
   first_trigger_ = false;
 }
 
+void TailFile::watchTailedDirectories() {
+  if (!change_notifier_) {
+    return;
+  }
+  files_in_unwatched_directories_.clear();
+  for (const auto& [full_file_name, state] : tail_states_) {
+    if (change_notifier_->isWatched(state.path_)) {
+      continue;
+    }
+    if (change_notifier_->watchDirectory(state.path_)) {
+      // the file may have been written before its directory was watched, so it is read without waiting for a notification
+      files_with_unread_data_.insert(full_file_name);
+    } else {
+      files_in_unwatched_directories_.insert(full_file_name);
+    }
+  }
+}
+
+std::vector<std::filesystem::path> TailFile::filesToProcess() {
+  // the directories which did not exist or were deleted and recreated since the last trigger are watched again
+  watchTailedDirectories();
+
+  std::vector<std::filesystem::path> files;
+  files.reserve(tail_states_.size());
+  if (!change_notifier_ || first_trigger_) {
+    std::ranges::transform(tail_states_, std::back_inserter(files), [](const auto& tail_state) { return tail_state.first; });
+    return files;
+  }
+
+  // files which were not read to the end because of the batch size are processed again without waiting
+  const auto wait_time = files_with_unread_data_.empty() ? notification_wait_time_ : std::chrono::milliseconds{0};
+  const auto changes = change_notifier_->waitForChanges(wait_time);
+  for (const auto& [full_file_name, state] : tail_states_) {
+    if (changes.contains(state.fileNameWithPath()) || files_with_unread_data_.contains(full_file_name) || files_in_unwatched_directories_.contains(full_file_name)) {
+      files.push_back(full_file_name);
+    }
+  }
+  return files;
+}
+
 bool TailFile::isOldFileInitiallyRead(const TailState& state) const {
   // This is our initial processing and no stored state was found
   return first_trigger_ && state.last_read_time_ == std::chrono::file_clock::time_point{};
 }
 
-void TailFile::processFile(core::ProcessSession& session,
+bool TailFile::processFile(core::ProcessSession& session,
                            const std::filesystem::path& full_file_name,
                            TailState &state) {
+  const auto identity = getFileIdentity(full_file_name);
   if (isOldFileInitiallyRead(state)) {
     if (initial_start_position_ == InitialStartPositions::BEGINNING_OF_TIME) {
       processAllRotatedFiles(session, state);
@@ -616,21 +733,25 @@ void TailFile::processFile(core::ProcessSession& session,
       state.position_ = utils::file::file_size(full_file_name);
       state.last_read_time_ = std::chrono::file_clock::now();
       state.checksum_ = utils::file::computeChecksum(full_file_name, state.position_);
+      state.identity_ = identity;
       storeState();
-      return;
+      return false;
     }
   } else {
     uint64_t fsize = utils::file::file_size(full_file_name);
-    if (fsize < state.position_) {
+    const bool file_was_replaced = identity && state.identity_ && *identity != *state.identity_;
+    if (fsize < state.position_ || file_was_replaced) {
       processRotatedFilesAfterLastReadTime(session, state);
     } else if (fsize == state.position_) {
       logger_->log_trace("Skipping file {} as its size hasn't changed since last read", state.file_name_);
-      return;
+      return false;
     }
   }
 
-  processSingleFile(session, full_file_name, state);
+  state.identity_ = identity;
+  const bool has_unread_data = processSingleFile(session, full_file_name, state);
   storeState();
+  return has_unread_data;
 }
 
 void TailFile::processRotatedFilesAfterLastReadTime(core::ProcessSession& session, TailState &state) {
@@ -651,14 +772,14 @@ void TailFile::processRotatedFiles(core::ProcessSession& session, TailState &sta
   state.checksum_ = 0;
 }
 
-void TailFile::processSingleFile(core::ProcessSession& session,
+bool TailFile::processSingleFile(core::ProcessSession& session,
                                  const std::filesystem::path& full_file_name,
                                  TailState &state) {
   auto fileName = state.file_name_;
 
   if (utils::file::file_size(full_file_name) == 0U) {
     logger_->log_warn("Unable to read file {} as it does not exist or has size zero", full_file_name);
-    return;
+    return false;
   }
   logger_->log_debug("Tailing file {} from {}", full_file_name, state.position_);
 
@@ -671,27 +792,38 @@ void TailFile::processSingleFile(core::ProcessSession& session,
     logger_->log_trace("Looking for delimiter 0x{:X}", *delimiter_);
 
     std::size_t num_flow_files = 0;
-    FileReaderCallback file_reader{full_file_name, state.position_, *delimiter_, state.checksum_, buffer_size_};
+    uint64_t num_lines = 0;
+    FileReaderCallback file_reader{full_file_name, state.position_, *delimiter_, state.checksum_, buffer_size_, max_flow_file_size_};
     TailState state_copy{state};
 
-    while (file_reader.hasMoreToRead() && (!batch_size_ || *batch_size_ > num_flow_files)) {
+    while (file_reader.hasMoreToRead() && (!batch_size_ || *batch_size_ > num_lines)) {
+      file_reader.setMaxLines(batch_size_ ? std::min<uint64_t>(lines_per_flow_file_, *batch_size_ - num_lines) : lines_per_flow_file_);
       auto flow_file = session.create();
       session.write(flow_file, std::ref(file_reader));
 
-      if (file_reader.endedWithDelimiter() || (state.is_rotated_ && flow_file->getSize() > 0)) {
+      bool is_complete = file_reader.endedWithDelimiter() || (state.is_rotated_ && flow_file->getSize() > 0);
+      if (!is_complete && file_reader.completeLinesSize() > 0) {
+        // the incomplete last line is cut off without copying the content, it will be read again by a later trigger
+        flow_file->setSize(file_reader.completeLinesSize());
+        is_complete = true;
+      }
+
+      if (is_complete) {
         updateFlowFileAttributes(full_file_name, state_copy, fileName, baseName, extension, *flow_file);
         session.transfer(flow_file, Success);
         updateStateAttributes(state_copy, flow_file->getSize(), file_reader.checksum());
 
         ++num_flow_files;
-
+        num_lines += file_reader.linesInLatestFlowFile();
       } else {
         session.remove(flow_file);
       }
     }
 
     state = state_copy;
-    logger_->log_info("{} flowfiles were received from TailFile input", num_flow_files);
+    logger_->log_info("{} flowfiles were received from TailFile input ({} lines)", num_flow_files, num_lines);
+
+    return batch_size_ && num_lines >= *batch_size_ && file_reader.hasMoreToRead();
 
   } else {
     WholeFileReaderCallback file_reader{full_file_name, state.position_, state.checksum_, buffer_size_};
@@ -702,6 +834,7 @@ void TailFile::processSingleFile(core::ProcessSession& session,
     session.transfer(flow_file, Success);
     updateStateAttributes(state, flow_file->getSize(), file_reader.checksum());
   }
+  return false;
 }
 
 void TailFile::updateFlowFileAttributes(const std::filesystem::path& full_file_name, const TailState& state,
@@ -756,6 +889,8 @@ void TailFile::checkForRemovedFiles() {
 
   for (const auto &full_file_name : file_names_to_remove) {
     tail_states_.erase(full_file_name);
+    files_with_unread_data_.erase(full_file_name);
+    files_in_unwatched_directories_.erase(full_file_name);
   }
 }
 
@@ -765,6 +900,8 @@ void TailFile::checkForNewFiles(core::ProcessContext& context) {
     auto full_file_name = path / file_name;
     if (!containsKey(tail_states_, full_file_name) && utils::regexMatch(file_name.string(), *pattern_regex_)) {
       tail_states_.emplace(full_file_name, TailState{path, file_name});
+      // the file may have been written before its directory was watched, so it is read without waiting for a notification
+      files_with_unread_data_.insert(full_file_name);
     }
     return true;
   };
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <map>
+#include <set>
 #include <memory>
 #include <utility>
 #include <string>
@@ -39,6 +40,7 @@
 #include "utils/Enum.h"
 #include "minifi-cpp/utils/Export.h"
 #include "utils/RegexUtils.h"
+#include "../utils/FileChangeNotifier.h"
 
 namespace org::apache::nifi::minifi::processors {
 
@@ -53,11 +55,17 @@ enum class TailResultFormat {
   FlowFilePerBatch
 };
 
+enum class TailChangeDetection {
+  Polling,
+  FileSystemNotifications
+};
+
 }  // namespace org::apache::nifi::minifi::processors
 
 namespace magic_enum::customize {
 using InitialStartPositions = org::apache::nifi::minifi::processors::InitialStartPositions;
 using TailResultFormat = org::apache::nifi::minifi::processors::TailResultFormat;
+using TailChangeDetection = org::apache::nifi::minifi::processors::TailChangeDetection;
 
 template <>
 constexpr customize_t enum_name<InitialStartPositions>(InitialStartPositions value) noexcept {
@@ -82,15 +90,35 @@ constexpr customize_t enum_name<TailResultFormat>(TailResultFormat value) noexce
   }
   return invalid_tag;
 }
+
+template<>
+constexpr customize_t enum_name<TailChangeDetection>(TailChangeDetection value) noexcept {
+  switch (value) {
+    case TailChangeDetection::Polling:
+      return "Polling";
+    case TailChangeDetection::FileSystemNotifications:
+      return "File System Notifications";
+  }
+  return invalid_tag;
+}
 }  // namespace magic_enum::customize
 
 namespace org::apache::nifi::minifi::processors {
 
+// Identifies a file independently of its name, so a renamed (rotated) file can be recognized without reading its content
+struct FileIdentity {
+  uint64_t device = 0;
+  uint64_t inode = 0;
+
+  bool operator==(const FileIdentity&) const = default;
+};
+
 struct TailState {
   TailState(std::filesystem::path path, std::filesystem::path file_name, uint64_t position,
             const std::chrono::file_clock::time_point last_read_time,
-            const uint64_t checksum, const bool is_rotated = false)
-      : path_(std::move(path)), file_name_(std::move(file_name)), position_(position), last_read_time_(last_read_time), checksum_(checksum), is_rotated_(is_rotated) {}
+            const uint64_t checksum, const bool is_rotated = false, std::optional<FileIdentity> identity = std::nullopt)
+      : path_(std::move(path)), file_name_(std::move(file_name)), position_(position), last_read_time_(last_read_time), checksum_(checksum), is_rotated_(is_rotated),
+        identity_(identity) {}
 
   TailState(std::filesystem::path path, std::filesystem::path file_name, const bool is_rotated = false)
       : TailState{std::move(path), std::move(file_name), 0, std::chrono::file_clock::time_point{}, 0, is_rotated} {}
@@ -111,6 +139,7 @@ struct TailState {
   std::chrono::file_clock::time_point last_read_time_;
   uint64_t checksum_ = 0;
   bool is_rotated_ = false;
+  std::optional<FileIdentity> identity_;
 };
 
 std::ostream& operator<<(std::ostream &os, const TailState &tail_state);
@@ -207,6 +236,34 @@ class TailFile : public core::ProcessorImpl {
       .withDefaultValue(magic_enum::enum_name(TailResultFormat::FlowFilePerDelimiter))
       .withAllowedValues(magic_enum::enum_names<TailResultFormat>())
       .build();
+  EXTENSIONAPI static constexpr auto LinesPerFlowFile = core::PropertyDefinitionBuilder<>::createProperty("Lines Per Flow File")
+      .withDescription("Maximum number of lines emitted in a single flow file when using Flow file per delimiter Result Mode.")
+      .isRequired(true)
+      .withValidator(core::StandardPropertyValidators::UNSIGNED_INTEGER_VALIDATOR)
+      .withDefaultValue("1")
+      .build();
+  EXTENSIONAPI static constexpr auto MaxFlowFileSize = core::PropertyDefinitionBuilder<>::createProperty("Max Flow File Size")
+      .withDescription("When using Flow file per delimiter Result Mode, a flow file is finished at the first delimiter after this many bytes, "
+          "even if it contains fewer lines than Lines Per Flow File. If not set, only Lines Per Flow File limits the size of the flow files.")
+      .isRequired(false)
+      .withValidator(core::StandardPropertyValidators::DATA_SIZE_VALIDATOR)
+      .build();
+  EXTENSIONAPI static constexpr auto ChangeDetection = core::PropertyDefinitionBuilder<magic_enum::enum_count<TailChangeDetection>()>::createProperty("Change Detection")
+      .withDescription("Specifies how the processor finds out that the tailed files have changed.\n"
+          "Polling: Every tailed file is checked on every trigger.\n"
+          "File System Notifications: The processor waits for notifications of the operating system about changes in the directories of the tailed files, "
+          "and only reads the files that have changed. Only supported on Linux, other platforms fall back to Polling.")
+      .isRequired(true)
+      .withDefaultValue(magic_enum::enum_name(TailChangeDetection::Polling))
+      .withAllowedValues(magic_enum::enum_names<TailChangeDetection>())
+      .build();
+  EXTENSIONAPI static constexpr auto NotificationWaitTime = core::PropertyDefinitionBuilder<>::createProperty("Notification Wait Time")
+      .withDescription("When using File System Notifications Change Detection, the maximum time a trigger waits for a change of the tailed files. "
+          "The processor is not yielded when no change arrives in time, so the Run Schedule can be set to 0 sec to pick up new lines with low latency.")
+      .isRequired(true)
+      .withValidator(core::StandardPropertyValidators::TIME_PERIOD_VALIDATOR)
+      .withDefaultValue("1 sec")
+      .build();
   EXTENSIONAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({
       FileName,
       StateFile,
@@ -219,7 +276,11 @@ class TailFile : public core::ProcessorImpl {
       InitialStartPosition,
       AttributeProviderService,
       BatchSize,
-      ResultFormat
+      ResultFormat,
+      LinesPerFlowFile,
+      MaxFlowFileSize,
+      ChangeDetection,
+      NotificationWaitTime
   });
 
 
@@ -264,10 +325,10 @@ class TailFile : public core::ProcessorImpl {
   std::vector<TailState> findAllRotatedFiles(const TailState &state) const;
   std::vector<TailState> findRotatedFilesAfterLastReadTime(const TailState &state) const;
   static std::vector<TailState> sortAndSkipMainFilePrefix(const TailState &state, std::vector<TailStateWithMtime>& matched_files_with_mtime);
-  void processFile(core::ProcessSession& session,
+  bool processFile(core::ProcessSession& session,
                    const std::filesystem::path& full_file_name,
                    TailState &state);
-  void processSingleFile(core::ProcessSession& session,
+  bool processSingleFile(core::ProcessSession& session,
                          const std::filesystem::path& full_file_name,
                          TailState &state);
   bool getStateFromStateManager(std::map<std::filesystem::path, TailState> &new_tail_states) const;
@@ -282,6 +343,8 @@ class TailFile : public core::ProcessorImpl {
                                 core::FlowFile& flow_file) const;
   static void updateStateAttributes(TailState &state, uint64_t size, uint64_t checksum);
   bool isOldFileInitiallyRead(const TailState &state) const;
+  void watchTailedDirectories();
+  std::vector<std::filesystem::path> filesToProcess();
 
   static constexpr int BUFFER_SIZE = 512;
 
@@ -300,6 +363,13 @@ class TailFile : public core::ProcessorImpl {
   controllers::AttributeProviderService* attribute_provider_service_ = nullptr;
   std::unordered_map<std::string, controllers::AttributeProviderService::AttributeMap> extra_attributes_;
   std::optional<uint32_t> batch_size_;
+  uint64_t lines_per_flow_file_ = 1;
+  std::optional<uint64_t> max_flow_file_size_;
+  std::unique_ptr<utils::FileChangeNotifier> change_notifier_;
+  std::chrono::milliseconds notification_wait_time_{};
+  std::set<std::filesystem::path> files_with_unread_data_;
+  // files whose directory cannot be watched, e.g. because it does not exist yet, are polled instead
+  std::set<std::filesystem::path> files_in_unwatched_directories_;
   size_t buffer_size_{};
 };
 
@@ -17,8 +17,10 @@
  */
 #include <array>
 #include <memory>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include "unit/TestBase.h"
 #include "unit/Catch.h"
 #include "core/Core.h"
@@ -375,6 +377,70 @@ TEST_CASE("Test Keepalive", "[InvokeHTTP]") {
   CHECK(1 == connection_counting_server.getConnectionCounter());
 }
 
+TEST_CASE("InvokeHTTP sends the requests of multiple flow files concurrently", "[InvokeHTTP]") {
+  using minifi::processors::InvokeHTTP;
+
+  test::SingleProcessorTestController test_controller{minifi::test::utils::make_processor<InvokeHTTP>("InvokeHTTP")};
+  auto invoke_http = test_controller.getProcessor();
+  const TestHTTPServer http_server;
+
+  REQUIRE(invoke_http->setProperty(InvokeHTTP::Method.name, "POST"));
+  REQUIRE(invoke_http->setProperty(InvokeHTTP::URL.name, TestHTTPServer::URL));
+  REQUIRE(invoke_http->setProperty(InvokeHTTP::MaxConcurrentRequests.name, "4"));
+
+  std::vector<InputFlowFileData> input_flow_files;
+  for (const auto* content : {"one", "two", "three", "four", "five"}) {
+    input_flow_files.push_back(InputFlowFileData{.content = content});
+  }
+  // a new flow file is taken as soon as one of the first four requests completes
+  const auto result = test_controller.trigger(std::move(input_flow_files));
+  CHECK(result.at(InvokeHTTP::RelFailure).empty());
+  CHECK(result.at(InvokeHTTP::RelNoRetry).empty());
+  CHECK(result.at(InvokeHTTP::RelRetry).empty());
+  CHECK(result.at(InvokeHTTP::RelResponse).size() == 5);
+  const auto& success_flow_files = result.at(InvokeHTTP::Success);
+  REQUIRE(success_flow_files.size() == 5);
+
+  std::set<std::string> transaction_ids;
+  for (const auto& flow_file : success_flow_files) {
+    CHECK(flow_file->getAttribute(std::string{InvokeHTTP::STATUS_CODE}) == "200");
+    transaction_ids.insert(flow_file->getAttribute(std::string{InvokeHTTP::TRANSACTION_ID}).value_or(""));
+  }
+  CHECK(transaction_ids.size() == 5);
+}
+
+TEST_CASE("InvokeHTTP limits the number of flow files taken in a trigger with concurrent requests", "[InvokeHTTP]") {
+  using minifi::processors::InvokeHTTP;
+
+  test::SingleProcessorTestController test_controller{minifi::test::utils::make_processor<InvokeHTTP>("InvokeHTTP")};
+  auto invoke_http = test_controller.getProcessor();
+  const TestHTTPServer http_server;
+
+  REQUIRE(invoke_http->setProperty(InvokeHTTP::Method.name, "POST"));
+  REQUIRE(invoke_http->setProperty(InvokeHTTP::URL.name, TestHTTPServer::URL));
+  REQUIRE(invoke_http->setProperty(InvokeHTTP::MaxConcurrentRequests.name, "2"));
+
+  std::vector<InputFlowFileData> input_flow_files(25, InputFlowFileData{.content = "data"});
+  const auto result = test_controller.trigger(std::move(input_flow_files));
+  // at most 10 times Max Concurrent Requests flow files are taken, so that the session is committed regularly
+  const auto first_trigger_count = result.at(InvokeHTTP::Success).size();
+  CHECK(first_trigger_count <= 20);
+  CHECK(result.at(InvokeHTTP::RelFailure).empty());
+
+  const auto second_result = test_controller.trigger();
+  CHECK(first_trigger_count + second_result.at(InvokeHTTP::Success).size() == 25);
+}
+
+TEST_CASE("InvokeHTTP does not accept zero concurrent requests", "[InvokeHTTP]") {
+  using minifi::processors::InvokeHTTP;
+
+  test::SingleProcessorTestController test_controller{minifi::test::utils::make_processor<InvokeHTTP>("InvokeHTTP")};
+  auto invoke_http = test_controller.getProcessor();
+  REQUIRE(invoke_http->setProperty(InvokeHTTP::URL.name, TestHTTPServer::URL));
+  REQUIRE(invoke_http->setProperty(InvokeHTTP::MaxConcurrentRequests.name, "0"));
+  REQUIRE_THROWS_WITH(test_controller.trigger(), Catch::Matchers::ContainsSubstring("Max Concurrent Requests must be at least 1"));
+}
+
 TEST_CASE("Validating data transfer speed") {
   const auto& data_transfer_speed_validator = processors::invoke_http::DATA_TRANSFER_SPEED_VALIDATOR;
   CHECK(data_transfer_speed_validator.validate("10 kB/s"));
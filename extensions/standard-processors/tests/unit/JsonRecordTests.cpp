@@ -16,11 +16,13 @@
  */
 
 #include <numbers>
+#include <string>
 #include <variant>
 
 #include "catch2/generators/catch_generators.hpp"
 #include "controllers/JsonRecordSetWriter.h"
 #include "controllers/JsonTreeReader.h"
+#include "io/BufferStream.h"
 #include "minifi-cpp/core/Record.h"
 #include "unit/Catch.h"
 #include "unit/RecordSetTesters.h"
@@ -115,4 +117,71 @@ TEST_CASE("JsonTreeReader tests") {
   CHECK(core::test::testRecordReader(json_record_set_reader, input_str, expected_record_set));
 }
 
+TEST_CASE("JsonTreeReader reads the records one by one") {
+  std::string input_str;
+  std::string expected_first_value;
+  SECTION("One line per object") {
+    for (size_t i = 0; i < 1000; ++i) {
+      input_str += fmt::format(R"({{"index":{},"text":"line, with \"quoted\" ] and }} characters"}})", i) + "\n";
+    }
+  }
+  SECTION("Array") {
+    input_str = "[";
+    for (size_t i = 0; i < 1000; ++i) {
+      input_str += fmt::format(R"({}{{"index":{},"text":"line, with \"quoted\" ] and }} characters"}})", i == 0 ? "" : ",\n  ", i);
+    }
+    input_str += "]";
+  }
+  io::BufferStream buffer_stream;
+  buffer_stream.write(as_bytes(std::span(input_str)));
+
+  JsonTreeReader json_record_set_reader{"json_record_set_reader"};
+  const auto record_reader = json_record_set_reader.createRecordReader(buffer_stream);
+  for (size_t i = 0; i < 1000; ++i) {
+    auto record = record_reader->next();
+    REQUIRE(record);
+    REQUIRE(*record);
+    CHECK(std::get<int64_t>((*record)->at("index").value_) == gsl::narrow<int64_t>(i));
+    CHECK(std::get<std::string>((*record)->at("text").value_) == R"(line, with "quoted" ] and } characters)");
+  }
+  const auto end = record_reader->next();
+  REQUIRE(end);
+  CHECK_FALSE(*end);
+}
+
+TEST_CASE("JsonTreeReader stops reading at the first invalid record") {
+  const std::string input_str = GENERATE("{\"a\":1}\nnot json\n{\"b\":2}\n", R"([{"a":1},"not an object",{"b":2}])");
+  io::BufferStream buffer_stream;
+  buffer_stream.write(as_bytes(std::span(input_str)));
+
+  JsonTreeReader json_record_set_reader{"json_record_set_reader"};
+  const auto record_set = json_record_set_reader.read(buffer_stream);
+  REQUIRE(record_set);
+  REQUIRE(record_set->size() == 1);
+  CHECK(std::get<int64_t>(record_set->at(0).at("a").value_) == 1);
+}
+
+TEST_CASE("JsonRecordSetWriter writes each record as soon as it is received") {
+  JsonRecordSetWriter json_record_set_writer{"json_record_set_writer"};
+  const auto [output_grouping, expected_after_first_record, expected_output] = GENERATE(
+      std::make_tuple("One Line Per Object", R"({"a":1})" "\n", R"({"a":1})" "\n" R"({"a":2})" "\n"),
+      std::make_tuple("Array", R"([{"a":1})", R"([{"a":1},{"a":2}])"));
+  json_record_set_writer.initialize();
+  CHECK(json_record_set_writer.setProperty(JsonRecordSetWriter::OutputGrouping.name, output_grouping));
+  json_record_set_writer.onEnable();
+
+  io::BufferStream buffer_stream;
+  const auto record_writer = json_record_set_writer.createRecordWriter(buffer_stream);
+  const auto create_record = [](int64_t value) {
+    core::Record record;
+    record.emplace("a", core::RecordField{value});
+    return record;
+  };
+  CHECK_FALSE(io::isError(record_writer->write(create_record(1))));
+  CHECK(std::string{reinterpret_cast<const char*>(buffer_stream.getBuffer().data()), buffer_stream.size()} == expected_after_first_record);
+  CHECK_FALSE(io::isError(record_writer->write(create_record(2))));
+  CHECK_FALSE(io::isError(record_writer->finish()));
+  CHECK(std::string{reinterpret_cast<const char*>(buffer_stream.getBuffer().data()), buffer_stream.size()} == expected_output);
+}
+
 }  // namespace org::apache::nifi::minifi::standard::test
@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 #include <string>
+#include <string_view>
 
 #include "unit/Catch.h"
 #include "processors/ListenUDP.h"
@@ -117,4 +118,66 @@ TEST_CASE("ListenUDP max queue and max batch size test", "[ListenUDP][NetworkLis
   CHECK(controller.trigger().at(ListenUDP::Success).empty());
 }
 
+TEST_CASE("ListenUDP packs the messages of the same sender into one flow file", "[ListenUDP][NetworkListenerProcessor]") {
+  SingleProcessorTestController controller{minifi::test::utils::make_processor<ListenUDP>("ListenUDP")};
+  const auto listen_udp = controller.getProcessor<ListenUDP>();
+  LogTestController::getInstance().setTrace<ListenUDP>();
+
+  std::string expected_content;
+  SECTION("Newline delimited") {
+    REQUIRE(listen_udp->setProperty(ListenUDP::MessagePackingProperty.name, std::string(magic_enum::enum_name(processors::MessagePacking::NewlineDelimited))));
+    expected_content = "first\nsecond\nthird\n";
+  }
+  SECTION("Length prefixed") {
+    REQUIRE(listen_udp->setProperty(ListenUDP::MessagePackingProperty.name, std::string(magic_enum::enum_name(processors::MessagePacking::LengthPrefixed))));
+    expected_content = std::string("\0\0\0\5first\0\0\0\6second\0\0\0\5third", 28);
+  }
+
+  auto port = utils::scheduleProcessorOnRandomPort(controller.plan, listen_udp);
+  const auto endpoint = asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), port);
+
+  asio::io_context io_context;
+  asio::ip::udp::socket socket(io_context, asio::ip::udp::v4());
+  for (const auto message : {"first", "second", "third"}) {
+    socket.send_to(asio::buffer(std::string_view(message)), endpoint);
+  }
+  const auto other_sender_result = utils::sendUdpDatagram({"other"}, endpoint);
+  REQUIRE(other_sender_result.has_value());
+
+  const auto sender_port = socket.local_endpoint().port();
+  std::string packed_content;
+  size_t other_sender_flow_files = 0;
+  REQUIRE(utils::verifyEventHappenedInPollTime(300ms, [&] {
+    for (const auto& flow_file : controller.trigger().at(ListenUDP::Success)) {
+      if (flow_file->getAttribute("udp.sender.port") == std::to_string(sender_port)) {
+        check_for_attributes(*flow_file, port, sender_port);
+        packed_content += controller.plan->getContent(flow_file);
+      } else {
+        ++other_sender_flow_files;
+      }
+    }
+    return packed_content.size() >= expected_content.size() && other_sender_flow_files == 1;
+  }, 20ms));
+  CHECK(packed_content == expected_content);
+}
+
+TEST_CASE("ListenUDP receives on multiple sockets", "[ListenUDP][NetworkListenerProcessor]") {
+  SingleProcessorTestController controller{minifi::test::utils::make_processor<ListenUDP>("ListenUDP")};
+  const auto listen_udp = controller.getProcessor<ListenUDP>();
+  LogTestController::getInstance().setTrace<ListenUDP>();
+  REQUIRE(listen_udp->setProperty(ListenUDP::ReceiveSocketCount.name, "4"));
+
+  auto port = utils::scheduleProcessorOnRandomPort(controller.plan, listen_udp);
+  const auto endpoint = asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), port);
+
+  constexpr size_t message_count = 20;
+  for (size_t i = 0; i < message_count; ++i) {
+    CHECK(utils::sendUdpDatagram({"test_message"}, endpoint).has_value());
+  }
+
+  ProcessorTriggerResult result;
+  REQUIRE(controller.triggerUntil({{ListenUDP::Success, message_count}}, result, 300ms, 50ms));
+  CHECK(result.at(ListenUDP::Success).size() == message_count);
+}
+
 }  // namespace org::apache::nifi::minifi::test
@@ -246,6 +246,28 @@ TEST_CASE_METHOD(RouteTextController, "RouteText correctly handles Matching Stra
   verifyAllOutput(expected);
 }
 
+TEST_CASE_METHOD(RouteTextController, "RouteText evaluates regex patterns for each flow file") {
+  REQUIRE(proc_->setProperty(processors::RouteText::RoutingStrategy.name, "Dynamic Routing"));
+  REQUIRE(proc_->setProperty(processors::RouteText::MatchingStrategy.name, "Contains Regex"));
+  REQUIRE(proc_->setDynamicProperty("here", "${pattern}"));
+
+  createOutput({"here", ""});
+
+  putFlowFile({{"pattern", "a.c"}}, "abc");
+  putFlowFile({{"pattern", "x.z"}}, "xyz");
+  putFlowFile({{"pattern", "a.c"}}, "xyz");
+
+  run();
+
+  std::map<std::string, FlowFilePatternVec> expected{
+      {"here", {FlowFilePattern{}.attr("pattern", "a.c").content("abc"), FlowFilePattern{}.attr("pattern", "x.z").content("xyz")}},
+      {"matched", {}},
+      {"unmatched", {FlowFilePattern{}.attr("pattern", "a.c").content("xyz")}}
+  };
+
+  verifyAllOutput(expected);
+}
+
 TEST_CASE_METHOD(RouteTextController, "RouteText correctly handles Routing Strategies") {
   REQUIRE(proc_->setProperty(processors::RouteText::MatchingStrategy.name, "Contains"));
   REQUIRE(proc_->setDynamicProperty("one", "apple"));
@@ -194,6 +194,10 @@ TEST_CASE("SimpleTest", "[NiFi]") {
   CHECK(controller.plan->getContentAsBytes(*segments[0]) == expected_segment_1);
   CHECK(controller.plan->getContentAsBytes(*segments[1]) == expected_segment_2);
   CHECK(controller.plan->getContentAsBytes(*segments[2]) == expected_segment_3);
+  // the segments reference the content of the original instead of copying it
+  for (const auto& segment : segments) {
+    CHECK(segment->getResourceClaim() == original[0]->getResourceClaim());
+  }
 
   auto flowfile_filename = *original[0]->getAttribute(core::SpecialFlowAttribute::FILENAME);
 
@@ -1832,3 +1832,201 @@ TEST_CASE("Result mode tests") {
   const auto& file_contents = result.at(minifi::processors::TailFile::Success);
   CHECK(file_contents.size() == ff_count);
 }
+
+TEST_CASE("TailFile emits multiple lines per flow file", "[linesPerFlowFile]") {
+  LogTestController::getInstance().setTrace<minifi::processors::TailFile>();
+
+  minifi::test::SingleProcessorTestController test_controller(minifi::test::utils::make_processor<minifi::processors::TailFile>("TailFile"));
+  auto tail_file = test_controller.getProcessor();
+
+  auto temp_dir = test_controller.createTempDirectory();
+  createTempFile(temp_dir, TMP_FILE, "line1\nline2\nline3\nline4\nline5\npartial");
+
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::FileName.name, (temp_dir / TMP_FILE).string()));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::Delimiter.name, "\n"));
+
+  SECTION("Lines Per Flow File limits the number of lines") {
+    CHECK(tail_file->setProperty(minifi::processors::TailFile::LinesPerFlowFile.name, "2"));
+
+    const auto result = test_controller.trigger();
+    const auto& flow_files = result.at(minifi::processors::TailFile::Success);
+    REQUIRE(flow_files.size() == 3);
+    CHECK(test_controller.plan->getContent(flow_files[0]) == "line1\nline2\n");
+    CHECK(test_controller.plan->getContent(flow_files[1]) == "line3\nline4\n");
+    CHECK(test_controller.plan->getContent(flow_files[2]) == "line5\n");
+    CHECK(flow_files[2]->getAttribute(minifi::processors::textfragmentutils::OFFSET_ATTRIBUTE) == "24");
+  }
+
+  SECTION("Max Flow File Size finishes the flow file at the next delimiter") {
+    CHECK(tail_file->setProperty(minifi::processors::TailFile::LinesPerFlowFile.name, "100"));
+    CHECK(tail_file->setProperty(minifi::processors::TailFile::MaxFlowFileSize.name, "10 B"));
+
+    const auto result = test_controller.trigger();
+    const auto& flow_files = result.at(minifi::processors::TailFile::Success);
+    REQUIRE(flow_files.size() == 3);
+    CHECK(test_controller.plan->getContent(flow_files[0]) == "line1\nline2\n");
+    CHECK(test_controller.plan->getContent(flow_files[1]) == "line3\nline4\n");
+    CHECK(test_controller.plan->getContent(flow_files[2]) == "line5\n");
+  }
+
+  SECTION("Batch Size limits the number of lines") {
+    CHECK(tail_file->setProperty(minifi::processors::TailFile::LinesPerFlowFile.name, "2"));
+    CHECK(tail_file->setProperty(minifi::processors::TailFile::BatchSize.name, "3"));
+
+    const auto result = test_controller.trigger();
+    const auto& flow_files = result.at(minifi::processors::TailFile::Success);
+    REQUIRE(flow_files.size() == 2);
+    CHECK(test_controller.plan->getContent(flow_files[0]) == "line1\nline2\n");
+    CHECK(test_controller.plan->getContent(flow_files[1]) == "line3\n");
+  }
+
+  appendTempFile(temp_dir, TMP_FILE, "\n");
+  const auto result = test_controller.trigger();
+  const auto& flow_files = result.at(minifi::processors::TailFile::Success);
+  REQUIRE_FALSE(flow_files.empty());
+  CHECK(test_controller.plan->getContent(flow_files.back()).ends_with("partial\n"));
+}
+
+#ifndef WIN32
+TEST_CASE("TailFile recognizes the renamed file by its identity instead of its checksum", "[rotation]") {
+  LogTestController::getInstance().setTrace<minifi::processors::TailFile>();
+
+  minifi::test::SingleProcessorTestController test_controller(minifi::test::utils::make_processor<minifi::processors::TailFile>("TailFile"));
+  auto tail_file = test_controller.getProcessor();
+
+  auto temp_dir = test_controller.createTempDirectory();
+  const auto log_file = createTempFile(temp_dir, "test.log", "one\ntwo\n");
+
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::FileName.name, log_file.string()));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::Delimiter.name, "\n"));
+
+  REQUIRE(test_controller.trigger().at(minifi::processors::TailFile::Success).size() == 2);
+
+  // the prefix is overwritten in place, so the checksum no longer matches, but it is still the same file
+  const auto rotated_file = temp_dir / "test.log.1";
+  std::filesystem::rename(log_file, rotated_file);
+  {
+    std::fstream rotated_file_stream{rotated_file, std::ios::in | std::ios::out | std::ios::binary};
+    rotated_file_stream << "ONE\ntwo\nthree\n";
+  }
+  std::filesystem::last_write_time(rotated_file, std::chrono::file_clock::now() + 1s);
+  createTempFile(temp_dir, "test.log", "four\n", std::ios::out | std::ios::binary, 1s);
+
+  const auto result = test_controller.trigger();
+  const auto& flow_files = result.at(minifi::processors::TailFile::Success);
+  REQUIRE(flow_files.size() == 2);
+  CHECK(test_controller.plan->getContent(flow_files[0]) == "three\n");
+  CHECK(test_controller.plan->getContent(flow_files[1]) == "four\n");
+}
+#endif
+
+// file system notifications are only supported on Linux, other platforms fall back to polling
+#ifdef __linux__
+TEST_CASE("TailFile only reads the changed files when using file system notifications", "[changeDetection]") {
+  LogTestController::getInstance().setTrace<minifi::processors::TailFile>();
+
+  minifi::test::SingleProcessorTestController test_controller(minifi::test::utils::make_processor<minifi::processors::TailFile>("TailFile"));
+  auto tail_file = test_controller.getProcessor();
+
+  auto temp_dir = test_controller.createTempDirectory();
+  createTempFile(temp_dir, TMP_FILE, NEW_TAIL_DATA);
+
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::FileName.name, (temp_dir / TMP_FILE).string()));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::Delimiter.name, "\n"));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::ChangeDetection.name,
+      std::string(magic_enum::enum_name(minifi::processors::TailChangeDetection::FileSystemNotifications))));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::NotificationWaitTime.name, "100 ms"));
+
+  CHECK(test_controller.trigger().at(minifi::processors::TailFile::Success).size() == 1);
+  CHECK(test_controller.trigger().at(minifi::processors::TailFile::Success).empty());
+
+  appendTempFile(temp_dir, TMP_FILE, ADDITIONALY_CREATED_FILE_CONTENT);
+  const auto result = test_controller.trigger();
+  const auto& flow_files = result.at(minifi::processors::TailFile::Success);
+  REQUIRE(flow_files.size() == 1);
+  CHECK(test_controller.plan->getContent(flow_files[0]) == ADDITIONALY_CREATED_FILE_CONTENT);
+}
+
+TEST_CASE("TailFile reads new files found by the lookup without waiting for a notification", "[changeDetection]") {
+  minifi::test::SingleProcessorTestController test_controller(minifi::test::utils::make_processor<minifi::processors::TailFile>("TailFile"));
+  auto tail_file = test_controller.getProcessor();
+
+  auto temp_dir = test_controller.createTempDirectory();
+  createTempFile(temp_dir, "first.log", "first line\n");
+
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::TailMode.name, "Multiple file"));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::BaseDirectory.name, temp_dir.string()));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::FileName.name, ".*\\.log"));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::RecursiveLookup.name, "true"));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::LookupFrequency.name, "0 sec"));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::Delimiter.name, "\n"));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::ChangeDetection.name,
+      std::string(magic_enum::enum_name(minifi::processors::TailChangeDetection::FileSystemNotifications))));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::NotificationWaitTime.name, "100 ms"));
+
+  CHECK(test_controller.trigger().at(minifi::processors::TailFile::Success).size() == 1);
+
+  // the new subdirectory is not watched yet, so there is no notification about the new file in it
+  createTempFile(temp_dir / "subdirectory", "second.log", "second line\n");
+  const auto result = test_controller.trigger();
+  const auto& flow_files = result.at(minifi::processors::TailFile::Success);
+  REQUIRE(flow_files.size() == 1);
+  CHECK(test_controller.plan->getContent(flow_files[0]) == "second line\n");
+}
+
+TEST_CASE("TailFile waits for notifications again after a file with unread data is removed", "[changeDetection]") {
+  minifi::test::SingleProcessorTestController test_controller(minifi::test::utils::make_processor<minifi::processors::TailFile>("TailFile"));
+  auto tail_file = test_controller.getProcessor();
+
+  auto temp_dir = test_controller.createTempDirectory();
+  const auto log_file = createTempFile(temp_dir, "first.log", "one\ntwo\nthree\n");
+
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::TailMode.name, "Multiple file"));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::BaseDirectory.name, temp_dir.string()));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::FileName.name, ".*\\.log"));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::LookupFrequency.name, "0 sec"));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::Delimiter.name, "\n"));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::BatchSize.name, "1"));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::ChangeDetection.name,
+      std::string(magic_enum::enum_name(minifi::processors::TailChangeDetection::FileSystemNotifications))));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::NotificationWaitTime.name, "300 ms"));
+
+  // only the first line is read, the rest of the file is left for the next trigger
+  CHECK(test_controller.trigger().at(minifi::processors::TailFile::Success).size() == 1);
+
+  std::filesystem::remove(log_file);
+  CHECK(test_controller.trigger().at(minifi::processors::TailFile::Success).empty());
+
+  // the removed file no longer has unread data, so the trigger waits for notifications instead of returning immediately
+  const auto start = std::chrono::steady_clock::now();
+  CHECK(test_controller.trigger().at(minifi::processors::TailFile::Success).empty());
+  CHECK(std::chrono::steady_clock::now() - start >= 200ms);
+}
+
+TEST_CASE("TailFile tails the file again after its directory is deleted and recreated", "[changeDetection]") {
+  minifi::test::SingleProcessorTestController test_controller(minifi::test::utils::make_processor<minifi::processors::TailFile>("TailFile"));
+  auto tail_file = test_controller.getProcessor();
+
+  const auto log_dir = test_controller.createTempDirectory() / "logs";
+  createTempFile(log_dir, "test.log", "one\ntwo\nthree\n");
+
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::FileName.name, (log_dir / "test.log").string()));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::Delimiter.name, "\n"));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::ChangeDetection.name,
+      std::string(magic_enum::enum_name(minifi::processors::TailChangeDetection::FileSystemNotifications))));
+  CHECK(tail_file->setProperty(minifi::processors::TailFile::NotificationWaitTime.name, "100 ms"));
+
+  CHECK(test_controller.trigger().at(minifi::processors::TailFile::Success).size() == 3);
+
+  // deleting the directory removes its watch
+  std::filesystem::remove_all(log_dir);
+  CHECK(test_controller.trigger().at(minifi::processors::TailFile::Success).empty());
+  CHECK(test_controller.trigger().at(minifi::processors::TailFile::Success).empty());
+
+  createTempFile(log_dir, "test.log", "new\n");
+  const auto result = test_controller.trigger();
+  const auto& flow_files = result.at(minifi::processors::TailFile::Success);
+  REQUIRE(flow_files.size() == 1);
+  CHECK(test_controller.plan->getContent(flow_files[0]) == "new\n");
+}
+#endif
@@ -0,0 +1,161 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FileChangeNotifier.h"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "minifi-cpp/utils/gsl.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+#ifdef __linux__
+
+namespace {
+constexpr uint32_t WATCHED_EVENTS = IN_CREATE | IN_MODIFY | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE;
+}  // namespace
+
+FileChangeNotifier::FileChangeNotifier(std::shared_ptr<core::logging::Logger> logger)
+    : logger_(std::move(logger)),
+      fd_(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) {
+  if (fd_ < 0) {
+    logger_->log_error("Failed to initialize inotify: {}", std::strerror(errno));
+  }
+}
+
+FileChangeNotifier::~FileChangeNotifier() {
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+bool FileChangeNotifier::isSupported() const {
+  return fd_ >= 0;
+}
+
+bool FileChangeNotifier::watchDirectory(const std::filesystem::path& directory) {
+  if (fd_ < 0) {
+    return false;
+  }
+  const int watch_descriptor = inotify_add_watch(fd_, directory.c_str(), WATCHED_EVENTS);
+  if (watch_descriptor < 0) {
+    if (errno == ENOENT) {
+      logger_->log_debug("Cannot watch directory {} as it does not exist", directory);
+    } else {
+      logger_->log_warn("Failed to watch directory {}: {}", directory, std::strerror(errno));
+    }
+    return false;
+  }
+  if (watched_directories_.emplace(watch_descriptor, directory).second) {
+    watched_paths_.insert(directory);
+    logger_->log_debug("Watching directory {} for changes", directory);
+  }
+  return true;
+}
+
+bool FileChangeNotifier::isWatched(const std::filesystem::path& directory) const {
+  return watched_paths_.contains(directory);
+}
+
+FileChanges FileChangeNotifier::waitForChanges(std::chrono::milliseconds timeout) {
+  FileChanges changes;
+  if (fd_ < 0) {
+    return changes;
+  }
+  pollfd poll_fd{.fd = fd_, .events = POLLIN, .revents = 0};
+  const int result = poll(&poll_fd, 1, gsl::narrow<int>(timeout.count()));
+  if (result < 0 && errno != EINTR) {
+    logger_->log_error("Failed to wait for file changes: {}", std::strerror(errno));
+  } else if (result > 0) {
+    readEvents(changes);
+  }
+  return changes;
+}
+
+void FileChangeNotifier::readEvents(FileChanges& changes) {
+  alignas(inotify_event) std::array<char, 16 * 1024> buffer{};
+  while (true) {
+    const ssize_t length = read(fd_, buffer.data(), buffer.size());
+    if (length <= 0) {
+      if (length < 0 && errno != EAGAIN && errno != EINTR) {
+        logger_->log_error("Failed to read file change notifications: {}", std::strerror(errno));
+      }
+      return;
+    }
+    for (ssize_t offset = 0; offset < length;) {
+      const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+      offset += gsl::narrow<ssize_t>(sizeof(inotify_event) + event->len);
+      if (event->mask & IN_Q_OVERFLOW) {
+        logger_->log_warn("File change notification queue overflowed");
+        changes.overflow = true;
+        continue;
+      }
+      if (event->mask & IN_IGNORED) {
+        if (const auto directory = watched_directories_.find(event->wd); directory != watched_directories_.end()) {
+          logger_->log_debug("Directory {} is no longer watched", directory->second);
+          watched_paths_.erase(directory->second);
+          watched_directories_.erase(directory);
+        }
+        continue;
+      }
+      const auto directory = watched_directories_.find(event->wd);
+      if (directory != watched_directories_.end() && event->len > 0) {
+        changes.changed_files.insert(directory->second / event->name);
+      }
+    }
+  }
+}
+
+#else
+
+FileChangeNotifier::FileChangeNotifier(std::shared_ptr<core::logging::Logger> logger)
+    : logger_(std::move(logger)) {
+}
+
+FileChangeNotifier::~FileChangeNotifier() = default;
+
+bool FileChangeNotifier::isSupported() const {
+  return false;
+}
+
+bool FileChangeNotifier::watchDirectory(const std::filesystem::path&) {
+  return false;
+}
+
+bool FileChangeNotifier::isWatched(const std::filesystem::path&) const {
+  return false;
+}
+
+FileChanges FileChangeNotifier::waitForChanges(std::chrono::milliseconds) {
+  return {};
+}
+
+void FileChangeNotifier::readEvents(FileChanges&) {
+}
+
+#endif
+
+}  // namespace org::apache::nifi::minifi::utils
@@ -0,0 +1,74 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <set>
+#include <unordered_map>
+
+#include "minifi-cpp/core/logging/Logger.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+struct FileChanges {
+  std::set<std::filesystem::path> changed_files;
+  // notifications were lost, so any watched file may have changed
+  bool overflow = false;
+
+  [[nodiscard]] bool contains(const std::filesystem::path& file) const {
+    return overflow || changed_files.contains(file);
+  }
+
+  [[nodiscard]] bool empty() const {
+    return !overflow && changed_files.empty();
+  }
+};
+
+// Waits for files to be created, modified, moved or deleted in a set of watched directories.
+// Uses inotify on Linux, isSupported() returns false on other platforms.
+class FileChangeNotifier {
+ public:
+  explicit FileChangeNotifier(std::shared_ptr<core::logging::Logger> logger);
+  ~FileChangeNotifier();
+
+  FileChangeNotifier(const FileChangeNotifier&) = delete;
+  FileChangeNotifier& operator=(const FileChangeNotifier&) = delete;
+  FileChangeNotifier(FileChangeNotifier&&) = delete;
+  FileChangeNotifier& operator=(FileChangeNotifier&&) = delete;
+
+  [[nodiscard]] bool isSupported() const;
+
+  bool watchDirectory(const std::filesystem::path& directory);
+
+  // A directory stops being watched when it is deleted or moved away
+  [[nodiscard]] bool isWatched(const std::filesystem::path& directory) const;
+
+  // Returns the full paths of the changed files, or an empty result if nothing has changed until the timeout
+  FileChanges waitForChanges(std::chrono::milliseconds timeout);
+
+ private:
+  void readEvents(FileChanges& changes);
+
+  std::shared_ptr<core::logging::Logger> logger_;
+  int fd_ = -1;
+  std::unordered_map<int, std::filesystem::path> watched_directories_;
+  std::set<std::filesystem::path> watched_paths_;
+};
+
+}  // namespace org::apache::nifi::minifi::utils
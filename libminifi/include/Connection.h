@@ -25,6 +25,7 @@
 #include <vector>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <atomic>
 #include <algorithm>
 #include <utility>
@@ -35,6 +36,8 @@
 #include "minifi-cpp/core/FlowFile.h"
 #include "minifi-cpp/core/Repository.h"
 #include "utils/FlowFileQueue.h"
+#include "utils/LatencyHistogram.h"
+#include "utils/ShardedQueue.h"
 #include "minifi-cpp/Connection.h"
 #include "core/logging/LoggerFactory.h"
 
@@ -146,8 +149,7 @@ class ConnectionImpl : public core::ConnectableImpl, public virtual Connection {
   bool backpressureThresholdReached() const override;
 
   uint64_t getQueueSize() const override {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return queue_.size();
+    return ready_queue_.size() + queue_size_;
   }
 
   uint64_t getQueueDataSize() override {
@@ -160,11 +162,23 @@ class ConnectionImpl : public core::ConnectableImpl, public virtual Connection {
 
   std::shared_ptr<core::FlowFile> poll(std::set<std::shared_ptr<core::FlowFile>> &expiredFlowRecords) override;
 
+  std::optional<std::chrono::steady_clock::time_point> getNextPenaltyExpiration() override;
+
   void drain(bool delete_permanently) override;
 
+  std::chrono::nanoseconds getQueueWaitTimePercentile(double ratio) const override {
+    return queue_wait_time_histogram_.percentile(ratio);
+  }
+
   void yield() override {}
 
   bool isWorkAvailable() override {
+    if (!ready_queue_.empty()) {
+      return true;
+    }
+    if (queue_size_ == 0) {
+      return false;
+    }
     const std::lock_guard<std::mutex> lock{mutex_};
     return queue_.isWorkAvailable();
   }
@@ -186,10 +200,30 @@ class ConnectionImpl : public core::ConnectableImpl, public virtual Connection {
   std::shared_ptr<core::ContentRepository> content_repo_;
 
  private:
+  // Flow files which can be processed immediately go to ready_queue_, which does not need the connection-wide lock.
+  // Penalized flow files, and every flow file of connections which can swap out flow files, go to queue_.
+  bool canBeQueuedAsReady(const core::FlowFile& flow_file) const;
+  std::shared_ptr<core::FlowFile> pollQueue(std::set<std::shared_ptr<core::FlowFile>>& expired_flow_files);
+  std::shared_ptr<core::FlowFile> pollReadyQueue(std::set<std::shared_ptr<core::FlowFile>>& expired_flow_files);
+  bool checkExpired(const std::shared_ptr<core::FlowFile>& flow_file, std::set<std::shared_ptr<core::FlowFile>>& expired_flow_files);
+  void recordQueueWaitTime(const core::FlowFile& flow_file);
+  // the source processor may be waiting for the backpressure to be released
+  void notifyBackpressureReleased(bool was_backpressure_reached);
+  void updateQueueSize() { queue_size_ = queue_.size(); }
+  void deleteFromRepository(core::FlowFile& flow_file);
+
   bool drop_empty_ = false;
   mutable std::mutex mutex_;
   std::atomic<uint64_t> queued_data_size_ = 0;
   utils::FlowFileQueue queue_;
+  // the part of queued_data_size_ which belongs to the flow files of queue_, guarded by mutex_
+  uint64_t queue_data_size_ = 0;
+  // the size of queue_, so that it can be queried without locking mutex_
+  std::atomic<size_t> queue_size_ = 0;
+  bool ready_queue_enabled_ = true;
+  utils::ShardedQueue<std::shared_ptr<core::FlowFile>> ready_queue_;
+  // time between putting a flow file into the connection and polling it
+  utils::LatencyHistogram queue_wait_time_histogram_;
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<Connection>::getLogger();
 };
 }  // namespace org::apache::nifi::minifi
@@ -24,6 +24,7 @@
 #include <chrono>
 
 constexpr auto DEFAULT_TIME_SLICE = std::chrono::milliseconds(500);
+constexpr auto DEFAULT_EVENT_DRIVEN_IDLE_PERIOD = std::chrono::milliseconds(1000);
 
 #include "minifi-cpp/core/logging/Logger.h"
 #include "core/Processor.h"
@@ -48,15 +49,26 @@ class EventDrivenSchedulingAgent : public ThreadedSchedulingAgent {
     if (time_slice_ < 10ms || 1000ms < time_slice_) {
       throw Exception(FLOW_EXCEPTION, std::string(Configure::nifi_flow_engine_event_driven_time_slice) + " is out of reasonable range!");
     }
+
+    idle_period_ = configuration->get(Configure::nifi_flow_engine_event_driven_idle_period)
+        | utils::andThen(utils::timeutils::StringToDuration<std::chrono::milliseconds>)
+        | utils::valueOrElse([] { return DEFAULT_EVENT_DRIVEN_IDLE_PERIOD; });
+
+    if (idle_period_ < 10ms) {
+      throw Exception(FLOW_EXCEPTION, std::string(Configure::nifi_flow_engine_event_driven_idle_period) + " is out of reasonable range!");
+    }
   }
 
   void schedule(core::Processor* processor) override;
+  void unschedule(core::Processor* processor) override;
 
   utils::TaskRescheduleInfo run(core::Processor* processor, const std::shared_ptr<core::ProcessContext> &process_context,
       const std::shared_ptr<core::ProcessSessionFactory> &session_factory) override;
 
  private:
   std::chrono::milliseconds time_slice_{};
+  // upper bound of the time an idle processor waits for an incoming flow file notification
+  std::chrono::milliseconds idle_period_{};
 };
 
 }  // namespace org::apache::nifi::minifi
@@ -25,6 +25,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <cstdio>
 #include <queue>
 #include <set>
@@ -38,6 +39,7 @@
 #include "minifi-cpp/core/logging/Logger.h"
 #include "minifi-cpp/core/ProcessContext.h"
 #include "core/ProcessGroup.h"
+#include "core/ProcessGroupDiff.h"
 #include "core/Processor.h"
 #include "core/ProcessSession.h"
 #include "minifi-cpp/core/Property.h"
@@ -165,6 +167,11 @@ class FlowController : public core::controller::ForwardingControllerServiceProvi
   std::unique_ptr<core::ProcessGroup> loadInitialFlow();
 
   void loadFlowRepo();
+  void setFlowFileContainers();
+  // returns the changes to apply in place, or std::nullopt if the whole flow has to be restarted
+  std::optional<core::ProcessGroupDiff> compareWithRunningFlow(const core::ProcessGroup& new_root) const;
+  // stops the whole flow and starts new_root instead, restarting the previous flow if it fails to start
+  bool reloadFlow(std::unique_ptr<core::ProcessGroup> new_root);
   std::vector<state::StateController*> getAllComponents();
   state::StateController* getComponent(const std::string& id_or_name);
   gsl::not_null<std::unique_ptr<state::ProcessorController>> createController(core::Processor& processor);
@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "core/ProcessGroup.h"
+#include "core/ProcessGroupDiff.h"
 #include "utils/Id.h"
 #include "core/state/ProcessorController.h"
 #include "core/state/MetricsPublisherStore.h"
@@ -54,6 +55,11 @@ class RootProcessGroupWrapper {
   std::string getVersion() const;
   const core::ProcessGroup* getRoot() const { return root_.get(); }
   void setNewRoot(std::unique_ptr<core::ProcessGroup> new_root);
+  // updates the running flow in place, only the processors affected by the diff are stopped and restarted
+  void applyDiff(std::unique_ptr<core::ProcessGroup> updated_root, const core::ProcessGroupDiff& diff,
+                 TimerDrivenSchedulingAgent& timer_scheduler,
+                 EventDrivenSchedulingAgent& event_scheduler,
+                 CronDrivenSchedulingAgent& cron_scheduler);
   void restoreBackup();
   void clearBackup();
   void stopProcessing(TimerDrivenSchedulingAgent& timer_scheduler,
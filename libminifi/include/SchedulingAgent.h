@@ -115,6 +115,8 @@ class SchedulingAgent {
   std::chrono::milliseconds getAdminYieldDuration() const { return admin_yield_duration_; }
 
  protected:
+  static bool hasWorkToDo(core::Processor* processor);
+
   std::mutex mutex_;
   std::atomic<bool> running_;
   std::chrono::milliseconds admin_yield_duration_;
@@ -136,6 +136,11 @@ class FlowConfiguration : public CoreComponentImpl {
     return service_provider_;
   }
 
+  // Puts back the provider of the running controller services after the flow parsed by updateFromPayload was applied to the running flow in place
+  void restoreControllerServiceProvider(std::shared_ptr<core::controller::StandardControllerServiceProvider> service_provider) {
+    service_provider_ = std::move(service_provider);
+  }
+
   utils::ChecksumCalculator& getChecksumCalculator() { return checksum_calculator_; }
 
   const std::unordered_map<std::string, gsl::not_null<std::unique_ptr<ParameterContext>>>& getParameterContexts() const {
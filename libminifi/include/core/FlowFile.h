@@ -21,8 +21,10 @@
 #include <memory>
 #include <optional>
 #include <set>
+#include <span>
 #include <unordered_set>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -156,26 +158,49 @@ class FlowFileImpl : public CoreComponentImpl, public ReferenceContainerImpl, pu
   /**
    * setAttribute, if attribute already there, update it, else, add it
    */
-  void setAttribute(std::string_view key, std::string value) override {
-    attributes_.insert_or_assign(std::string{key}, std::move(value));
-  }
+  void setAttribute(std::string_view key, std::string value) override;
 
   /**
    * Returns the map of attributes
    * @return attributes.
    */
   [[nodiscard]] std::map<std::string, std::string> getAttributes() const override {
-    return {attributes_.begin(), attributes_.end()};
+    return {attributes_->begin(), attributes_->end()};
   }
 
   /**
-   * Returns the map of attributes
+   * Returns the map of attributes for modification, which stops sharing it with other flow files
    * @return attributes.
    */
   AttributeMap *getAttributesPtr() override {
-    return &attributes_;
+    return &mutableAttributes();
   }
 
+  /**
+   * Returns the map of attributes
+   * @return attributes.
+   */
+  [[nodiscard]] const AttributeMap *getAttributesPtr() const override {
+    return attributes_.get();
+  }
+
+  /**
+   * Returns the attribute map shared with the caller, the next modification of this flow file makes a private copy of it
+   * @return attributes.
+   */
+  [[nodiscard]] std::shared_ptr<const AttributeMap> getAttributesSnapshot() const override {
+    return attributes_;
+  }
+
+  /**
+   * Takes over the attributes of the parent, except for the excluded ones. Attributes of this flow file
+   * which the parent does not have are kept. The attribute map is shared with the parent until either
+   * of them modifies it, so creating many children of the same parent does not copy its attributes.
+   * @param parent flow file to copy the attributes of
+   * @param excluded_keys attributes which are not copied
+   */
+  void inheritAttributes(const FlowFile& parent, std::span<const std::string_view> excluded_keys);
+
   /**
    * adds an attribute if it does not exist
    *
@@ -216,6 +241,14 @@ class FlowFileImpl : public CoreComponentImpl, public ReferenceContainerImpl, pu
     to_be_processed_after_ = to_be_processed_after;
   }
 
+  [[nodiscard]] std::chrono::steady_clock::time_point getLastQueueTime() const override {
+    return last_queue_time_;
+  }
+
+  void setLastQueueTime(std::chrono::steady_clock::time_point queue_time) override {
+    last_queue_time_ = queue_time;
+  }
+
   /**
    * Gets the offset within the flow file
    * @return size as a uint64_t
@@ -259,8 +292,8 @@ class FlowFileImpl : public CoreComponentImpl, public ReferenceContainerImpl, pu
   std::chrono::system_clock::time_point event_time_{};
   // Date at which the origin of this flow file entered the flow
   std::chrono::system_clock::time_point lineage_start_date_{};
-  // Date at which the flow file was queued
-  uint64_t last_queue_date_;
+  // Time at which the flow file was last put into a connection
+  std::chrono::steady_clock::time_point last_queue_time_{};
   // Size in bytes of the data corresponding to this flow file
   uint64_t size_;
   // A global unique identifier
@@ -270,8 +303,13 @@ class FlowFileImpl : public CoreComponentImpl, public ReferenceContainerImpl, pu
   uint64_t offset_;
   // Penalty expiration
   std::chrono::steady_clock::time_point to_be_processed_after_;
-  // Attributes key/values pairs for the flow record
-  AttributeMap attributes_;
+  // Returns the attribute map after making a private copy of it if it is shared with other flow files
+  AttributeMap& mutableAttributes();
+
+  // Attributes key/values pairs for the flow record, shared between copies of the flow file until modified.
+  // The flow files sharing the map can be modified on different threads, but, like the rest of the flow file,
+  // a single flow file must not be modified while another thread accesses it, e.g. to inherit its attributes.
+  std::shared_ptr<AttributeMap> attributes_;
   // Pointer to the associated content resource claim
   std::shared_ptr<ResourceClaim> claim_;
   // Pointers to stashed content resource claims
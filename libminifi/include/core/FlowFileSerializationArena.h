@@ -0,0 +1,63 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "io/BufferStream.h"
+#include "minifi-cpp/FlowFileRecord.h"
+#include "minifi-cpp/utils/SmallString.h"
+
+namespace org::apache::nifi::minifi::core {
+
+/**
+ * Serializes the flow file records of a session commit into a single buffer, which is reused between commits,
+ * so persisting the records does not need any allocation per flow file once the buffers have grown to the
+ * usual commit size. The entries can be passed to Repository::MultiPut as they are.
+ */
+class FlowFileSerializationArena {
+ public:
+  // Buffers grown larger than this by an unusually large commit are released instead of being retained
+  static constexpr size_t MAX_RETAINED_BUFFER_SIZE = 4 * 1024 * 1024;
+
+  void add(FlowFileRecord& flow_file);
+
+  // The returned entries are valid until the next call to add() or clear()
+  std::span<const std::pair<std::string_view, std::span<const std::byte>>> entries();
+
+  void clear();
+
+  [[nodiscard]] size_t size() const {
+    return keys_.size();
+  }
+
+  [[nodiscard]] bool empty() const {
+    return keys_.empty();
+  }
+
+ private:
+  io::BufferStream buffer_;
+  std::vector<utils::SmallString<36>> keys_;
+  std::vector<size_t> value_ends_;
+  std::vector<std::pair<std::string_view, std::span<const std::byte>>> entries_;
+};
+
+}  // namespace org::apache::nifi::minifi::core
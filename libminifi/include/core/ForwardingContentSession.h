@@ -20,6 +20,7 @@
 
 #include <unordered_set>
 #include <memory>
+#include <optional>
 #include "minifi-cpp/ResourceClaim.h"
 #include "minifi-cpp/io/BaseStream.h"
 #include "minifi-cpp/core/ContentRepository.h"
@@ -32,15 +33,23 @@ class ContentRepository;
 /**
  * Warning: this implementation simply forwards all calls to the underlying
  * repository without any atomicity guarantees or possibility of rollback.
+ *
+ * If max_container_size is not zero, new content is packed into container claims: the content is appended to the
+ * current container of the session, until it reaches max_container_size or the session is committed or rolled back.
+ * The container is removed by the repository when no flow file references any of its content.
  */
 class ForwardingContentSession : public ContentSessionImpl {
  public:
-  explicit ForwardingContentSession(std::shared_ptr<ContentRepository> repository);
+  explicit ForwardingContentSession(std::shared_ptr<ContentRepository> repository, size_t max_container_size = 0);
 
   std::shared_ptr<ResourceClaim> create() override;
 
   std::shared_ptr<io::BaseStream> write(const std::shared_ptr<ResourceClaim>& resource_id) override;
 
+  NewContent writeNewContent() override;
+
+  std::shared_ptr<io::BaseStream> append(const std::shared_ptr<ResourceClaim>& resource_id, size_t offset, const std::function<void(const std::shared_ptr<ResourceClaim>&)>& on_copy) override;
+
   std::shared_ptr<io::BaseStream> read(const std::shared_ptr<ResourceClaim>& resource_id) override;
 
   void commit() override;
@@ -51,6 +60,19 @@ class ForwardingContentSession : public ContentSessionImpl {
   std::shared_ptr<io::BaseStream> append(const std::shared_ptr<ResourceClaim>& resource_id) override;
 
   std::unordered_set<std::shared_ptr<ResourceClaim>> created_claims_;
+
+ private:
+  struct Container {
+    std::shared_ptr<ResourceClaim> claim;
+    std::shared_ptr<io::BaseStream> stream;
+    // the slice of the content written last, no new content can be appended while it is in use
+    std::weak_ptr<io::BaseStream> last_slice;
+  };
+
+  void closeContainer();
+
+  size_t max_container_size_;
+  std::optional<Container> container_;
 };
 
 }  // namespace org::apache::nifi::minifi::core
@@ -130,16 +130,21 @@ class ProcessGroup : public CoreComponentImpl {
     return config_version_;
   }
 
+  void setVersion(int version) {
+    config_version_ = version;
+  }
+
   void startProcessing(TimerDrivenSchedulingAgent& timeScheduler,
                        EventDrivenSchedulingAgent& eventScheduler,
-                       CronDrivenSchedulingAgent& cronScheduler);
+                       CronDrivenSchedulingAgent& cronScheduler,
+                       const std::function<bool(const Processor*)>& filter = nullptr);
 
   void stopProcessing(TimerDrivenSchedulingAgent& timeScheduler,
                       EventDrivenSchedulingAgent& eventScheduler,
                       CronDrivenSchedulingAgent& cronScheduler,
                       const std::function<bool(const Processor*)>& filter = nullptr);
 
-  bool isRemoteProcessGroup();
+  bool isRemoteProcessGroup() const;
   void setParent(ProcessGroup *parent) {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
     parent_process_group_ = parent;
@@ -152,6 +157,9 @@ class ProcessGroup : public CoreComponentImpl {
   void addPort(std::unique_ptr<Port> port);
   void addProcessGroup(std::unique_ptr<ProcessGroup> child);
   void addConnection(std::unique_ptr<Connection> connection);
+  // the removed components are not detached from each other, the callers have to rewire the remaining ones
+  std::unique_ptr<Processor> removeProcessor(const Processor* processor);
+  std::unique_ptr<Connection> removeConnection(const Connection* connection);
   const std::set<Port*>& getPorts() const {
     return ports_;
   }
@@ -181,6 +189,10 @@ class ProcessGroup : public CoreComponentImpl {
 
   void getAllProcessors(std::vector<Processor*>& processor_vec) const;
 
+  // the processors and connections of this group, excluding the child groups
+  std::vector<Processor*> getProcessors() const;
+  std::vector<Connection*> getConnections() const;
+
   void addControllerService(const std::string &nodeId, const std::shared_ptr<core::controller::ControllerServiceNode> &node);
 
   core::controller::ControllerServiceNode* findControllerService(const std::string &nodeId, Traverse traverse = Traverse::ExcludeChildren) const;
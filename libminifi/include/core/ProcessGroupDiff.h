@@ -0,0 +1,54 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <optional>
+#include <unordered_set>
+
+#include "core/ProcessGroup.h"
+#include "utils/Id.h"
+
+namespace org::apache::nifi::minifi::core {
+
+// The differences between the running flow and a new version of it, the components are matched by their ids.
+struct ProcessGroupDiff {
+  // processors whose configuration differs, or whose connections are added, removed or changed
+  std::unordered_set<utils::Identifier> changed_processors;
+  std::unordered_set<utils::Identifier> added_processors;
+  std::unordered_set<utils::Identifier> removed_processors;
+  // connections with the same endpoints whose settings, e.g. the back pressure thresholds, differ
+  std::unordered_set<utils::Identifier> changed_connections;
+  std::unordered_set<utils::Identifier> added_connections;
+  std::unordered_set<utils::Identifier> removed_connections;
+
+  // Returns std::nullopt if the updated flow cannot be applied to the running one in place: when the process groups,
+  // the controller services, remote process groups, the type of a processor or the endpoints of a connection differ.
+  static std::optional<ProcessGroupDiff> compare(const ProcessGroup& current, const ProcessGroup& updated);
+
+  [[nodiscard]] bool empty() const;
+
+  // the processors of the running flow that have to be stopped before applying the diff
+  [[nodiscard]] bool needsStopping(const Processor& processor) const;
+  // the processors that have to be started after applying the diff
+  [[nodiscard]] bool needsStarting(const Processor& processor) const;
+
+  // Moves the added components from the updated flow into the current one, reconfigures the changed ones and drops the removed ones.
+  // The processors for which needsStopping() is true must have been unscheduled. The retained connections keep their queued flow files.
+  void apply(ProcessGroup& current, ProcessGroup& updated) const;
+};
+
+}  // namespace org::apache::nifi::minifi::core
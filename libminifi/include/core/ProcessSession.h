@@ -87,6 +87,8 @@ class ProcessSessionImpl : public ReferenceContainerImpl, public virtual Process
 
   detail::ReadBufferResult readBuffer(const std::shared_ptr<core::FlowFile>& flow) override;
 
+  int64_t readInPlace(const core::FlowFile& flow_file, const io::InputBufferCallback& callback) override;
+
   void write(const std::shared_ptr<core::FlowFile> &flow, const io::OutputStreamCallback& callback) override;
 
   void write(core::FlowFile& flow, const io::OutputStreamCallback& callback) override;
@@ -181,9 +183,10 @@ class ProcessSessionImpl : public ReferenceContainerImpl, public virtual Process
       const std::map<Connectable*, std::vector<std::shared_ptr<core::FlowFile>>>& transactionMap);
 
   std::shared_ptr<core::FlowFile> cloneDuringTransfer(const core::FlowFile& parent);
+  void reportContentModified(const core::FlowFile& flow_file, std::chrono::steady_clock::time_point start_time);
   std::shared_ptr<ProcessContext> process_context_;
   std::shared_ptr<logging::Logger> logger_;
-  std::shared_ptr<provenance::ProvenanceReporter> provenance_report_;
+  std::shared_ptr<provenance::ProvenanceReporterImpl> provenance_report_;
   std::shared_ptr<ContentSession> content_session_;
   StateManager* stateManager_;
 
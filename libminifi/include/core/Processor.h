@@ -23,6 +23,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_set>
@@ -97,6 +98,7 @@ class Processor : public ConnectableImpl, public ConfigurableComponentImpl, publ
   std::chrono::steady_clock::time_point getYieldExpirationTime() const;
   std::chrono::steady_clock::duration getYieldTime() const;
   bool addConnection(Connectable* connection);
+  bool removeConnection(Connectable* connection);
   bool canEdit() override;
   void initialize() override;
   void triggerAndCommit(const std::shared_ptr<ProcessContext>& context, const std::shared_ptr<ProcessSessionFactory>& session_factory);
@@ -105,6 +107,10 @@ class Processor : public ConnectableImpl, public ConfigurableComponentImpl, publ
   void onSchedule(ProcessContext& context, ProcessSessionFactory& session_factory);
   void onUnSchedule();
   bool isWorkAvailable() override;
+  // the time when the earliest penalized flow file of the incoming connections can be processed, if there is any
+  std::optional<std::chrono::steady_clock::time_point> getNextPenaltyExpiration();
+  void notifyWork() override;
+  void setWorkNotifier(std::function<void()> work_notifier);
   bool isThrottledByBackpressure() const;
   Connectable* pickIncomingConnection() override;
   void validateAnnotations() const;
@@ -122,6 +128,8 @@ class Processor : public ConnectableImpl, public ConfigurableComponentImpl, publ
   void setLogBulletinLevel(logging::LOG_LEVEL level);
   void setLoggerCallback(const std::function<void(logging::LOG_LEVEL level, const std::string& message)>& callback);
   void restore(const std::shared_ptr<FlowFile>& file) override;
+  // ratio of the flow files whose provenance events are recorded, resolved from the configuration when the processor is scheduled
+  double getProvenanceSamplingRatio() const;
 
   static constexpr auto DynamicProperties = std::array<DynamicPropertyDefinition, 0>{};
 
@@ -157,6 +165,10 @@ class Processor : public ConnectableImpl, public ConfigurableComponentImpl, publ
   mutable std::mutex mutex_;
   std::atomic<std::chrono::steady_clock::time_point> yield_expiration_{};
 
+  // called when an incoming connection receives new flow files, set by the event driven scheduling agent
+  std::mutex work_notifier_mutex_;
+  std::function<void()> work_notifier_;
+
   // must hold the graphMutex
   void updateReachability(const std::lock_guard<std::mutex>& graph_lock, bool force = false);
 
@@ -164,6 +176,8 @@ class Processor : public ConnectableImpl, public ConfigurableComponentImpl, publ
 
   static bool partOfCycle(Connection* conn);
 
+  double resolveProvenanceSamplingRatio(ProcessContext& context) const;
+
   // an outgoing connection allows us to reach these nodes
   std::unordered_map<Connection*, std::unordered_set<Processor*>> reachable_processors_;
 
@@ -172,6 +186,7 @@ class Processor : public ConnectableImpl, public ConfigurableComponentImpl, publ
   std::string process_group_path_;
 
   gsl::not_null<std::shared_ptr<ProcessorMetrics>> metrics_;
+  std::atomic<double> provenance_sampling_ratio_{1.0};
 
  protected:
   std::unique_ptr<ProcessorApi> impl_;
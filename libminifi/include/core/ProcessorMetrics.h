@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "core/state/Value.h"
+#include "utils/LatencyHistogram.h"
 #include "state/nodes/MetricsBase.h"
 
 namespace org::apache::nifi::minifi::core {
@@ -47,11 +48,13 @@ class ProcessorMetrics : public state::response::ResponseNodeImpl {
   void increaseRelationshipTransferCount(const std::string& relationship, size_t count = 1);
   std::chrono::milliseconds getAverageOnTriggerRuntime() const;
   std::chrono::milliseconds getLastOnTriggerRuntime() const;
-  void addLastOnTriggerRuntime(std::chrono::milliseconds runtime);
+  void addLastOnTriggerRuntime(std::chrono::nanoseconds runtime);
+  const utils::LatencyHistogram& getOnTriggerRuntimeHistogram() const { return on_trigger_runtime_histogram_; }
 
   std::chrono::milliseconds getAverageSessionCommitRuntime() const;
   std::chrono::milliseconds getLastSessionCommitRuntime() const;
-  void addLastSessionCommitRuntime(std::chrono::milliseconds runtime);
+  void addLastSessionCommitRuntime(std::chrono::nanoseconds runtime);
+  const utils::LatencyHistogram& getSessionCommitRuntimeHistogram() const { return session_commit_runtime_histogram_; }
   std::optional<size_t> getTransferredFlowFilesToRelationshipCount(const std::string& relationship) const;
 
   std::atomic<size_t>& invocations() {return invocations_;}
@@ -99,6 +102,9 @@ class ProcessorMetrics : public state::response::ResponseNodeImpl {
   const Processor& source_processor_;
   Averager<std::chrono::milliseconds> on_trigger_runtime_averager_;
   Averager<std::chrono::milliseconds> session_commit_runtime_averager_;
+  // every runtime since the start of the processor, for the tail latencies hidden by the averages
+  utils::LatencyHistogram on_trigger_runtime_histogram_;
+  utils::LatencyHistogram session_commit_runtime_histogram_;
 
  private:
   std::atomic<size_t> invocations_{0};
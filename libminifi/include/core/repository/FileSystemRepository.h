@@ -18,6 +18,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <filesystem>
+#include <functional>
 #include <string>
 #include <string_view>
 
@@ -28,8 +31,16 @@
 
 namespace org::apache::nifi::minifi::core::repository {
 
+/**
+ * Stores every resource claim in a separate file. The files are spread over a number of subdirectories based on the
+ * hash of their names, so that no directory grows too large. Content written with the flat layout of previous versions
+ * stays readable, as the claims store the full path of their content.
+ * If a maximum container size is configured, sessions pack the content of multiple flow files into shared container files.
+ */
 class FileSystemRepository : public ContentRepositoryImpl {
  public:
+  static constexpr size_t DEFAULT_SUBDIRECTORY_COUNT = 256;
+
   explicit FileSystemRepository(const std::string_view name = className<FileSystemRepository>())
     : ContentRepositoryImpl(name),
       logger_(logging::LoggerFactory<FileSystemRepository>::getLogger()) {
@@ -46,6 +57,8 @@ class FileSystemRepository : public ContentRepositoryImpl {
   std::shared_ptr<io::BaseStream> write(const ResourceClaim& claim, bool append = false) override;
   std::shared_ptr<io::BaseStream> read(const ResourceClaim& claim) override;
 
+  std::string getStreamPath(std::string_view stream_name) const override;
+
   bool close(const ResourceClaim& claim) override {
     return remove(claim);
   }
@@ -60,12 +73,27 @@ class FileSystemRepository : public ContentRepositoryImpl {
 
   size_t size(const ResourceClaim& claim) override;
 
-  uint64_t getRepositoryEntryCount() const override;
+  uint64_t getRepositoryEntryCount() const override {
+    return entry_count_;
+  }
 
  protected:
   bool removeKey(const std::string& content_path) override;
 
  private:
+  // Calls the callback with the path of every content file of the flat and the hashed layouts, the subdirectories are processed on multiple threads in parallel
+  void forEachContentFile(const std::function<void(const std::string&)>& callback) const;
+  void decrementEntryCount();
+
+  size_t subdirectory_count_ = DEFAULT_SUBDIRECTORY_COUNT;
+  // 0 means that the content of every flow file is stored in a separate file
+  size_t max_container_size_ = 0;
+  // read content files through memory mapped streams, so that their content can be processed in place
+  bool memory_mapped_reads_ = false;
+  // the content directory is not configured, so MINIFI_HOME is used, which contains other files than content
+  bool is_minifi_home_ = false;
+  // Number of content files, counted at startup and kept up to date afterwards instead of listing the directories on every query
+  std::atomic<uint64_t> entry_count_{0};
   std::shared_ptr<logging::Logger> logger_;
 };
 
@@ -21,6 +21,7 @@
 #include <limits>
 #include <map>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -67,6 +68,8 @@ class VolatileRepository : public core::ThreadedRepositoryImpl {
    **/
   bool MultiPut(const std::vector<std::pair<std::string, std::unique_ptr<io::BufferStream>>>& data) override;
 
+  bool MultiPut(std::span<const std::pair<std::string_view, std::span<const std::byte>>> data) override;
+
   /**
    * Deletes the key
    * @return status of the delete operation
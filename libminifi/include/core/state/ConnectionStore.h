@@ -22,6 +22,7 @@
 #include <unordered_map>
 
 #include "minifi-cpp/Connection.h"
+#include "core/state/nodes/MetricsBase.h"
 #include "minifi-cpp/utils/gsl.h"
 
 namespace org::apache::nifi::minifi::state {
@@ -50,6 +51,10 @@ class ConnectionStore {
         {{"connection_uuid", connection->getUUIDStr()}, {"connection_name", connection->getName()}, {"metric_class", metric_class}}});
       metrics.push_back({"queue_size_max", static_cast<double>(connection->getBackpressureThresholdCount()),
         {{"connection_uuid", connection->getUUIDStr()}, {"connection_name", connection->getName()}, {"metric_class", metric_class}}});
+      for (const auto& percentile : response::PUBLISHED_LATENCY_PERCENTILES) {
+        metrics.push_back({"queue_wait_time_nanoseconds", static_cast<double>(connection->getQueueWaitTimePercentile(percentile.ratio).count()),
+          {{"connection_uuid", connection->getUUIDStr()}, {"connection_name", connection->getName()}, {"metric_class", metric_class}, {"quantile", std::string{percentile.quantile}}}});
+      }
     }
 
     return metrics;
@@ -17,6 +17,8 @@
  */
 #pragma once
 
+#include <array>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <memory>
@@ -30,6 +32,19 @@
 
 namespace org::apache::nifi::minifi::state::response {
 
+// Percentiles of the latency histograms published as metrics. The quantile is the value of the "quantile" label of the
+// published metric, the suffix is appended to the name of the serialized node.
+struct LatencyPercentile {
+  std::string_view quantile;
+  std::string_view suffix;
+  double ratio;
+};
+inline constexpr std::array<LatencyPercentile, 3> PUBLISHED_LATENCY_PERCENTILES{{
+  {.quantile = "0.5", .suffix = "P50", .ratio = 0.5},
+  {.quantile = "0.99", .suffix = "P99", .ratio = 0.99},
+  {.quantile = "0.999", .suffix = "P999", .ratio = 0.999}
+}};
+
 class ResponseNodeSource {
  public:
   virtual ~ResponseNodeSource() = default;
@@ -19,14 +19,18 @@
 
 #include <algorithm>
 #include <atomic>
+#include <concepts>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 #include "core/Core.h"
 #include "core/SerializableComponent.h"
@@ -63,6 +67,9 @@ class ProvenanceEventRecordImpl : public core::SerializableComponentImpl, public
   }
 
   std::map<std::string, std::string> getAttributes() const override {
+    if (flow_file_attributes_) {
+      return {flow_file_attributes_->begin(), flow_file_attributes_->end()};
+    }
     return _attributes;
   }
 
@@ -218,7 +225,7 @@ class ProvenanceEventRecordImpl : public core::SerializableComponentImpl, public
     _lineageStartDate = flow_file.getlineageStartDate();
     _lineageIdentifiers = flow_file.getlineageIdentifiers();
     flow_uuid_ = flow_file.getUUID();
-    _attributes = flow_file.getAttributes();
+    flow_file_attributes_ = flow_file.getAttributesSnapshot();
     _size = flow_file.getSize();
     _offset = flow_file.getOffset();
     if (flow_file.getConnection())
@@ -249,6 +256,8 @@ class ProvenanceEventRecordImpl : public core::SerializableComponentImpl, public
   uint64_t _offset = 0;
   std::string _contentFullPath;
   std::map<std::string, std::string> _attributes;
+  // attributes of the flow file when the event was created, shared with the flow file instead of copying them
+  std::shared_ptr<const core::FlowFile::AttributeMap> flow_file_attributes_;
   // UUID string for all parents
   std::vector<utils::Identifier> _lineageIdentifiers;
   std::string _transitUri;
@@ -269,8 +278,12 @@ class ProvenanceEventRecordImpl : public core::SerializableComponentImpl, public
 
 class ProvenanceReporterImpl : public virtual ProvenanceReporter {
  public:
-  ProvenanceReporterImpl(std::shared_ptr<core::Repository> repo, std::string componentId, std::string componentType)
-      : logger_(core::logging::LoggerFactory<ProvenanceReporter>::getLogger()) {
+  /**
+   * @param sampling_ratio ratio of the flow files whose events are recorded, the events of the other flow files are dropped without being built
+   */
+  ProvenanceReporterImpl(std::shared_ptr<core::Repository> repo, std::string componentId, std::string componentType, double sampling_ratio = 1.0)
+      : logger_(core::logging::LoggerFactory<ProvenanceReporter>::getLogger()),
+        sampling_threshold_(samplingThreshold(sampling_ratio)) {
     _componentId = componentId;
     _componentType = componentType;
     repo_ = repo;
@@ -311,9 +324,46 @@ class ProvenanceReporterImpl : public virtual ProvenanceReporter {
   void receive(const core::FlowFile& flow_file, const std::string& transitUri,
     const std::string& sourceSystemFlowFileIdentifier, const std::string& detail, std::chrono::milliseconds processingDuration) override;
 
+  // The overloads below take a generator for the details, which is only called if the event is recorded
+
+  template<std::invocable DetailsGenerator>
+  void create(const core::FlowFile& flow_file, DetailsGenerator&& details) {
+    record(ProvenanceEventRecord::CREATE, flow_file, std::forward<DetailsGenerator>(details));
+  }
+
+  template<std::invocable DetailsGenerator>
+  void modifyAttributes(const core::FlowFile& flow_file, DetailsGenerator&& details) {
+    record(ProvenanceEventRecord::ATTRIBUTES_MODIFIED, flow_file, std::forward<DetailsGenerator>(details));
+  }
+
+  template<std::invocable DetailsGenerator>
+  void modifyContent(const core::FlowFile& flow_file, DetailsGenerator&& details, std::chrono::milliseconds processingDuration) {
+    if (auto event = record(ProvenanceEventRecord::CONTENT_MODIFIED, flow_file, std::forward<DetailsGenerator>(details))) {
+      event->setEventDuration(processingDuration);
+    }
+  }
+
+  template<std::invocable DetailsGenerator>
+  void expire(const core::FlowFile& flow_file, DetailsGenerator&& details) {
+    record(ProvenanceEventRecord::EXPIRE, flow_file, std::forward<DetailsGenerator>(details));
+  }
+
+  // Returns whether the events of the flow file are recorded by this reporter
+  [[nodiscard]] bool isRecorded(const core::FlowFile& flow_file) const;
+
  protected:
+  template<std::invocable DetailsGenerator>
+  std::shared_ptr<ProvenanceEventRecord> record(ProvenanceEventRecord::ProvenanceEventType eventType, const core::FlowFile& flow_file, DetailsGenerator&& details) {
+    auto event = allocate(eventType, flow_file);
+    if (event) {
+      event->setDetails(std::string{std::invoke(std::forward<DetailsGenerator>(details))});
+      add(event);
+    }
+    return event;
+  }
+
   std::shared_ptr<ProvenanceEventRecord> allocate(ProvenanceEventRecord::ProvenanceEventType eventType, const core::FlowFile& flow_file) {
-    if (repo_->isNoop()) {
+    if (repo_->isNoop() || !isRecorded(flow_file)) {
       return nullptr;
     }
 
@@ -328,9 +378,13 @@ class ProvenanceReporterImpl : public virtual ProvenanceReporter {
   std::string _componentType;
 
  private:
+  static std::optional<uint64_t> samplingThreshold(double sampling_ratio);
+
   std::shared_ptr<core::logging::Logger> logger_;
   std::set<std::shared_ptr<ProvenanceEventRecord>> _events;
   std::shared_ptr<core::Repository> repo_;
+  // flow files whose hashed UUID is below the threshold are recorded, no threshold means that every flow file is recorded
+  std::optional<uint64_t> sampling_threshold_;
 
   ProvenanceReporterImpl(const ProvenanceReporterImpl &parent);
   ProvenanceReporterImpl &operator=(const ProvenanceReporterImpl &parent);
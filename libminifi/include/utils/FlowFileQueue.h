@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <vector>
 #include <algorithm>
 #include <utility>
@@ -46,6 +47,8 @@ class FlowFileQueue {
   std::optional<value_type> tryPop(std::chrono::milliseconds timeout);
   void push(value_type element);
   bool isWorkAvailable() const;
+  // the time when the next flow file of the queue becomes available, if the queue is not empty
+  std::optional<TimePoint> getNextPenaltyExpiration() const;
   bool empty() const;
   size_t size() const;
   void setMinSize(size_t min_size);
@@ -0,0 +1,141 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace org::apache::nifi::minifi::utils {
+
+// A FIFO queue split into shards, each guarded by its own mutex. Every thread pushes to the same shard, so concurrent
+// producers rarely contend. The elements are numbered when pushed, and a pop takes the oldest head of the shards,
+// so elements are popped in the order they were pushed, regardless of the pushing and popping threads.
+// The size is kept in an atomic, so it can be queried without locking.
+template<typename T>
+class ShardedQueue {
+ public:
+  explicit ShardedQueue(size_t shard_count = std::thread::hardware_concurrency()) {
+    shard_count = std::max<size_t>(shard_count, 1);
+    for (size_t i = 0; i < shard_count; ++i) {
+      shards_.push_back(std::make_unique<Shard>());
+    }
+  }
+
+  ShardedQueue(const ShardedQueue&) = delete;
+  ShardedQueue& operator=(const ShardedQueue&) = delete;
+  ShardedQueue(ShardedQueue&&) = delete;
+  ShardedQueue& operator=(ShardedQueue&&) = delete;
+  ~ShardedQueue() = default;
+
+  void push(T element) {
+    auto& shard = *shards_[ownShardIndex()];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.queue.push_back(Entry{.sequence = next_sequence_++, .element = std::move(element)});
+    ++size_;
+  }
+
+  // Pushes all elements while locking the shard only once
+  void push(std::vector<T> elements) {
+    if (elements.empty()) {
+      return;
+    }
+    auto& shard = *shards_[ownShardIndex()];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const uint64_t first_sequence = next_sequence_.fetch_add(elements.size());
+    for (size_t i = 0; i < elements.size(); ++i) {
+      shard.queue.push_back(Entry{.sequence = first_sequence + i, .element = std::move(elements[i])});
+    }
+    size_ += elements.size();
+  }
+
+  // Pops the oldest element. The shards are locked one at a time, so an element pushed concurrently may be missed.
+  std::optional<T> tryPop() {
+    while (size_ > 0) {
+      std::optional<size_t> oldest_shard_index;
+      uint64_t oldest_sequence = 0;
+      for (size_t i = 0; i < shards_.size(); ++i) {
+        auto& shard = *shards_[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (!shard.queue.empty() && (!oldest_shard_index || shard.queue.front().sequence < oldest_sequence)) {
+          oldest_shard_index = i;
+          oldest_sequence = shard.queue.front().sequence;
+        }
+      }
+      if (!oldest_shard_index) {
+        return std::nullopt;
+      }
+      auto& shard = *shards_[*oldest_shard_index];
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      // if another consumer has taken the oldest element in the meantime, the heads are compared again
+      if (!shard.queue.empty() && shard.queue.front().sequence == oldest_sequence) {
+        T element = std::move(shard.queue.front().element);
+        shard.queue.pop_front();
+        --size_;
+        return element;
+      }
+    }
+    return std::nullopt;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  void clear() {
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      size_ -= shard->queue.size();
+      shard->queue.clear();
+    }
+  }
+
+ private:
+  struct Entry {
+    uint64_t sequence;
+    T element;
+  };
+
+  // the sequence numbers are assigned while holding the lock of the shard, so they are increasing within a shard
+  struct Shard {
+    std::mutex mutex;
+    std::deque<Entry> queue;
+  };
+
+  size_t ownShardIndex() const {
+    static thread_local const size_t thread_hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return thread_hash % shards_.size();
+  }
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<size_t> size_{0};
+  std::atomic<uint64_t> next_sequence_{0};
+};
+
+}  // namespace org::apache::nifi::minifi::utils
@@ -25,8 +25,11 @@
 #include <chrono>
 #include <thread>
 #include <list>
+#include <optional>
+#include <utility>
 #include "minifi-cpp/core/FlowFile.h"
 #include "core/Connectable.h"
+#include "minifi-cpp/utils/gsl.h"
 
 using namespace std::literals::chrono_literals;
 
@@ -70,22 +73,20 @@ ConnectionImpl::ConnectionImpl(std::shared_ptr<core::Repository> flow_repository
     : core::ConnectableImpl(name, uuid),
       flow_repository_(std::move(flow_repository)),
       content_repo_(std::move(content_repo)),
-      queue_(std::move(swap_manager)) {
+      queue_(swap_manager),
+      ready_queue_enabled_(swap_manager == nullptr) {
   logger_->log_debug("Connection {} created", name_);
 }
 
 bool ConnectionImpl::isEmpty() const {
-  std::lock_guard<std::mutex> lock(mutex_);
-
-  return queue_.empty();
+  return getQueueSize() == 0;
 }
 
 bool ConnectionImpl::backpressureThresholdReached() const {
-  std::lock_guard<std::mutex> lock(mutex_);
   auto backpressure_threshold_count = backpressure_threshold_count_.load();
   auto backpressure_threshold_data_size = backpressure_threshold_data_size_.load();
 
-  if (backpressure_threshold_count != 0 && queue_.size() >= backpressure_threshold_count)
+  if (backpressure_threshold_count != 0 && getQueueSize() >= backpressure_threshold_count)
     return true;
 
   if (backpressure_threshold_data_size != 0 && queued_data_size_ >= backpressure_threshold_data_size)
@@ -94,20 +95,27 @@ bool ConnectionImpl::backpressureThresholdReached() const {
   return false;
 }
 
+bool ConnectionImpl::canBeQueuedAsReady(const core::FlowFile& flow_file) const {
+  // swapping needs every flow file of the connection in queue_
+  return ready_queue_enabled_ && !flow_file.isPenalized();
+}
+
 void ConnectionImpl::put(const std::shared_ptr<core::FlowFile>& flow) {
   if (drop_empty_ && flow->getSize() == 0) {
     logger_->log_info("Dropping empty flow file: {}", flow->getUUIDStr());
     return;
   }
-  {
+  queued_data_size_ += flow->getSize();
+  flow->setLastQueueTime(std::chrono::steady_clock::now());
+  if (canBeQueuedAsReady(*flow)) {
+    ready_queue_.push(flow);
+  } else {
     std::lock_guard<std::mutex> lock(mutex_);
-
+    queue_data_size_ += flow->getSize();
     queue_.push(flow);
-
-    queued_data_size_ += flow->getSize();
-
-    logger_->log_debug("Enqueue flow file UUID {} to connection {}", flow->getUUIDStr(), name_);
+    updateQueueSize();
   }
+  logger_->log_debug("Enqueue flow file UUID {} to connection {}", flow->getUUIDStr(), name_);
 
   // Notify receiving processor that work may be available
   if (dest_connectable_) {
@@ -117,20 +125,30 @@ void ConnectionImpl::put(const std::shared_ptr<core::FlowFile>& flow) {
 }
 
 void ConnectionImpl::multiPut(std::vector<std::shared_ptr<core::FlowFile>>& flows) {
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::shared_ptr<core::FlowFile>> ready_flows;
+  std::vector<std::shared_ptr<core::FlowFile>> penalized_flows;
+  const auto queue_time = std::chrono::steady_clock::now();
+  for (auto &ff : flows) {
+    if (drop_empty_ && ff->getSize() == 0) {
+      logger_->log_info("Dropping empty flow file: {}", ff->getUUIDStr());
+      continue;
+    }
 
-    for (auto &ff : flows) {
-      if (drop_empty_ && ff->getSize() == 0) {
-        logger_->log_info("Dropping empty flow file: {}", ff->getUUIDStr());
-        continue;
-      }
+    queued_data_size_ += ff->getSize();
+    ff->setLastQueueTime(queue_time);
+    (canBeQueuedAsReady(*ff) ? ready_flows : penalized_flows).push_back(ff);
 
-      queue_.push(ff);
-      queued_data_size_ += ff->getSize();
+    logger_->log_debug("Enqueue flow file UUID {} to connection {}", ff->getUUIDStr(), name_);
+  }
 
-      logger_->log_debug("Enqueue flow file UUID {} to connection {}", ff->getUUIDStr(), name_);
+  ready_queue_.push(std::move(ready_flows));
+  if (!penalized_flows.empty()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& ff : penalized_flows) {
+      queue_data_size_ += ff->getSize();
+      queue_.push(std::move(ff));
     }
+    updateQueueSize();
   }
 
   if (dest_connectable_) {
@@ -140,7 +158,35 @@ void ConnectionImpl::multiPut(std::vector<std::shared_ptr<core::FlowFile>>& flow
 }
 
 std::shared_ptr<core::FlowFile> ConnectionImpl::poll(std::set<std::shared_ptr<core::FlowFile>> &expiredFlowRecords) {
+  const bool was_backpressure_reached = backpressureThresholdReached();
+  const auto notify_source = gsl::finally([&] { notifyBackpressureReleased(was_backpressure_reached); });
+  // flow files whose penalty has expired are taken first, they would have been processed earlier without the penalty
+  if (queue_size_ > 0) {
+    if (auto item = pollQueue(expiredFlowRecords)) {
+      return item;
+    }
+  }
+  return pollReadyQueue(expiredFlowRecords);
+}
+
+std::optional<std::chrono::steady_clock::time_point> ConnectionImpl::getNextPenaltyExpiration() {
+  if (queue_size_ == 0) {
+    return std::nullopt;
+  }
+  const std::lock_guard<std::mutex> lock{mutex_};
+  return queue_.getNextPenaltyExpiration();
+}
+
+void ConnectionImpl::notifyBackpressureReleased(bool was_backpressure_reached) {
+  if (was_backpressure_reached && source_connectable_ && !backpressureThresholdReached()) {
+    logger_->log_debug("Notifying {} that the backpressure of connection {} was released", source_connectable_->getName(), name_);
+    source_connectable_->notifyWork();
+  }
+}
+
+std::shared_ptr<core::FlowFile> ConnectionImpl::pollQueue(std::set<std::shared_ptr<core::FlowFile>>& expired_flow_files) {
   std::lock_guard<std::mutex> lock(mutex_);
+  const auto update_queue_size = gsl::finally([this] { updateQueueSize(); });
 
   while (queue_.isWorkAvailable()) {
     std::optional<std::shared_ptr<core::FlowFile>> opt_item = queue_.tryPop();
@@ -148,22 +194,9 @@ std::shared_ptr<core::FlowFile> ConnectionImpl::poll(std::set<std::shared_ptr<co
       return nullptr;
     }
     std::shared_ptr<core::FlowFile> item = std::move(opt_item.value());
-    queued_data_size_ -= item->getSize();
-
-    if (expired_duration_.load() > 0ms) {
-      // We need to check for flow expiration
-      if (std::chrono::system_clock::now() > (item->getEntryDate() + expired_duration_.load())) {
-        // Flow record expired
-        expiredFlowRecords.insert(item);
-        logger_->log_debug("Delete flow file UUID {} from connection {}, because it expired", item->getUUIDStr(), name_);
-      } else {
-        item->setConnection(this);
-        logger_->log_debug("Dequeue flow file UUID {} from connection {}", item->getUUIDStr(), name_);
-        return item;
-      }
-    } else {
-      item->setConnection(this);
-      logger_->log_debug("Dequeue flow file UUID {} from connection {}", item->getUUIDStr(), name_);
+    queue_data_size_ -= item->getSize();
+    if (!checkExpired(item, expired_flow_files)) {
+      recordQueueWaitTime(*item);
       return item;
     }
   }
@@ -171,8 +204,48 @@ std::shared_ptr<core::FlowFile> ConnectionImpl::poll(std::set<std::shared_ptr<co
   return nullptr;
 }
 
+std::shared_ptr<core::FlowFile> ConnectionImpl::pollReadyQueue(std::set<std::shared_ptr<core::FlowFile>>& expired_flow_files) {
+  while (auto item = ready_queue_.tryPop()) {
+    if (!checkExpired(*item, expired_flow_files)) {
+      recordQueueWaitTime(**item);
+      return std::move(*item);
+    }
+  }
+  return nullptr;
+}
+
+void ConnectionImpl::recordQueueWaitTime(const core::FlowFile& flow_file) {
+  // flow files restored from the flow file repository or swapped in do not know when they were queued
+  if (const auto queue_time = flow_file.getLastQueueTime(); queue_time != std::chrono::steady_clock::time_point{}) {
+    queue_wait_time_histogram_.record(std::chrono::steady_clock::now() - queue_time);
+  }
+}
+
+bool ConnectionImpl::checkExpired(const std::shared_ptr<core::FlowFile>& flow_file, std::set<std::shared_ptr<core::FlowFile>>& expired_flow_files) {
+  queued_data_size_ -= flow_file->getSize();
+
+  if (expired_duration_.load() > 0ms && std::chrono::system_clock::now() > (flow_file->getEntryDate() + expired_duration_.load())) {
+    // Flow record expired
+    expired_flow_files.insert(flow_file);
+    logger_->log_debug("Delete flow file UUID {} from connection {}, because it expired", flow_file->getUUIDStr(), name_);
+    return true;
+  }
+  flow_file->setConnection(this);
+  logger_->log_debug("Dequeue flow file UUID {} from connection {}", flow_file->getUUIDStr(), name_);
+  return false;
+}
+
 void ConnectionImpl::drain(bool delete_permanently) {
+  const bool was_backpressure_reached = backpressureThresholdReached();
+  const auto notify_source = gsl::finally([&] { notifyBackpressureReleased(was_backpressure_reached); });
   std::lock_guard<std::mutex> lock(mutex_);
+  // ready flow files can be put concurrently without the lock, so only the sizes of the drained ones are subtracted
+  while (auto item = ready_queue_.tryPop()) {
+    queued_data_size_ -= (*item)->getSize();
+    if (delete_permanently) {
+      deleteFromRepository(**item);
+    }
+  }
   if (!delete_permanently) {
     // simply discard in-memory flow files
     queue_.clear();
@@ -182,17 +255,22 @@ void ConnectionImpl::drain(bool delete_permanently) {
       if (!opt_item) {
         continue;
       }
-      auto& item = opt_item.value();
-      if (item->isStored() && flow_repository_->Delete(item->getUUIDStr())) {
-        item->setStoredToRepository(false);
-        auto claim = item->getResourceClaim();
-        if (claim) claim->decreaseFlowFileRecordOwnedCount();
-      }
+      deleteFromRepository(*opt_item.value());
     }
   }
 
-  queued_data_size_ = 0;
+  updateQueueSize();
+  queued_data_size_ -= queue_data_size_;
+  queue_data_size_ = 0;
   logger_->log_debug("Drain connection {}", name_);
 }
 
+void ConnectionImpl::deleteFromRepository(core::FlowFile& flow_file) {
+  if (flow_file.isStored() && flow_repository_->Delete(flow_file.getUUIDStr())) {
+    flow_file.setStoredToRepository(false);
+    auto claim = flow_file.getResourceClaim();
+    if (claim) claim->decreaseFlowFileRecordOwnedCount();
+  }
+}
+
 }  // namespace org::apache::nifi::minifi
@@ -33,15 +33,34 @@ void EventDrivenSchedulingAgent::schedule(core::Processor* processor) {
   if (!processor->hasIncomingConnections()) {
     throw Exception(PROCESS_SCHEDULE_EXCEPTION, "EventDrivenSchedulingAgent cannot schedule processor without incoming connection!");
   }
+  processor->setWorkNotifier([&thread_pool = thread_pool_, task_id = processor->getUUIDStr()] {
+    thread_pool.wakeUp(task_id);
+  });
   ThreadedSchedulingAgent::schedule(processor);
 }
 
+void EventDrivenSchedulingAgent::unschedule(core::Processor* processor) {
+  processor->setWorkNotifier(nullptr);
+  ThreadedSchedulingAgent::unschedule(processor);
+}
+
 utils::TaskRescheduleInfo EventDrivenSchedulingAgent::run(core::Processor* processor,
     const std::shared_ptr<core::ProcessContext>& process_context,
     const std::shared_ptr<core::ProcessSessionFactory>& session_factory) {
   if (!this->running_) {
     return utils::TaskRescheduleInfo::Done();
   }
+  if (!processor->isYield() && !hasWorkToDo(processor)) {
+    // no need to poll the incoming connections, new flow files wake the task up through Processor::notifyWork,
+    // but penalized flow files become available without a notification, so the task is run when the first penalty expires
+    const auto idle_until = std::chrono::steady_clock::now() + idle_period_;
+    const auto next_penalty_expiration = processor->getNextPenaltyExpiration();
+    return utils::TaskRescheduleInfo::RetryAfter(next_penalty_expiration ? std::min(idle_until, *next_penalty_expiration) : idle_until);
+  }
+  if (!processor->isYield() && processor->isThrottledByBackpressure()) {
+    // the outgoing connection wakes the task up through Processor::notifyWork when its backpressure is released
+    return utils::TaskRescheduleInfo::RetryIn(idle_period_);
+  }
   if (processorYields(processor)) {
     return utils::TaskRescheduleInfo::RetryAfter(processor->getYieldExpirationTime());
   }
@@ -54,7 +73,7 @@ utils::TaskRescheduleInfo EventDrivenSchedulingAgent::run(core::Processor* proce
   process_session->setMetrics(processor->getMetrics());
   bool needs_commit = true;
 
-  while (processor->isRunning() && (std::chrono::steady_clock::now() - start_time < time_slice_)) {
+  while (processor->isRunning() && (std::chrono::steady_clock::now() - start_time < time_slice_) && hasWorkToDo(processor)) {
     const auto trigger_result = this->trigger(processor, process_context, process_session);
     if (!trigger_result) {
       try {
@@ -37,6 +37,8 @@
 #include "utils/file/PathUtils.h"
 #include "utils/file/FileSystem.h"
 #include "utils/file/FileUtils.h"
+#include "utils/ParsingUtils.h"
+#include "utils/StringUtils.h"
 #include "http/BaseHTTPClient.h"
 #include "io/NetworkPrioritizer.h"
 #include "io/FileStream.h"
@@ -109,9 +111,11 @@ FlowController::~FlowController() {
 }
 
 nonstd::expected<void, std::string> FlowController::applyConfiguration(const std::string &source, const std::string &configurePayload, const std::optional<std::string>& flow_id) {
+  // parsing the payload replaces the controller service provider of flow_configuration_, but an in-place update keeps the running one
+  auto running_service_provider = flow_configuration_->getControllerServiceProvider();
   std::unique_ptr<core::ProcessGroup> newRoot;
   try {
-    newRoot = updateFromPayload(source, configurePayload, flow_id);
+    newRoot = flow_configuration_->updateFromPayload(source, configurePayload, flow_id);
   } catch (const std::exception& ex) {
     logger_->log_error("Invalid configuration payload, type: {}, what: {}", typeid(ex).name(), ex.what());
     return nonstd::make_unexpected(fmt::format("Invalid configuration payload, type: {}, what: {}", typeid(ex).name(), ex.what()));
@@ -129,25 +133,44 @@ nonstd::expected<void, std::string> FlowController::applyConfiguration(const std
   {
     std::scoped_lock<UpdateState> update_lock(updating_);
     std::lock_guard<std::recursive_mutex> flow_lock(mutex_);
-    stop();
-
-    root_wrapper_.setNewRoot(std::move(newRoot));
-    initialized_ = false;
-    try {
-      load(true);
-      started = start() == 0;
-    } catch (const std::exception& ex) {
-      logger_->log_error("Caught exception while starting flow, type {}, what: {}", typeid(ex).name(), ex.what());
-    } catch (...) {
-      logger_->log_error("Caught unknown exception while starting flow, type {}", getCurrentExceptionTypeName());
-    }
-    if (!started) {
-      logger_->log_error("Failed to start new flow, restarting previous flow");
-      root_wrapper_.restoreBackup();
-      load(true);
-      start();
+    if (auto diff = compareWithRunningFlow(*newRoot)) {
+      logger_->log_info("Updating the running flow in place, processors changed: {}, added: {}, removed: {}, connections changed: {}, added: {}, removed: {}",
+          diff->changed_processors.size(), diff->added_processors.size(), diff->removed_processors.size(),
+          diff->changed_connections.size(), diff->added_connections.size(), diff->removed_connections.size());
+      try {
+        // the controller services are the same, the running ones are kept
+        root_wrapper_.applyDiff(std::move(newRoot), *diff, *timer_scheduler_, *event_scheduler_, *cron_scheduler_);
+        // the parsed controller service nodes refer to the process groups of the parsed flow, which have been destroyed
+        flow_configuration_->restoreControllerServiceProvider(std::move(running_service_provider));
+        setFlowFileContainers();
+        started = true;
+      } catch (const std::exception& ex) {
+        logger_->log_error("Caught exception while updating the flow, type {}, what: {}", typeid(ex).name(), ex.what());
+      } catch (...) {
+        logger_->log_error("Caught unknown exception while updating the flow, type {}", getCurrentExceptionTypeName());
+      }
+      if (!started) {
+        // the running flow may have been partially updated and some of its processors are stopped, so the whole flow is restarted instead
+        logger_->log_error("Failed to update the running flow in place, reloading the whole flow");
+        try {
+          newRoot = flow_configuration_->updateFromPayload(source, configurePayload, flow_id);
+        } catch (const std::exception& ex) {
+          logger_->log_error("Caught exception while reloading the flow, type {}, what: {}", typeid(ex).name(), ex.what());
+        } catch (...) {
+          logger_->log_error("Caught unknown exception while reloading the flow, type {}", getCurrentExceptionTypeName());
+        }
+        if (newRoot) {
+          started = reloadFlow(std::move(newRoot));
+        } else {
+          logger_->log_error("Could not create root process group, restarting the previous flow");
+          stop();
+          initialized_ = false;
+          load(true);
+          start();
+        }
+      }
     } else {
-      root_wrapper_.clearBackup();
+      started = reloadFlow(std::move(newRoot));
     }
   }
 
@@ -169,6 +192,34 @@ nonstd::expected<void, std::string> FlowController::applyConfiguration(const std
   return {};
 }
 
+bool FlowController::reloadFlow(std::unique_ptr<core::ProcessGroup> new_root) {
+  // prepare to accept the new controller service provider from flow_configuration_
+  clearControllerServices();
+  controller_service_provider_impl_ = flow_configuration_->getControllerServiceProvider();
+  stop();
+
+  root_wrapper_.setNewRoot(std::move(new_root));
+  initialized_ = false;
+  bool started = false;
+  try {
+    load(true);
+    started = start() == 0;
+  } catch (const std::exception& ex) {
+    logger_->log_error("Caught exception while starting flow, type {}, what: {}", typeid(ex).name(), ex.what());
+  } catch (...) {
+    logger_->log_error("Caught unknown exception while starting flow, type {}", getCurrentExceptionTypeName());
+  }
+  if (!started) {
+    logger_->log_error("Failed to start new flow, restarting previous flow");
+    root_wrapper_.restoreBackup();
+    load(true);
+    start();
+  } else {
+    root_wrapper_.clearBackup();
+  }
+  return started;
+}
+
 int16_t FlowController::stop() {
   std::lock_guard<std::recursive_mutex> flow_lock(mutex_);
   if (running_) {
@@ -280,6 +331,8 @@ void FlowController::load(bool reload) {
   if (!thread_pool_.isRunning() || reload) {
     thread_pool_.shutdown();
     thread_pool_.setMaxConcurrentTasks(configuration_->getInt(Configure::nifi_flow_engine_threads, 5));
+    const bool work_stealing = (configuration_->get(Configure::nifi_flow_engine_work_stealing) | utils::andThen(&utils::string::toBool)).value_or(false);
+    thread_pool_.setSchedulingMode(work_stealing ? utils::ThreadPoolSchedulingMode::WORK_STEALING : utils::ThreadPoolSchedulingMode::SHARED_QUEUE);
     thread_pool_.setControllerServiceProvider(this);
     thread_pool_.start();
   }
@@ -310,19 +363,36 @@ void FlowController::load(bool reload) {
 
 void FlowController::loadFlowRepo() {
   if (this->flow_file_repo_ != nullptr) {
-    logger_->log_debug("Getting connection map");
-    std::map<std::string, core::Connectable*> connectionMap;
-    std::map<std::string, core::Connectable*> containers;
-    root_wrapper_.getConnections(connectionMap);
-    root_wrapper_.getFlowFileContainers(containers);
-    flow_file_repo_->setConnectionMap(connectionMap);
-    flow_file_repo_->setContainers(containers);
+    setFlowFileContainers();
     flow_file_repo_->loadComponent(content_repo_);
   } else {
     logger_->log_debug("Flow file repository is not set");
   }
 }
 
+void FlowController::setFlowFileContainers() {
+  logger_->log_debug("Getting connection map");
+  std::map<std::string, core::Connectable*> connectionMap;
+  std::map<std::string, core::Connectable*> containers;
+  root_wrapper_.getConnections(connectionMap);
+  root_wrapper_.getFlowFileContainers(containers);
+  flow_file_repo_->setConnectionMap(connectionMap);
+  flow_file_repo_->setContainers(containers);
+}
+
+std::optional<core::ProcessGroupDiff> FlowController::compareWithRunningFlow(const core::ProcessGroup& new_root) const {
+  const auto* root = root_wrapper_.getRoot();
+  const bool differential_update = (configuration_->get(Configure::nifi_flow_configuration_differential_update) | utils::andThen(&utils::string::toBool)).value_or(true);
+  if (!differential_update || !running_ || !root) {
+    return std::nullopt;
+  }
+  auto diff = core::ProcessGroupDiff::compare(*root, new_root);
+  if (!diff) {
+    logger_->log_info("The process groups, controller services or connection endpoints of the new flow differ from the running one, restarting the whole flow");
+  }
+  return diff;
+}
+
 int16_t FlowController::start() {
   std::lock_guard<std::recursive_mutex> flow_lock(mutex_);
   if (!initialized_) {
@@ -24,6 +24,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <iostream>
 #include <fstream>
 #include <cinttypes>
@@ -107,14 +108,14 @@ bool FlowFileRecordImpl::Serialize(io::OutputStream &outStream) {
   }
   // write flow attributes
   {
-    const auto numAttributes = gsl::narrow<uint32_t>(attributes_.size());
+    const auto numAttributes = gsl::narrow<uint32_t>(attributes_->size());
     const auto ret = outStream.write(numAttributes);
     if (ret != 4) {
       return false;
     }
   }
 
-  for (auto& itAttribute : attributes_) {
+  for (const auto& itAttribute : *attributes_) {
     {
       const auto ret = outStream.write(itAttribute.first, true);
       if (ret == 0 || io::isError(ret)) {
@@ -242,7 +243,7 @@ std::shared_ptr<FlowFileRecord> FlowFileRecordImpl::DeSerialize(io::InputStream&
         return {};
       }
     }
-    file->attributes_[key] = value;
+    file->mutableAttributes()[key] = std::move(value);
   }
 
   std::string content_full_path;
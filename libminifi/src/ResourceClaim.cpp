@@ -39,12 +39,12 @@ void setDefaultDirectory(std::string path) {
 
 ResourceClaimImpl::ResourceClaimImpl(std::shared_ptr<core::StreamManager<ResourceClaim>> claim_manager)
     : _contentFullPath([&] {
-        auto contentDirectory = claim_manager->getStoragePath();
-        if (contentDirectory.empty())
-          contentDirectory = default_directory_path;
+        const auto stream_name = non_repeating_string_generator_.generate();
+        if (claim_manager->getStoragePath().empty())
+          return default_directory_path + "/" + stream_name;
 
-        // Create the full content path for the content
-        return contentDirectory + "/" + non_repeating_string_generator_.generate();
+        // The repository decides where the content is stored within its storage path
+        return claim_manager->getStreamPath(stream_name);
       }()),
       claim_manager_(std::move(claim_manager)),
       logger_(core::logging::LoggerFactory<ResourceClaim>::getLogger()) {
@@ -64,6 +64,39 @@ void RootProcessGroupWrapper::setNewRoot(std::unique_ptr<core::ProcessGroup> new
   }
 }
 
+void RootProcessGroupWrapper::applyDiff(std::unique_ptr<core::ProcessGroup> updated_root, const core::ProcessGroupDiff& diff,
+                                        TimerDrivenSchedulingAgent& timer_scheduler,
+                                        EventDrivenSchedulingAgent& event_scheduler,
+                                        CronDrivenSchedulingAgent& cron_scheduler) {
+  gsl_Expects(root_ && updated_root);
+
+  if (metrics_publisher_store_) { metrics_publisher_store_->clearMetricNodes(); }
+  if (controller_socket_protocol_) {
+    controller_socket_protocol_->setRoot(nullptr);
+  }
+  root_->stopProcessing(timer_scheduler, event_scheduler, cron_scheduler, [&diff] (const core::Processor* proc) -> bool {
+    return diff.needsStopping(*proc);
+  });
+  // the controllers hold the scheduling agent matching the scheduling strategy of the processor, which may have changed
+  for (const auto& id : diff.changed_processors) {
+    processor_to_controller_.erase(id);
+  }
+  for (const auto& id : diff.removed_processors) {
+    processor_to_controller_.erase(id);
+  }
+
+  diff.apply(*root_, *updated_root);
+  updated_root.reset();
+
+  root_->startProcessing(timer_scheduler, event_scheduler, cron_scheduler, [&diff] (const core::Processor* proc) -> bool {
+    return diff.needsStarting(*proc);
+  });
+  if (metrics_publisher_store_) { metrics_publisher_store_->loadMetricNodes(root_.get()); }
+  if (controller_socket_protocol_) {
+    controller_socket_protocol_->setRoot(root_.get());
+  }
+}
+
 void RootProcessGroupWrapper::restoreBackup() {
   if (metrics_publisher_store_) { metrics_publisher_store_->clearMetricNodes(); }
   root_ = std::move(backup_root_);
@@ -29,14 +29,12 @@
 
 using namespace std::literals::chrono_literals;
 
-namespace {
-bool hasWorkToDo(org::apache::nifi::minifi::core::Processor* processor) {
+namespace org::apache::nifi::minifi {
+
+bool SchedulingAgent::hasWorkToDo(core::Processor* processor) {
   // Whether it has work to do
   return processor->getTriggerWhenEmpty() || !processor->hasIncomingConnections() || processor->isWorkAvailable();
 }
-}  // namespace
-
-namespace org::apache::nifi::minifi {
 
 bool SchedulingAgent::processorYields(core::Processor* processor) const {
   if (processor->isYield()) {
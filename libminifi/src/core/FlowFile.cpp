@@ -16,10 +16,13 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <set>
 #include <cinttypes>
+#include <utility>
 #include "utils/Id.h"
 #include "core/FlowFile.h"
 #include "utils/requirements/Container.h"
@@ -39,11 +42,11 @@ FlowFileImpl::FlowFileImpl()
       entry_date_(std::chrono::system_clock::now()),
       event_time_(entry_date_),
       lineage_start_date_(entry_date_),
-      last_queue_date_(0),
       size_(0),
       id_(numeric_id_generator_->generateId()),
       offset_(0),
-      to_be_processed_after_(std::chrono::steady_clock::now()) {
+      to_be_processed_after_(std::chrono::steady_clock::now()),
+      attributes_(std::make_shared<AttributeMap>()) {
 }
 
 FlowFileImpl& FlowFileImpl::operator=(const FlowFileImpl& other) {
@@ -56,7 +59,7 @@ FlowFileImpl& FlowFileImpl::operator=(const FlowFileImpl& other) {
   entry_date_ = other.entry_date_;
   lineage_start_date_ = other.lineage_start_date_;
   lineage_Identifiers_ = other.lineage_Identifiers_;
-  last_queue_date_ = other.last_queue_date_;
+  last_queue_time_ = other.last_queue_time_;
   size_ = other.size_;
   to_be_processed_after_ = other.to_be_processed_after_;
   attributes_ = other.attributes_;
@@ -153,13 +156,55 @@ bool FlowFileImpl::getAttribute(std::string_view key, std::string& value) const
 }
 
 std::optional<std::string> FlowFileImpl::getAttribute(std::string_view key) const {
-  auto it = attributes_.find(key);
-  if (it != attributes_.end()) {
+  auto it = attributes_->find(key);
+  if (it != attributes_->end()) {
     return it->second;
   }
   return std::nullopt;
 }
 
+void FlowFileImpl::setAttribute(std::string_view key, std::string value) {
+  auto it = attributes_->find(key);
+  if (it != attributes_->end() && it->second == value) {
+    // avoid unsharing the attribute map for a no-op change
+    return;
+  }
+  mutableAttributes().insert_or_assign(std::string{key}, std::move(value));
+}
+
+FlowFile::AttributeMap& FlowFileImpl::mutableAttributes() {
+  if (attributes_.use_count() > 1) {
+    attributes_ = std::make_shared<AttributeMap>(*attributes_);
+  } else {
+    // The other owners may have just copied the map on another thread before releasing it. use_count() is a relaxed load,
+    // the fence pairs it with the release of their reference, so that their reads happen before our writes to the map.
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  return *attributes_;
+}
+
+void FlowFileImpl::inheritAttributes(const FlowFile& parent, std::span<const std::string_view> excluded_keys) {
+  const auto* parent_impl = dynamic_cast<const FlowFileImpl*>(&parent);
+  if (!parent_impl) {
+    for (const auto& [key, value] : *parent.getAttributesPtr()) {
+      if (std::find(excluded_keys.begin(), excluded_keys.end(), key) == excluded_keys.end()) {
+        setAttribute(key, value);
+      }
+    }
+    return;
+  }
+
+  auto own_attributes = std::exchange(attributes_, parent_impl->attributes_);
+  for (const auto key : excluded_keys) {
+    removeAttribute(key);
+  }
+  for (const auto& [key, value] : *own_attributes) {
+    if (attributes_->find(key) == attributes_->end()) {
+      mutableAttributes().insert_or_assign(key, value);
+    }
+  }
+}
+
 // Get Size
 uint64_t FlowFileImpl::getSize() const {
   return size_;
@@ -170,34 +215,28 @@ uint64_t FlowFileImpl::getOffset() const {
 }
 
 bool FlowFileImpl::removeAttribute(std::string_view key) {
-  auto it = attributes_.find(key);
-  if (it != attributes_.end()) {
-    attributes_.erase(it);
-    return true;
-  } else {
+  if (attributes_->find(key) == attributes_->end()) {
     return false;
   }
+  mutableAttributes().erase(key);
+  return true;
 }
 
 bool FlowFileImpl::updateAttribute(std::string_view key, const std::string& value) {
-  auto it = attributes_.find(key);
-  if (it != attributes_.end()) {
-    it->second = value;
-    return true;
-  } else {
+  if (attributes_->find(key) == attributes_->end()) {
     return false;
   }
+  mutableAttributes().at(key) = value;
+  return true;
 }
 
 bool FlowFileImpl::addAttribute(std::string_view key, const std::string& value) {
-  auto it = attributes_.find(key);
-  if (it != attributes_.end()) {
+  if (attributes_->find(key) != attributes_->end()) {
     // attribute already there in the map
     return false;
-  } else {
-    attributes_[key] = value;
-    return true;
   }
+  mutableAttributes()[key] = value;
+  return true;
 }
 
 void FlowFileImpl::setLineageStartDate(const std::chrono::system_clock::time_point date) {
@@ -0,0 +1,49 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "core/FlowFileSerializationArena.h"
+
+namespace org::apache::nifi::minifi::core {
+
+void FlowFileSerializationArena::add(FlowFileRecord& flow_file) {
+  keys_.push_back(flow_file.getUUIDStr());
+  flow_file.Serialize(buffer_);
+  value_ends_.push_back(buffer_.size());
+}
+
+std::span<const std::pair<std::string_view, std::span<const std::byte>>> FlowFileSerializationArena::entries() {
+  // the views are only created once every record has been written, as the buffer may be reallocated while growing
+  entries_.clear();
+  const auto buffer = buffer_.getBuffer();
+  size_t value_begin = 0;
+  for (size_t i = 0; i < keys_.size(); ++i) {
+    entries_.emplace_back(keys_[i].view(), buffer.subspan(value_begin, value_ends_[i] - value_begin));
+    value_begin = value_ends_[i];
+  }
+  return entries_;
+}
+
+void FlowFileSerializationArena::clear() {
+  if (buffer_.size() > MAX_RETAINED_BUFFER_SIZE) {
+    buffer_.moveBuffer();
+  }
+  buffer_.initialize();
+  keys_.clear();
+  value_ends_.clear();
+  entries_.clear();
+}
+
+}  // namespace org::apache::nifi::minifi::core
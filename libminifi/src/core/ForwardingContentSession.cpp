@@ -23,12 +23,15 @@
 #include "minifi-cpp/ResourceClaim.h"
 #include "minifi-cpp/io/BaseStream.h"
 #include "minifi-cpp/Exception.h"
+#include "io/OutputStreamSlice.h"
 #include "io/StreamPipe.h"
 #include "io/StreamSlice.h"
 
 namespace org::apache::nifi::minifi::core {
 
-ForwardingContentSession::ForwardingContentSession(std::shared_ptr<ContentRepository> repository) : ContentSessionImpl(std::move(repository)) {}
+ForwardingContentSession::ForwardingContentSession(std::shared_ptr<ContentRepository> repository, size_t max_container_size)
+    : ContentSessionImpl(std::move(repository)),
+      max_container_size_(max_container_size) {}
 
 std::shared_ptr<ResourceClaim> ForwardingContentSession::create() {
   auto claim = ResourceClaim::create(repository_);
@@ -43,20 +46,61 @@ std::shared_ptr<io::BaseStream> ForwardingContentSession::write(const std::share
   return repository_->write(*resource_id, false);
 }
 
+ContentSession::NewContent ForwardingContentSession::writeNewContent() {
+  if (max_container_size_ == 0 || (container_ && !container_->last_slice.expired())) {
+    // a nested write while the previous content is still being written gets a claim of its own
+    return ContentSessionImpl::writeNewContent();
+  }
+  if (container_ && container_->stream->size() >= max_container_size_) {
+    closeContainer();
+  }
+  if (!container_) {
+    auto claim = create();
+    auto stream = repository_->write(*claim, false);
+    container_ = Container{.claim = std::move(claim), .stream = std::move(stream), .last_slice = {}};
+  }
+  auto slice = std::make_shared<io::OutputStreamSlice>(container_->stream);
+  container_->last_slice = slice;
+  return {.claim = container_->claim, .offset = slice->offset(), .stream = slice};
+}
+
+std::shared_ptr<io::BaseStream> ForwardingContentSession::append(const std::shared_ptr<ResourceClaim>& resource_id, size_t offset,
+    const std::function<void(const std::shared_ptr<ResourceClaim>&)>& on_copy) {
+  if (container_ && container_->claim == resource_id) {
+    // the content of the flow file is at the end of the current container, it can only be extended in place if nothing else is appended to the container
+    closeContainer();
+  }
+  return ContentSessionImpl::append(resource_id, offset, on_copy);
+}
+
 std::shared_ptr<io::BaseStream> ForwardingContentSession::read(const std::shared_ptr<ResourceClaim>& resource_id) {
   return repository_->read(*resource_id);
 }
 
 std::shared_ptr<io::BaseStream> ForwardingContentSession::append(const std::shared_ptr<ResourceClaim>& resource_id) {
-  return repository_->write(*resource_id, true);
+  auto stream = repository_->write(*resource_id, true);
+  if (!stream) {
+    throw Exception(REPOSITORY_EXCEPTION, "Couldn't open the underlying resource for append: " + resource_id->getContentFullPath());
+  }
+  // the size of the appended stream only counts the appended content, the existing content is counted by the append state
+  return std::make_shared<io::OutputStreamSlice>(std::move(stream));
+}
+
+void ForwardingContentSession::closeContainer() {
+  if (container_) {
+    container_->stream->close();
+    container_.reset();
+  }
 }
 
 void ForwardingContentSession::commit() {
+  closeContainer();
   created_claims_.clear();
   append_state_.clear();
 }
 
 void ForwardingContentSession::rollback() {
+  closeContainer();
   created_claims_.clear();
   append_state_.clear();
 }
@@ -108,13 +108,14 @@ nonstd::expected<std::string, std::error_code> ProcessContextImpl::getProperty(c
   if (!property->supportsExpressionLanguage()) {
     return getProcessor().getProperty(name);
   }
-  if (!cached_expressions_.contains(name)) {
+  auto cached_expression_it = cached_expressions_.find(name);
+  if (cached_expression_it == cached_expressions_.end()) {
     auto expression_str = getProcessor().getProperty(name);
     if (!expression_str) { return expression_str; }
-    cached_expressions_.emplace(std::string{name}, expression::compile(*expression_str));
+    cached_expression_it = cached_expressions_.emplace(std::string{name}, expression::compile(*expression_str)).first;
   }
   expression::Parameters p(this, flow_file);
-  auto result = cached_expressions_[std::string{name}](p).asString();
+  auto result = cached_expression_it->second(p).asString();
   if (!property->getValidator().validate(result)) {
     return nonstd::make_unexpected(PropertyErrorCode::ValidationFailed);
   }
@@ -132,13 +133,14 @@ nonstd::expected<void, std::error_code> ProcessContextImpl::clearProperty(const
 }
 
 nonstd::expected<std::string, std::error_code> ProcessContextImpl::getDynamicProperty(const std::string_view name, const FlowFile* flow_file) const {
-  if (!cached_dynamic_expressions_.contains(name)) {
+  auto cached_expression_it = cached_dynamic_expressions_.find(name);
+  if (cached_expression_it == cached_dynamic_expressions_.end()) {
     auto expression_str = getProcessor().getDynamicProperty(name);
     if (!expression_str) { return expression_str; }
-    cached_dynamic_expressions_.emplace(std::string{name}, expression::compile(*expression_str));
+    cached_expression_it = cached_dynamic_expressions_.emplace(std::string{name}, expression::compile(*expression_str)).first;
   }
   const expression::Parameters p(this, flow_file);
-  return cached_dynamic_expressions_[std::string{name}](p).asString();
+  return cached_expression_it->second(p).asString();
 }
 
 nonstd::expected<std::string, std::error_code> ProcessContextImpl::getRawProperty(const std::string_view name) const {
@@ -77,7 +77,7 @@ ProcessGroup::~ProcessGroup() {
   }
 }
 
-bool ProcessGroup::isRemoteProcessGroup() {
+bool ProcessGroup::isRemoteProcessGroup() const {
   return (type_ == REMOTE_PROCESS_GROUP);
 }
 
@@ -106,6 +106,21 @@ void ProcessGroup::addPort(std::unique_ptr<Port> port) {
   }
 }
 
+std::unique_ptr<Processor> ProcessGroup::removeProcessor(const Processor* processor) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  const auto it = ranges::find_if(processors_, [processor](const auto& owned_processor) { return owned_processor.get() == processor; });
+  if (it == processors_.end()) {
+    return nullptr;
+  }
+  auto removed_processor = std::move(processors_.extract(it).value());
+  failed_processors_.erase(removed_processor.get());
+  if (auto port = dynamic_cast<Port*>(removed_processor.get())) {
+    ports_.erase(port);
+  }
+  logger_->log_debug("Remove processor {} from process group {}", removed_processor->getName(), name_);
+  return removed_processor;
+}
+
 void ProcessGroup::addProcessGroup(std::unique_ptr<ProcessGroup> child) {
   std::lock_guard<std::recursive_mutex> lock(mutex_);
 
@@ -187,12 +202,15 @@ void ProcessGroup::startProcessingProcessors(TimerDrivenSchedulingAgent& timeSch
 }
 
 void ProcessGroup::startProcessing(TimerDrivenSchedulingAgent& timeScheduler, EventDrivenSchedulingAgent& eventScheduler,
-                                   CronDrivenSchedulingAgent& cronScheduler) {
+                                   CronDrivenSchedulingAgent& cronScheduler, const std::function<bool(const Processor*)>& filter) {
   try {
     // All processors are marked as failed.
     {
       std::lock_guard<std::recursive_mutex> lock(mutex_);
       for (auto& processor : processors_) {
+        if (filter && !filter(processor.get())) {
+          continue;
+        }
         failed_processors_.insert(processor.get());
       }
     }
@@ -202,7 +220,7 @@ void ProcessGroup::startProcessing(TimerDrivenSchedulingAgent& timeScheduler, Ev
 
     // Start processing the group
     for (auto& processGroup : child_process_groups_) {
-      processGroup->startProcessing(timeScheduler, eventScheduler, cronScheduler);
+      processGroup->startProcessing(timeScheduler, eventScheduler, cronScheduler, filter);
     }
   } catch (std::exception &exception) {
     logger_->log_debug("Caught Exception {}", exception.what());
@@ -316,6 +334,26 @@ void ProcessGroup::getAllProcessors(std::vector<Processor*>& processor_vec) cons
   }
 }
 
+std::vector<Processor*> ProcessGroup::getProcessors() const {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  std::vector<Processor*> processors;
+  processors.reserve(processors_.size());
+  for (const auto& processor : processors_) {
+    processors.push_back(processor.get());
+  }
+  return processors;
+}
+
+std::vector<Connection*> ProcessGroup::getConnections() const {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  std::vector<Connection*> connections;
+  connections.reserve(connections_.size());
+  for (const auto& connection : connections_) {
+    connections.push_back(connection.get());
+  }
+  return connections;
+}
+
 void ProcessGroup::updatePropertyValue(const std::string& processorName, const std::string& propertyName, const std::string& propertyValue) {
   std::lock_guard<std::recursive_mutex> lock(mutex_);
   for (auto& processor : processors_) {
@@ -454,6 +492,17 @@ void ProcessGroup::addConnection(std::unique_ptr<Connection> connection) {
   }
 }
 
+std::unique_ptr<Connection> ProcessGroup::removeConnection(const Connection* connection) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  const auto it = ranges::find_if(connections_, [connection](const auto& owned_connection) { return owned_connection.get() == connection; });
+  if (it == connections_.end()) {
+    return nullptr;
+  }
+  auto removed_connection = std::move(connections_.extract(it).value());
+  logger_->log_debug("Remove connection {} from process group {}", removed_connection->getName(), name_);
+  return removed_connection;
+}
+
 void ProcessGroup::drainConnections() {
   for (auto&& connection : connections_) {
     connection->drain(false);
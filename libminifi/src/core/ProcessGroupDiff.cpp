@@ -0,0 +1,370 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "core/ProcessGroupDiff.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Connection.h"
+#include "Port.h"
+#include "core/logging/LoggerFactory.h"
+#include "minifi-cpp/core/controller/ControllerServiceNode.h"
+
+namespace org::apache::nifi::minifi::core {
+
+namespace {
+
+template<typename Component, typename Group>
+struct ComponentInGroup {
+  Component* component;
+  Group* group;
+};
+
+// ProcessGroup or const ProcessGroup, only the root of the traversal is const, the child groups are reachable as mutable
+template<typename Group>
+struct FlowComponents {
+  std::unordered_map<utils::Identifier, Group*> groups;
+  std::unordered_map<utils::Identifier, ComponentInGroup<Processor, Group>> processors;
+  std::unordered_map<utils::Identifier, ComponentInGroup<Connection, Group>> connections;
+};
+
+template<typename Group>
+void collectComponents(Group& group, FlowComponents<Group>& components) {
+  components.groups.emplace(group.getUUID(), &group);
+  for (auto* processor : group.getProcessors()) {
+    components.processors.emplace(processor->getUUID(), ComponentInGroup<Processor, Group>{processor, &group});
+  }
+  for (auto* connection : group.getConnections()) {
+    components.connections.emplace(connection->getUUID(), ComponentInGroup<Connection, Group>{connection, &group});
+  }
+  for (const auto& child : group.getChildProcessGroups()) {
+    collectComponents<Group>(*child, components);
+  }
+}
+
+template<typename Group>
+FlowComponents<Group> collectComponents(Group& root) {
+  FlowComponents<Group> components;
+  collectComponents(root, components);
+  return components;
+}
+
+std::optional<utils::Identifier> getParentId(const ProcessGroup& group) {
+  if (const auto* parent = group.getParent()) {
+    return parent->getUUID();
+  }
+  return std::nullopt;
+}
+
+std::map<std::string, std::vector<std::string>> getPropertyValues(const ConfigurableComponent& component) {
+  std::map<std::string, std::vector<std::string>> values;
+  for (const auto& [name, property] : component.getSupportedProperties()) {
+    values.emplace(name, component.getAllPropertyValues(name).value_or(std::vector<std::string>{}));
+  }
+  return values;
+}
+
+std::map<std::string, std::vector<std::string>> getDynamicPropertyValues(const ConfigurableComponent& component) {
+  std::map<std::string, std::vector<std::string>> values;
+  for (const auto& name : component.getDynamicPropertyKeys()) {
+    values.emplace(name, component.getAllDynamicPropertyValues(name).value_or(std::vector<std::string>{}));
+  }
+  return values;
+}
+
+bool haveSameProperties(const ConfigurableComponent& lhs, const ConfigurableComponent& rhs) {
+  return getPropertyValues(lhs) == getPropertyValues(rhs) && getDynamicPropertyValues(lhs) == getDynamicPropertyValues(rhs);
+}
+
+std::set<std::string> getAutoTerminatedRelationshipNames(const Processor& processor) {
+  std::set<std::string> names;
+  for (const auto& relationship : processor.getAutoTerminatedRelationships()) {
+    names.insert(relationship.getName());
+  }
+  return names;
+}
+
+bool haveSameType(const Processor& lhs, const Processor& rhs) {
+  if (lhs.getProcessorType() != rhs.getProcessorType()) {
+    return false;
+  }
+  const auto* lhs_port = dynamic_cast<const Port*>(&lhs);
+  const auto* rhs_port = dynamic_cast<const Port*>(&rhs);
+  if (!lhs_port || !rhs_port) {
+    return !lhs_port && !rhs_port;
+  }
+  return lhs_port->getPortType() == rhs_port->getPortType();
+}
+
+bool haveSameConfiguration(const Processor& lhs, const Processor& rhs) {
+  return lhs.getName() == rhs.getName()
+      && lhs.getSchedulingStrategy() == rhs.getSchedulingStrategy()
+      && lhs.getSchedulingPeriod() == rhs.getSchedulingPeriod()
+      && lhs.getCronPeriod() == rhs.getCronPeriod()
+      && lhs.getRunDurationNano() == rhs.getRunDurationNano()
+      && lhs.getYieldPeriod() == rhs.getYieldPeriod()
+      && lhs.getPenalizationPeriod() == rhs.getPenalizationPeriod()
+      && lhs.getMaxConcurrentTasks() == rhs.getMaxConcurrentTasks()
+      && lhs.getLogBulletinLevel() == rhs.getLogBulletinLevel()
+      && getAutoTerminatedRelationshipNames(lhs) == getAutoTerminatedRelationshipNames(rhs)
+      && haveSameProperties(lhs, rhs);
+}
+
+bool haveSameConfiguration(const controller::ControllerServiceNode& lhs, const controller::ControllerServiceNode& rhs) {
+  if (lhs.getName() != rhs.getName() || !haveSameProperties(lhs, rhs)) {
+    return false;
+  }
+  const auto* lhs_implementation = lhs.getControllerServiceImplementation();
+  const auto* rhs_implementation = rhs.getControllerServiceImplementation();
+  if (!lhs_implementation || !rhs_implementation) {
+    return !lhs_implementation && !rhs_implementation;
+  }
+  return typeid(*lhs_implementation) == typeid(*rhs_implementation) && haveSameProperties(*lhs_implementation, *rhs_implementation);
+}
+
+bool haveSameControllerServices(const ProcessGroup& lhs, const ProcessGroup& rhs) {
+  // the services are registered both by their id and their name
+  const auto get_services = [](const ProcessGroup& group) {
+    std::unordered_map<utils::Identifier, const controller::ControllerServiceNode*> services;
+    for (const auto* service : group.getAllControllerServices()) {
+      services.emplace(service->getUUID(), service);
+    }
+    return services;
+  };
+  const auto lhs_services = get_services(lhs);
+  const auto rhs_services = get_services(rhs);
+  return lhs_services.size() == rhs_services.size() && std::ranges::all_of(lhs_services, [&](const auto& id_and_service) {
+    const auto rhs_service = rhs_services.find(id_and_service.first);
+    return rhs_service != rhs_services.end() && haveSameConfiguration(*id_and_service.second, *rhs_service->second);
+  });
+}
+
+bool haveSameEndpoints(const Connection& lhs, const Connection& rhs) {
+  return lhs.getSourceUUID() == rhs.getSourceUUID()
+      && lhs.getDestinationUUID() == rhs.getDestinationUUID()
+      && lhs.getRelationships() == rhs.getRelationships();
+}
+
+bool haveSameSettings(const Connection& lhs, const Connection& rhs) {
+  return lhs.getName() == rhs.getName()
+      && lhs.getBackpressureThresholdCount() == rhs.getBackpressureThresholdCount()
+      && lhs.getBackpressureThresholdDataSize() == rhs.getBackpressureThresholdDataSize()
+      && lhs.getFlowExpirationDuration() == rhs.getFlowExpirationDuration()
+      && lhs.getDropEmptyFlowFiles() == rhs.getDropEmptyFlowFiles();
+}
+
+void detachConnection(Connection& connection) {
+  for (auto* endpoint : {connection.getSource(), connection.getDestination()}) {
+    if (auto* processor = dynamic_cast<Processor*>(endpoint)) {
+      processor->removeConnection(&connection);
+    }
+  }
+}
+
+void reconfigure(Processor& processor, const Processor& configuration) {
+  processor.setName(configuration.getName());
+  processor.setSchedulingStrategy(configuration.getSchedulingStrategy());
+  processor.setSchedulingPeriod(configuration.getSchedulingPeriod());
+  processor.setCronPeriod(configuration.getCronPeriod());
+  processor.setRunDurationNano(configuration.getRunDurationNano());
+  processor.setYieldPeriodMsec(std::chrono::duration_cast<std::chrono::milliseconds>(configuration.getYieldPeriod()));
+  processor.setPenalizationPeriod(configuration.getPenalizationPeriod());
+  processor.setMaxConcurrentTasks(configuration.getMaxConcurrentTasks());
+  processor.setLogBulletinLevel(configuration.getLogBulletinLevel());
+  const auto auto_terminated_relationships = configuration.getAutoTerminatedRelationships();
+  processor.setAutoTerminatedRelationships(auto_terminated_relationships);
+  processor.copyPropertiesFrom(configuration);
+}
+
+}  // namespace
+
+std::optional<ProcessGroupDiff> ProcessGroupDiff::compare(const ProcessGroup& current, const ProcessGroup& updated) {
+  const auto logger = logging::LoggerFactory<ProcessGroupDiff>::getLogger();
+  const auto current_components = collectComponents(current);
+  const auto updated_components = collectComponents(updated);
+
+  if (current_components.groups.size() != updated_components.groups.size()) {
+    logger->log_debug("The number of process groups differs");
+    return std::nullopt;
+  }
+  for (const auto& [id, current_group] : current_components.groups) {
+    const auto updated_group = updated_components.groups.find(id);
+    if (updated_group == updated_components.groups.end()) {
+      logger->log_debug("Process group {} is not present in the updated flow", id.to_string());
+      return std::nullopt;
+    }
+    // the settings of the remote process groups are stored in the implementation of their ports, which cannot be compared
+    if (current_group->isRemoteProcessGroup() || updated_group->second->isRemoteProcessGroup()) {
+      logger->log_debug("Process group {} is a remote process group", id.to_string());
+      return std::nullopt;
+    }
+    if (current_group->getName() != updated_group->second->getName() || getParentId(*current_group) != getParentId(*updated_group->second)) {
+      logger->log_debug("The name or the parent of process group {} differs", id.to_string());
+      return std::nullopt;
+    }
+    if (!haveSameControllerServices(*current_group, *updated_group->second)) {
+      logger->log_debug("The controller services of process group {} differ", id.to_string());
+      return std::nullopt;
+    }
+  }
+
+  ProcessGroupDiff diff;
+  for (const auto& [id, current_processor] : current_components.processors) {
+    const auto updated_processor = updated_components.processors.find(id);
+    if (updated_processor == updated_components.processors.end()) {
+      diff.removed_processors.insert(id);
+      continue;
+    }
+    if (current_processor.group->getUUID() != updated_processor->second.group->getUUID()
+        || !haveSameType(*current_processor.component, *updated_processor->second.component)) {
+      logger->log_debug("The type or the process group of processor {} differs", id.to_string());
+      return std::nullopt;
+    }
+    if (!haveSameConfiguration(*current_processor.component, *updated_processor->second.component)) {
+      diff.changed_processors.insert(id);
+    }
+  }
+  for (const auto& [id, updated_processor] : updated_components.processors) {
+    if (!current_components.processors.contains(id)) {
+      diff.added_processors.insert(id);
+    }
+  }
+
+  const auto mark_endpoints_changed = [&](const Connection& connection) {
+    for (const auto& endpoint : {connection.getSourceUUID(), connection.getDestinationUUID()}) {
+      if (current_components.processors.contains(endpoint) && !diff.removed_processors.contains(endpoint)) {
+        diff.changed_processors.insert(endpoint);
+      }
+    }
+  };
+  // a retained connection stays wired to the processor instances of the running flow, so those must be retained as well
+  const auto is_retained_endpoint = [&](const utils::Identifier& endpoint) {
+    return current_components.processors.contains(endpoint) == updated_components.processors.contains(endpoint);
+  };
+  for (const auto& [id, current_connection] : current_components.connections) {
+    const auto updated_connection = updated_components.connections.find(id);
+    if (updated_connection == updated_components.connections.end()) {
+      diff.removed_connections.insert(id);
+      mark_endpoints_changed(*current_connection.component);
+      continue;
+    }
+    const auto& current_settings = *current_connection.component;
+    const auto& updated_settings = *updated_connection->second.component;
+    if (current_connection.group->getUUID() != updated_connection->second.group->getUUID() || !haveSameEndpoints(current_settings, updated_settings)
+        || !is_retained_endpoint(current_settings.getSourceUUID()) || !is_retained_endpoint(current_settings.getDestinationUUID())) {
+      logger->log_debug("The endpoints or the process group of connection {} differ", id.to_string());
+      return std::nullopt;
+    }
+    if (!haveSameSettings(current_settings, updated_settings)) {
+      diff.changed_connections.insert(id);
+      mark_endpoints_changed(current_settings);
+    }
+  }
+  for (const auto& [id, updated_connection] : updated_components.connections) {
+    if (!current_components.connections.contains(id)) {
+      diff.added_connections.insert(id);
+      mark_endpoints_changed(*updated_connection.component);
+    }
+  }
+
+  return diff;
+}
+
+bool ProcessGroupDiff::empty() const {
+  return changed_processors.empty() && added_processors.empty() && removed_processors.empty()
+      && changed_connections.empty() && added_connections.empty() && removed_connections.empty();
+}
+
+bool ProcessGroupDiff::needsStopping(const Processor& processor) const {
+  const auto id = processor.getUUID();
+  return changed_processors.contains(id) || removed_processors.contains(id);
+}
+
+bool ProcessGroupDiff::needsStarting(const Processor& processor) const {
+  const auto id = processor.getUUID();
+  return changed_processors.contains(id) || added_processors.contains(id);
+}
+
+void ProcessGroupDiff::apply(ProcessGroup& current, ProcessGroup& updated) const {
+  const auto current_components = collectComponents(current);
+  const auto updated_components = collectComponents(updated);
+
+  // the processors moved into the running flow must not reference the connections of the updated flow
+  for (const auto& [id, updated_connection] : updated_components.connections) {
+    detachConnection(*updated_connection.component);
+  }
+
+  for (const auto& id : removed_connections) {
+    const auto& [connection, group] = current_components.connections.at(id);
+    detachConnection(*connection);
+    connection->drain(true);
+    group->removeConnection(connection);
+  }
+
+  for (const auto& id : removed_processors) {
+    const auto& [processor, group] = current_components.processors.at(id);
+    group->removeProcessor(processor);
+  }
+
+  for (const auto& id : changed_processors) {
+    reconfigure(*current_components.processors.at(id).component, *updated_components.processors.at(id).component);
+  }
+
+  for (const auto& id : added_processors) {
+    const auto& [processor, updated_group] = updated_components.processors.at(id);
+    auto* current_group = current_components.groups.at(updated_group->getUUID());
+    auto added_processor = updated_group->removeProcessor(processor);
+    if (dynamic_cast<Port*>(added_processor.get())) {
+      current_group->addPort(std::unique_ptr<Port>(static_cast<Port*>(added_processor.release())));
+    } else {
+      current_group->addProcessor(std::move(added_processor));
+    }
+  }
+
+  // added after the processors, so that the process group can wire them to both of their endpoints
+  for (const auto& id : added_connections) {
+    const auto& [connection, updated_group] = updated_components.connections.at(id);
+    current_components.groups.at(updated_group->getUUID())->addConnection(updated_group->removeConnection(connection));
+  }
+
+  for (const auto& id : changed_connections) {
+    auto& connection = *current_components.connections.at(id).component;
+    const auto& configuration = *updated_components.connections.at(id).component;
+    connection.setName(configuration.getName());
+    connection.setBackpressureThresholdCount(configuration.getBackpressureThresholdCount());
+    connection.setBackpressureThresholdDataSize(configuration.getBackpressureThresholdDataSize());
+    connection.setFlowExpirationDuration(configuration.getFlowExpirationDuration());
+    connection.setDropEmptyFlowFiles(configuration.getDropEmptyFlowFiles());
+  }
+
+  // the parameter contexts of the running flow are replaced on every update
+  for (const auto& [id, current_group] : current_components.groups) {
+    current_group->setParameterContext(updated_components.groups.at(id)->getParameterContext());
+  }
+  current.setVersion(updated.getVersion());
+}
+
+}  // namespace org::apache::nifi::minifi::core
@@ -20,6 +20,7 @@
 #include "core/ProcessSession.h"
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cinttypes>
 #include <ctime>
@@ -30,7 +31,10 @@
 #include <string>
 #include <vector>
 
+#include "core/FlowFileSerializationArena.h"
 #include "core/ProcessSessionReadCallback.h"
+#include "io/FileStream.h"
+#include "io/MemoryMappedFileStream.h"
 #include "io/StreamSlice.h"
 #include "io/StreamPipe.h"
 #include "minifi-cpp/utils/gsl.h"
@@ -60,6 +64,26 @@ int getpagesize(void) {
 
 namespace org::apache::nifi::minifi::core {
 
+namespace {
+// special attributes which are not copied from the parent to its children
+constexpr std::array<std::string_view, 3> NON_INHERITED_ATTRIBUTES{
+    SpecialFlowAttribute::ALTERNATE_IDENTIFIER, SpecialFlowAttribute::DISCARD_REASON, SpecialFlowAttribute::UUID};
+
+// Copies the source file from the offset to the content stream inside the kernel, if the content is stored in a local file
+bool copyFileInKernel(const std::string& source, uint64_t offset, io::BaseStream& content_stream) {
+  auto* content_file_stream = io::getUnderlyingFileStream(content_stream);
+  if (!content_file_stream) {
+    return false;
+  }
+  std::error_code file_size_error;
+  const auto file_size = std::filesystem::file_size(source, file_size_error);
+  if (file_size_error || file_size < offset) {
+    return false;
+  }
+  return content_file_stream->copyFrom({.path = source, .offset = offset, .size = file_size - offset}).has_value();
+}
+}  // namespace
+
 std::shared_ptr<utils::IdGenerator> ProcessSessionImpl::id_generator_ = utils::IdGenerator::getIdGenerator();
 
 ProcessSessionImpl::ProcessSessionImpl(std::shared_ptr<ProcessContext> processContext)
@@ -68,7 +92,8 @@ ProcessSessionImpl::ProcessSessionImpl(std::shared_ptr<ProcessContext> processCo
           stateManager_(process_context_->hasStateManager() ? process_context_->getStateManager() : nullptr) {
   logger_->log_trace("ProcessSession created for {}", process_context_->getProcessor().getName());
   auto repo = process_context_->getProvenanceRepository();
-  provenance_report_ = std::make_shared<provenance::ProvenanceReporterImpl>(repo, process_context_->getProcessor().getName(), process_context_->getProcessor().getName());
+  provenance_report_ = std::make_shared<provenance::ProvenanceReporterImpl>(repo, process_context_->getProcessor().getName(), process_context_->getProcessor().getName(),
+      process_context_->getProcessor().getProvenanceSamplingRatio());
   content_session_ = process_context_->getContentRepository()->createSession();
 
   if (stateManager_ && !stateManager_->beginTransaction()) {
@@ -101,13 +126,7 @@ std::shared_ptr<core::FlowFile> ProcessSessionImpl::create(const core::FlowFile*
   }
 
   if (parent) {
-    for (const auto& attribute : parent->getAttributes()) {
-      if (attribute.first == SpecialFlowAttribute::ALTERNATE_IDENTIFIER || attribute.first == SpecialFlowAttribute::DISCARD_REASON || attribute.first == SpecialFlowAttribute::UUID) {
-        // Do not copy special attributes from parent
-        continue;
-      }
-      record->setAttribute(attribute.first, attribute.second);
-    }
+    record->inheritAttributes(*parent, NON_INHERITED_ATTRIBUTES);
     record->setLineageStartDate(parent->getlineageStartDate());
     record->setLineageIdentifiers(parent->getlineageIdentifiers());
     record->getlineageIdentifiers().push_back(parent->getUUID());
@@ -116,9 +135,9 @@ std::shared_ptr<core::FlowFile> ProcessSessionImpl::create(const core::FlowFile*
   utils::Identifier uuid = record->getUUID();
   added_flowfiles_[uuid].flow_file = record;
   logger_->log_debug("Create FlowFile with UUID {}", record->getUUIDStr());
-  std::stringstream details;
-  details << process_context_->getProcessor().getName() << " creates flow record " << record->getUUIDStr();
-  provenance_report_->create(*record, details.str());
+  provenance_report_->create(*record, [&] {
+    return fmt::format("{} creates flow record {}", process_context_->getProcessor().getName(), record->getUUIDStr());
+  });
 
   return record;
 }
@@ -148,16 +167,7 @@ std::shared_ptr<core::FlowFile> ProcessSessionImpl::cloneDuringTransfer(const co
   }
   this->cloned_flowfiles_.push_back(record);
   logger_->log_debug("Clone FlowFile with UUID {} during transfer", record->getUUIDStr());
-  // Copy attributes
-  for (const auto& attribute : parent.getAttributes()) {
-    if (attribute.first == SpecialFlowAttribute::ALTERNATE_IDENTIFIER
-        || attribute.first == SpecialFlowAttribute::DISCARD_REASON
-        || attribute.first == SpecialFlowAttribute::UUID) {
-      // Do not copy special attributes from parent
-      continue;
-    }
-    record->setAttribute(attribute.first, attribute.second);
-  }
+  record->inheritAttributes(parent, NON_INHERITED_ATTRIBUTES);
   record->setLineageStartDate(parent.getlineageStartDate());
   record->setLineageIdentifiers(parent.getlineageIdentifiers());
   record->getlineageIdentifiers().push_back(parent.getUUID());
@@ -183,13 +193,12 @@ std::shared_ptr<core::FlowFile> ProcessSessionImpl::clone(const FlowFile& parent
   std::shared_ptr<core::FlowFile> record = this->create(&parent);
   if (record) {
     logger_->log_debug("Cloned parent flow files {} to {}, with {}:{}", parent.getUUIDStr(), record->getUUIDStr(), offset, size);
-    if (parent.getResourceClaim()) {
-      write(record, [&] (const std::shared_ptr<io::OutputStream>& output) -> int64_t {
-        return read(parent, [&] (const std::shared_ptr<io::InputStream>& input) -> int64_t {
-          io::StreamSlice slice(input, offset, size);
-          return minifi::internal::pipe(slice, *output);
-        });
-      });
+    // The clone references its range of the parent's claim instead of copying it, the claim is owned
+    // by every persisted flow file referencing it, the same way as for a full clone
+    if (std::shared_ptr<ResourceClaim> parent_claim = parent.getResourceClaim()) {
+      record->setResourceClaim(parent_claim);
+      record->setOffset(parent.getOffset() + gsl::narrow<uint64_t>(offset));
+      record->setSize(gsl::narrow<uint64_t>(size));
     }
     provenance_report_->clone(parent, *record);
   }
@@ -206,14 +215,23 @@ void ProcessSessionImpl::remove(const std::shared_ptr<core::FlowFile> &flow) {
 
 void ProcessSessionImpl::putAttribute(core::FlowFile& flow_file, std::string_view key, const std::string& value) {
   flow_file.setAttribute(key, value);
-  std::string details = fmt::format("{} modify flow record {} attribute {}:{}", process_context_->getProcessor().getName(), flow_file.getUUIDStr(), key, value);
-  provenance_report_->modifyAttributes(flow_file, details);
+  provenance_report_->modifyAttributes(flow_file, [&] {
+    return fmt::format("{} modify flow record {} attribute {}:{}", process_context_->getProcessor().getName(), flow_file.getUUIDStr(), key, value);
+  });
 }
 
 void ProcessSessionImpl::removeAttribute(core::FlowFile& flow_file, std::string_view key) {
   flow_file.removeAttribute(key);
-  std::string details = fmt::format("{} remove flow record {} attribute {}", process_context_->getProcessor().getName(), flow_file.getUUIDStr(), key);
-  provenance_report_->modifyAttributes(flow_file, details);
+  provenance_report_->modifyAttributes(flow_file, [&] {
+    return fmt::format("{} remove flow record {} attribute {}", process_context_->getProcessor().getName(), flow_file.getUUIDStr(), key);
+  });
+}
+
+void ProcessSessionImpl::reportContentModified(const core::FlowFile& flow_file, std::chrono::steady_clock::time_point start_time) {
+  auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
+  provenance_report_->modifyContent(flow_file, [&] {
+    return fmt::format("{} modify flow record content {}", process_context_->getProcessor().getName(), flow_file.getUUIDStr());
+  }, duration);
 }
 
 void ProcessSessionImpl::penalize(const std::shared_ptr<core::FlowFile> &flow) {
@@ -247,11 +265,10 @@ void ProcessSessionImpl::write(core::FlowFile &flow, const io::OutputStreamCallb
       || added_flowfiles_.contains(flow.getUUID())
       || std::any_of(cloned_flowfiles_.begin(), cloned_flowfiles_.end(), [&flow](const auto& flow_file) { return &flow == flow_file.get(); }));
 
-  std::shared_ptr<ResourceClaim> claim = content_session_->create();
-
   try {
     auto start_time = std::chrono::steady_clock::now();
-    std::shared_ptr<io::BaseStream> stream = content_session_->write(claim);
+    // the content may be packed into a claim shared with other flow files of the session
+    auto [claim, offset, stream] = content_session_->writeNewContent();
     // Call the callback to write the content
     if (nullptr == stream) {
       throw Exception(FILE_OPERATION_EXCEPTION, "Failed to open flowfile content for write");
@@ -261,13 +278,11 @@ void ProcessSessionImpl::write(core::FlowFile &flow, const io::OutputStreamCallb
     }
 
     flow.setSize(stream->size());
-    flow.setOffset(0);
+    flow.setOffset(offset);
     flow.setResourceClaim(claim);
 
     stream->close();
-    std::string details = process_context_->getProcessor().getName() + " modify flow record content " + flow.getUUIDStr();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
-    provenance_report_->modifyContent(flow, details, duration);
+    reportContentModified(flow, start_time);
     if (metrics_) {
       metrics_->bytesWritten() += stream->size();
     }
@@ -325,10 +340,7 @@ void ProcessSessionImpl::append(const std::shared_ptr<core::FlowFile> &flow, con
       metrics_->bytesWritten() += stream->size() - stream_size_before_callback;
     }
 
-    std::stringstream details;
-    details << process_context_->getProcessor().getName() << " modify flow record content " << flow->getUUIDStr();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
-    provenance_report_->modifyContent(*flow, details.str(), duration);
+    reportContentModified(*flow, start_time);
   } catch (const std::exception& exception) {
     logger_->log_debug("Caught Exception during process session append, type: {}, what: {}", typeid(exception).name(), exception.what());
     throw;
@@ -407,11 +419,12 @@ int64_t ProcessSessionImpl::readWrite(const std::shared_ptr<core::FlowFile> &flo
     }
 
     std::shared_ptr<ResourceClaim> input_claim = flow->getResourceClaim();
-    std::shared_ptr<io::BaseStream> input_stream = content_session_->read(input_claim);
-    if (!input_stream) {
+    std::shared_ptr<io::BaseStream> claim_stream = content_session_->read(input_claim);
+    if (!claim_stream) {
       throw Exception(FILE_OPERATION_EXCEPTION, "Failed to open flowfile content for read");
     }
-    input_stream->seek(flow->getOffset());
+    // the claim can contain the content of other flow files after this one
+    auto input_stream = std::make_shared<io::StreamSlice>(claim_stream, flow->getOffset(), flow->getSize());
 
     std::shared_ptr<ResourceClaim> output_claim = content_session_->create();
     std::shared_ptr<io::BaseStream> output_stream = content_session_->write(output_claim);
@@ -459,6 +472,42 @@ detail::ReadBufferResult ProcessSessionImpl::readBuffer(const std::shared_ptr<co
   return result;
 }
 
+int64_t ProcessSessionImpl::readInPlace(const core::FlowFile& flow_file, const io::InputBufferCallback& callback) {
+  try {
+    auto flow_file_stream = getFlowFileContentStream(flow_file);
+    if (!flow_file_stream) {
+      return callback({});
+    }
+
+    std::vector<std::byte> buffer;
+    auto content = io::getContiguousBuffer(*flow_file_stream);
+    if (!content) {
+      buffer.resize(flow_file_stream->size());
+      const auto read_status = flow_file_stream->read(buffer);
+      if (read_status != buffer.size()) {
+        logger_->log_error("readInPlace: {} bytes were requested from the stream but {} bytes were read. Rolling back.", buffer.size(), read_status);
+        throw Exception(PROCESSOR_EXCEPTION, "Failed to read the entire FlowFile.");
+      }
+      content = buffer;
+    }
+
+    auto ret = callback(*content);
+    if (ret < 0) {
+      throw Exception(FILE_OPERATION_EXCEPTION, "Failed to process flowfile content");
+    }
+    if (metrics_) {
+      metrics_->bytesRead() += ret;
+    }
+    return ret;
+  } catch (const std::exception& exception) {
+    logger_->log_debug("Caught Exception {}", exception.what());
+    throw;
+  } catch (...) {
+    logger_->log_debug("Caught Exception during process session readInPlace");
+    throw;
+  }
+}
+
 void ProcessSessionImpl::importFrom(io::InputStream&& stream, const std::shared_ptr<core::FlowFile> &flow) {  // NOLINT(cppcoreguidelines-rvalue-reference-param-not-moved)
   importFrom(stream, flow);
 }
@@ -503,10 +552,7 @@ void ProcessSessionImpl::importFrom(io::InputStream &stream, const std::shared_p
     if (metrics_) {
       metrics_->bytesWritten() += content_stream->size();
     }
-    std::stringstream details;
-    details << process_context_->getProcessor().getName() << " modify flow record content " << flow->getUUIDStr();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
-    provenance_report_->modifyContent(*flow, details.str(), duration);
+    reportContentModified(*flow, start_time);
   } catch (const std::exception& exception) {
     logger_->log_debug("Caught Exception during ProcessSession::importFrom, type: {}, what: {}", typeid(exception).name(), exception.what());
     throw;
@@ -540,7 +586,8 @@ void ProcessSessionImpl::import(const std::string& source, const std::shared_ptr
           invalidWrite = true;
         }
       }
-      while (input.good()) {
+      const bool copied_in_kernel = !invalidWrite && copyFileInKernel(source, offset, *stream);
+      while (!copied_in_kernel && input.good()) {
         input.read(reinterpret_cast<char*>(charBuffer.data()), gsl::narrow<std::streamsize>(size));
         if (input) {
           if (io::isError(stream->write(charBuffer.data(), size))) {
@@ -571,10 +618,7 @@ void ProcessSessionImpl::import(const std::string& source, const std::shared_ptr
         if (!keepSource) {
           (void)std::remove(source.c_str());
         }
-        std::stringstream details;
-        details << process_context_->getProcessor().getName() << " modify flow record content " << flow->getUUIDStr();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
-        provenance_report_->modifyContent(*flow, details.str(), duration);
+        reportContentModified(*flow, start_time);
       } else {
         stream->close();
         input.close();
@@ -672,9 +716,7 @@ void ProcessSessionImpl::import(const std::string& source, std::vector<std::shar
         if (metrics_) {
           metrics_->bytesWritten() += stream->size();
         }
-        std::string details = process_context_->getProcessor().getName() + " modify flow record content " + flowFile->getUUIDStr();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
-        provenance_report_->modifyContent(*flowFile, details, duration);
+        reportContentModified(*flowFile, start_time);
         flows.push_back(flowFile);
 
         /* Reset these to start processing the next FlowFile with a clean slate */
@@ -955,7 +997,7 @@ void ProcessSessionImpl::commit() {
     logger_->log_debug("ProcessSession committed for {}", process_context_->getProcessor().getName());
     if (metrics_) {
       auto time_delta = std::chrono::steady_clock::now() - commit_start_time;
-      metrics_->addLastSessionCommitRuntime(std::chrono::duration_cast<std::chrono::milliseconds>(time_delta));
+      metrics_->addLastSessionCommitRuntime(time_delta);
       metrics_->processingNanos() += std::chrono::duration_cast<std::chrono::nanoseconds>(time_delta).count();
     }
   } catch (const std::exception& exception) {
@@ -1047,7 +1089,10 @@ void ProcessSessionImpl::persistFlowFilesBeforeTransfer(
     return;
   }
 
-  std::vector<std::pair<std::string, std::unique_ptr<io::BufferStream>>> flowData;
+  // sessions are short-lived, so the serialization buffers are kept per thread to be reused by the next commit
+  thread_local FlowFileSerializationArena arena;
+  arena.clear();
+  const auto clear_arena = gsl::finally([] { arena.clear(); });
 
   enum class Type {
     Dropped, Transferred
@@ -1076,10 +1121,9 @@ void ProcessSessionImpl::persistFlowFilesBeforeTransfer(
 
   // collect serialized flowfiles
   forEachFlowFile(Type::Transferred, [&] (auto& ff, auto& /*original*/) {
-    auto stream = std::make_unique<io::BufferStream>();
-    std::dynamic_pointer_cast<FlowFileRecord>(ff)->Serialize(*stream);
-
-    flowData.emplace_back(ff->getUUIDStr(), std::move(stream));
+    auto record = dynamic_cast<FlowFileRecord*>(ff.get());
+    gsl_Assert(record);
+    arena.add(*record);
   });
 
   // increment on behalf of the to be persisted instance
@@ -1088,7 +1132,7 @@ void ProcessSessionImpl::persistFlowFilesBeforeTransfer(
       claim->increaseFlowFileRecordOwnedCount();
   });
 
-  if (!flowFileRepo->MultiPut(flowData)) {
+  if (!flowFileRepo->MultiPut(arena.entries())) {
     logger_->log_error("Failed execute multiput on FF repo!");
     // decrement on behalf of the failed persisted instance
     forEachFlowFile(Type::Transferred, [&] (auto& ff, auto& /*original*/) {
@@ -1154,9 +1198,9 @@ std::shared_ptr<core::FlowFile> ProcessSessionImpl::get() {
     if (!expired.empty()) {
       // Remove expired flow record
       for (const auto& record : expired) {
-        std::stringstream details;
-        details << process_context_->getProcessor().getName() << " expire flow record " << record->getUUIDStr();
-        provenance_report_->expire(*record, details.str());
+        provenance_report_->expire(*record, [&] {
+          return fmt::format("{} expire flow record {}", process_context_->getProcessor().getName(), record->getUUIDStr());
+        });
         // there is no rolling back expired FlowFiles
         if (record->isStored() && process_context_->getFlowFileRepository()->Delete(record->getUUIDStr())) {
           record->setStoredToRepository(false);
@@ -25,6 +25,7 @@
 #include <utility>
 
 #include "core/logging/LoggerConfiguration.h"
+#include "io/FileStream.h"
 #include "minifi-cpp/utils/gsl.h"
 
 namespace org::apache::nifi::minifi::core {
@@ -42,6 +43,12 @@ ProcessSessionReadCallback::ProcessSessionReadCallback(std::filesystem::path tem
 int64_t ProcessSessionReadCallback::operator()(const std::shared_ptr<io::InputStream>& stream) {
   // Copy file contents into tmp file
   write_succeeded_ = false;
+  if (tmp_file_os_.is_open()) {
+    if (const auto copied = io::copyToFileInKernel(*stream, tmp_file_, 0)) {
+      write_succeeded_ = true;
+      return gsl::narrow<int64_t>(*copied);
+    }
+  }
   size_t size = 0;
   std::array<std::byte, 8192> buffer{};
   do {
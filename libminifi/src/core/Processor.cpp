@@ -22,9 +22,12 @@
 #include <ctime>
 #include <cctype>
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "minifi-cpp/Connection.h"
@@ -36,6 +39,8 @@
 #include "minifi-cpp/core/ProcessorDescriptor.h"
 #include "minifi-cpp/core/ProcessSessionFactory.h"
 #include "minifi-cpp/utils/gsl.h"
+#include "minifi-cpp/properties/Configure.h"
+#include "utils/ParsingUtils.h"
 #include "core/ProcessSession.h"
 #include "range/v3/algorithm/any_of.hpp"
 #include "fmt/format.h"
@@ -175,6 +180,35 @@ bool Processor::addConnection(Connectable* conn) {
   return result != SetAs::NONE;
 }
 
+bool Processor::removeConnection(Connectable* conn) {
+  if (isRunning()) {
+    logger_->log_warn("Can not remove connection while the process {} is running", name_);
+    return false;
+  }
+  const auto connection = dynamic_cast<Connection*>(conn);
+  if (!connection) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(getGraphMutex());
+  bool removed = false;
+  if (incoming_connections_.erase(connection) > 0) {
+    logger_->log_debug("Remove connection {} from Processor {} incoming connection", connection->getName(), name_);
+    incoming_connections_Iter = incoming_connections_.begin();
+    removed = true;
+  }
+  for (auto it = outgoing_connections_.begin(); it != outgoing_connections_.end();) {
+    if (it->second.erase(connection) > 0) {
+      logger_->log_debug("Remove connection {} from Processor {} outgoing connection for relationship {}", connection->getName(), name_, it->first);
+      removed = true;
+    }
+    it = it->second.empty() ? outgoing_connections_.erase(it) : std::next(it);
+  }
+  // the reachability of the upstream processors is not narrowed, at worst they keep treating a removed cycle as present
+  reachable_processors_.erase(connection);
+  return removed;
+}
+
 void Processor::triggerAndCommit(const std::shared_ptr<ProcessContext>& context, const std::shared_ptr<ProcessSessionFactory>& session_factory) {
   const auto process_session = std::dynamic_pointer_cast<core::ProcessSessionImpl>(session_factory->createSession());
   gsl_Assert(process_session);
@@ -198,7 +232,7 @@ void Processor::trigger(const std::shared_ptr<ProcessContext>& context, const st
   ++metrics_->invocations();
   const auto start = std::chrono::steady_clock::now();
   onTrigger(*context, *process_session);
-  metrics_->addLastOnTriggerRuntime(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start));
+  metrics_->addLastOnTriggerRuntime(std::chrono::steady_clock::now() - start);
 }
 
 bool Processor::isWorkAvailable() {
@@ -226,6 +260,36 @@ bool Processor::isWorkAvailable() {
   return hasWork || impl_->isWorkAvailable();
 }
 
+std::optional<std::chrono::steady_clock::time_point> Processor::getNextPenaltyExpiration() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::optional<std::chrono::steady_clock::time_point> next_penalty_expiration;
+  for (const auto &conn : incoming_connections_) {
+    auto connection = dynamic_cast<Connection*>(conn);
+    if (!connection) {
+      continue;
+    }
+    if (const auto penalty_expiration = connection->getNextPenaltyExpiration()) {
+      next_penalty_expiration = next_penalty_expiration ? std::min(*next_penalty_expiration, *penalty_expiration) : *penalty_expiration;
+    }
+  }
+  return next_penalty_expiration;
+}
+
+void Processor::notifyWork() {
+  if (strategy_ != EVENT_DRIVEN) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(work_notifier_mutex_);
+  if (work_notifier_) {
+    work_notifier_();
+  }
+}
+
+void Processor::setWorkNotifier(std::function<void()> work_notifier) {
+  std::lock_guard<std::mutex> lock(work_notifier_mutex_);
+  work_notifier_ = std::move(work_notifier);
+}
+
 // must hold the graphMutex
 void Processor::updateReachability(const std::lock_guard<std::mutex>& graph_lock, bool force) {
   bool didChange = force;
@@ -520,9 +584,31 @@ void Processor::onTrigger(ProcessContext& context, ProcessSession& session) {
 }
 
 void Processor::onSchedule(ProcessContext& context, ProcessSessionFactory& session_factory) {
+  provenance_sampling_ratio_ = resolveProvenanceSamplingRatio(context);
   impl_->onSchedule(context, session_factory);
 }
 
+double Processor::resolveProvenanceSamplingRatio(ProcessContext& context) const {
+  const auto configuration = context.getConfiguration();
+  const auto processor_property = fmt::format("{}.{}", Configuration::nifi_provenance_repository_sampling_ratio, getName());
+  for (const auto& property_name : {processor_property, std::string{Configuration::nifi_provenance_repository_sampling_ratio}}) {
+    const auto value = configuration->get(property_name);
+    if (!value) {
+      continue;
+    }
+    if (const auto ratio = parsing::parseFloat(*value); ratio && *ratio >= 0.0F && *ratio <= 1.0F) {
+      return *ratio;
+    }
+    logger_->log_warn("Invalid provenance sampling ratio \"{}\" in {}, it must be between 0 and 1, recording every provenance event", *value, property_name);
+    return 1.0;
+  }
+  return 1.0;
+}
+
+double Processor::getProvenanceSamplingRatio() const {
+  return provenance_sampling_ratio_;
+}
+
 // Hook executed when onSchedule fails (throws). Configuration should be reset in this
 void Processor::onUnSchedule() {
   impl_->onUnSchedule();
@@ -18,6 +18,7 @@
 
 #include "core/Processor.h"
 #include "core/state/Value.h"
+#include "fmt/format.h"
 #include "minifi-cpp/utils/gsl.h"
 #include "range/v3/numeric/accumulate.hpp"
 
@@ -60,6 +61,13 @@ std::vector<state::response::SerializedResponseNode> ProcessorMetrics::serialize
     }
   };
 
+  for (const auto& percentile : state::response::PUBLISHED_LATENCY_PERCENTILES) {
+    root_node.children.push_back({.name = fmt::format("OnTriggerRunTimeNanos{}", percentile.suffix),
+        .value = static_cast<uint64_t>(on_trigger_runtime_histogram_.percentile(percentile.ratio).count())});
+    root_node.children.push_back({.name = fmt::format("SessionCommitRunTimeNanos{}", percentile.suffix),
+        .value = static_cast<uint64_t>(session_commit_runtime_histogram_.percentile(percentile.ratio).count())});
+  }
+
   {
     std::lock_guard<std::mutex> lock(transferred_relationships_mutex_);
     for (const auto& [relationship, count] : transferred_relationships_) {
@@ -99,6 +107,13 @@ std::vector<state::PublishedMetric> ProcessorMetrics::calculateMetrics() {
     {"processing_nanos", static_cast<double>(processingNanos()), getCommonLabels()}
   };
 
+  for (const auto& percentile : state::response::PUBLISHED_LATENCY_PERCENTILES) {
+    auto labels = getCommonLabels();
+    labels.emplace("quantile", percentile.quantile);
+    metrics.push_back({"onTrigger_runtime_nanoseconds", static_cast<double>(on_trigger_runtime_histogram_.percentile(percentile.ratio).count()), labels});
+    metrics.push_back({"session_commit_runtime_nanoseconds", static_cast<double>(session_commit_runtime_histogram_.percentile(percentile.ratio).count()), std::move(labels)});
+  }
+
   {
     std::lock_guard<std::mutex> lock(transferred_relationships_mutex_);
     for (const auto& [relationship, count] : transferred_relationships_) {
@@ -127,8 +142,9 @@ std::chrono::milliseconds ProcessorMetrics::getAverageOnTriggerRuntime() const {
   return on_trigger_runtime_averager_.getAverage();
 }
 
-void ProcessorMetrics::addLastOnTriggerRuntime(std::chrono::milliseconds runtime) {
-  on_trigger_runtime_averager_.addValue(runtime);
+void ProcessorMetrics::addLastOnTriggerRuntime(std::chrono::nanoseconds runtime) {
+  on_trigger_runtime_averager_.addValue(std::chrono::duration_cast<std::chrono::milliseconds>(runtime));
+  on_trigger_runtime_histogram_.record(runtime);
 }
 
 std::chrono::milliseconds ProcessorMetrics::getLastOnTriggerRuntime() const {
@@ -139,8 +155,9 @@ std::chrono::milliseconds ProcessorMetrics::getAverageSessionCommitRuntime() con
   return session_commit_runtime_averager_.getAverage();
 }
 
-void ProcessorMetrics::addLastSessionCommitRuntime(std::chrono::milliseconds runtime) {
-  session_commit_runtime_averager_.addValue(runtime);
+void ProcessorMetrics::addLastSessionCommitRuntime(std::chrono::nanoseconds runtime) {
+  session_commit_runtime_averager_.addValue(std::chrono::duration_cast<std::chrono::milliseconds>(runtime));
+  session_commit_runtime_histogram_.record(runtime);
 }
 
 std::chrono::milliseconds ProcessorMetrics::getLastSessionCommitRuntime() const {
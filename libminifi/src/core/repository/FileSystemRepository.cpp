@@ -18,28 +18,89 @@
 
 #include "core/repository/FileSystemRepository.h"
 
+#include <algorithm>
+#include <cctype>
 #include <filesystem>
 #include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 
 #include "core/ForwardingContentSession.h"
+#include "fmt/format.h"
 #include "io/FileStream.h"
+#include "io/MemoryMappedFileStream.h"
+#include "minifi-cpp/utils/gsl.h"
 #include "utils/Locations.h"
+#include "utils/StringUtils.h"
+#include "utils/ParsingUtils.h"
+#include "utils/expected.h"
 #include "utils/file/FileUtils.h"
 
 namespace org::apache::nifi::minifi::core::repository {
 
+namespace {
+std::string subdirectoryName(size_t index) {
+  return fmt::format("{:02x}", index);
+}
+
+bool isSubdirectoryName(std::string_view name) {
+  return name.size() >= 2 && std::all_of(name.begin(), name.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)) || (c >= 'a' && c <= 'f'); });
+}
+}  // namespace
+
 bool FileSystemRepository::initialize(const std::shared_ptr<Configure>& configuration) {
   if (std::string directory_str; configuration->get(Configure::nifi_dbcontent_repository_directory_default, directory_str) && !directory_str.empty()) {
     directory_ = directory_str;
+    is_minifi_home_ = false;
   } else {
     directory_ = utils::getMinifiDir().string();
+    is_minifi_home_ = true;
+  }
+  if (auto subdirectory_count_str = configuration->get(Configure::nifi_content_repository_subdirectory_count)) {
+    if (const auto subdirectory_count = parsing::parseIntegral<uint64_t>(*subdirectory_count_str)) {
+      subdirectory_count_ = gsl::narrow<size_t>(*subdirectory_count);
+    } else {
+      logger_->log_error("Invalid value '{}' for {}, using the default subdirectory count {}",
+          *subdirectory_count_str, Configure::nifi_content_repository_subdirectory_count, DEFAULT_SUBDIRECTORY_COUNT);
+    }
+  }
+  if (auto max_container_size_str = configuration->get(Configure::nifi_content_repository_max_container_size)) {
+    if (const auto max_container_size = parsing::parseDataSize(*max_container_size_str)) {
+      max_container_size_ = gsl::narrow<size_t>(*max_container_size);
+    } else {
+      logger_->log_error("Invalid value '{}' for {}, content packing is disabled", *max_container_size_str, Configure::nifi_content_repository_max_container_size);
+    }
   }
+  memory_mapped_reads_ = (configuration->get(Configure::nifi_content_repository_memory_mapped_reads) | utils::andThen(&utils::string::toBool)).value_or(false);
   utils::file::create_dir(directory_);
+  for (size_t i = 0; i < subdirectory_count_; ++i) {
+    utils::file::create_dir(directory_ + "/" + subdirectoryName(i));
+  }
+
+  std::atomic<uint64_t> entry_count{0};
+  forEachContentFile([&entry_count](const std::string&) { ++entry_count; });
+  entry_count_ = entry_count.load();
+  logger_->log_debug("Found {} entries in the content repository {}", entry_count_.load(), directory_);
   return true;
 }
 
+std::string FileSystemRepository::getStreamPath(std::string_view stream_name) const {
+  if (subdirectory_count_ == 0) {
+    return ContentRepositoryImpl::getStreamPath(stream_name);
+  }
+  const auto index = std::hash<std::string_view>{}(stream_name) % subdirectory_count_;
+  return directory_ + "/" + subdirectoryName(index) + "/" + std::string{stream_name};
+}
+
 std::shared_ptr<io::BaseStream> FileSystemRepository::write(const ResourceClaim& claim, bool append) {
-  return std::make_shared<io::FileStream>(claim.getContentFullPath(), append);
+  const auto path = claim.getContentFullPath();
+  if (!append) {
+    if (std::error_code ec; !std::filesystem::exists(path, ec)) {
+      ++entry_count_;
+    }
+  }
+  return std::make_shared<io::FileStream>(path, append);
 }
 
 bool FileSystemRepository::exists(const ResourceClaim& streamId) {
@@ -48,6 +109,13 @@ bool FileSystemRepository::exists(const ResourceClaim& streamId) {
 }
 
 std::shared_ptr<io::BaseStream> FileSystemRepository::read(const ResourceClaim& claim) {
+  if (memory_mapped_reads_) {
+    auto stream = std::make_shared<io::MemoryMappedFileStream>(claim.getContentFullPath());
+    if (stream->isMapped()) {
+      return stream;
+    }
+    logger_->log_debug("Could not map {} into memory, reading it as a file stream", claim.getContentFullPath());
+  }
   return std::make_shared<io::FileStream>(claim.getContentFullPath(), 0, false);
 }
 
@@ -68,34 +136,87 @@ bool FileSystemRepository::removeKey(const std::string& content_path) {
     logger_->log_error("Deleting {} from content repository failed with the following error: {}", content_path, ec.message());
     return false;
   }
+  decrementEntryCount();
   return true;
 }
 
+void FileSystemRepository::decrementEntryCount() {
+  // the count can get out of sync if files are removed externally, it must not wrap around in that case
+  auto count = entry_count_.load();
+  while (count > 0 && !entry_count_.compare_exchange_weak(count, count - 1)) {}
+}
+
 std::shared_ptr<ContentSession> FileSystemRepository::createSession() {
-  return std::make_shared<ForwardingContentSession>(sharedFromThis<ContentRepository>());
+  return std::make_shared<ForwardingContentSession>(sharedFromThis<ContentRepository>(), max_container_size_);
 }
 
-void FileSystemRepository::clearOrphans() {
+void FileSystemRepository::forEachContentFile(const std::function<void(const std::string&)>& callback) const {
+  // the files directly in the repository directory are left from the flat layout, and the subdirectories named like
+  // the shards of the hashed layout may be left from a different subdirectory count, all of them are content
+  std::vector<std::string> subdirectories;
   utils::file::list_dir(directory_, [&] (auto& /*dir*/, auto& filename) {
-    auto path = directory_ +  "/" + filename.string();
-    bool is_orphan = false;
-    {
-      std::lock_guard lock(count_map_mutex_);
-      auto it = count_map_.find(path);
-      is_orphan = it == count_map_.end() || it->second == 0;
+    callback(directory_ + "/" + filename.string());
+    return true;
+  }, logger_, [&] (const std::filesystem::path& subdirectory) {
+    if (isSubdirectoryName(subdirectory.filename().string())) {
+      subdirectories.push_back(directory_ + "/" + subdirectory.filename().string());
+    }
+    return false;
+  });
+  if (subdirectories.empty()) {
+    return;
+  }
+
+  std::atomic<size_t> next_subdirectory{0};
+  auto process_subdirectories = [&] {
+    for (size_t i = next_subdirectory++; i < subdirectories.size(); i = next_subdirectory++) {
+      utils::file::list_dir(subdirectories[i], [&] (auto& /*dir*/, auto& filename) {
+        callback(subdirectories[i] + "/" + filename.string());
+        return true;
+      }, logger_, false);
     }
-    if (is_orphan) {
-      logger_->log_debug("Deleting orphan resource {}", path);
-      if (std::error_code ec; !std::filesystem::remove(path, ec)) {
-        {
-          std::lock_guard<std::mutex> lock(purge_list_mutex_);
-          purge_list_.push_back(path);
-        }
-        logger_->log_error("Deleting {} from content repository failed with the following error: {}", path, ec.message());
+  };
+  const size_t thread_count = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1U), subdirectories.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count; ++i) {
+    threads.emplace_back(process_subdirectories);
+  }
+  process_subdirectories();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+void FileSystemRepository::clearOrphans() {
+  if (is_minifi_home_) {
+    logger_->log_info("The content repository directory is not configured, not deleting orphan content from {}", directory_);
+    return;
+  }
+  std::unordered_set<std::string> used_paths;
+  {
+    std::lock_guard lock(count_map_mutex_);
+    for (const auto& [path, count] : count_map_) {
+      if (count > 0) {
+        used_paths.insert(path);
       }
     }
-    return true;
-  }, logger_, false);
+  }
+
+  forEachContentFile([&] (const std::string& path) {
+    if (used_paths.contains(path)) {
+      return;
+    }
+    logger_->log_debug("Deleting orphan resource {}", path);
+    if (std::error_code ec; !std::filesystem::remove(path, ec)) {
+      {
+        std::lock_guard<std::mutex> lock(purge_list_mutex_);
+        purge_list_.push_back(path);
+      }
+      logger_->log_error("Deleting {} from content repository failed with the following error: {}", path, ec.message());
+    } else {
+      decrementEntryCount();
+    }
+  });
 }
 
 size_t FileSystemRepository::size(const ResourceClaim& claim) {
@@ -106,14 +227,6 @@ size_t FileSystemRepository::size(const ResourceClaim& claim) {
   return size;
 }
 
-uint64_t FileSystemRepository::getRepositoryEntryCount() const {
-  auto dir_it = std::filesystem::recursive_directory_iterator(directory_, std::filesystem::directory_options::skip_permission_denied);
-  return std::count_if(
-    begin(dir_it),
-    end(dir_it),
-    [](auto& entry) { return entry.is_regular_file(); });
-}
-
 std::shared_ptr<core::ContentRepository> createFileSystemRepository() {
   return std::make_shared<FileSystemRepository>();
 }
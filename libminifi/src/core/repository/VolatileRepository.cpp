@@ -87,6 +87,15 @@ bool VolatileRepository::MultiPut(const std::vector<std::pair<std::string, std::
   return true;
 }
 
+bool VolatileRepository::MultiPut(std::span<const std::pair<std::string_view, std::span<const std::byte>>> data) {
+  for (const auto& [key, value] : data) {
+    if (!Put(std::string{key}, reinterpret_cast<const uint8_t*>(value.data()), value.size())) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool VolatileRepository::Delete(const std::string& key) {
   logger_->log_debug("Delete from volatile");
   for (auto ent : repo_data_.value_vector) {
@@ -19,13 +19,15 @@
 #include "core/state/nodes/QueueMetrics.h"
 #include "core/Resource.h"
 #include "core/state/Value.h"
+#include "fmt/format.h"
+#include "utils/StringUtils.h"
 
 namespace org::apache::nifi::minifi::state::response {
 
 std::vector<SerializedResponseNode> QueueMetrics::serialize() {
   std::vector<SerializedResponseNode> serialized;
   for (const auto& [_, connection] : connection_store_.getConnections()) {
-    serialized.push_back({
+    SerializedResponseNode connection_node{
       .name = connection->getName(),
       .children = {
         {.name = "datasize", .value = std::to_string(connection->getQueueDataSize())},
@@ -33,7 +35,12 @@ std::vector<SerializedResponseNode> QueueMetrics::serialize() {
         {.name = "queued", .value = std::to_string(connection->getQueueSize())},
         {.name = "queuedmax", .value = std::to_string(connection->getBackpressureThresholdCount())},
       }
-    });
+    };
+    for (const auto& percentile : PUBLISHED_LATENCY_PERCENTILES) {
+      connection_node.children.push_back({.name = fmt::format("waittimenanos{}", utils::string::toLower(std::string{percentile.suffix})),
+          .value = std::to_string(connection->getQueueWaitTimePercentile(percentile.ratio).count())});
+    }
+    serialized.push_back(std::move(connection_node));
   }
   return serialized;
 }
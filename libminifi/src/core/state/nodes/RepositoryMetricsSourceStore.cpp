@@ -19,6 +19,16 @@
 
 namespace org::apache::nifi::minifi::state::response {
 
+namespace {
+double averageWriteGroupSize(const core::RepositoryMetricsSource::RocksDbWriteGroupStats& stats) {
+  return stats.write_group_count == 0 ? 0.0 : static_cast<double>(stats.grouped_write_count) / static_cast<double>(stats.write_group_count);
+}
+
+double averageCommitLatencyMicroseconds(const core::RepositoryMetricsSource::RocksDbWriteGroupStats& stats) {
+  return stats.grouped_write_count == 0 ? 0.0 : static_cast<double>(stats.total_commit_latency_us) / static_cast<double>(stats.grouped_write_count);
+}
+}  // namespace
+
 RepositoryMetricsSourceStore::RepositoryMetricsSourceStore(std::string name) : name_(std::move(name)) {}
 
 void RepositoryMetricsSourceStore::setRepositories(const std::vector<std::shared_ptr<core::RepositoryMetricsSource>> &repositories) {
@@ -48,6 +58,11 @@ std::vector<SerializedResponseNode> RepositoryMetricsSourceStore::serialize() co
     if (auto rocksdb_stats = repo->getRocksDbStats()) {
       parent.children.push_back({.name = "rocksDbTableReadersSize", .value = rocksdb_stats->table_readers_size});
       parent.children.push_back({.name = "rocksDbAllMemoryTablesSize", .value = rocksdb_stats->all_memory_tables_size});
+      if (const auto& write_group_stats = rocksdb_stats->write_group_stats) {
+        parent.children.push_back({.name = "rocksDbWriteGroupCount", .value = write_group_stats->write_group_count});
+        parent.children.push_back({.name = "rocksDbAverageWriteGroupSize", .value = averageWriteGroupSize(*write_group_stats)});
+        parent.children.push_back({.name = "rocksDbAverageCommitLatencyMicroseconds", .value = averageCommitLatencyMicroseconds(*write_group_stats)});
+      }
     }
 
     serialized.push_back(parent);
@@ -68,6 +83,14 @@ std::vector<PublishedMetric> RepositoryMetricsSourceStore::calculateMetrics() co
         {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
       metrics.push_back({"rocksdb_all_memory_tables_size_bytes", static_cast<double>(rocksdb_stats->all_memory_tables_size),
         {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+      if (const auto& write_group_stats = rocksdb_stats->write_group_stats) {
+        metrics.push_back({"rocksdb_write_group_count", static_cast<double>(write_group_stats->write_group_count),
+          {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+        metrics.push_back({"rocksdb_average_write_group_size", averageWriteGroupSize(*write_group_stats),
+          {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+        metrics.push_back({"rocksdb_commit_latency_microseconds", averageCommitLatencyMicroseconds(*write_group_stats),
+          {{"metric_class", name_}, {"repository_name", repo->getRepositoryName()}}});
+      }
     }
   }
   return metrics;
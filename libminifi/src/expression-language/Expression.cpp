@@ -22,9 +22,13 @@
 #include <iomanip>
 #include <random>
 #include <algorithm>
+#include <deque>
 #include <regex>
 #include <functional>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_set>
 
 #include "rapidjson/reader.h"
 #include "rapidjson/writer.h"
@@ -768,18 +772,20 @@ Value expr_replace(const std::vector<Value> &args) {
   return Value(result);
 }
 
+Value expr_replaceFirst(const std::vector<Value> &args, const std::regex &find) {
+  return Value(std::regex_replace(args[0].asString(), find, args[2].asString(), std::regex_constants::format_first_only));
+}
+
 Value expr_replaceFirst(const std::vector<Value> &args) {
-  std::string result = args[0].asString();
-  const std::regex find(args[1].asString());
-  const std::string &replace = args[2].asString();
-  return Value(std::regex_replace(result, find, replace, std::regex_constants::format_first_only));
+  return expr_replaceFirst(args, std::regex(args[1].asString()));
+}
+
+Value expr_replaceAll(const std::vector<Value> &args, const std::regex &find) {
+  return Value(std::regex_replace(args[0].asString(), find, args[2].asString()));
 }
 
 Value expr_replaceAll(const std::vector<Value> &args) {
-  std::string result = args[0].asString();
-  const std::regex find(args[1].asString());
-  const std::string &replace = args[2].asString();
-  return Value(std::regex_replace(result, find, replace));
+  return expr_replaceAll(args, std::regex(args[1].asString()));
 }
 
 Value expr_replaceNull(const std::vector<Value> &args) {
@@ -791,24 +797,24 @@ Value expr_replaceNull(const std::vector<Value> &args) {
 }
 
 Value expr_replaceEmpty(const std::vector<Value> &args) {
-  std::string result = args[0].asString();
-  const std::regex find("^[ \n\r\t]*$");
-  const std::string &replace = args[1].asString();
-  return Value(std::regex_replace(result, find, replace));
+  static const std::regex find("^[ \n\r\t]*$");
+  return Value(std::regex_replace(args[0].asString(), find, args[1].asString()));
+}
+
+Value expr_matches(const std::vector<Value> &args, const utils::Regex &expr) {
+  return Value(utils::regexMatch(args[0].asString(), expr));
 }
 
 Value expr_matches(const std::vector<Value> &args) {
-  const auto &subject = args[0].asString();
-  const auto expr = utils::Regex(args[1].asString());
+  return expr_matches(args, utils::Regex(args[1].asString()));
+}
 
-  return Value(utils::regexMatch(subject, expr));
+Value expr_find(const std::vector<Value> &args, const utils::Regex &expr) {
+  return Value(utils::regexSearch(args[0].asString(), expr));
 }
 
 Value expr_find(const std::vector<Value> &args) {
-  const auto &subject = args[0].asString();
-  const auto expr = utils::Regex(args[1].asString());
-
-  return Value(utils::regexSearch(subject, expr));
+  return expr_find(args, utils::Regex(args[1].asString()));
 }
 
 Value expr_trim(const std::vector<Value> &args) {
@@ -917,6 +923,74 @@ Value expr_random(const std::vector<Value>& /*args*/) {
   return Value(distribution(generator));
 }
 
+/**
+ * Evaluating the arguments of a function call needs a vector of values. Instead of allocating a new one for every
+ * call, every thread keeps one vector for each nesting level of function calls, and reuses them between evaluations.
+ */
+class ArgumentBuffer {
+ public:
+  ArgumentBuffer() : level_(current_level_++) {
+    if (buffers_.size() <= level_) {
+      buffers_.emplace_back();
+    }
+  }
+
+  ArgumentBuffer(const ArgumentBuffer&) = delete;
+  ArgumentBuffer& operator=(const ArgumentBuffer&) = delete;
+
+  ~ArgumentBuffer() {
+    buffers_[level_].clear();
+    --current_level_;
+  }
+
+  // deque elements are not invalidated when nested calls add deeper levels, so the reference stays valid
+  std::vector<Value>& values() {
+    return buffers_[level_];
+  }
+
+  std::vector<Value>& evaluate(const std::vector<Expression> &args, const Parameters &params) {
+    auto& buffer = values();
+    for (const auto &arg : args) {
+      buffer.emplace_back(arg(params));
+    }
+    return buffer;
+  }
+
+ private:
+  static inline thread_local std::deque<std::vector<Value>> buffers_;
+  static inline thread_local std::size_t current_level_ = 0;
+  std::size_t level_;
+};
+
+bool is_deterministic_function(const std::string &function_name) {
+  static const std::unordered_set<std::string_view> non_deterministic_functions{
+    "hostname", "resolve_user_id", "ip", "reverseDnsLookup", "UUID", "now", "random", "nextInt"
+  };
+  return !non_deterministic_functions.contains(function_name);
+}
+
+/**
+ * Evaluates a deterministic function call at compile time if all of its arguments are static.
+ * Calls which fail are left to be evaluated dynamically, so that the error is reported on evaluation as before.
+ */
+template<typename Fn>
+std::optional<Expression> fold_static_call(const std::string &function_name, const std::vector<Expression> &args, Fn fn) {
+  if (args.empty() || !is_deterministic_function(function_name)
+      || std::any_of(args.begin(), args.end(), [](const Expression &arg) { return arg.is_dynamic() || arg.is_multi(); })) {
+    return std::nullopt;
+  }
+  try {
+    std::vector<Value> evaluated_args;
+    evaluated_args.reserve(args.size());
+    for (const auto &arg : args) {
+      evaluated_args.emplace_back(arg(Parameters{}));
+    }
+    return Expression(fn(evaluated_args));
+  } catch (const std::exception&) {
+    return std::nullopt;
+  }
+}
+
 template<Value T(const std::vector<Value> &)>
 Expression make_dynamic_function_incomplete(const std::string &function_name, const std::vector<Expression> &args, std::size_t num_args) {
   if (args.size() < num_args) {
@@ -925,6 +999,10 @@ Expression make_dynamic_function_incomplete(const std::string &function_name, co
     throw std::runtime_error(message_ss.str());
   }
 
+  if (auto folded = fold_static_call(function_name, args, T)) {
+    return *folded;
+  }
+
   if (!args.empty() && args[0].is_multi()) {
     std::vector<Expression> multi_args;
 
@@ -938,17 +1016,39 @@ Expression make_dynamic_function_incomplete(const std::string &function_name, co
                                  multi_args);
   } else {
     return make_dynamic([=](const Parameters &params, const std::vector<Expression>& /*sub_exprs*/) -> Value {
-      std::vector<Value> evaluated_args;
-      evaluated_args.reserve(args.size());
-      for (const auto &arg : args) {
-        evaluated_args.emplace_back(arg(params));
-      }
-
-      return T(evaluated_args);
+      ArgumentBuffer buffer;
+      return T(buffer.evaluate(args, params));
     });
   }
 }
 
+/**
+ * Same as make_dynamic_function_incomplete, but if the pattern argument is a literal, the regular expression
+ * is compiled only once instead of on every evaluation.
+ */
+template<typename RegexType, Value T(const std::vector<Value> &, const RegexType &), Value TUncompiled(const std::vector<Value> &)>
+Expression make_dynamic_regex_function(const std::string &function_name, const std::vector<Expression> &args, std::size_t num_args) {
+  // the subject is not counted in num_args
+  if (args.size() < num_args + 1 || args[0].is_multi() || args[1].is_dynamic()) {
+    return make_dynamic_function_incomplete<TUncompiled>(function_name, args, num_args);
+  }
+  if (auto folded = fold_static_call(function_name, args, TUncompiled)) {
+    return *folded;
+  }
+
+  std::shared_ptr<const RegexType> regex;
+  try {
+    regex = std::make_shared<const RegexType>(args[1](Parameters{}).asString());
+  } catch (const std::exception&) {
+    // invalid patterns are reported on evaluation, as before
+    return make_dynamic_function_incomplete<TUncompiled>(function_name, args, num_args);
+  }
+  return make_dynamic([args, regex](const Parameters &params, const std::vector<Expression>& /*sub_exprs*/) -> Value {
+    ArgumentBuffer buffer;
+    return T(buffer.evaluate(args, params), *regex);
+  });
+}
+
 Value expr_literal(const std::vector<Value> &args) {
   return args[0];
 }
@@ -1436,17 +1536,17 @@ Expression make_dynamic_function(const std::string &function_name, const std::ve
   } else if (function_name == "replace") {
     return make_dynamic_function_incomplete<expr_replace>(function_name, args, 2);
   } else if (function_name == "replaceFirst") {
-    return make_dynamic_function_incomplete<expr_replaceFirst>(function_name, args, 2);
+    return make_dynamic_regex_function<std::regex, expr_replaceFirst, expr_replaceFirst>(function_name, args, 2);
   } else if (function_name == "replaceAll") {
-    return make_dynamic_function_incomplete<expr_replaceAll>(function_name, args, 2);
+    return make_dynamic_regex_function<std::regex, expr_replaceAll, expr_replaceAll>(function_name, args, 2);
   } else if (function_name == "replaceNull") {
     return make_dynamic_function_incomplete<expr_replaceNull>(function_name, args, 1);
   } else if (function_name == "replaceEmpty") {
     return make_dynamic_function_incomplete<expr_replaceEmpty>(function_name, args, 1);
   } else if (function_name == "matches") {
-    return make_dynamic_function_incomplete<expr_matches>(function_name, args, 1);
+    return make_dynamic_regex_function<utils::Regex, expr_matches, expr_matches>(function_name, args, 1);
   } else if (function_name == "find") {
-    return make_dynamic_function_incomplete<expr_find>(function_name, args, 1);
+    return make_dynamic_regex_function<utils::Regex, expr_find, expr_find>(function_name, args, 1);
   } else if (function_name == "allMatchingAttributes") {
     return make_allMatchingAttributes(function_name, args);
   } else if (function_name == "anyMatchingAttribute") {
@@ -1609,10 +1709,9 @@ Expression Expression::compose_multi(const std::function<Value(const std::vector
     for (const auto &sub_expr : sub_exprs) {
       out_exprs.emplace_back(make_dynamic([=](const Parameters &params,
                   const std::vector<Expression>& /*sub_exprs*/) {
-                std::vector<Value> evaluated_args;
-
+                ArgumentBuffer buffer;
+                auto& evaluated_args = buffer.values();
                 evaluated_args.emplace_back(sub_expr(params));
-
                 for (const auto &arg : args) {
                   evaluated_args.emplace_back(arg(params));
                 }
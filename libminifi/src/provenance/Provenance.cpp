@@ -18,7 +18,9 @@
 
 #include "provenance/Provenance.h"
 
+#include <cmath>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -145,26 +147,32 @@ bool ProvenanceEventRecordImpl::serialize(io::OutputStream& output_stream) {
     }
   }
   // write flow attributes
-  {
-    const auto numAttributes = gsl::narrow<uint32_t>(this->_attributes.size());
-    const auto ret = output_stream.write(numAttributes);
-    if (ret != 4) {
-      return false;
-    }
-  }
-  for (const auto& itAttribute : _attributes) {
+  const auto write_attributes = [&output_stream](const auto& attributes) {
     {
-      const auto ret = output_stream.write(itAttribute.first);
-      if (ret == 0 || io::isError(ret)) {
+      const auto numAttributes = gsl::narrow<uint32_t>(attributes.size());
+      const auto ret = output_stream.write(numAttributes);
+      if (ret != 4) {
         return false;
       }
     }
-    {
-      const auto ret = output_stream.write(itAttribute.second);
-      if (ret == 0 || io::isError(ret)) {
-        return false;
+    for (const auto& itAttribute : attributes) {
+      {
+        const auto ret = output_stream.write(itAttribute.first);
+        if (ret == 0 || io::isError(ret)) {
+          return false;
+        }
+      }
+      {
+        const auto ret = output_stream.write(itAttribute.second);
+        if (ret == 0 || io::isError(ret)) {
+          return false;
+        }
       }
     }
+    return true;
+  };
+  if (!(flow_file_attributes_ ? write_attributes(*flow_file_attributes_) : write_attributes(_attributes))) {
+    return false;
   }
   {
     const auto ret = output_stream.write(this->_contentFullPath);
@@ -444,6 +452,28 @@ bool ProvenanceEventRecordImpl::deserialize(io::InputStream &input_stream) {
   return true;
 }
 
+std::optional<uint64_t> ProvenanceReporterImpl::samplingThreshold(double sampling_ratio) {
+  if (!(sampling_ratio < 1.0)) {
+    return std::nullopt;
+  }
+  if (!(sampling_ratio > 0.0)) {
+    return 0;
+  }
+  return static_cast<uint64_t>(std::ldexp(sampling_ratio, 64));
+}
+
+bool ProvenanceReporterImpl::isRecorded(const core::FlowFile& flow_file) const {
+  if (!sampling_threshold_) {
+    return true;
+  }
+  // splitmix64 finalizer, so that the sampled flow files are spread evenly regardless of the UUID generator
+  uint64_t hash = std::hash<utils::Identifier>{}(flow_file.getUUID());
+  hash = (hash ^ (hash >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+  hash = (hash ^ (hash >> 27U)) * 0x94d049bb133111ebULL;
+  hash ^= hash >> 31U;
+  return hash < *sampling_threshold_;
+}
+
 void ProvenanceReporterImpl::commit() {
   if (repo_->isNoop()) {
     return;
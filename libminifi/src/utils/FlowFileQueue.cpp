@@ -160,6 +160,19 @@ bool FlowFileQueue::isWorkAvailable() const {
   return !swapped_flow_files_.empty() && swapped_flow_files_.min().to_be_processed_after <= now;
 }
 
+std::optional<FlowFileQueue::TimePoint> FlowFileQueue::getNextPenaltyExpiration() const {
+  if (!queue_.empty()) {
+    return queue_.min()->getPenaltyExpiration();
+  }
+  if (load_task_) {
+    return load_task_->min;
+  }
+  if (!swapped_flow_files_.empty()) {
+    return swapped_flow_files_.min().to_be_processed_after;
+  }
+  return std::nullopt;
+}
+
 bool FlowFileQueue::empty() const {
   return size() == 0;
 }
@@ -56,6 +56,7 @@ class ProcessorWithStatistics {
  public:
   std::atomic<int> trigger_count{0};
   std::function<void()> onTriggerCb_;
+  std::function<void()> onStopCb_;
 };
 
 class TestProcessor : public core::ProcessorImpl, public ProcessorWithStatistics {
@@ -105,6 +106,13 @@ class TestProcessor : public core::ProcessorImpl, public ProcessorWithStatistics
   }
   std::atomic<int64_t> apple_probability_;
   std::atomic<int64_t> banana_probability_;
+
+ protected:
+  void notifyStop() override {
+    if (onStopCb_) {
+      onStopCb_();
+    }
+  }
 };
 
 class TestFlowFileGenerator : public processors::GenerateFlowFile, public ProcessorWithStatistics {
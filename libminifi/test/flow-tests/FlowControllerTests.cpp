@@ -19,7 +19,9 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <utility>
 
 #include "core/Core.h"
 #include "core/repository/AtomicRepoEntries.h"
@@ -295,3 +297,130 @@ Controller Services: []
   REQUIRE(minifi::test::utils::verifyLogLinePresenceInPollTime(0s, "Destroying FlowController"));
   REQUIRE(LogTestController::getInstance().countOccurrences("Destroying scheduling agent") == 3);
 }
+
+TEST_CASE("Flow update only restarts the changed processors", "[TestFlow6]") {
+  TestControllerWithFlow testController(yamlConfig);
+  auto controller = testController.controller_;
+  auto root = testController.root_;
+
+  TypedProcessorWrapper<minifi::processors::TestProcessor> sinkProc = root->findProcessorByName("TestProcessor");
+  gsl_Assert(sinkProc);
+  // prevent execution of the consumer processor, so that the flow files stay queued
+  sinkProc->yield(10s);
+
+  std::map<std::string, minifi::Connection*> connectionMap;
+  root->getConnections(connectionMap);
+  auto* connection = connectionMap.at("Gen");
+
+  testController.startFlow();
+  REQUIRE(verifyWithBusyWait(std::chrono::milliseconds{1000}, [&] { return connection->getQueueSize() >= 3; }));
+  LogTestController::getInstance().clear();
+
+  std::string updated_flow{yamlConfig};
+  constexpr std::string_view batch_size_setting = "Batch Size: 3";
+  const auto batch_size_position = updated_flow.find(batch_size_setting);
+  REQUIRE(batch_size_position != std::string::npos);
+  updated_flow.replace(batch_size_position, batch_size_setting.size(), "Batch Size: 5");
+  bool update_successful = controller->applyConfiguration("/flows/1", updated_flow).has_value();
+  REQUIRE(update_successful);
+
+  CHECK(LogTestController::getInstance().countOccurrences("Creating scheduling agent") == 0);
+  CHECK(LogTestController::getInstance().countOccurrences("Updating the running flow in place") == 1);
+  auto generator = root->findProcessorByName("Generator");
+  REQUIRE(generator);
+  CHECK(generator->getProperty("Batch Size") == "5");
+
+  // the connection and its queue are kept, the consumer has not been restarted
+  std::map<std::string, minifi::Connection*> updatedConnectionMap;
+  root->getConnections(updatedConnectionMap);
+  CHECK(updatedConnectionMap.at("Gen") == connection);
+  CHECK(connection->getQueueSize() >= 3);
+  CHECK(sinkProc.get().trigger_count == 0);
+  CHECK(sinkProc->isYield());
+}
+
+TEST_CASE("Flow update adds and removes processors and connections in place", "[TestFlow7]") {
+  TestControllerWithFlow testController(yamlConfig);
+  auto controller = testController.controller_;
+  auto root = testController.root_;
+  testController.startFlow();
+
+  std::string extended_flow{yamlConfig};
+  const auto connections_position = extended_flow.find("Connections:");
+  REQUIRE(connections_position != std::string::npos);
+  extended_flow.insert(connections_position, R"(  - name: SecondSink
+    id: 2438e3c8-015a-1000-79ca-83af40ec1993
+    class: org.apache.nifi.processors.standard.TestProcessor
+    max concurrent tasks: 1
+    scheduling strategy: TIMER_DRIVEN
+    scheduling period: 100 ms
+    auto-terminated relationships list:
+      - apple
+      - banana
+)");
+  const auto remote_groups_position = extended_flow.find("Remote Processing Groups:");
+  REQUIRE(remote_groups_position != std::string::npos);
+  extended_flow.insert(remote_groups_position, R"(  - name: SecondGen
+    id: 2438e3c8-015a-1000-79ca-83af40ec1998
+    source id: 2438e3c8-015a-1000-79ca-83af40ec1991
+    source relationship name: success
+    destination id: 2438e3c8-015a-1000-79ca-83af40ec1993
+)");
+
+  LogTestController::getInstance().clear();
+  REQUIRE(controller->applyConfiguration("/flows/1", extended_flow).has_value());
+  CHECK(LogTestController::getInstance().countOccurrences("Updating the running flow in place, processors changed: 1, added: 1, removed: 0, connections changed: 0, added: 1, removed: 0") == 1);
+  CHECK(LogTestController::getInstance().countOccurrences("Creating scheduling agent") == 0);
+
+  TypedProcessorWrapper<minifi::processors::TestProcessor> second_sink = root->findProcessorByName("SecondSink");
+  REQUIRE(second_sink);
+  std::map<std::string, minifi::Connection*> connection_map;
+  root->getConnections(connection_map);
+  REQUIRE(connection_map.contains("SecondGen"));
+  // the added processor is scheduled and receives the flow files of the added connection
+  CHECK(verifyWithBusyWait(std::chrono::milliseconds{3000}, [&] { return second_sink.get().trigger_count > 0; }));
+
+  LogTestController::getInstance().clear();
+  REQUIRE(controller->applyConfiguration("/flows/1", yamlConfig).has_value());
+  CHECK(LogTestController::getInstance().countOccurrences("Updating the running flow in place, processors changed: 1, added: 0, removed: 1, connections changed: 0, added: 0, removed: 1") == 1);
+  CHECK(LogTestController::getInstance().countOccurrences("Creating scheduling agent") == 0);
+  CHECK(root->findProcessorByName("SecondSink") == nullptr);
+  connection_map.clear();
+  root->getConnections(connection_map);
+  CHECK_FALSE(connection_map.contains("SecondGen"));
+  CHECK(connection_map.contains("Gen"));
+}
+
+TEST_CASE("Flow update restarts the whole flow if the update in place fails", "[TestFlow8]") {
+  TestControllerWithFlow testController(yamlConfig);
+  LogTestController::getInstance().setDebug<core::ProcessGroup>();
+  auto controller = testController.controller_;
+  auto root = testController.root_;
+
+  TypedProcessorWrapper<minifi::processors::TestProcessor> sinkProc = root->findProcessorByName("TestProcessor");
+  gsl_Assert(sinkProc);
+  bool stop_failed = false;
+  sinkProc.get().onStopCb_ = [&] {
+    if (!std::exchange(stop_failed, true)) {
+      throw std::runtime_error("Failed to stop the processor");
+    }
+  };
+  testController.startFlow();
+  LogTestController::getInstance().clear();
+
+  // the changed processor is stopped by the update in place, which fails
+  std::string updated_flow{yamlConfig};
+  constexpr std::string_view penalization_setting = "penalization period: 3 sec";
+  const auto penalization_position = updated_flow.find(penalization_setting);
+  REQUIRE(penalization_position != std::string::npos);
+  updated_flow.replace(penalization_position, penalization_setting.size(), "penalization period: 5 sec");
+  REQUIRE(controller->applyConfiguration("/flows/1", updated_flow).has_value());
+
+  CHECK(stop_failed);
+  CHECK(LogTestController::getInstance().countOccurrences("Failed to update the running flow in place, reloading the whole flow") == 1);
+  CHECK(LogTestController::getInstance().countOccurrences("Creating scheduling agent") == 3);
+
+  // every processor of the reloaded flow is started again
+  CHECK(LogTestController::getInstance().countOccurrences("Starting Generator") == 1);
+  CHECK(LogTestController::getInstance().countOccurrences("Starting TestProcessor") == 1);
+}
@@ -123,6 +123,32 @@ void testReadOnSmallerClonedFlowFiles(std::shared_ptr<core::ContentRepository> c
   CHECK(read_until_it_can_callback.value_ == "bar");
 }
 
+void testSliceClonesShareTheClaimOfTheParent(std::shared_ptr<core::ContentRepository> content_repo) {
+  Fixture fixture = Fixture(std::move(content_repo));
+  core::ProcessSession& process_session = fixture.processSession();
+  const auto original_ff = process_session.create();
+  fixture.writeToFlowFile(original_ff, "foobar");
+  fixture.transferAndCommit(original_ff);
+
+  auto clone_first_half = process_session.clone(*original_ff, 0, 3);
+  auto clone_second_half = process_session.clone(*original_ff, 3, 3);
+  REQUIRE(clone_first_half != nullptr);
+  REQUIRE(clone_second_half != nullptr);
+  CHECK(clone_first_half->getResourceClaim() == original_ff->getResourceClaim());
+  CHECK(clone_second_half->getResourceClaim() == original_ff->getResourceClaim());
+  CHECK(clone_second_half->getOffset() == original_ff->getOffset() + 3);
+  CHECK(process_session.clone(*original_ff, 4, 3) == nullptr);
+
+  process_session.appendBuffer(clone_first_half, std::string_view{"123"});
+  process_session.appendBuffer(clone_second_half, std::string_view{"456"});
+  fixture.transferAndCommit(clone_first_half);
+  fixture.transferAndCommit(clone_second_half);
+
+  CHECK(to_string(process_session.readBuffer(original_ff)) == "foobar");
+  CHECK(to_string(process_session.readBuffer(clone_first_half)) == "foo123");
+  CHECK(to_string(process_session.readBuffer(clone_second_half)) == "bar456");
+}
+
 void testAppendToUnmanagedFlowFile(std::shared_ptr<core::ContentRepository> content_repo) {
   Fixture fixture = Fixture(std::move(content_repo));
   core::ProcessSession& process_session = fixture.processSession();
@@ -60,6 +60,8 @@ class TestRepositoryBase : public T_BaseRepository {
     return true;
   }
 
+  using T_BaseRepository::MultiPut;
+
   bool MultiPut(const std::vector<std::pair<std::string, std::unique_ptr<org::apache::nifi::minifi::io::BufferStream>>>& data) override {
     for (const auto& item : data) {
       if (!Put(item.first, reinterpret_cast<const uint8_t*>(item.second->getBuffer().data()), item.second->size())) {
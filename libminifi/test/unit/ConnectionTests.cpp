@@ -14,6 +14,12 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
 #include "Connection.h"
 
 #include "unit/TestBase.h"
@@ -125,3 +131,165 @@ TEST_CASE("Connection backpressure tests", "[Connection]") {
     CHECK_FALSE(connection->backpressureThresholdReached());
   }
 }
+
+TEST_CASE("Connection returns every flow file once with concurrent producers and consumers", "[Connection]") {
+  const auto flow_repo = std::make_shared<TestRepository>();
+  const auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  content_repo->initialize(std::make_shared<minifi::ConfigureImpl>());
+
+  const auto id_generator = utils::IdGenerator::getIdGenerator();
+  const auto connection = std::make_shared<minifi::ConnectionImpl>(flow_repo, content_repo, "test_connection", id_generator->generate(), id_generator->generate(), id_generator->generate());
+  connection->setBackpressureThresholdCount(0);
+
+  constexpr size_t THREAD_COUNT = 4;
+  constexpr size_t FLOW_FILES_PER_PRODUCER = 500;
+  std::vector<std::thread> threads;
+  for (size_t producer = 0; producer < THREAD_COUNT; ++producer) {
+    threads.emplace_back([&connection] {
+      for (size_t i = 0; i < FLOW_FILES_PER_PRODUCER; i += 2) {
+        connection->put(std::make_shared<core::FlowFileImpl>());
+        std::vector<std::shared_ptr<core::FlowFile>> flow_files{std::make_shared<core::FlowFileImpl>()};
+        connection->multiPut(flow_files);
+      }
+    });
+  }
+  std::atomic<size_t> polled_count = 0;
+  std::mutex polled_mutex;
+  std::set<std::shared_ptr<core::FlowFile>> polled_flow_files;
+  for (size_t consumer = 0; consumer < THREAD_COUNT; ++consumer) {
+    threads.emplace_back([&] {
+      std::set<std::shared_ptr<core::FlowFile>> expired_flow_files;
+      while (polled_count < THREAD_COUNT * FLOW_FILES_PER_PRODUCER) {
+        if (auto flow_file = connection->poll(expired_flow_files)) {
+          std::lock_guard<std::mutex> lock(polled_mutex);
+          polled_flow_files.insert(std::move(flow_file));
+          ++polled_count;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  CHECK(polled_flow_files.size() == THREAD_COUNT * FLOW_FILES_PER_PRODUCER);
+  CHECK(connection->isEmpty());
+  CHECK_FALSE(connection->isWorkAvailable());
+}
+
+TEST_CASE("Connection returns flow files put by a single thread in order", "[Connection]") {
+  const auto flow_repo = std::make_shared<TestRepository>();
+  const auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  content_repo->initialize(std::make_shared<minifi::ConfigureImpl>());
+
+  const auto id_generator = utils::IdGenerator::getIdGenerator();
+  const auto connection = std::make_shared<minifi::ConnectionImpl>(flow_repo, content_repo, "test_connection", id_generator->generate(), id_generator->generate(), id_generator->generate());
+
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  for (int i = 0; i < 10; ++i) {
+    flow_files.push_back(std::make_shared<core::FlowFileImpl>());
+    connection->put(flow_files.back());
+  }
+  CHECK(connection->getQueueSize() == 10);
+  CHECK(connection->isWorkAvailable());
+
+  std::set<std::shared_ptr<core::FlowFile>> expired_flow_files;
+  for (const auto& flow_file : flow_files) {
+    CHECK(connection->poll(expired_flow_files) == flow_file);
+  }
+  CHECK(connection->isEmpty());
+}
+
+TEST_CASE("Connection keeps track of the size of the flow files put while draining", "[Connection]") {
+  const auto flow_repo = std::make_shared<TestRepository>();
+  const auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  content_repo->initialize(std::make_shared<minifi::ConfigureImpl>());
+
+  const auto id_generator = utils::IdGenerator::getIdGenerator();
+  const auto connection = std::make_shared<minifi::ConnectionImpl>(flow_repo, content_repo, "test_connection", id_generator->generate(), id_generator->generate(), id_generator->generate());
+  connection->setBackpressureThresholdCount(0);
+
+  const auto penalized_flow_file = std::make_shared<core::FlowFileImpl>();
+  penalized_flow_file->setSize(100);
+  penalized_flow_file->penalize(std::chrono::seconds{10});
+  connection->put(penalized_flow_file);
+
+  constexpr size_t FLOW_FILE_COUNT = 1000;
+  std::thread producer([&connection] {
+    for (size_t i = 0; i < FLOW_FILE_COUNT; ++i) {
+      const auto flow_file = std::make_shared<core::FlowFileImpl>();
+      flow_file->setSize(10);
+      connection->put(flow_file);
+    }
+  });
+  for (size_t i = 0; i < 100; ++i) {
+    connection->drain(false);
+  }
+  producer.join();
+
+  CHECK(connection->getQueueDataSize() == 10 * connection->getQueueSize());
+  std::set<std::shared_ptr<core::FlowFile>> expired_flow_files;
+  while (connection->poll(expired_flow_files)) {}
+  CHECK(connection->getQueueDataSize() == 0);
+}
+
+namespace {
+struct WorkNotificationCountingConnectable : minifi::ConnectionImpl {
+  using minifi::ConnectionImpl::ConnectionImpl;
+
+  void notifyWork() override {
+    ++work_notification_count;
+  }
+
+  std::atomic<size_t> work_notification_count = 0;
+};
+}  // namespace
+
+TEST_CASE("Connection notifies its source when its backpressure is released", "[Connection]") {
+  const auto flow_repo = std::make_shared<TestRepository>();
+  const auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  content_repo->initialize(std::make_shared<minifi::ConfigureImpl>());
+
+  const auto id_generator = utils::IdGenerator::getIdGenerator();
+  WorkNotificationCountingConnectable source{flow_repo, content_repo, "source", id_generator->generate()};
+  const auto connection = std::make_shared<minifi::ConnectionImpl>(flow_repo, content_repo, "test_connection", id_generator->generate(), id_generator->generate(), id_generator->generate());
+  connection->setSource(&source);
+  connection->setBackpressureThresholdCount(2);
+
+  std::set<std::shared_ptr<core::FlowFile>> expired_flow_files;
+  connection->put(std::make_shared<core::FlowFileImpl>());
+  REQUIRE(connection->poll(expired_flow_files));
+  CHECK(source.work_notification_count == 0);
+
+  connection->put(std::make_shared<core::FlowFileImpl>());
+  connection->put(std::make_shared<core::FlowFileImpl>());
+  REQUIRE(connection->backpressureThresholdReached());
+  REQUIRE(connection->poll(expired_flow_files));
+  CHECK(source.work_notification_count == 1);
+
+  connection->put(std::make_shared<core::FlowFileImpl>());
+  REQUIRE(connection->backpressureThresholdReached());
+  connection->drain(false);
+  CHECK(source.work_notification_count == 2);
+}
+
+TEST_CASE("Connection reports when its first penalized flow file becomes available", "[Connection]") {
+  const auto flow_repo = std::make_shared<TestRepository>();
+  const auto content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  content_repo->initialize(std::make_shared<minifi::ConfigureImpl>());
+
+  const auto id_generator = utils::IdGenerator::getIdGenerator();
+  const auto connection = std::make_shared<minifi::ConnectionImpl>(flow_repo, content_repo, "test_connection", id_generator->generate(), id_generator->generate(), id_generator->generate());
+  CHECK_FALSE(connection->getNextPenaltyExpiration());
+
+  connection->put(std::make_shared<core::FlowFileImpl>());
+  CHECK_FALSE(connection->getNextPenaltyExpiration());
+
+  const auto penalized_flow_file = std::make_shared<core::FlowFileImpl>();
+  penalized_flow_file->penalize(std::chrono::seconds{10});
+  connection->put(penalized_flow_file);
+  const auto less_penalized_flow_file = std::make_shared<core::FlowFileImpl>();
+  less_penalized_flow_file->penalize(std::chrono::seconds{5});
+  connection->put(less_penalized_flow_file);
+  CHECK(connection->getNextPenaltyExpiration() == less_penalized_flow_file->getPenaltyExpiration());
+}
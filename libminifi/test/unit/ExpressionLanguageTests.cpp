@@ -20,6 +20,7 @@
 
 #include <memory>
 #include <string>
+#include <tuple>
 #ifdef WIN32
 #ifdef _DEBUG
 #pragma comment(lib, "libcurl-d.lib")
@@ -1680,3 +1681,31 @@ TEST_CASE("variable registry test") {
     CHECK(baz_expr(expression::Parameters{&variable_registry, flow_file.get()}).asString() == "ff_baz");
   }
 }
+
+TEST_CASE("Function calls with static arguments are evaluated at compile time", "[expressionLanguageConstantFolding]") {
+  const auto expr = expression::compile("${literal('abc'):toUpper():append('-'):append(${literal(2):plus(3)})}");
+  CHECK_FALSE(expr.is_dynamic());
+  CHECK(expr(expression::Parameters{}).asString() == "ABC-5");
+
+  const auto uuid_expr = expression::compile("${UUID():toUpper()}");
+  CHECK(uuid_expr.is_dynamic());
+  CHECK(uuid_expr(expression::Parameters{}).asString() != uuid_expr(expression::Parameters{}).asString());
+}
+
+TEST_CASE("Regex functions with a literal pattern can be evaluated repeatedly", "[expressionLanguageRegexLiteral]") {
+  const auto replace_expr = expression::compile("${attr:replaceFirst('[aeiou]', '_'):replaceAll('[0-9]+', '#')}");
+  const auto matches_expr = expression::compile("${attr:matches('.*[0-9]{2}\\\\.txt')}");
+  const auto find_expr = expression::compile("${attr:find('new')}");
+  const auto invalid_pattern_expr = expression::compile("${attr:replaceAll('(', '')}");
+
+  for (const auto& [attribute, replaced, matches, found] : {
+      std::tuple{"a brand new file12.txt", "_ brand new file#.txt", true, true},
+      std::tuple{"old file1.txt", "_ld file#.txt", false, false}}) {
+    const auto flow_file = std::make_shared<core::FlowFileImpl>();
+    flow_file->addAttribute("attr", attribute);
+    CHECK(replace_expr(expression::Parameters{flow_file.get()}).asString() == replaced);
+    CHECK(matches_expr(expression::Parameters{flow_file.get()}).asBoolean() == matches);
+    CHECK(find_expr(expression::Parameters{flow_file.get()}).asBoolean() == found);
+    CHECK_THROWS(invalid_pattern_expr(expression::Parameters{flow_file.get()}));
+  }
+}
@@ -23,6 +23,9 @@
 #include "unit/TestBase.h"
 #include "unit/TestUtils.h"
 #include "io/FileStream.h"
+#include "io/BufferStream.h"
+#include "io/StreamPipe.h"
+#include "io/StreamSlice.h"
 #include "utils/file/FileUtils.h"
 
 TEST_CASE("TestFileOverWrite", "[TestFiles]") {
@@ -296,3 +299,42 @@ TEST_CASE("Readonly filestream write test") {
   REQUIRE(minifi::io::isError(stream.write("dolor sit amet", false)));
   REQUIRE(test_controller.getLog().getInstance().contains("Error writing to file: write call on file stream failed", std::chrono::seconds(0)));
 }
+
+TEST_CASE("Piping a file stream to another file stream copies the remaining content") {
+  TestController test_controller;
+  const auto dir = test_controller.createTempDirectory();
+  const auto source_path = dir / "source.txt";
+  const auto destination_path = dir / "destination.txt";
+  const std::string payload(minifi::io::MIN_KERNEL_COPY_SIZE * 3, 'x');
+  {
+    std::ofstream outfile(source_path, std::ios::binary);
+    outfile << "header|" << payload << "|trailer";
+  }
+
+  auto source = std::make_shared<minifi::io::FileStream>(source_path, 0, false);
+  minifi::io::StreamSlice slice(source, 4, payload.size() + 3);
+  slice.seek(3);
+  const auto region = minifi::io::getRemainingFileRegion(slice);
+  REQUIRE(region);
+  CHECK(region->path == source_path);
+  CHECK(region->offset == 7);
+  CHECK(region->size == payload.size());
+
+  minifi::io::FileStream destination(destination_path);
+  destination.write(reinterpret_cast<const uint8_t*>(">>"), 2);
+  REQUIRE(minifi::internal::pipe(slice, destination) == gsl::narrow<int64_t>(payload.size()));
+  CHECK(slice.tell() == slice.size());
+  CHECK(destination.tell() == payload.size() + 2);
+  CHECK(destination.size() == payload.size() + 2);
+
+  destination.write(reinterpret_cast<const uint8_t*>("<<"), 2);
+  destination.close();
+  CHECK(utils::file::get_content(destination_path) == ">>" + payload + "<<");
+}
+
+TEST_CASE("Streams not backed by files have no file region") {
+  minifi::io::BufferStream buffer_stream;
+  buffer_stream.write(reinterpret_cast<const uint8_t*>("data"), 4);
+  CHECK_FALSE(minifi::io::getRemainingFileRegion(buffer_stream));
+  CHECK(minifi::io::getUnderlyingFileStream(buffer_stream) == nullptr);
+}
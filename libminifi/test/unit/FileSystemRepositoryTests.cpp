@@ -20,10 +20,18 @@
 // as we measure the absolute memory usage that would fail this test
 #define EXTENSION_LIST ""  // NOLINT(cppcoreguidelines-macro-usage)
 
+#include <filesystem>
+#include <fstream>
 #include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "minifi-cpp/utils/gsl.h"
 #include "utils/OsUtils.h"
+#include "utils/Environment.h"
+#include "Defaults.h"
 #include "unit/TestUtils.h"
 #include "unit/TestBase.h"
 #include "unit/Catch.h"
@@ -31,6 +39,8 @@
 #include "core/repository/FileSystemRepository.h"
 #include "utils/file/FileUtils.h"
 #include "ResourceClaim.h"
+#include "io/MemoryMappedFileStream.h"
+#include "io/StreamSlice.h"
 
 using namespace std::literals::chrono_literals;
 
@@ -102,6 +112,8 @@ TEST_CASE("FileSystemRepository can retry removing entry that previously failed
   auto dir = testController.createTempDirectory();
   auto configuration = std::make_shared<org::apache::nifi::minifi::ConfigureImpl>();
   configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, dir.string());
+  // the repository directory is made read-only, so the content files have to be directly in it
+  configuration->set(minifi::Configure::nifi_content_repository_subdirectory_count, "0");
 
   auto content_repo = std::make_shared<TestFileSystemRepository>();
   REQUIRE(content_repo->initialize(configuration));
@@ -133,6 +145,8 @@ TEST_CASE("FileSystemRepository removes non-existing resource file from purge li
   auto dir = testController.createTempDirectory();
   auto configuration = std::make_shared<org::apache::nifi::minifi::ConfigureImpl>();
   configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, dir.string());
+  // the repository directory is made read-only, so the content files have to be directly in it
+  configuration->set(minifi::Configure::nifi_content_repository_subdirectory_count, "0");
 
   auto content_repo = std::make_shared<TestFileSystemRepository>();
   REQUIRE(content_repo->initialize(configuration));
@@ -201,5 +215,203 @@ TEST_CASE("Append Claim") {
   CHECK(content_repo->lockAppend(*claim, content.length() + appended.length()) != nullptr);
 }
 
+TEST_CASE("FileSystemRepository spreads the content over subdirectories and keeps track of the entry count") {
+  TestController testController;
+  auto dir = testController.createTempDirectory();
+  auto configuration = std::make_shared<org::apache::nifi::minifi::ConfigureImpl>();
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, dir.string());
+  configuration->set(minifi::Configure::nifi_content_repository_subdirectory_count, "16");
+
+  // content of the flat layout used by previous versions is counted and cleared as well
+  std::ofstream{dir / "legacy_content"} << "legacy";
+
+  {
+    auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+    REQUIRE(content_repo->initialize(configuration));
+    CHECK(content_repo->getRepositoryEntryCount() == 1);
+
+    std::vector<std::shared_ptr<minifi::ResourceClaim>> claims;
+    for (int i = 0; i < 100; ++i) {
+      auto claim = std::make_shared<minifi::ResourceClaimImpl>(content_repo);
+      content_repo->write(*claim)->write("hi");
+      CHECK(std::filesystem::path(claim->getContentFullPath()).parent_path().parent_path() == dir);
+      claims.push_back(claim);
+    }
+    CHECK(content_repo->getRepositoryEntryCount() == 101);
+    CHECK(minifi::utils::file::list_dir_all(dir, testController.getLogger()).size() == 101);
+
+    for (size_t i = 0; i < 50; ++i) {
+      content_repo->incrementStreamCount(*claims[i]);
+    }
+    claims.erase(claims.begin() + 50, claims.end());
+    CHECK(content_repo->getRepositoryEntryCount() == 51);
+  }
+
+  auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  REQUIRE(content_repo->initialize(configuration));
+  CHECK(content_repo->getRepositoryEntryCount() == 51);
+  content_repo->clearOrphans();
+  CHECK(content_repo->getRepositoryEntryCount() == 0);
+  CHECK(minifi::utils::file::list_dir_all(dir, testController.getLogger()).empty());
+}
+
+TEST_CASE("FileSystemRepository clears orphans written with a different subdirectory count") {
+  TestController testController;
+  auto dir = testController.createTempDirectory();
+  auto configuration = std::make_shared<org::apache::nifi::minifi::ConfigureImpl>();
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, dir.string());
+  configuration->set(minifi::Configure::nifi_content_repository_subdirectory_count, "16");
+
+  {
+    auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+    REQUIRE(content_repo->initialize(configuration));
+    std::vector<std::shared_ptr<minifi::ResourceClaim>> claims;
+    for (int i = 0; i < 20; ++i) {
+      auto claim = std::make_shared<minifi::ResourceClaimImpl>(content_repo);
+      content_repo->write(*claim)->write("hi");
+      // the content is kept when the claim is released
+      content_repo->incrementStreamCount(*claim);
+      claims.push_back(claim);
+    }
+  }
+  REQUIRE(minifi::utils::file::list_dir_all(dir, testController.getLogger()).size() == 20);
+
+  configuration->set(minifi::Configure::nifi_content_repository_subdirectory_count, "4");
+  auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  REQUIRE(content_repo->initialize(configuration));
+  CHECK(content_repo->getRepositoryEntryCount() == 20);
+  content_repo->clearOrphans();
+  CHECK(content_repo->getRepositoryEntryCount() == 0);
+  CHECK(minifi::utils::file::list_dir_all(dir, testController.getLogger()).empty());
+}
+
+TEST_CASE("FileSystemRepository only clears orphans from its own subdirectories") {
+  TestController testController;
+  auto dir = testController.createTempDirectory();
+  std::filesystem::create_directories(dir / "conf");
+  std::ofstream{dir / "conf" / "minifi.properties"} << "nifi.flow.configuration.file=./conf/config.yml";
+  auto configuration = std::make_shared<org::apache::nifi::minifi::ConfigureImpl>();
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, dir.string());
+  configuration->set(minifi::Configure::nifi_content_repository_subdirectory_count, "16");
+
+  auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  REQUIRE(content_repo->initialize(configuration));
+  CHECK(content_repo->getRepositoryEntryCount() == 0);
+  content_repo->clearOrphans();
+  CHECK(std::filesystem::exists(dir / "conf" / "minifi.properties"));
+}
+
+TEST_CASE("FileSystemRepository does not clear orphans when falling back to MINIFI_HOME") {
+  TestController testController;
+  auto dir = testController.createTempDirectory();
+  std::ofstream{dir / "minifi.pid"} << "1234";
+  const auto minifi_home_key = std::string(MINIFI_HOME_ENV_KEY);
+  const auto previous_minifi_home = minifi::utils::Environment::getEnvironmentVariable(minifi_home_key.c_str());
+  REQUIRE(minifi::utils::Environment::setEnvironmentVariable(minifi_home_key.c_str(), dir.string().c_str()));
+  const auto restore_minifi_home = gsl::finally([&] {
+    if (previous_minifi_home) {
+      minifi::utils::Environment::setEnvironmentVariable(minifi_home_key.c_str(), previous_minifi_home->c_str());
+    } else {
+      minifi::utils::Environment::unsetEnvironmentVariable(minifi_home_key.c_str());
+    }
+  });
+  auto configuration = std::make_shared<org::apache::nifi::minifi::ConfigureImpl>();
+  configuration->set(minifi::Configure::nifi_content_repository_subdirectory_count, "0");
+
+  auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  REQUIRE(content_repo->initialize(configuration));
+  content_repo->clearOrphans();
+  CHECK(std::filesystem::exists(dir / "minifi.pid"));
+}
+
+TEST_CASE("FileSystemRepository sessions pack new content into shared containers") {
+  TestController testController;
+  auto dir = testController.createTempDirectory();
+  auto configuration = std::make_shared<org::apache::nifi::minifi::ConfigureImpl>();
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, dir.string());
+  configuration->set(minifi::Configure::nifi_content_repository_max_container_size, "10 B");
+  auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  REQUIRE(content_repo->initialize(configuration));
+
+  auto session = content_repo->createSession();
+  std::vector<core::ContentSession::NewContent> contents;
+  for (const std::string_view data : {"aaaa", "bbbb", "cccc", "dddd"}) {
+    auto content = session->writeNewContent();
+    content.stream->write(as_bytes(std::span(data)));
+    CHECK(content.stream->size() == data.size());
+    content.stream->close();
+    content.stream.reset();
+    contents.push_back(std::move(content));
+  }
+
+  // the fourth content does not fit into the first container
+  CHECK(contents[1].claim == contents[0].claim);
+  CHECK(contents[2].claim == contents[0].claim);
+  CHECK(contents[3].claim != contents[0].claim);
+  CHECK(contents[0].offset == 0);
+  CHECK(contents[1].offset == 4);
+  CHECK(contents[2].offset == 8);
+  CHECK(contents[3].offset == 0);
+  CHECK(content_repo->getRepositoryEntryCount() == 2);
+
+  std::string read_content(4, '\0');
+  minifi::io::StreamSlice second_content(content_repo->read(*contents[1].claim), contents[1].offset, 4);
+  second_content.read(as_writable_bytes(std::span(read_content)));
+  CHECK(read_content == "bbbb");
+
+  SECTION("Nested writes get a claim of their own") {
+    auto outer = session->writeNewContent();
+    auto nested = session->writeNewContent();
+    CHECK(nested.claim != outer.claim);
+    CHECK(nested.offset == 0);
+  }
+
+  SECTION("Containers are removed when none of their content is referenced") {
+    session->commit();
+    const auto container_path = contents[0].claim->getContentFullPath();
+    contents.erase(contents.begin(), contents.begin() + 2);
+    CHECK(std::filesystem::exists(container_path));
+    contents.erase(contents.begin());
+    CHECK_FALSE(std::filesystem::exists(container_path));
+    CHECK(content_repo->getRepositoryEntryCount() == 1);
+  }
+}
+
+TEST_CASE("FileSystemRepository can read content through memory mapped streams") {
+  TestController testController;
+  auto dir = testController.createTempDirectory();
+  auto configuration = std::make_shared<org::apache::nifi::minifi::ConfigureImpl>();
+  configuration->set(minifi::Configure::nifi_dbcontent_repository_directory_default, dir.string());
+  configuration->set(minifi::Configure::nifi_content_repository_memory_mapped_reads, "true");
+  auto content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  REQUIRE(content_repo->initialize(configuration));
+
+  const std::string content = "first line\nsecond line\n";
+  auto claim = std::make_shared<minifi::ResourceClaimImpl>(content_repo);
+  content_repo->write(*claim)->write(as_bytes(std::span(content)));
+
+  auto stream = content_repo->read(*claim);
+  REQUIRE(dynamic_cast<minifi::io::MemoryMappedFileStream*>(stream.get()) != nullptr);
+  CHECK(stream->size() == content.size());
+
+  std::string read_content(content.size(), '\0');
+  CHECK(stream->read(as_writable_bytes(std::span(read_content))) == content.size());
+  CHECK(read_content == content);
+  CHECK(stream->read(as_writable_bytes(std::span(read_content))) == 0);
+  CHECK(minifi::io::isError(stream->write(as_bytes(std::span(content)))));
+
+  // only the content of the slice is returned, starting from its current position
+  minifi::io::StreamSlice second_line(stream, 11, 12);
+  second_line.seek(7);
+  const auto buffer = minifi::io::getContiguousBuffer(second_line);
+  REQUIRE(buffer);
+  CHECK(std::string_view(reinterpret_cast<const char*>(buffer->data()), buffer->size()) == "line\n");
+
+  auto empty_claim = std::make_shared<minifi::ResourceClaimImpl>(content_repo);
+  content_repo->write(*empty_claim)->close();
+  auto empty_stream = content_repo->read(*empty_claim);
+  CHECK(empty_stream->size() == 0);
+  CHECK(minifi::io::getContiguousBuffer(*empty_stream)->empty());
+}
 
 }  // namespace org::apache::nifi::minifi::test
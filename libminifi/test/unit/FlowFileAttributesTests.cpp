@@ -0,0 +1,108 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <array>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "unit/TestBase.h"
+#include "unit/Catch.h"
+#include "core/FlowFile.h"
+
+namespace {
+const core::FlowFile::AttributeMap* attributeMapOf(const core::FlowFile& flow_file) {
+  return flow_file.getAttributesPtr();
+}
+}  // namespace
+
+TEST_CASE("Inherited attributes are shared with the parent until modified", "[FlowFileAttributes]") {
+  core::FlowFileImpl parent;
+  parent.setAttribute("filename", "parent.txt");
+  parent.setAttribute("path", "/tmp/");
+  parent.setAttribute("uuid", "parent-uuid");
+
+  constexpr std::array<std::string_view, 1> excluded_keys{"uuid"};
+  core::FlowFileImpl child;
+  child.setAttribute("filename", "child.txt");
+  child.setAttribute("child.only", "value");
+  child.inheritAttributes(parent, excluded_keys);
+
+  CHECK(child.getAttribute("filename") == "parent.txt");
+  CHECK(child.getAttribute("path") == "/tmp/");
+  CHECK(child.getAttribute("child.only") == "value");
+  CHECK_FALSE(child.getAttribute("uuid"));
+
+  core::FlowFileImpl plain_child;
+  plain_child.inheritAttributes(parent, {});
+  CHECK(attributeMapOf(plain_child) == attributeMapOf(parent));
+
+  SECTION("Setting an attribute to its current value keeps sharing") {
+    plain_child.setAttribute("path", "/tmp/");
+    CHECK(attributeMapOf(plain_child) == attributeMapOf(parent));
+  }
+
+  SECTION("Modifying the child does not affect the parent") {
+    plain_child.setAttribute("path", "/var/");
+    plain_child.removeAttribute("filename");
+    CHECK(plain_child.getAttribute("path") == "/var/");
+    CHECK(parent.getAttribute("path") == "/tmp/");
+    CHECK(parent.getAttribute("filename") == "parent.txt");
+  }
+
+  SECTION("Modifying the parent does not affect the child") {
+    parent.updateAttribute("path", "/var/");
+    parent.addAttribute("new", "attribute");
+    CHECK(plain_child.getAttribute("path") == "/tmp/");
+    CHECK_FALSE(plain_child.getAttribute("new"));
+  }
+
+  SECTION("Getting the mutable attribute map stops sharing") {
+    plain_child.getAttributesPtr()->insert_or_assign(std::string{"path"}, std::string{"/var/"});
+    CHECK(parent.getAttribute("path") == "/tmp/");
+  }
+}
+
+TEST_CASE("Flow files sharing their attributes can be modified on different threads", "[FlowFileAttributes]") {
+  core::FlowFileImpl parent;
+  parent.setAttribute("filename", "parent.txt");
+
+  constexpr size_t CHILD_COUNT = 8;
+  std::vector<core::FlowFileImpl> children(CHILD_COUNT);
+  for (auto& child : children) {
+    child.inheritAttributes(parent, {});
+  }
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < CHILD_COUNT; ++i) {
+    threads.emplace_back([&child = children[i], i] {
+      for (size_t j = 0; j < 100; ++j) {
+        child.setAttribute("filename", "child" + std::to_string(i) + "_" + std::to_string(j) + ".txt");
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  CHECK(parent.getAttribute("filename") == "parent.txt");
+  for (size_t i = 0; i < CHILD_COUNT; ++i) {
+    CHECK(children[i].getAttribute("filename") == "child" + std::to_string(i) + "_99.txt");
+  }
+}
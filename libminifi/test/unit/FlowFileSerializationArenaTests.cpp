@@ -0,0 +1,56 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "unit/TestBase.h"
+#include "unit/Catch.h"
+#include "FlowFileRecord.h"
+#include "core/FlowFileSerializationArena.h"
+#include "io/BufferStream.h"
+
+TEST_CASE("FlowFileSerializationArena produces the same entries as serializing the flow files one by one", "[FlowFileSerializationArena]") {
+  std::vector<std::shared_ptr<minifi::FlowFileRecordImpl>> flow_files;
+  for (int i = 0; i < 3; ++i) {
+    auto flow_file = std::make_shared<minifi::FlowFileRecordImpl>();
+    flow_file->setSize(i * 100);
+    flow_file->addAttribute("index", std::to_string(i));
+    flow_files.push_back(flow_file);
+  }
+
+  core::FlowFileSerializationArena arena;
+  for (int round = 0; round < 2; ++round) {
+    for (const auto& flow_file : flow_files) {
+      arena.add(*flow_file);
+    }
+    REQUIRE(arena.size() == flow_files.size());
+
+    const auto entries = arena.entries();
+    REQUIRE(entries.size() == flow_files.size());
+    for (size_t i = 0; i < flow_files.size(); ++i) {
+      CHECK(entries[i].first == flow_files[i]->getUUIDStr().view());
+      minifi::io::BufferStream expected;
+      flow_files[i]->Serialize(expected);
+      CHECK(std::ranges::equal(entries[i].second, expected.getBuffer()));
+    }
+
+    arena.clear();
+    CHECK(arena.empty());
+  }
+}
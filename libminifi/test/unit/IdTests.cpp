@@ -21,6 +21,8 @@
 #include <ctime>
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <vector>
 #include "unit/TestBase.h"
 #include "unit/Catch.h"
 #include "utils/Id.h"
@@ -102,6 +104,42 @@ TEST_CASE("Test random", "[id]") {
   LogTestController::getInstance().reset();
 }
 
+TEST_CASE("Test time ordered", "[id]") {
+  TestController test_controller;
+
+  LogTestController::getInstance().setDebug<utils::IdGenerator>();
+  std::shared_ptr<minifi::Properties> id_props = std::make_shared<minifi::PropertiesImpl>(minifi::PropertiesImpl::PersistTo::MultipleFiles, "UID properties");
+  id_props->set("uid.implementation", "Time_Ordered");
+
+  std::shared_ptr<utils::IdGenerator> generator = utils::IdGenerator::getIdGenerator();
+  generator->initialize(id_props);
+
+  REQUIRE(true == LogTestController::getInstance().contains("Using time ordered (version 7) implementation for uids."));
+
+  const auto before = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+  std::vector<utils::Identifier> uuids(16 * 1024U);
+  for (auto& uuid : uuids) {
+    uuid = generator->generate();
+  }
+
+  const auto& first = IdentifierTestAccessor::get_data_(uuids.front());
+  REQUIRE(0x07 == (first[6] >> 4));
+  REQUIRE(0x02 == (first[8] >> 6));
+  int64_t timestamp = 0;
+  for (size_t i = 0; i < 6; ++i) {
+    timestamp = (timestamp << 8) | first[i];
+  }
+  REQUIRE(before <= timestamp);
+
+  // the identifiers generated by a thread are increasing, both as bytes and as strings
+  REQUIRE(std::adjacent_find(uuids.begin(), uuids.end(), [](const utils::Identifier& a, const utils::Identifier& b) {
+    return memcmp(IdentifierTestAccessor::get_data_(a).data(), IdentifierTestAccessor::get_data_(b).data(), 16U) >= 0
+        || a.to_string().view() >= b.to_string().view();
+  }) == uuids.end());
+
+  LogTestController::getInstance().reset();
+}
+
 TEST_CASE("Test uuid_default", "[id]") {
   TestController test_controller;
 
@@ -327,6 +365,9 @@ TEST_CASE("Collision", "[collision]") {
   SECTION("uuid_default") {
     id_props->set("uid.implementation", "uuid_default");
   }
+  SECTION("time_ordered") {
+    id_props->set("uid.implementation", "time_ordered");
+  }
 
   std::shared_ptr<utils::IdGenerator> generator = utils::IdGenerator::getIdGenerator();
   generator->initialize(id_props);
@@ -368,6 +409,9 @@ TEST_CASE("Speed", "[speed]") {
   SECTION("uuid_default") {
     implementation = "uuid_default";
   }
+  SECTION("time_ordered") {
+    implementation = "time_ordered";
+  }
   id_props->set("uid.implementation", implementation);
 
   std::shared_ptr<utils::IdGenerator> generator = utils::IdGenerator::getIdGenerator();
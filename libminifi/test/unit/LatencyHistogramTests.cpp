@@ -0,0 +1,86 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "unit/TestBase.h"
+#include "unit/Catch.h"
+#include "utils/LatencyHistogram.h"
+
+using namespace std::literals::chrono_literals;
+using minifi::utils::LatencyHistogram;
+
+TEST_CASE("Every value falls into the bucket it is reported with", "[LatencyHistogram]") {
+  for (const uint64_t value : std::vector<uint64_t>{0, 1, 31, 32, 33, 63, 64, 65, 1000, 123456789, LatencyHistogram::MAX_VALUE}) {
+    const auto index = LatencyHistogram::bucketIndex(value);
+    REQUIRE(index < LatencyHistogram::BUCKET_COUNT);
+    CHECK(LatencyHistogram::bucketUpperBound(index) >= value);
+    if (index > 0) {
+      CHECK(LatencyHistogram::bucketUpperBound(index - 1) < value);
+    }
+  }
+  CHECK(LatencyHistogram::bucketIndex(LatencyHistogram::MAX_VALUE) == LatencyHistogram::BUCKET_COUNT - 1);
+  CHECK(LatencyHistogram::bucketIndex(std::numeric_limits<uint64_t>::max()) == LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST_CASE("LatencyHistogram reports percentiles within its precision", "[LatencyHistogram]") {
+  LatencyHistogram histogram;
+  CHECK(histogram.percentile(0.5) == 0ns);
+
+  std::mt19937_64 generator{42};
+  std::lognormal_distribution<double> distribution{10.0, 2.0};
+  std::vector<int64_t> values;
+  for (int i = 0; i < 100000; ++i) {
+    values.push_back(static_cast<int64_t>(distribution(generator)));
+    histogram.record(std::chrono::nanoseconds{values.back()});
+  }
+  std::ranges::sort(values);
+
+  CHECK(histogram.count() == values.size());
+  CHECK(histogram.max().count() == values.back());
+  for (const double ratio : {0.5, 0.9, 0.99, 0.999}) {
+    const auto exact = values[static_cast<size_t>(std::ceil(ratio * static_cast<double>(values.size()))) - 1];
+    const auto reported = histogram.percentile(ratio).count();
+    CHECK(reported >= exact);
+    CHECK(static_cast<double>(reported - exact) <= static_cast<double>(exact) / 32.0);
+  }
+  CHECK(histogram.percentile(1.0).count() == values.back());
+}
+
+TEST_CASE("LatencyHistogram can be recorded from multiple threads", "[LatencyHistogram]") {
+  LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int thread_index = 0; thread_index < 4; ++thread_index) {
+    threads.emplace_back([&histogram, thread_index] {
+      for (int i = 0; i < 10000; ++i) {
+        histogram.record(std::chrono::microseconds{thread_index + 1});
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  CHECK(histogram.count() == 40000);
+  CHECK(histogram.max() == 4us);
+  CHECK(histogram.percentile(0.2) < 2us);
+  CHECK(histogram.percentile(0.8) == 4us);
+}
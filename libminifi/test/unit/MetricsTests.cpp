@@ -15,7 +15,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <map>
 #include <memory>
+#include <set>
+#include <string>
+#include <thread>
 
 #include "../../include/core/state/nodes/QueueMetrics.h"
 #include "../../include/core/state/nodes/RepositoryMetrics.h"
@@ -31,6 +35,7 @@
 #include "core/ProcessorMetrics.h"
 #include "unit/TestUtils.h"
 #include "Connection.h"
+#include "FlowFileRecord.h"
 
 using namespace std::literals::chrono_literals;
 
@@ -74,12 +79,39 @@ TEST_CASE("QueueMetricsTestConnections", "[c2m3]") {
   minifi::state::response::SerializedResponseNode resp = metrics.serialize().at(0);
 
   REQUIRE("testconnection" == resp.name);
-  REQUIRE(4 == resp.children.size());
+  REQUIRE(7 == resp.children.size());
 
   checkSerializedValue(resp.children, "datasize", "0");
   checkSerializedValue(resp.children, "datasizemax", "1024");
   checkSerializedValue(resp.children, "queued", "0");
   checkSerializedValue(resp.children, "queuedmax", "1024");
+  checkSerializedValue(resp.children, "waittimenanosp50", "0");
+  checkSerializedValue(resp.children, "waittimenanosp99", "0");
+  checkSerializedValue(resp.children, "waittimenanosp999", "0");
+}
+
+TEST_CASE("QueueMetrics reports the time flow files spent in the queue", "[c2m3]") {
+  minifi::state::response::QueueMetrics metrics;
+  std::shared_ptr<core::ContentRepository> content_repo = std::make_shared<core::repository::VolatileContentRepository>();
+  content_repo->initialize(std::make_shared<minifi::ConfigureImpl>());
+  auto connection = std::make_unique<minifi::ConnectionImpl>(std::make_shared<TestRepository>(), content_repo, "testconnection");
+  metrics.updateConnection(connection.get());
+
+  connection->put(std::make_shared<minifi::FlowFileRecordImpl>());
+  std::this_thread::sleep_for(10ms);
+  std::set<std::shared_ptr<core::FlowFile>> expired_flow_files;
+  REQUIRE(connection->poll(expired_flow_files));
+
+  CHECK(connection->getQueueWaitTimePercentile(0.5) >= 10ms);
+  size_t wait_time_metric_count = 0;
+  for (const auto& metric : metrics.calculateMetrics()) {
+    if (metric.name == "queue_wait_time_nanoseconds") {
+      ++wait_time_metric_count;
+      CHECK(metric.value >= 10'000'000.0);
+      CHECK(metric.labels.contains("quantile"));
+    }
+  }
+  CHECK(wait_time_metric_count == 3);
 }
 
 TEST_CASE("RepositorymetricsNoRepo", "[c2m4]") {
@@ -207,6 +239,37 @@ TEST_CASE("Test on trigger runtime processor metrics", "[ProcessorMetrics]") {
   metrics.addLastOnTriggerRuntime(10ms);
   REQUIRE(metrics.getLastOnTriggerRuntime() == 10ms);
   REQUIRE(metrics.getAverageOnTriggerRuntime() == 37ms);
+
+  // the histogram keeps every runtime, not only the last 10
+  CHECK(metrics.getOnTriggerRuntimeHistogram().count() == 24);
+  CHECK(metrics.getOnTriggerRuntimeHistogram().max() == 50ms);
+  const auto median = metrics.getOnTriggerRuntimeHistogram().percentile(0.5);
+  CHECK(median >= 40ms);
+  CHECK(median <= 42ms);
+}
+
+TEST_CASE("Processor metrics publish the tail latencies of onTrigger calls", "[ProcessorMetrics]") {
+  auto dummy_processor = minifi::test::utils::make_processor<DummyProcessor>("dummy");
+  minifi::core::ProcessorMetrics metrics(*dummy_processor);
+  for (auto i = 0; i < 999; ++i) {
+    metrics.addLastOnTriggerRuntime(100us);
+  }
+  metrics.addLastOnTriggerRuntime(1s);
+
+  std::map<std::string, double> published_percentiles;
+  for (const auto& metric : metrics.calculateMetrics()) {
+    if (metric.name == "onTrigger_runtime_nanoseconds") {
+      published_percentiles[metric.labels.at("quantile")] = metric.value;
+    }
+  }
+  REQUIRE(published_percentiles.size() == 3);
+  CHECK(published_percentiles["0.5"] == Catch::Approx(100'000).epsilon(0.04));
+  CHECK(published_percentiles["0.99"] == Catch::Approx(100'000).epsilon(0.04));
+  CHECK(published_percentiles["0.999"] == Catch::Approx(100'000).epsilon(0.04));
+  CHECK(metrics.getOnTriggerRuntimeHistogram().max() == 1s);
+
+  metrics.addLastOnTriggerRuntime(1s);
+  CHECK(metrics.getOnTriggerRuntimeHistogram().percentile(0.999) == 1s);
 }
 
 TEST_CASE("Test commit runtime processor metrics", "[ProcessorMetrics]") {
@@ -103,6 +103,11 @@ TEST_CASE("ProcessSession::read reads the flowfile from offset to size", "[reado
   ContentRepositoryDependentTests::testReadOnSmallerClonedFlowFiles(std::make_shared<minifi::core::repository::FileSystemRepository>());
 }
 
+TEST_CASE("ProcessSession::clone with offset and size references the content of the parent", "[cloneslice]") {
+  ContentRepositoryDependentTests::testSliceClonesShareTheClaimOfTheParent(std::make_shared<minifi::core::repository::VolatileContentRepository>());
+  ContentRepositoryDependentTests::testSliceClonesShareTheClaimOfTheParent(std::make_shared<minifi::core::repository::FileSystemRepository>());
+}
+
 TEST_CASE("ProcessSession::append should append to the flowfile and set its size correctly" "[appendsetsize]") {
   SECTION("Unmanaged") {
     SECTION("VolatileContentRepository") {
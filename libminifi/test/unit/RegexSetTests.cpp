@@ -0,0 +1,98 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include "utils/RegexSet.h"
+#include "unit/TestBase.h"
+#include "unit/Catch.h"
+#include "catch2/matchers/catch_matchers_string.hpp"
+
+namespace utils = org::apache::nifi::minifi::utils;
+using utils::Regex;
+using utils::RegexSet;
+
+namespace {
+
+void checkSameResultsAsRegex(const std::vector<std::string>& patterns, const std::vector<std::string>& inputs, const std::vector<Regex::Mode>& modes = {}) {
+  for (const auto match_mode : {RegexSet::MatchMode::FULL_MATCH, RegexSet::MatchMode::SEARCH}) {
+    RegexSet regex_set(patterns, match_mode, modes);
+    for (const auto& input : inputs) {
+      const auto matches = regex_set.match(input);
+      REQUIRE(matches.size() == patterns.size());
+      for (size_t i = 0; i < patterns.size(); ++i) {
+        const Regex regex(patterns[i], modes);
+        const bool expected = match_mode == RegexSet::MatchMode::FULL_MATCH ? utils::regexMatch(input, regex) : utils::regexSearch(input, regex);
+        INFO("pattern: " << patterns[i] << ", input: " << input << ", full match: " << (match_mode == RegexSet::MatchMode::FULL_MATCH));
+        CHECK(matches[i] == expected);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("RegexSet matches the same inputs as the individual regexes", "[regexset]") {
+  const std::vector<std::string> patterns{
+    "Speed limit [0-9]+", "error|warn", "^(ERROR|WARN) module[0-9]{1,3}:", "[[:upper:]][a-z]*", "colou?r", "a.c", "\\w+@\\w+\\.com$",
+    "[^ ]+ +[^ ]+", "x{2,}", "(ab)*c", "\\s\\S", "file\\.txt", "[a-c-]+", "(a|b)+$"
+  };
+  const std::vector<std::string> inputs{
+    "", "Speed limit 130", "speed limit 80", "warn", "an error", "ERROR module12: disk failed", "WARN module1234: x", "Hello", "color",
+    "colour", "abc", "a\nc", "john@example.com", "john@example.com ", "two words", "xx", "x", "ababc", "c", "abac", " a", "file.txt",
+    "filetxt", "a-c", "abba", "abbac"
+  };
+  checkSameResultsAsRegex(patterns, inputs);
+  checkSameResultsAsRegex(patterns, inputs, {Regex::Mode::ICASE});
+}
+
+TEST_CASE("RegexSet falls back to Regex for the patterns not supported by the automaton", "[regexset]") {
+  const std::vector<std::string> patterns{"a[0-9]+b", "(a)\\1", "\\d+", "\\bword", "[\\]]", "(a|)", "a^b"};
+  RegexSet regex_set(patterns, RegexSet::MatchMode::SEARCH);
+  CHECK(regex_set.isMatchedByAutomaton(0));
+  for (size_t i = 1; i < patterns.size(); ++i) {
+    INFO("pattern: " << patterns[i]);
+    CHECK_FALSE(regex_set.isMatchedByAutomaton(i));
+  }
+  const auto matches = regex_set.match("a12b");
+  CHECK(matches[0]);
+  CHECK_FALSE(matches[1]);
+}
+
+TEST_CASE("RegexSet reports invalid patterns like Regex", "[regexset]") {
+  REQUIRE_THROWS_WITH(RegexSet({"valid", "[Invalid)A(F)"}, RegexSet::MatchMode::SEARCH), Catch::Matchers::StartsWith("Regex Operation"));
+}
+
+TEST_CASE("RegexSet matches many patterns against a long input", "[regexset]") {
+  std::vector<std::string> patterns;
+  for (size_t i = 0; i < 50; ++i) {
+    patterns.push_back("(ERROR|WARN) module" + std::to_string(i) + ": [a-z]+ failed");
+  }
+  std::string input;
+  for (size_t i = 0; i < 10000; ++i) {
+    input += "INFO module" + std::to_string(i % 70) + ": request handled in 12 ms\n";
+  }
+  input += "WARN module42: disk failed\n";
+
+  RegexSet regex_set(patterns, RegexSet::MatchMode::SEARCH);
+  const auto matches = regex_set.match(input);
+  for (size_t i = 0; i < patterns.size(); ++i) {
+    CHECK(matches[i] == (i == 42));
+  }
+}
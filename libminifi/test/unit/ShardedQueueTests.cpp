@@ -0,0 +1,108 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "unit/TestBase.h"
+#include "unit/Catch.h"
+#include "utils/ShardedQueue.h"
+
+namespace utils = org::apache::nifi::minifi::utils;
+
+TEST_CASE("ShardedQueue keeps the order of the elements pushed by a thread", "[ShardedQueue]") {
+  utils::ShardedQueue<int> queue(4);
+  for (int i = 0; i < 10; ++i) {
+    queue.push(i);
+  }
+  queue.push(std::vector<int>{10, 11, 12});
+  CHECK(queue.size() == 13);
+
+  std::thread consumer([&queue] {
+    for (int i = 0; i < 13; ++i) {
+      const auto value = queue.tryPop();
+      REQUIRE(value);
+      CHECK(*value == i);
+    }
+  });
+  consumer.join();
+  CHECK(queue.empty());
+  CHECK_FALSE(queue.tryPop());
+}
+
+TEST_CASE("ShardedQueue pops the oldest element regardless of the pushing thread", "[ShardedQueue]") {
+  utils::ShardedQueue<int> queue(4);
+  for (int i = 0; i < 8; ++i) {
+    // every element is pushed by a different thread, so they are spread across the shards
+    std::thread producer([&queue, i] { queue.push(i); });
+    producer.join();
+  }
+
+  for (int i = 0; i < 8; ++i) {
+    const auto value = queue.tryPop();
+    REQUIRE(value);
+    CHECK(*value == i);
+  }
+  CHECK(queue.empty());
+}
+
+TEST_CASE("ShardedQueue returns every element exactly once with concurrent producers and consumers", "[ShardedQueue]") {
+  utils::ShardedQueue<int> queue(4);
+  constexpr int PRODUCER_COUNT = 4;
+  constexpr int ELEMENTS_PER_PRODUCER = 1000;
+  std::vector<std::thread> threads;
+  for (int producer = 0; producer < PRODUCER_COUNT; ++producer) {
+    threads.emplace_back([&queue, producer] {
+      for (int i = 0; i < ELEMENTS_PER_PRODUCER; ++i) {
+        queue.push(producer * ELEMENTS_PER_PRODUCER + i);
+      }
+    });
+  }
+  std::atomic<int> popped_count = 0;
+  std::vector<std::vector<int>> results(PRODUCER_COUNT);
+  for (auto& result : results) {
+    threads.emplace_back([&queue, &popped_count, &result] {
+      while (popped_count < PRODUCER_COUNT * ELEMENTS_PER_PRODUCER) {
+        if (const auto value = queue.tryPop()) {
+          result.push_back(*value);
+          ++popped_count;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::set<int> all_results;
+  for (const auto& result : results) {
+    all_results.insert(result.begin(), result.end());
+  }
+  CHECK(all_results.size() == PRODUCER_COUNT * ELEMENTS_PER_PRODUCER);
+  CHECK(queue.empty());
+}
+
+TEST_CASE("ShardedQueue can be cleared", "[ShardedQueue]") {
+  utils::ShardedQueue<int> queue(2);
+  queue.push(std::vector<int>{1, 2, 3});
+  queue.clear();
+  CHECK(queue.size() == 0);
+  CHECK_FALSE(queue.tryPop());
+}
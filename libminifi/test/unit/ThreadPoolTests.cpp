@@ -16,11 +16,15 @@
  * limitations under the License.
  */
 
+#include <array>
+#include <string>
 #include <utility>
+#include <vector>
 #include <future>
 #include <memory>
 #include "unit/TestBase.h"
 #include "unit/Catch.h"
+#include "unit/TestUtils.h"
 #include "utils/ThreadPool.h"
 
 using namespace std::literals::chrono_literals;
@@ -74,3 +78,87 @@ TEST_CASE("Worker wait time should be relative to the last run") {
   REQUIRE(worker_execution_time_points.size() == 2);
   CHECK(worker_execution_time_points[1] - worker_execution_time_points[0] >= wait_time_between_tasks);
 }
+
+TEST_CASE("Delayed tasks can be woken up before their next execution time") {
+  std::atomic<size_t> counter = 0;
+  utils::ThreadPool pool(1);
+  utils::Worker worker([&counter]() {
+    if (++counter == 2) {
+      return utils::TaskRescheduleInfo::Done();
+    }
+    return utils::TaskRescheduleInfo::RetryIn(1h);
+  }, "id");
+
+  std::future<utils::TaskRescheduleInfo> task_future;
+  pool.execute(std::move(worker), task_future);
+  pool.start();
+
+  REQUIRE(minifi::test::utils::verifyEventHappenedInPollTime(1s, [&counter] { return counter == 1; }));
+  pool.wakeUp("other_id");
+  std::this_thread::sleep_for(10ms);
+  CHECK(counter == 1);
+
+  pool.wakeUp("id");
+  REQUIRE(task_future.wait_for(1s) == std::future_status::ready);
+  CHECK(task_future.get().isFinished());
+  CHECK(counter == 2);
+}
+
+TEST_CASE("Waking up a delayed task leaves the other delayed tasks in place") {
+  std::atomic<size_t> woken_up_counter = 0;
+  std::atomic<size_t> other_counter = 0;
+  utils::ThreadPool pool(2);
+  const auto make_worker = [](std::atomic<size_t>& counter, std::string id) {
+    return utils::Worker([&counter]() {
+      if (++counter == 3) {
+        return utils::TaskRescheduleInfo::Done();
+      }
+      return utils::TaskRescheduleInfo::RetryIn(1h);
+    }, std::move(id));
+  };
+
+  std::future<utils::TaskRescheduleInfo> woken_up_future;
+  std::future<utils::TaskRescheduleInfo> other_future;
+  pool.execute(make_worker(woken_up_counter, "id"), woken_up_future);
+  pool.execute(make_worker(other_counter, "other_id"), other_future);
+  pool.start();
+
+  REQUIRE(minifi::test::utils::verifyEventHappenedInPollTime(1s, [&] { return woken_up_counter == 1 && other_counter == 1; }));
+  pool.wakeUp("id");
+  REQUIRE(minifi::test::utils::verifyEventHappenedInPollTime(1s, [&] { return woken_up_counter == 2; }));
+  pool.wakeUp("id");
+  REQUIRE(woken_up_future.wait_for(1s) == std::future_status::ready);
+  CHECK(woken_up_counter == 3);
+  CHECK(other_counter == 1);
+
+  pool.stopTasks("other_id");
+  pool.wakeUp("other_id");
+  std::this_thread::sleep_for(10ms);
+  CHECK(other_counter == 1);
+}
+
+TEST_CASE("Work stealing thread pool runs every task") {
+  constexpr size_t task_count = 20;
+  constexpr size_t runs_per_task = 10;
+  std::array<std::atomic<size_t>, task_count> run_counts{};
+  utils::ThreadPool pool(4, nullptr, "WorkStealingPool", utils::ThreadPoolSchedulingMode::WORK_STEALING);
+  pool.start();
+
+  std::vector<std::future<utils::TaskRescheduleInfo>> futures(task_count);
+  for (size_t i = 0; i < task_count; ++i) {
+    utils::Worker worker([&run_count = run_counts[i]]() {
+      if (++run_count == runs_per_task) {
+        return utils::TaskRescheduleInfo::Done();
+      }
+      return utils::TaskRescheduleInfo::RetryImmediately();
+    }, "id" + std::to_string(i));
+    pool.execute(std::move(worker), futures[i]);
+  }
+
+  for (auto& future : futures) {
+    CHECK(future.get().isFinished());
+  }
+  for (const auto& run_count : run_counts) {
+    CHECK(run_count == runs_per_task);
+  }
+}
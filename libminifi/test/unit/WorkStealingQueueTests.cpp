@@ -0,0 +1,116 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "unit/TestBase.h"
+#include "unit/Catch.h"
+#include "utils/WorkStealingQueue.h"
+
+namespace utils = org::apache::nifi::minifi::utils;
+
+TEST_CASE("WorkStealingQueue returns every element exactly once", "[WorkStealingQueue]") {
+  utils::WorkStealingQueue<int> queue(4);
+  for (int i = 0; i < 100; ++i) {
+    queue.enqueue(i);
+  }
+  REQUIRE(queue.size() == 100);
+
+  std::set<int> results;
+  int value = 0;
+  while (!queue.empty() && queue.dequeueWait(value)) {
+    CHECK(results.insert(value).second);
+  }
+  CHECK(results.size() == 100);
+}
+
+TEST_CASE("A registered consumer takes its own elements first", "[WorkStealingQueue]") {
+  utils::WorkStealingQueue<int> queue(2);
+  queue.enqueue(1);  // goes to shard 0
+  std::thread consumer([&queue] {
+    queue.registerConsumer();  // gets shard 0
+    queue.enqueue(2);
+    int value = 0;
+    REQUIRE(queue.dequeueWait(value));
+    CHECK(value == 1);
+    REQUIRE(queue.dequeueWait(value));
+    CHECK(value == 2);
+  });
+  consumer.join();
+  CHECK(queue.empty());
+}
+
+TEST_CASE("Idle consumers steal elements from other shards", "[WorkStealingQueue]") {
+  utils::WorkStealingQueue<int> queue(2);
+  std::vector<int> results;
+  std::thread consumer([&queue, &results] {
+    queue.registerConsumer();
+    int value = 0;
+    while (results.size() < 10 && queue.dequeueWait(value)) {
+      results.push_back(value);
+    }
+  });
+  for (int i = 0; i < 10; ++i) {
+    queue.enqueue(i);
+  }
+  consumer.join();
+  CHECK(results.size() == 10);
+}
+
+TEST_CASE("Stopping the WorkStealingQueue interrupts waiting consumers", "[WorkStealingQueue]") {
+  utils::WorkStealingQueue<int> queue(3);
+  std::vector<std::thread> consumers;
+  std::atomic<int> interrupted_count = 0;
+  for (int i = 0; i < 3; ++i) {
+    consumers.emplace_back([&queue, &interrupted_count] {
+      queue.registerConsumer();
+      int value = 0;
+      if (!queue.dequeueWait(value)) {
+        ++interrupted_count;
+      }
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  queue.stop();
+  for (auto& consumer : consumers) {
+    consumer.join();
+  }
+  CHECK(interrupted_count == 3);
+}
+
+TEST_CASE("Elements can be removed from and kept during resizing the WorkStealingQueue", "[WorkStealingQueue]") {
+  utils::WorkStealingQueue<int> queue(2);
+  for (int i = 0; i < 10; ++i) {
+    queue.enqueue(i);
+  }
+  queue.remove([](int value) { return value % 2 == 0; });
+  CHECK(queue.size() == 5);
+
+  queue.resize(3);
+  CHECK(queue.size() == 5);
+  std::set<int> results;
+  int value = 0;
+  while (!queue.empty() && queue.dequeueWait(value)) {
+    results.insert(value);
+  }
+  CHECK(results == std::set<int>{1, 3, 5, 7, 9});
+}
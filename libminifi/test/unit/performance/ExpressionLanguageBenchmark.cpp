@@ -0,0 +1,51 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "core/FlowFile.h"
+#include "expression-language/Expression.h"
+
+namespace minifi = org::apache::nifi::minifi;
+namespace expression = minifi::expression;
+
+namespace {
+
+// Evaluates the expression against a flow file, as UpdateAttribute and RouteOnAttribute do for every incoming flow file
+void evaluateExpression(benchmark::State& state, const std::string& expression_str) {
+  const auto expr = expression::compile(expression_str);
+  const auto flow_file = std::make_shared<minifi::core::FlowFileImpl>();
+  flow_file->setAttribute("filename", "sensor-data-2024-03-01.csv");
+  flow_file->setAttribute("path", "/var/log/minifi/sensors/");
+  flow_file->setAttribute("record.count", "1250");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(expr(expression::Parameters{flow_file.get()}).asString());
+  }
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(evaluateExpression, attribute, std::string("${filename}"));
+BENCHMARK_CAPTURE(evaluateExpression, functionChain, std::string("${filename:substringBefore('.'):toUpper():append('_'):append(${record.count})}"));
+BENCHMARK_CAPTURE(evaluateExpression, staticSubexpressions, std::string("${literal('prefix'):toUpper():append(${literal(10):multiply(60)})}-${filename}"));
+BENCHMARK_CAPTURE(evaluateExpression, replaceAll, std::string("${filename:replaceAll('[0-9]{4}-[0-9]{2}-[0-9]{2}', 'DATE')}"));
+BENCHMARK_CAPTURE(evaluateExpression, matches, std::string("${path:matches('/var/log/.*/sensors/')}"));
+BENCHMARK_CAPTURE(evaluateExpression, routingCondition, std::string("${filename:endsWith('.csv'):and(${record.count:gt(1000)}):and(${path:find('sensors')})}"));
+
+BENCHMARK_MAIN();
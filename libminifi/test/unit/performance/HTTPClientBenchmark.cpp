@@ -0,0 +1,110 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "CivetServer.h"
+#include "http/HTTPClient.h"
+#include "http/HTTPMultiClient.h"
+#include "integration/CivetLibrary.h"
+#include "minifi-cpp/utils/gsl.h"
+
+namespace minifi = org::apache::nifi::minifi;
+
+namespace {
+
+constexpr auto SERVER_LATENCY = std::chrono::milliseconds(20);
+
+// Responds after a fixed delay, simulating a remote service which InvokeHTTP spends most of its time waiting for
+class DelayedResponder : public CivetHandler {
+ public:
+  bool handleGet(CivetServer*, struct mg_connection* conn) override {
+    std::this_thread::sleep_for(SERVER_LATENCY);
+    mg_printf(conn, "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: 2\r\n\r\nOK");
+    return true;
+  }
+};
+
+class DelayedServer {
+ public:
+  DelayedServer() : server_(std::vector<std::string>{"listening_ports", "0", "num_threads", "64", "enable_keep_alive", "yes"}) {
+    server_.addHandler("/delayed", handler_);
+    url_ = "http://localhost:" + std::to_string(server_.getListeningPorts().at(0)) + "/delayed";
+  }
+
+  [[nodiscard]] const std::string& getURL() const {
+    return url_;
+  }
+
+ private:
+  CivetLibrary lib_;
+  DelayedResponder handler_;
+  CivetServer server_;
+  std::string url_;
+};
+
+std::vector<std::unique_ptr<minifi::http::HTTPClient>> createClients(const std::string& url, size_t count) {
+  std::vector<std::unique_ptr<minifi::http::HTTPClient>> clients;
+  for (size_t i = 0; i < count; ++i) {
+    auto client = std::make_unique<minifi::http::HTTPClient>();
+    client->initialize(minifi::http::HttpRequestMethod::Get, url, nullptr);
+    clients.push_back(std::move(client));
+  }
+  return clients;
+}
+
+// Sends the requests one after the other, as each InvokeHTTP thread does with a blocking client
+void sendSequentially(benchmark::State& state) {
+  const DelayedServer server;
+  const auto requests = gsl::narrow<size_t>(state.range(0));
+  const auto clients = createClients(server.getURL(), 1);
+  for (auto _ : state) {
+    for (size_t i = 0; i < requests; ++i) {
+      benchmark::DoNotOptimize(clients[0]->submit());
+    }
+  }
+  state.SetItemsProcessed(gsl::narrow<int64_t>(state.iterations() * requests));
+}
+
+// Keeps all requests in flight at the same time from a single thread, as InvokeHTTP does with Max Concurrent Requests set
+void sendConcurrently(benchmark::State& state) {
+  const DelayedServer server;
+  const auto requests = gsl::narrow<size_t>(state.range(0));
+  const auto clients = createClients(server.getURL(), requests);
+  minifi::http::HTTPMultiClient multi_client;
+  for (auto _ : state) {
+    for (const auto& client : clients) {
+      multi_client.addTransfer(*client);
+    }
+    while (multi_client.size() > 0) {
+      benchmark::DoNotOptimize(multi_client.perform(std::chrono::seconds(1)));
+    }
+  }
+  state.SetItemsProcessed(gsl::narrow<int64_t>(state.iterations() * requests));
+}
+
+}  // namespace
+
+BENCHMARK(sendSequentially)->RangeMultiplier(4)->Range(1, 64)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(sendConcurrently)->RangeMultiplier(4)->Range(1, 64)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
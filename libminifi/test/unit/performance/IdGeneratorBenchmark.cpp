@@ -0,0 +1,50 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "properties/Properties.h"
+#include "utils/Id.h"
+
+namespace minifi = org::apache::nifi::minifi;
+
+namespace {
+
+// Generates ids from every benchmark thread, as the processors of a flow do when creating flow files, provenance events and claims
+void generateIds(benchmark::State& state, const std::string& implementation) {
+  const auto generator = minifi::utils::IdGenerator::getIdGenerator();
+  if (state.thread_index() == 0) {
+    const auto properties = std::make_shared<minifi::PropertiesImpl>(minifi::PropertiesImpl::PersistTo::MultipleFiles, "UID properties");
+    properties->set("uid.implementation", implementation);
+    generator->initialize(properties);
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(generator->generate());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(generateIds, time, std::string("time"))->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_CAPTURE(generateIds, random, std::string("random"))->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_CAPTURE(generateIds, minifiUid, std::string("minifi_uid"))->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_CAPTURE(generateIds, timeOrdered, std::string("time_ordered"))->ThreadRange(1, 32)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,88 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "FlowFileRecord.h"
+#include "core/FlowFileSerializationArena.h"
+#include "core/repository/VolatileRepository.h"
+#include "io/BufferStream.h"
+
+namespace minifi = org::apache::nifi::minifi;
+namespace core = minifi::core;
+
+namespace {
+
+std::vector<std::shared_ptr<minifi::FlowFileRecordImpl>> createFlowFiles(size_t count) {
+  std::vector<std::shared_ptr<minifi::FlowFileRecordImpl>> flow_files;
+  for (size_t i = 0; i < count; ++i) {
+    auto flow_file = std::make_shared<minifi::FlowFileRecordImpl>();
+    flow_file->setSize(1024);
+    flow_file->addAttribute("path", "/var/log/minifi/");
+    flow_file->addAttribute("mime.type", "application/json");
+    flow_file->addAttribute("record.count", std::to_string(i));
+    flow_files.push_back(std::move(flow_file));
+  }
+  return flow_files;
+}
+
+std::unique_ptr<core::repository::VolatileRepository> createRepository() {
+  auto repository = std::make_unique<core::repository::VolatileRepository>("BenchmarkRepository", "", core::MAX_REPOSITORY_ENTRY_LIFE_TIME, 100 * 1024 * 1024);
+  repository->initialize(nullptr);
+  return repository;
+}
+
+// Persisting the flow files of a commit with a separately allocated buffer and key for every flow file, as it was done before the arena
+void commitWithBufferPerFlowFile(benchmark::State& state) {
+  const auto flow_files = createFlowFiles(gsl::narrow<size_t>(state.range(0)));
+  const auto repository = createRepository();
+  for (auto _ : state) {
+    std::vector<std::pair<std::string, std::unique_ptr<minifi::io::BufferStream>>> flow_data;
+    for (const auto& flow_file : flow_files) {
+      auto stream = std::make_unique<minifi::io::BufferStream>();
+      flow_file->Serialize(*stream);
+      flow_data.emplace_back(flow_file->getUUIDStr(), std::move(stream));
+    }
+    benchmark::DoNotOptimize(repository->MultiPut(flow_data));
+  }
+  state.counters["commits/s"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+
+void commitWithArena(benchmark::State& state) {
+  const auto flow_files = createFlowFiles(gsl::narrow<size_t>(state.range(0)));
+  const auto repository = createRepository();
+  core::FlowFileSerializationArena arena;
+  for (auto _ : state) {
+    for (const auto& flow_file : flow_files) {
+      arena.add(*flow_file);
+    }
+    benchmark::DoNotOptimize(repository->MultiPut(arena.entries()));
+    arena.clear();
+  }
+  state.counters["commits/s"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+
+}  // namespace
+
+BENCHMARK(commitWithBufferPerFlowFile)->Arg(1)->Arg(10)->Arg(1000);
+BENCHMARK(commitWithArena)->Arg(1)->Arg(10)->Arg(1000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,98 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "io/FileStream.h"
+#include "io/InputStream.h"
+#include "io/StreamPipe.h"
+
+namespace minifi = org::apache::nifi::minifi;
+
+namespace {
+
+// Hides the file behind the stream, so that pipe() has to copy the data through user space as it did before the kernel copies
+class UserSpaceInputStream : public minifi::io::InputStreamImpl {
+ public:
+  explicit UserSpaceInputStream(minifi::io::InputStream& stream) : stream_(stream) {}
+
+  size_t read(std::span<std::byte> out_buffer) override { return stream_.read(out_buffer); }
+  [[nodiscard]] size_t size() const override { return stream_.size(); }
+
+ private:
+  minifi::io::InputStream& stream_;
+};
+
+class TemporaryFiles {
+ public:
+  explicit TemporaryFiles(size_t source_size)
+      : directory_(std::filesystem::temp_directory_path() / ("minifi-stream-pipe-benchmark-" + std::to_string(source_size))) {
+    std::filesystem::create_directories(directory_);
+    std::ofstream source_file(source(), std::ios::binary);
+    const std::vector<char> chunk(1024 * 1024, 'x');
+    for (size_t written = 0; written < source_size; written += chunk.size()) {
+      source_file.write(chunk.data(), gsl::narrow<std::streamsize>(std::min(chunk.size(), source_size - written)));
+    }
+  }
+
+  ~TemporaryFiles() {
+    std::error_code remove_error;
+    std::filesystem::remove_all(directory_, remove_error);
+  }
+
+  TemporaryFiles(const TemporaryFiles&) = delete;
+  TemporaryFiles& operator=(const TemporaryFiles&) = delete;
+  TemporaryFiles(TemporaryFiles&&) = delete;
+  TemporaryFiles& operator=(TemporaryFiles&&) = delete;
+
+  [[nodiscard]] std::filesystem::path source() const { return directory_ / "source"; }
+  [[nodiscard]] std::filesystem::path destination() const { return directory_ / "destination"; }
+
+ private:
+  std::filesystem::path directory_;
+};
+
+// Copies a flow file content from the content repository to another file, as e.g. PutFile and ProcessSession::import do
+void pipeFileToFile(benchmark::State& state, bool in_kernel) {
+  const auto size = gsl::narrow<size_t>(state.range(0));
+  const TemporaryFiles files(size);
+  for (auto _ : state) {
+    minifi::io::FileStream source(files.source(), 0, false);
+    minifi::io::FileStream destination(files.destination());
+    if (in_kernel) {
+      benchmark::DoNotOptimize(minifi::internal::pipe(source, destination));
+    } else {
+      UserSpaceInputStream user_space_source(source);
+      benchmark::DoNotOptimize(minifi::internal::pipe(user_space_source, destination));
+    }
+  }
+  state.SetBytesProcessed(gsl::narrow<int64_t>(state.iterations() * size));
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(pipeFileToFile, userSpace, false)->Arg(1024)->Arg(1024 * 1024)->Arg(1024 * 1024 * 1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(pipeFileToFile, kernel, true)->Arg(1024)->Arg(1024 * 1024)->Arg(1024 * 1024 * 1024)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
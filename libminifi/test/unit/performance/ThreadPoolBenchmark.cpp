@@ -0,0 +1,82 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "utils/ThreadPool.h"
+
+namespace utils = org::apache::nifi::minifi::utils;
+
+namespace {
+
+constexpr int64_t TASKS_PER_THREAD = 4;
+constexpr size_t RUNS_PER_TASK = 1000;
+
+// Every task reschedules itself RUNS_PER_TASK times, with every 10th run being delayed, similarly to processors yielding.
+void runTasks(benchmark::State& state, utils::ThreadPoolSchedulingMode scheduling_mode) {
+  const auto thread_count = static_cast<int>(state.range(0));
+  const auto task_count = static_cast<size_t>(thread_count * TASKS_PER_THREAD);
+  for (auto _ : state) {
+    state.PauseTiming();
+    utils::ThreadPool pool(thread_count, nullptr, "BenchmarkPool", scheduling_mode);
+    pool.start();
+    std::vector<std::atomic<size_t>> run_counts(task_count);
+    std::vector<std::future<utils::TaskRescheduleInfo>> futures(task_count);
+    state.ResumeTiming();
+
+    for (size_t i = 0; i < task_count; ++i) {
+      utils::Worker worker([&run_count = run_counts[i]]() {
+        const auto runs = ++run_count;
+        if (runs == RUNS_PER_TASK) {
+          return utils::TaskRescheduleInfo::Done();
+        }
+        if (runs % 10 == 0) {
+          return utils::TaskRescheduleInfo::RetryIn(std::chrono::microseconds(100));
+        }
+        return utils::TaskRescheduleInfo::RetryImmediately();
+      }, "task" + std::to_string(i));
+      pool.execute(std::move(worker), futures[i]);
+    }
+    for (auto& future : futures) {
+      future.wait();
+    }
+
+    state.PauseTiming();
+    pool.shutdown();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * gsl::narrow<int64_t>(task_count * RUNS_PER_TASK));
+}
+
+void BM_SharedQueueThreadPool(benchmark::State& state) {
+  runTasks(state, utils::ThreadPoolSchedulingMode::SHARED_QUEUE);
+}
+
+void BM_WorkStealingThreadPool(benchmark::State& state) {
+  runTasks(state, utils::ThreadPoolSchedulingMode::WORK_STEALING);
+}
+
+}  // namespace
+
+BENCHMARK(BM_SharedQueueThreadPool)->RangeMultiplier(2)->Range(8, 64)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_WorkStealingThreadPool)->RangeMultiplier(2)->Range(8, 64)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -16,9 +16,11 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 
 namespace org::apache::nifi::minifi::io {
 
@@ -35,5 +37,7 @@ struct ReadWriteResult {
 using InputStreamCallback = std::function<int64_t(const std::shared_ptr<InputStream>& input_stream)>;
 using OutputStreamCallback = std::function<int64_t(const std::shared_ptr<OutputStream>& output_stream)>;
 using InputOutputStreamCallback = std::function<std::optional<ReadWriteResult>(const std::shared_ptr<InputStream>& input_stream, const std::shared_ptr<OutputStream>& output_stream)>;
+// receives the whole content at once, it is only valid during the call
+using InputBufferCallback = std::function<int64_t(std::span<const std::byte> content)>;
 
 }  // namespace org::apache::nifi::minifi::io
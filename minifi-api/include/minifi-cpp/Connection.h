@@ -25,6 +25,7 @@
 #include <vector>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <atomic>
 #include <algorithm>
 #include <utility>
@@ -69,6 +70,10 @@ class Connection : public virtual core::Connectable {
   virtual uint64_t getQueueDataSize() = 0;
   virtual void multiPut(std::vector<std::shared_ptr<core::FlowFile>>& flows) = 0;
   virtual std::shared_ptr<core::FlowFile> poll(std::set<std::shared_ptr<core::FlowFile>> &expiredFlowRecords) = 0;
+  // The time when the earliest penalized flow file of the connection can be polled, if there is any
+  virtual std::optional<std::chrono::steady_clock::time_point> getNextPenaltyExpiration() = 0;
   virtual void drain(bool delete_permanently) = 0;
+  // The given percentile (a ratio between 0 and 1) of the time the polled flow files have spent in the queue
+  virtual std::chrono::nanoseconds getQueueWaitTimePercentile(double ratio) const = 0;
 };
 }  // namespace org::apache::nifi::minifi
@@ -16,6 +16,9 @@
  */
 #pragma once
 
+#include <memory>
+#include <optional>
+
 #include "minifi-cpp/core/controller/ControllerService.h"
 #include "minifi-cpp/core/ControllerServiceApiDefinition.h"
 #include "minifi-cpp/core/Record.h"
@@ -25,6 +28,16 @@
 
 namespace org::apache::nifi::minifi::core {
 
+// Pulls records one by one from an input stream, so the whole record set does not have to be kept in memory.
+// It must not outlive the input stream it was created for.
+class RecordReader {
+ public:
+  virtual ~RecordReader() = default;
+
+  // Returns the next record, std::nullopt at the end of the input, or an error if the input cannot be read
+  virtual nonstd::expected<std::optional<Record>, std::error_code> next() = 0;
+};
+
 class RecordSetReader : public virtual controller::ControllerService {
  public:
   static constexpr auto ProvidesApi = core::ControllerServiceApiDefinition{
@@ -34,6 +47,7 @@ class RecordSetReader : public virtual controller::ControllerService {
   };
 
   virtual nonstd::expected<RecordSet, std::error_code> read(io::InputStream& input_stream) = 0;
+  virtual std::unique_ptr<RecordReader> createRecordReader(io::InputStream& input_stream) = 0;
 };
 
 }  // namespace org::apache::nifi::minifi::core
@@ -16,15 +16,30 @@
  */
 #pragma once
 
+#include <memory>
+
 #include "minifi-cpp/core/controller/ControllerService.h"
 
 #include "minifi-cpp/core/ControllerServiceApiDefinition.h"
 #include "minifi-cpp/core/FlowFile.h"
 #include "minifi-cpp/core/ProcessSession.h"
 #include "minifi-cpp/core/Record.h"
+#include "minifi-cpp/io/OutputStream.h"
 
 namespace org::apache::nifi::minifi::core {
 
+// Serializes records one by one to an output stream, so the whole record set does not have to be kept in memory.
+// It must not outlive the output stream it was created for.
+class RecordWriter {
+ public:
+  virtual ~RecordWriter() = default;
+
+  // Both functions return the number of bytes written to the output stream, or io::STREAM_ERROR
+  virtual size_t write(const Record& record) = 0;
+  // Writes the closing part of the format, must be called once after the last record
+  virtual size_t finish() = 0;
+};
+
 class RecordSetWriter : public virtual controller::ControllerService {
  public:
   static constexpr auto ProvidesApi = core::ControllerServiceApiDefinition{
@@ -34,6 +49,7 @@ class RecordSetWriter : public virtual controller::ControllerService {
   };
 
   virtual void write(const RecordSet& record_set, const std::shared_ptr<FlowFile>& flow_file, ProcessSession& session) = 0;
+  virtual std::unique_ptr<RecordWriter> createRecordWriter(io::OutputStream& output_stream) = 0;
 };
 
 }  // namespace org::apache::nifi::minifi::core
@@ -31,10 +31,20 @@ class ContentRepository;
 
 class ContentSession {
  public:
+  struct NewContent {
+    std::shared_ptr<ResourceClaim> claim;
+    size_t offset = 0;
+    std::shared_ptr<io::BaseStream> stream;
+  };
+
   virtual std::shared_ptr<ResourceClaim> create() = 0;
 
   virtual std::shared_ptr<io::BaseStream> write(const std::shared_ptr<ResourceClaim>& resource_id) = 0;
 
+  // Opens a stream for new content. Unlike create() followed by write(), the session may place the content
+  // into a claim shared with other content of the session, in which case it starts at the returned offset.
+  virtual NewContent writeNewContent() = 0;
+
   virtual std::shared_ptr<io::BaseStream> append(const std::shared_ptr<ResourceClaim>& resource_id, size_t offset, const std::function<void(const std::shared_ptr<ResourceClaim>&)>& on_copy) = 0;
 
   virtual std::shared_ptr<io::BaseStream> read(const std::shared_ptr<ResourceClaim>& resource_id) = 0;
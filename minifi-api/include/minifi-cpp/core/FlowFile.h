@@ -64,12 +64,17 @@ class FlowFile : public virtual CoreComponent, public virtual ReferenceContainer
   virtual bool removeAttribute(std::string_view key) = 0;
   [[nodiscard]] virtual std::map<std::string, std::string> getAttributes() const = 0;
   virtual AttributeMap *getAttributesPtr() = 0;
+  [[nodiscard]] virtual const AttributeMap *getAttributesPtr() const = 0;
+  // The current attributes, which stay unchanged when the flow file is modified later
+  [[nodiscard]] virtual std::shared_ptr<const AttributeMap> getAttributesSnapshot() const = 0;
   virtual bool addAttribute(std::string_view key, const std::string& value) = 0;
   virtual void setSize(const uint64_t size) = 0;
   [[nodiscard]] virtual uint64_t getSize() const = 0;
   virtual void setOffset(const uint64_t offset) = 0;
   [[nodiscard]] virtual std::chrono::steady_clock::time_point getPenaltyExpiration() const = 0;
   virtual void setPenaltyExpiration(std::chrono::time_point<std::chrono::steady_clock> to_be_processed_after) = 0;
+  [[nodiscard]] virtual std::chrono::steady_clock::time_point getLastQueueTime() const = 0;
+  virtual void setLastQueueTime(std::chrono::steady_clock::time_point queue_time) = 0;
   [[nodiscard]] virtual uint64_t getOffset() const = 0;
   [[nodiscard]] virtual bool isPenalized() const = 0;
   [[nodiscard]] virtual uint64_t getId() const = 0;
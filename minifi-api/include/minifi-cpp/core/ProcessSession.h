@@ -66,6 +66,8 @@ class ProcessSession : public virtual ReferenceContainer {
   virtual int64_t read(const core::FlowFile& flow_file, const io::InputStreamCallback& callback) = 0;
   // Read content into buffer
   virtual detail::ReadBufferResult readBuffer(const std::shared_ptr<core::FlowFile>& flow) = 0;
+  // Execute the given callback against the whole content at once, without copying it if the content repository keeps it in memory
+  virtual int64_t readInPlace(const core::FlowFile& flow_file, const io::InputBufferCallback& callback) = 0;
   // Execute the given write callback against the content
   virtual void write(const std::shared_ptr<core::FlowFile> &flow, const io::OutputStreamCallback& callback) = 0;
 
@@ -22,7 +22,10 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include "minifi-cpp/core/Connectable.h"
@@ -44,6 +47,8 @@ class Repository : public virtual core::CoreComponent, public virtual core::Repo
 
   virtual bool Put(const std::string& /*key*/, const uint8_t* /*buf*/, size_t /*bufLen*/) = 0;
   virtual bool MultiPut(const std::vector<std::pair<std::string, std::unique_ptr<io::BufferStream>>>& /*data*/) = 0;
+  // The keys and values point into buffers owned by the caller, which only have to be valid until the call returns
+  virtual bool MultiPut(std::span<const std::pair<std::string_view, std::span<const std::byte>>> data) = 0;
   virtual bool Delete(const std::string& /*key*/) = 0;
   virtual bool Delete(const std::shared_ptr<core::CoreComponent>& item) = 0;
   virtual bool Delete(std::vector<std::shared_ptr<core::SerializableComponent>> &storedValues) = 0;
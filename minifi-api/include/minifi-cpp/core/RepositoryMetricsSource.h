@@ -25,9 +25,16 @@ namespace org::apache::nifi::minifi::core {
 
 class RepositoryMetricsSource {
  public:
+  struct RocksDbWriteGroupStats {
+    uint64_t write_group_count{};
+    uint64_t grouped_write_count{};
+    uint64_t total_commit_latency_us{};
+  };
+
   struct RocksDbStats {
     uint64_t table_readers_size{};
     uint64_t all_memory_tables_size{};
+    std::optional<RocksDbWriteGroupStats> write_group_stats{};
   };
 
   virtual ~RepositoryMetricsSource() = default;
@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include "minifi-cpp/properties/Configure.h"
 #include "minifi-cpp/ResourceClaim.h"
@@ -48,6 +49,13 @@ class StreamManager {
 
   virtual std::string getStoragePath() const = 0;
 
+  /**
+   * Returns the path under which the stream with the given name is to be stored.
+   * @param stream_name unique name of the stream
+   * @return full path of the stream
+   */
+  virtual std::string getStreamPath(std::string_view stream_name) const = 0;
+
   /**
    * Create a write stream using the streamId as a reference.
    * @param streamId stream identifier
@@ -45,9 +45,12 @@ class Configuration : public virtual Properties {
   static constexpr const char *nifi_flow_configuration_file = "nifi.flow.configuration.file";
   static constexpr const char *nifi_flow_configuration_encrypt = "nifi.flow.configuration.encrypt";
   static constexpr const char *nifi_flow_configuration_file_backup_update = "nifi.flow.configuration.backup.on.update";
+  static constexpr const char *nifi_flow_configuration_differential_update = "nifi.flow.configuration.differential.update";
   static constexpr const char *nifi_flow_engine_threads = "nifi.flow.engine.threads";
+  static constexpr const char *nifi_flow_engine_work_stealing = "nifi.flow.engine.work.stealing";
   static constexpr const char *nifi_flow_engine_alert_period = "nifi.flow.engine.alert.period";
   static constexpr const char *nifi_flow_engine_event_driven_time_slice = "nifi.flow.engine.event.driven.time.slice";
+  static constexpr const char *nifi_flow_engine_event_driven_idle_period = "nifi.flow.engine.event.driven.idle.period";
   static constexpr const char *nifi_administrative_yield_duration = "nifi.administrative.yield.duration";
   static constexpr const char *nifi_bored_yield_duration = "nifi.bored.yield.duration";
   static constexpr const char *nifi_graceful_shutdown_seconds = "nifi.flowcontroller.graceful.shutdown.period";
@@ -63,14 +66,20 @@ class Configuration : public virtual Properties {
   static constexpr const char *nifi_provenance_repository_max_storage_size = "nifi.provenance.repository.max.storage.size";
   static constexpr const char *nifi_provenance_repository_max_storage_time = "nifi.provenance.repository.max.storage.time";
   static constexpr const char *nifi_provenance_repository_directory_default = "nifi.provenance.repository.directory.default";
+  static constexpr const char *nifi_provenance_repository_sampling_ratio = "nifi.provenance.repository.sampling.ratio";
   static constexpr const char *nifi_flowfile_repository_directory_default = "nifi.flowfile.repository.directory.default";
   static constexpr const char *nifi_dbcontent_repository_directory_default = "nifi.database.content.repository.directory.default";
+  static constexpr const char *nifi_content_repository_subdirectory_count = "nifi.content.repository.subdirectory.count";
+  static constexpr const char *nifi_content_repository_max_container_size = "nifi.content.repository.max.container.size";
+  static constexpr const char *nifi_content_repository_memory_mapped_reads = "nifi.content.repository.memory.mapped.reads";
   static constexpr const char *nifi_default_internal_buffer_size = "nifi.default.internal.buffer.size";
 
   // these are internal properties related to the rocksdb backend
   static constexpr const char *nifi_flowfile_repository_rocksdb_compaction_period = "nifi.flowfile.repository.rocksdb.compaction.period";
   static constexpr const char *nifi_dbcontent_repository_rocksdb_compaction_period = "nifi.database.content.repository.rocksdb.compaction.period";
   static constexpr const char *nifi_dbcontent_repository_purge_period = "nifi.database.content.repository.purge.period";
+  static constexpr const char *nifi_dbcontent_repository_chunk_size = "nifi.database.content.repository.chunk.size";
+  static constexpr const char *nifi_dbcontent_repository_rocksdb_min_blob_size = "nifi.database.content.repository.rocksdb.min.blob.size";
   static constexpr const char *nifi_content_repository_rocksdb_use_synchronous_writes = "nifi.content.repository.rocksdb.use.synchronous.writes";
   static constexpr const char *nifi_content_repository_rocksdb_read_verify_checksums = "nifi.content.repository.rocksdb.read.verify.checksums";
   static constexpr const char *nifi_flowfile_repository_rocksdb_read_verify_checksums = "nifi.flowfile.repository.rocksdb.read.verify.checksums";